@@ -60,6 +60,32 @@ void DbInitializer::ensureCreated(const QString& dbPath) {
         )
     )");
 
+    // Results cached without the manifest's identity cannot tell a replaced
+    // manifest apart; the cache is only a shortcut, so it is rebuilt
+    query.exec("SELECT count(*) FROM pragma_table_info('VerificationCache') WHERE name = 'ManifestSize'");
+    if (query.next() && query.value(0).toInt() == 0) {
+        query.exec("DROP TABLE IF EXISTS VerificationCache");
+    }
+
+    // Create VerificationCache table: cartridge verification results keyed
+    // by path, valid while Inode/Size/ModifiedMs still match the file and
+    // the Manifest* columns its sidecar manifest
+    query.exec(R"(
+        CREATE TABLE IF NOT EXISTS VerificationCache (
+            Path TEXT PRIMARY KEY,
+            Inode INTEGER NOT NULL,
+            Size INTEGER NOT NULL,
+            ModifiedMs INTEGER NOT NULL,
+            ManifestInode INTEGER NOT NULL,
+            ManifestSize INTEGER NOT NULL,
+            ManifestModifiedMs INTEGER NOT NULL,
+            Digest BLOB NOT NULL,
+            TrustLevel INTEGER NOT NULL,
+            KeyFingerprint TEXT,
+            VerifiedUtc TEXT NOT NULL
+        )
+    )");
+
     db.close();
     QSqlDatabase::removeDatabase("init_connection");
 }
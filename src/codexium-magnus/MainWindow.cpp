@@ -13,6 +13,7 @@
 #include <QDebug>
 #include "../codexium-magnus-core/Models/TypographyConfig.h"
 #include "../codexium-magnus-core/Models/BibliographyConfig.h"
+#include "../codexium-magnus-storage/DbInitializer.h"
 #include "UI/NavigationPane.h"
 #include "UI/SearchPane.h"
 #include "UI/SettingsDialog.h"
@@ -20,6 +21,10 @@
 #include "Services/SearchService.h"
 #include "Services/LinkService.h"
 #include "Services/PrintService.h"
+#include "Services/VerifyingVfs.h"
+#include <QWebEngineProfile>
+#include <QWebEngineScript>
+#include <QWebEngineScriptCollection>
 
 // Placeholder configuration sources
 namespace CodexiumMagnus {
@@ -30,6 +35,228 @@ const qreal MainWindow::ZOOM_MAX = 5.0;
 const qreal MainWindow::ZOOM_STEP = 0.1;
 const qreal MainWindow::ZOOM_DEFAULT = 1.0;
 
+namespace {
+// In-page search highlighting, driven by "search:*" host messages:
+//   search:highlight {matches: [[start, length], ...]}  mark all matches, select the first
+//   search:next / search:previous                     move the current match
+//   search:clear                                      remove all marks
+// Offsets count characters of the document's plain text the way the search
+// service does (see CaseSensitiveFilter::plainText): text nodes joined
+// without separators, whitespace collapsed, leading whitespace dropped. Mapping them onto text
+// nodes and wrapping them in <mark> runs in slices of a few milliseconds,
+// so megabyte documents stay responsive and the first match shows at once.
+const char *kSearchHighlightScript = R"(
+(function() {
+    var kSliceMs = 8;
+    var hits = [];       // Marks of each match, in document order
+    var current = -1;
+    var pass = 0;        // Bumped to abandon a running highlight pass
+
+    function isSpace(code) {
+        return code === 32 || (code >= 9 && code <= 13) || code === 0xa0 || code === 0x1680
+            || (code >= 0x2000 && code <= 0x200a) || code === 0x2028 || code === 0x2029
+            || code === 0x202f || code === 0x205f || code === 0x3000;
+    }
+
+    // Wrap [start, end) of a text node; returns the mark and the text after it
+    function wrap(node, start, end) {
+        if (start > 0) {
+            node = node.splitText(start);
+            end -= start;
+        }
+        var rest = end < node.nodeValue.length ? node.splitText(end) : null;
+        var mark = document.createElement('mark');
+        mark.className = 'cm-search-hit';
+        node.parentNode.replaceChild(mark, node);
+        mark.appendChild(node);
+        return { mark: mark, rest: rest };
+    }
+
+    function select(index) {
+        if (hits.length === 0) {
+            return;
+        }
+        if (current >= 0) {
+            hits[current].forEach(function(mark) { mark.classList.remove('cm-search-current'); });
+        }
+        current = (index + hits.length) % hits.length;
+        hits[current].forEach(function(mark) { mark.classList.add('cm-search-current'); });
+        hits[current][0].scrollIntoView({ block: 'center' });
+    }
+
+    function clear() {
+        ++pass;
+        hits.forEach(function(marks) {
+            marks.forEach(function(mark) {
+                var parent = mark.parentNode;
+                if (!parent) {
+                    return;
+                }
+                while (mark.firstChild) {
+                    parent.insertBefore(mark.firstChild, mark);
+                }
+                parent.removeChild(mark);
+                parent.normalize();
+            });
+        });
+        hits = [];
+        current = -1;
+    }
+
+    function highlight(matches) {
+        clear();
+        var id = pass;
+        var walker = document.createTreeWalker(document.documentElement, NodeFilter.SHOW_TEXT, {
+            acceptNode: function(node) {
+                var name = node.parentNode ? node.parentNode.nodeName : '';
+                return (name === 'SCRIPT' || name === 'STYLE') ? NodeFilter.FILTER_REJECT : NodeFilter.FILTER_ACCEPT;
+            }
+        });
+        var node = walker.nextNode();
+        var i = 0;
+        var position = 0;
+        var pendingSpace = false;
+        var started = false;
+        var k = 0;
+        var segments = null;   // Earlier text nodes of a match spanning several
+        var segmentStart = 0;
+
+        function finishMatch() {
+            // Text in <head> (the title) counts but cannot be marked
+            if (document.body && document.body.contains(node)) {
+                var marks = segments.map(function(segment) {
+                    return wrap(segment.node, segment.start, segment.node.nodeValue.length).mark;
+                });
+                var wrapped = wrap(node, segmentStart, i + 1);
+                marks.push(wrapped.mark);
+                hits.push(marks);
+                if (hits.length === 1) {
+                    select(0);
+                }
+                // Continue in the text after the match
+                walker.currentNode = wrapped.rest || wrapped.mark.firstChild;
+                node = wrapped.rest;
+                i = -1;
+            }
+            segments = null;
+            ++k;
+        }
+
+        function step() {
+            if (id !== pass) {
+                return;
+            }
+            var deadline = performance.now() + kSliceMs;
+            while (node && k < matches.length) {
+                var text = node.nodeValue;
+                for (; i < text.length && k < matches.length; ++i) {
+                    if ((i & 1023) === 0 && performance.now() > deadline) {
+                        setTimeout(step, 0);
+                        return;
+                    }
+                    if (isSpace(text.charCodeAt(i))) {
+                        pendingSpace = true;
+                        continue;
+                    }
+                    if (pendingSpace && started) {
+                        ++position;
+                    }
+                    pendingSpace = false;
+                    started = true;
+
+                    var start = matches[k][0];
+                    if (!segments && position >= start) {
+                        segments = [];
+                        segmentStart = i;
+                    }
+                    var atEnd = segments && position >= start + matches[k][1] - 1;
+                    ++position;
+                    if (atEnd) {
+                        finishMatch();
+                        if (i < 0) {
+                            break;
+                        }
+                    }
+                }
+                if (i < 0) {
+                    // Resume at the start of the text after the last match
+                    i = 0;
+                    if (node) {
+                        continue;
+                    }
+                } else if (segments) {
+                    segments.push({ node: node, start: segmentStart });
+                    segmentStart = 0;
+                }
+                node = walker.nextNode();
+                i = 0;
+            }
+        }
+        step();
+    }
+
+    var previous = window.onHostMessage;
+    window.onHostMessage = function(message) {
+        var type = message ? message.type : '';
+        if (type === 'search:highlight') {
+            highlight(message.matches || []);
+        } else if (type === 'search:next') {
+            select(current + 1);
+        } else if (type === 'search:previous') {
+            select(current - 1);
+        } else if (type === 'search:clear') {
+            clear();
+        } else if (typeof previous === 'function') {
+            previous(message);
+        }
+    };
+})();
+)";
+
+// Styles of the search marks, part of the theme style sheet
+const char *kSearchHighlightStyle = R"(
+mark.cm-search-hit { background-color: var(--color-search-hit, #ffe066); color: inherit; }
+mark.cm-search-hit.cm-search-current { background-color: var(--color-search-current, #ff9632); }
+)";
+
+// Profile script that themes cartridge pages. It runs before the page is
+// parsed, so the document is never shown unthemed; the style sheet is
+// adopted rather than inserted, which needs no DOM yet.
+// A "theme:update" host message {set: {token: value}, remove: [token]}
+// (see ThemeManager::tokenDiff()) switches themes in place by editing the
+// :root rule of that sheet: one style recalc, no reload.
+//   %1  JSON array holding the style sheet
+//   %2  page scripts
+const char *kThemeScriptTemplate = R"(
+if (location.protocol === 'cdoc:') {
+    (function() {
+        var sheet = new CSSStyleSheet();
+        sheet.replaceSync(%1[0]);
+        document.adoptedStyleSheets = document.adoptedStyleSheets.concat([sheet]);
+
+        var tokens = sheet.cssRules[0].style;   // The :root rule
+        var previous = window.onHostMessage;
+        window.onHostMessage = function(message) {
+            if (message && message.type === 'theme:update') {
+                var set = message.set || {};
+                Object.keys(set).forEach(function(name) {
+                    tokens.setProperty(name, set[name]);
+                });
+                (message.remove || []).forEach(function(name) {
+                    tokens.removeProperty(name);
+                });
+            } else if (typeof previous === 'function') {
+                previous(message);
+            }
+        };
+    })();
+%2
+}
+)";
+
+const QString kThemeScriptName = "codexium-theme";
+}
+
 class MainWindow::SystemConfigSource : public Core::Configuration::ConfigurationSource {
 public:
     Core::Models::TypographyConfig* getTypography() override {
@@ -126,12 +353,21 @@ MainWindow::MainWindow(QWidget *parent)
     , m_searchService(nullptr)
     , m_linkService(nullptr)
     , m_printService(nullptr)
+    , m_assetService(nullptr)
+    , m_schemeHandler(nullptr)
     , m_themeManager(nullptr)
     , m_themeActionGroup(nullptr)
     , m_themeLightAction(nullptr)
     , m_themeSepiaAction(nullptr)
     , m_themeDarkAction(nullptr)
     , m_themeCustomAction(nullptr)
+    , m_currentDocumentId()
+    , m_themeStyleSheet()
+    , m_themeTokens()
+    , m_searchMatchRowid(0)
+    , m_searchMatches()
+    , m_pageLoaded(false)
+    , m_trustGate()
     , m_zoomFactor(ZOOM_DEFAULT)
 {
     // Load saved zoom factor from settings
@@ -167,17 +403,48 @@ MainWindow::MainWindow(QWidget *parent)
     m_configResolver = new Core::Configuration::CompositeConfigurationResolver(m_configSources);
     
     // Create services
-    // Create signature service first
-    m_signatureService = new Services::SignatureService(this);
+    // Create signature service first; verification results are cached in
+    // the local app database
+    Storage::DbInitializer::ensureCreated();
+    auto *signatureService = new Services::SignatureService(this);
+    signatureService->setVerificationCache(std::make_unique<Services::VerificationCache>(
+        Storage::DbInitializer::getDefaultDbPath()));
+    m_signatureService = signatureService;
     
     // Create cartridge service and connect signature service
     m_cartridgeService = new Services::CartridgeService(this);
     static_cast<Services::CartridgeService*>(m_cartridgeService)->setSignatureService(m_signatureService);
+    m_trustGate = std::make_unique<Services::TrustGate>(static_cast<Services::CartridgeService*>(m_cartridgeService));
+    static_cast<Services::CartridgeService*>(m_cartridgeService)->setDocumentCacheBudget(
+        settings.value("performance/documentCacheMB", 32).toLongLong() * 1024 * 1024);
+    
+    Services::CartridgeOpenProfile openProfile = Services::CartridgeOpenProfile::immutableCartridge();
+    openProfile.immutable = settings.value("performance/immutableCartridges", true).toBool();
+    openProfile.mmapSize = settings.value("performance/mmapSizeMB", 256).toLongLong() * 1024 * 1024;
+    openProfile.cacheSize = settings.value("performance/pageCacheMB", 16).toLongLong() * 1024 * 1024;
+    // Lazy verification checks only the chunks SQLite reads; without the
+    // SQLite C API the VFS is unavailable and cartridges are hashed whole
+    if (settings.value("performance/lazyVerification", true).toBool()
+        && Services::VerifyingVfs::registerVfs()) {
+        openProfile.vfs = Services::VerifyingVfs::name();
+        signatureService->setLazyVerification(true);
+    }
+    static_cast<Services::CartridgeService*>(m_cartridgeService)->setDefaultOpenProfile(openProfile);
     
     m_searchService = new Services::SearchService(m_cartridgeService, this);
+    static_cast<Services::SearchService*>(m_searchService)->setResultCacheCapacity(
+        settings.value("performance/searchResultCacheSize", 10000).toInt());
     m_linkService = new Services::LinkService(this);
     m_printService = new Services::PrintService(m_webEngineView, this);
     
+    // Documents are loaded from cdoc:// URLs rather than pushed through setHtml()
+    m_assetService = new Services::AssetService(
+        static_cast<Services::CartridgeService*>(m_cartridgeService), this);
+    m_schemeHandler = new Services::CartridgeSchemeHandler(this);
+    m_schemeHandler->addCartridgeService(m_cartridgeService, m_assetService);
+    m_webEngineView->page()->profile()->installUrlSchemeHandler(
+        Services::CartridgeSchemeHandler::schemeName(), m_schemeHandler);
+    
     // Connect signals
     connect(m_cartridgeService, &Services::ICartridgeService::cartridgeLoaded,
             this, &MainWindow::onCartridgeLoaded);
@@ -186,10 +453,38 @@ MainWindow::MainWindow(QWidget *parent)
     connect(static_cast<Services::CartridgeService*>(m_cartridgeService), 
             &Services::CartridgeService::trustLevelDetermined,
             this, &MainWindow::onTrustLevelDetermined);
+    connect(static_cast<Services::CartridgeService*>(m_cartridgeService),
+            &Services::CartridgeService::cartridgeOpened,
+            this, [this](const QString& cartridgeName) {
+                statusBar()->showMessage(QString("Cartridge opened: %1 - building navigation...").arg(cartridgeName));
+            });
+    connect(m_cartridgeService, &Services::ICartridgeService::errorOccurred,
+            this, [this](const QString& errorMessage) {
+                statusBar()->clearMessage();
+                QMessageBox::warning(this, "Error", QString("Failed to load cartridge.\n%1").arg(errorMessage));
+            });
     connect(m_searchPane, &UI::SearchPane::searchRequested,
             this, &MainWindow::onSearchRequested);
     connect(m_searchService, &Services::ISearchService::searchCompleted,
             this, &MainWindow::onSearchCompleted);
+    connect(m_searchService, &Services::ISearchService::resultsAppended,
+            m_searchPane, &UI::SearchPane::appendResults);
+    connect(m_searchService, &Services::ISearchService::totalHitCountReady,
+            m_searchPane, &UI::SearchPane::setTotalHitCount);
+    connect(m_searchPane, &UI::SearchPane::snippetsRequested,
+            m_searchService, &Services::ISearchService::requestSnippets);
+    connect(m_searchService, &Services::ISearchService::snippetsReady,
+            m_searchPane, &UI::SearchPane::setSnippets);
+    connect(m_searchService, &Services::ISearchService::snippetsReady,
+            this, &MainWindow::onSnippetsReady);
+    connect(m_searchPane, &UI::SearchPane::moreResultsRequested,
+            m_searchService, &Services::ISearchService::fetchMoreResults);
+    connect(m_searchPane, &UI::SearchPane::liveSearchRequested,
+            this, [this](const QString& query) {
+                m_searchService->performIncrementalSearch(query, m_searchPane->isCaseSensitive());
+            });
+    connect(m_searchPane, &UI::SearchPane::searchCleared,
+            m_searchService, &Services::ISearchService::cancelSearch);
     connect(m_navigationPane, &UI::NavigationPane::documentSelected,
             this, &MainWindow::onDocumentSelected);
     connect(m_searchPane, &UI::SearchPane::resultSelected,
@@ -217,9 +512,17 @@ MainWindow::MainWindow(QWidget *parent)
                 // Intercept external links
                 if (url.scheme() == "http" || url.scheme() == "https" || 
                     url.scheme() == "mailto" || url.scheme() == "ftp") {
-                    m_linkService->openExternalLink(url);
+                    openExternalLink(url);
                     // Prevent navigation in WebEngine
                     m_webEngineView->back();
+                    return;
+                }
+                
+                // Links between documents are followed in the page; keep
+                // the document printed in step
+                const QString documentId = Services::CartridgeSchemeHandler::documentIdFromUrl(url);
+                if (!documentId.isEmpty()) {
+                    m_currentDocumentId = documentId;
                 }
             });
 }
@@ -270,6 +573,9 @@ void MainWindow::setupMenuBar() {
     viewMenu->addAction("&Zoom In", this, &MainWindow::onZoomIn, QKeySequence::ZoomIn);
     viewMenu->addAction("Zoom &Out", this, &MainWindow::onZoomOut, QKeySequence::ZoomOut);
     viewMenu->addAction("&Normal Size", this, &MainWindow::onZoomReset, QKeySequence("Ctrl+0"));
+    viewMenu->addSeparator();
+    viewMenu->addAction("Next &Match", this, &MainWindow::onNextMatch, QKeySequence::FindNext);
+    viewMenu->addAction("&Previous Match", this, &MainWindow::onPreviousMatch, QKeySequence::FindPrevious);
     
     QMenu *themeMenu = menuBar()->addMenu("&Theme");
     setupThemeMenu();
@@ -354,6 +660,8 @@ void MainWindow::setupWebEngine() {
     // Create WebEngine bridge
     m_webEngineBridge = new Services::WebEngineBridge(m_webEngineView, this);
     
+    updateThemeStyleSheet();
+    
     // Load minimal empty state (WCAG-compliant: clean main content area)
     QString htmlContent = R"(
         <!DOCTYPE html>
@@ -403,13 +711,64 @@ void MainWindow::setupWebEngine() {
 void MainWindow::onWebEngineLoadFinished(bool success) {
     if (success) {
         pushConfigToWebEngine();
-        injectThemeTokens(m_currentDocumentContent);
+        injectThemeTokens();
+        m_pageLoaded = true;
+        // Also re-applies the marks when the page is reloaded for a theme
+        sendSearchHighlights();
         statusBar()->showMessage("Page loaded", 2000);
     } else {
         statusBar()->showMessage("Failed to load page", 2000);
     }
 }
 
+void MainWindow::sendSearchHighlights() {
+    if (!m_webEngineBridge || !m_pageLoaded || m_searchMatches.isEmpty()) {
+        return;
+    }
+
+    QJsonArray matches;
+    for (const auto& match : m_searchMatches) {
+        matches.append(QJsonArray{match.first, match.second});
+    }
+    QJsonObject payload;
+    payload["type"] = "search:highlight";
+    payload["matches"] = matches;
+    m_webEngineBridge->send(QString::fromUtf8(QJsonDocument(payload).toJson(QJsonDocument::Compact)));
+}
+
+void MainWindow::sendSearchMessage(const QString& type) {
+    if (!m_webEngineBridge || !m_pageLoaded) {
+        return;
+    }
+
+    QJsonObject payload;
+    payload["type"] = type;
+    m_webEngineBridge->send(QString::fromUtf8(QJsonDocument(payload).toJson(QJsonDocument::Compact)));
+}
+
+void MainWindow::onNextMatch() {
+    // Navigation happens in the page; the document is not reloaded
+    sendSearchMessage("search:next");
+}
+
+void MainWindow::onPreviousMatch() {
+    sendSearchMessage("search:previous");
+}
+
+void MainWindow::onSnippetsReady(const QList<Services::SearchHit>& hits) {
+    // Match offsets of a hit selected before its snippet was built
+    if (m_searchMatchRowid == 0 || !m_searchMatches.isEmpty()) {
+        return;
+    }
+    for (const auto& hit : hits) {
+        if (hit.rowid == m_searchMatchRowid) {
+            m_searchMatches = hit.matchOffsets;
+            sendSearchHighlights();
+            return;
+        }
+    }
+}
+
 void MainWindow::pushConfigToWebEngine() {
     if (!m_configResolver || !m_webEngineBridge) {
         return;
@@ -457,9 +816,12 @@ void MainWindow::onOpenCartridge() {
         "Cartridge Files (*.ruleset *.db *.sqlite *.sqlite3);;All Files (*.*)");
     
     if (!path.isEmpty()) {
-        if (!m_cartridgeService->loadCartridge(path)) {
-            QMessageBox::warning(this, "Error", "Failed to load cartridge.");
-        }
+        // Actions deferred for the previous cartridge no longer apply
+        m_trustGate->clear();
+        
+        // Load off the GUI thread; failures arrive via errorOccurred
+        statusBar()->showMessage(QString("Opening cartridge: %1").arg(QFileInfo(path).fileName()));
+        static_cast<Services::CartridgeService*>(m_cartridgeService)->loadCartridgeAsync(path);
     }
 }
 
@@ -470,6 +832,7 @@ void MainWindow::onCartridgeLoaded(const QString& cartridgeName) {
 }
 
 void MainWindow::onCartridgeUnloaded() {
+    m_trustGate->clear();
     statusBar()->showMessage("Cartridge unloaded", 2000);
     m_navigationPane->clear();
     setWindowTitle("Codexium Magnus");
@@ -482,16 +845,33 @@ void MainWindow::onSearchRequested(const QString& query) {
                                   m_searchPane->useWildcards());
 }
 
-void MainWindow::onSearchCompleted(const QList<QPair<QString, QString>>& results) {
+void MainWindow::onSearchCompleted(const QList<Services::SearchHit>& results) {
     m_searchPane->setResults(results);
+    if (m_searchService->hasMoreResults()) {
+        // Count in the background; the first page is already on screen
+        m_searchService->requestTotalHitCount();
+    } else {
+        m_searchPane->setTotalHitCount(results.size());
+    }
 }
 
 void MainWindow::onDocumentSelected(const QString& documentId) {
+    m_searchMatchRowid = 0;
+    m_searchMatches.clear();
     loadDocument(documentId);
 }
 
-void MainWindow::onResultSelected(const QString& resultId) {
-    loadDocument(resultId);
+void MainWindow::onResultSelected(const Services::SearchHit& hit) {
+    // The hit carries the document's primary key, so this is a single
+    // lookup; the page marks the matches and scrolls to the first one
+    // once it is loaded
+    m_searchMatchRowid = hit.rowid;
+    m_searchMatches = hit.matchOffsets;
+    if (m_searchMatches.isEmpty() && hit.snippet.isEmpty()) {
+        // Offsets are built with the snippet; see onSnippetsReady()
+        m_searchService->requestSnippets(QList<Services::SearchHit>{hit});
+    }
+    loadDocument(hit.documentId);
 }
 
 void MainWindow::loadDocument(const QString& documentId) {
@@ -499,11 +879,46 @@ void MainWindow::loadDocument(const QString& documentId) {
         return;
     }
     
-    QString content = m_cartridgeService->getDocumentContent(documentId);
-    if (!content.isEmpty()) {
-        m_currentDocumentContent = content;
-        QString wrappedContent = wrapContentWithTheme(content);
-        m_webEngineView->setHtml(wrappedContent);
+    // The scheme handler streams the content; it is read here only to print
+    m_currentDocumentId = documentId;
+    m_pageLoaded = false;
+    m_webEngineView->load(Services::CartridgeSchemeHandler::documentUrl(
+        m_cartridgeService->getCartridgePath(), documentId));
+}
+
+QString MainWindow::currentDocumentContent() const {
+    if (m_currentDocumentId.isEmpty() || !m_cartridgeService->isCartridgeLoaded()) {
+        return QString();
+    }
+    return m_cartridgeService->getDocumentContent(m_currentDocumentId);
+}
+
+void MainWindow::applyThemeToPage() {
+    const QMap<QString, QString> previousTokens = m_themeTokens;
+    updateThemeStyleSheet();
+    if (m_currentDocumentId.isEmpty()) {
+        return;
+    }
+    
+    if (!m_pageLoaded) {
+        // The loading page may have been created with the previous style sheet
+        reloadDocumentWithTheme();
+        return;
+    }
+    
+    QJsonObject payload = Theme::ThemeManager::tokenDiff(previousTokens, m_themeTokens);
+    if (payload["set"].toObject().isEmpty() && payload["remove"].toArray().isEmpty()) {
+        return;
+    }
+    payload["type"] = "theme:update";
+    m_webEngineBridge->send(QString::fromUtf8(QJsonDocument(payload).toJson(QJsonDocument::Compact)));
+}
+
+void MainWindow::reloadDocumentWithTheme() {
+    if (!m_currentDocumentId.isEmpty()) {
+        // The profile script applies the current style sheet on reload
+        m_pageLoaded = false;
+        m_webEngineView->reload();
     }
 }
 
@@ -524,11 +939,8 @@ void MainWindow::onThemeChanged(Theme::ThemeManager::Theme theme) {
             break;
     }
     
-    // Re-inject theme tokens into current document
-    if (!m_currentDocumentContent.isEmpty()) {
-        QString wrappedContent = wrapContentWithTheme(m_currentDocumentContent);
-        m_webEngineView->setHtml(wrappedContent);
-    }
+    // Switch the current document in place (FR-AT-2.1)
+    applyThemeToPage();
     
     // Update application palette
     QApplication::setPalette(m_themeManager->currentPalette());
@@ -605,12 +1017,6 @@ void MainWindow::onSettingsAccepted(const Core::Models::TypographyConfig& typogr
     // Push updated config to WebEngine
     pushConfigToWebEngine();
     
-    // Re-inject theme tokens if document is loaded
-    if (!m_currentDocumentContent.isEmpty()) {
-        QString wrappedContent = wrapContentWithTheme(m_currentDocumentContent);
-        m_webEngineView->setHtml(wrappedContent);
-    }
-    
     statusBar()->showMessage("Settings saved and applied", 2000);
 }
 
@@ -645,19 +1051,51 @@ void MainWindow::onTrustLevelDetermined(Services::TrustLevel trustLevel) {
     }
     
     statusBar()->showMessage(QString("%1 %2").arg(trustIcon, trustMessage), 5000);
+    
+    // Run what was deferred while verification was in progress
+    for (const QString& actionName : m_trustGate->runDeferred()) {
+        QMessageBox::warning(this, actionName,
+            QString("%1 is not available: this cartridge's signature could not be verified.").arg(actionName));
+    }
+}
+
+void MainWindow::runTrustGated(const QString& actionName, const std::function<void()>& action) {
+    // Verification runs in the background (FR-AT-9.3, FR-AT-10.4)
+    switch (m_trustGate->submit(actionName, action)) {
+    case Services::TrustGate::Decision::Run:
+        break;
+    case Services::TrustGate::Decision::Defer:
+        statusBar()->showMessage(
+            QString("Verifying cartridge - %1 will continue once verification completes").arg(actionName.toLower()));
+        break;
+    case Services::TrustGate::Decision::Refuse:
+        QMessageBox::warning(this, actionName,
+            QString("%1 is not available: this cartridge's signature could not be verified.").arg(actionName));
+        break;
+    }
+}
+
+void MainWindow::openExternalLink(const QUrl& url) {
+    runTrustGated("Opening external link", [this, url]() {
+        m_linkService->openExternalLink(url);
+    });
 }
 
 void MainWindow::onPrint() {
-    if (m_currentDocumentContent.isEmpty()) {
+    // Print what is shown now, even if verification delays the dialog
+    const QString content = currentDocumentContent();
+    if (content.isEmpty()) {
         QMessageBox::information(this, "Print", "No document loaded to print.");
         return;
     }
     
-    m_printService->printContent(m_currentDocumentContent);
+    runTrustGated("Printing", [this, content]() {
+        m_printService->printContent(content);
+    });
 }
 
 void MainWindow::onPrintToPdf() {
-    if (m_currentDocumentContent.isEmpty()) {
+    if (m_currentDocumentId.isEmpty()) {
         QMessageBox::information(this, "Print to PDF", "No document loaded to print.");
         return;
     }
@@ -668,38 +1106,76 @@ void MainWindow::onPrintToPdf() {
         "PDF Files (*.pdf);;All Files (*.*)");
     
     if (!path.isEmpty()) {
-        m_printService->printToPdf(m_currentDocumentContent, path);
+        const QString content = currentDocumentContent();
+        if (content.isEmpty()) {
+            QMessageBox::information(this, "Print to PDF", "No document loaded to print.");
+            return;
+        }
+        runTrustGated("Printing", [this, content, path]() {
+            m_printService->printToPdf(content, path);
+        });
     }
 }
 
 void MainWindow::onLinkClicked(const QUrl& url) {
-    m_linkService->openExternalLink(url);
+    openExternalLink(url);
 }
 
-QString MainWindow::wrapContentWithTheme(const QString& htmlContent) {
-    // Get theme tokens
-    QMap<QString, QString> tokens = m_themeManager->getTokenMap();
-    
-    // Build CSS with theme tokens
-    QString css = "<style>\n";
-    css += ":root {\n";
+QString MainWindow::buildThemeStyleSheet(const QMap<QString, QString>& tokens) const {
+    // Build CSS with theme tokens; the :root rule must stay first, the
+    // profile script updates tokens in place through it
+    QString css;
+    css.reserve(4096);
+    css += QLatin1String(":root {\n");
     for (auto it = tokens.constBegin(); it != tokens.constEnd(); ++it) {
-        css += QString("  %1: %2;\n").arg(it.key(), it.value());
-    }
-    css += "}\n";
-    css += "body {\n";
-    css += "  background-color: var(--color-background-primary);\n";
-    css += "  color: var(--color-text-primary);\n";
-    css += "  font-family: var(--font-family-base);\n";
-    css += "  font-size: var(--font-size-base);\n";
-    css += "}\n";
-    css += "a {\n";
-    css += "  color: var(--color-link);\n";
-    css += "}\n";
-    css += "a:hover {\n";
-    css += "  color: var(--color-link-hover);\n";
-    css += "}\n";
-    css += "</style>\n";
+        css += QLatin1String("  ") + it.key() + QLatin1String(": ") + it.value() + QLatin1String(";\n");
+    }
+    css += QLatin1String("}\n"
+                         "body {\n"
+                         "  background-color: var(--color-background-primary);\n"
+                         "  color: var(--color-text-primary);\n"
+                         "  font-family: var(--font-family-base);\n"
+                         "  font-size: var(--font-size-base);\n"
+                         "}\n"
+                         "a {\n"
+                         "  color: var(--color-link);\n"
+                         "}\n"
+                         "a:hover {\n"
+                         "  color: var(--color-link-hover);\n"
+                         "}\n");
+    css += QLatin1String(kSearchHighlightStyle);
+    return css;
+}
+
+void MainWindow::updateThemeStyleSheet() {
+    m_themeTokens = m_themeManager->getTokenMap();
+    m_themeStyleSheet = buildThemeStyleSheet(m_themeTokens);
+    
+    // Cartridge pages get the style sheet and page scripts from a profile
+    // script instead of markup spliced into each document, so serving a
+    // document never scans or copies its content
+    const QString styleSheet = QString::fromUtf8(
+        QJsonDocument(QJsonArray{m_themeStyleSheet}).toJson(QJsonDocument::Compact));
+    QWebEngineScript script;
+    script.setName(kThemeScriptName);
+    script.setInjectionPoint(QWebEngineScript::DocumentCreation);
+    script.setWorldId(QWebEngineScript::MainWorld);
+    script.setRunsOnSubFrames(false);
+    script.setSourceCode(QString::fromUtf8(kThemeScriptTemplate)
+                             .arg(styleSheet, QString::fromUtf8(kSearchHighlightScript)));
+    
+    // Shared by every view on the profile, including document viewer windows
+    QWebEngineScriptCollection *scripts = m_webEngineView->page()->profile()->scripts();
+    for (const QWebEngineScript& existing : scripts->find(kThemeScriptName)) {
+        scripts->remove(existing);
+    }
+    scripts->insert(script);
+}
+
+QString MainWindow::wrapContentWithTheme(const QString& htmlContent) {
+    // Only used for small built-in pages; cartridge pages are themed by
+    // the profile script (see updateThemeStyleSheet())
+    const QString css = QLatin1String("<style>\n") + m_themeStyleSheet + QLatin1String("</style>\n");
     
     // Inject CSS into HTML
     QString wrapped = htmlContent;
@@ -722,10 +1198,9 @@ QString MainWindow::wrapContentWithTheme(const QString& htmlContent) {
     return wrapped;
 }
 
-void MainWindow::injectThemeTokens(const QString& htmlContent) {
+void MainWindow::injectThemeTokens() {
     // This method can be used to inject tokens via JavaScript if needed
-    // For now, tokens are injected via CSS in wrapContentWithTheme()
-    Q_UNUSED(htmlContent);
+    // For now, tokens are injected via the profile script (see updateThemeStyleSheet())
 }
 
 void MainWindow::onZoomIn() {
@@ -12,6 +12,8 @@
 #include <QToolBar>
 #include <QFileDialog>
 #include <QActionGroup>
+#include <functional>
+#include <memory>
 #include "../codexium-magnus-core/Configuration/CompositeConfigurationResolver.h"
 #include "Services/WebEngineBridge.h"
 #include "Services/ICartridgeService.h"
@@ -22,8 +24,11 @@
 #include "Services/LinkService.h"
 #include "Services/IPrintService.h"
 #include "Services/PrintService.h"
+#include "Services/CartridgeSchemeHandler.h"
+#include "Services/AssetService.h"
 #include "Services/ISignatureService.h"
 #include "Services/SignatureService.h"
+#include "Services/TrustGate.h"
 #include "Theme/ThemeManager.h"
 #include "UI/NavigationPane.h"
 #include "UI/SearchPane.h"
@@ -46,9 +51,12 @@ private slots:
     void onCartridgeLoaded(const QString& cartridgeName);
     void onCartridgeUnloaded();
     void onSearchRequested(const QString& query);
-    void onSearchCompleted(const QList<QPair<QString, QString>>& results);
+    void onSearchCompleted(const QList<Services::SearchHit>& results);
     void onDocumentSelected(const QString& documentId);
-    void onResultSelected(const QString& resultId);
+    void onResultSelected(const Services::SearchHit& hit);
+    void onSnippetsReady(const QList<Services::SearchHit>& hits);
+    void onNextMatch();
+    void onPreviousMatch();
     void onThemeChanged(Theme::ThemeManager::Theme theme);
     void onThemeLight();
     void onThemeSepia();
@@ -76,8 +84,17 @@ private:
     void setupWebEngine();
     void setupThemeMenu();
     void loadDocument(const QString& documentId);
-    void injectThemeTokens(const QString& htmlContent);
+    QString currentDocumentContent() const;
+    void sendSearchHighlights();
+    void sendSearchMessage(const QString& type);
+    void injectThemeTokens();
+    QString buildThemeStyleSheet(const QMap<QString, QString>& tokens) const;
+    void updateThemeStyleSheet();
+    void applyThemeToPage();
     QString wrapContentWithTheme(const QString& htmlContent);
+    void reloadDocumentWithTheme();
+    void runTrustGated(const QString& actionName, const std::function<void()>& action);
+    void openExternalLink(const QUrl& url);
 
     // UI Components
     QWidget *m_centralWidget;
@@ -95,6 +112,8 @@ private:
     Services::ILinkService *m_linkService;
     Services::IPrintService *m_printService;
     Services::ISignatureService *m_signatureService;
+    Services::AssetService *m_assetService;             ///< Embedded images and fonts of the cartridge
+    Services::CartridgeSchemeHandler *m_schemeHandler;  ///< Serves cdoc:// pages from the cartridge
     Theme::ThemeManager *m_themeManager;
     
     // Theme menu
@@ -115,8 +134,20 @@ private:
     QList<Core::Configuration::ConfigurationSource*> m_configSources;
     SessionConfigSource* m_sessionConfigSource;  ///< Session config source for runtime updates
     
-    // Current document content (for printing)
-    QString m_currentDocumentContent;
+    // Document shown in the page; its content is read only to print it
+    QString m_currentDocumentId;
+    
+    QString m_themeStyleSheet;              ///< Themed CSS, rebuilt on theme change only
+    QMap<QString, QString> m_themeTokens;   ///< Tokens of m_themeStyleSheet
+    
+    // Matches of the selected search hit, highlighted in the page
+    qint64 m_searchMatchRowid;                ///< FTS5 rowid of the selected hit; 0 if opened otherwise
+    QList<QPair<int, int>> m_searchMatches;   ///< (offset, length) in the document's plain text
+    bool m_pageLoaded;                        ///< The current page has finished loading
+    
+    // Gates trust-sensitive actions (external links, printing); holds back
+    // those requested before the loaded cartridge's trust level was determined
+    std::unique_ptr<Services::TrustGate> m_trustGate;
     
     // Zoom state
     qreal m_zoomFactor;
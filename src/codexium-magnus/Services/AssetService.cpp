@@ -0,0 +1,154 @@
+#include "AssetService.h"
+#include <QSqlQuery>
+#include <QDir>
+#include <QMimeDatabase>
+#include <QDebug>
+
+namespace CodexiumMagnus::Services {
+
+namespace {
+// length() of a BLOB is read from the record header; the value itself is
+// not loaded
+const QString kAssetSql = "SELECT rowid, mime, length(\"blob\") FROM assets WHERE path = ?";
+const QString kAssetTable = "assets";
+const QString kAssetColumn = "blob";
+
+// The cast gives the size of TEXT content in bytes rather than characters
+const QString kDocumentSql = "SELECT rowid, length(CAST(content AS BLOB)) FROM documents WHERE id = ?";
+const QString kDocumentTable = "documents";
+const QString kDocumentColumn = "content";
+const QString kDocumentMimeType = "text/html;charset=utf-8";
+}
+
+AssetService::AssetService(CartridgeService *cartridgeService, QObject *parent)
+    : QObject(parent)
+    , m_cartridgeService(cartridgeService)
+    , m_openDevices()
+{
+    if (m_cartridgeService) {
+        connect(m_cartridgeService, &CartridgeService::cartridgeClosing,
+                this, &AssetService::onCartridgeClosing);
+    }
+}
+
+AssetService::~AssetService() {
+    onCartridgeClosing();
+}
+
+bool AssetService::findAsset(const QString& path, AssetInfo& info) const {
+    if (!m_cartridgeService || !m_cartridgeService->isCartridgeLoaded()) {
+        return false;
+    }
+
+    const QString normalized = normalizePath(path);
+    if (normalized.isEmpty()) {
+        return false;
+    }
+
+    // Cartridges without an assets table fail to prepare the statement
+    QSqlQuery *query = m_cartridgeService->preparedStatement(kAssetSql);
+    if (!query) {
+        return false;
+    }
+
+    bool found = false;
+    query->addBindValue(normalized);
+    if (query->exec() && query->next()) {
+        info.rowId = query->value(0).toLongLong();
+        info.path = normalized;
+        info.mimeType = mimeTypeForPath(normalized, query->value(1).toString());
+        info.size = query->value(2).toLongLong();
+        found = true;
+    }
+    query->finish();
+    return found;
+}
+
+CartridgeBlobDevice* AssetService::openAsset(const QString& path, AssetInfo& info, QObject *parent) {
+    if (!findAsset(path, info)) {
+        return nullptr;
+    }
+    return openDevice(kAssetTable, kAssetColumn, info, parent);
+}
+
+CartridgeBlobDevice* AssetService::openDocument(const QString& documentId, AssetInfo& info, QObject *parent) {
+    if (!m_cartridgeService || !m_cartridgeService->isCartridgeLoaded() || documentId.isEmpty()) {
+        return nullptr;
+    }
+
+    QSqlQuery *query = m_cartridgeService->preparedStatement(kDocumentSql);
+    if (!query) {
+        return nullptr;
+    }
+
+    bool found = false;
+    query->addBindValue(documentId);
+    if (query->exec() && query->next()) {
+        info.rowId = query->value(0).toLongLong();
+        info.path = documentId;
+        info.mimeType = kDocumentMimeType;
+        info.size = query->value(1).toLongLong();
+        found = true;
+    }
+    query->finish();
+    return found ? openDevice(kDocumentTable, kDocumentColumn, info, parent) : nullptr;
+}
+
+CartridgeBlobDevice* AssetService::openDevice(const QString& table, const QString& column, const AssetInfo& info,
+                                              QObject *parent) {
+    const QString cartridgePath = m_cartridgeService->getCartridgePath();
+    auto *device = new CartridgeBlobDevice(cartridgePath, m_cartridgeService->openProfile(cartridgePath),
+                                           table, column, info.rowId, info.size, parent);
+    if (!device->isOpen()) {
+        qWarning() << "Failed to open asset" << info.path << ":" << device->errorString();
+        delete device;
+        return nullptr;
+    }
+
+    // Drop devices that have been deleted meanwhile
+    m_openDevices.removeAll(nullptr);
+    m_openDevices.append(device);
+    return device;
+}
+
+QString AssetService::mimeTypeForPath(const QString& path, const QString& storedMimeType) {
+    if (!storedMimeType.trimmed().isEmpty()) {
+        return storedMimeType.trimmed();
+    }
+    static const QMimeDatabase mimeDatabase;
+    return mimeDatabase.mimeTypeForFile(path, QMimeDatabase::MatchExtension).name();
+}
+
+int AssetService::openDeviceCount() const {
+    int count = 0;
+    for (const auto& device : m_openDevices) {
+        if (device && device->hasConnection()) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+void AssetService::onCartridgeClosing() {
+    // Runs on the GUI thread; the devices may be in a read on WebEngine's
+    // IO thread, so only their connections are released here
+    for (const auto& device : m_openDevices) {
+        if (device) {
+            device->releaseConnection();
+        }
+    }
+    m_openDevices.clear();
+}
+
+QString AssetService::normalizePath(const QString& path) {
+    QString normalized = QDir::cleanPath(path);
+    while (normalized.startsWith('/')) {
+        normalized.remove(0, 1);
+    }
+    if (normalized == "." || normalized == ".." || normalized.startsWith("../")) {
+        return QString();
+    }
+    return normalized;
+}
+
+} // namespace CodexiumMagnus::Services
@@ -0,0 +1,104 @@
+#ifndef ASSETSERVICE_H
+#define ASSETSERVICE_H
+
+#include "CartridgeService.h"
+#include "CartridgeBlobDevice.h"
+#include <QObject>
+#include <QString>
+#include <QList>
+#include <QPointer>
+
+namespace CodexiumMagnus::Services {
+
+/**
+ * Binary assets (images, fonts) embedded in the loaded cartridge
+ * (FR-AT-11.3), and the stored content of its documents.
+ *
+ * Assets live in the cartridge's assets table (Architecture §6.1:
+ * Assets(id, path, mime, blob)) and are looked up by their path. They are
+ * served as CartridgeBlobDevice streams, each on its own read-only
+ * connection so it can be read on Qt WebEngine's IO thread, read in
+ * fixed-size chunks, so a large image reaches the page progressively and
+ * is never copied into a QByteArray as a whole.
+ *
+ * Devices handed out are tracked and their connections released when the
+ * cartridge is unloaded; reads on them fail from then on. The devices
+ * themselves stay open until their owner closes or deletes them, since a
+ * read may be in progress on another thread.
+ */
+class AssetService : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * An asset of the loaded cartridge.
+     */
+    struct AssetInfo {
+        qint64 rowId = -1;
+        QString path;
+        QString mimeType;      ///< Stored MIME type, or the one derived from the path
+        qint64 size = 0;       ///< Size in bytes
+    };
+
+    explicit AssetService(CartridgeService *cartridgeService, QObject *parent = nullptr);
+    ~AssetService();
+
+    CartridgeService* cartridgeService() const { return m_cartridgeService; }
+
+    /**
+     * Look up an asset of the loaded cartridge.
+     * @param path Asset path; a leading "/" or "./" is ignored
+     * @param info Receives the asset's row, MIME type and size
+     * @return true if the cartridge has an asset at this path
+     */
+    bool findAsset(const QString& path, AssetInfo& info) const;
+
+    /**
+     * Open an asset of the loaded cartridge for reading.
+     * @param path Asset path; a leading "/" or "./" is ignored
+     * @param info Receives the asset's row, MIME type and size
+     * @param parent Parent of the device
+     * @return Open, seekable device, or nullptr if there is no such asset
+     */
+    CartridgeBlobDevice* openAsset(const QString& path, AssetInfo& info, QObject *parent = nullptr);
+
+    /**
+     * Open the content of a document of the loaded cartridge for reading.
+     * The stored HTML is streamed like an asset, as UTF-8, instead of being
+     * loaded into a QString.
+     * @param documentId Primary key of the document (documents.id)
+     * @param info Receives the document's row, MIME type and size in bytes;
+     *             path is set to the document id
+     * @param parent Parent of the device
+     * @return Open, seekable device, or nullptr if there is no such document
+     */
+    CartridgeBlobDevice* openDocument(const QString& documentId, AssetInfo& info, QObject *parent = nullptr);
+
+    /**
+     * MIME type of an asset.
+     * @param path Asset path, used to guess the type from its extension
+     * @param storedMimeType Type stored with the asset; preferred if set
+     * @return MIME type, application/octet-stream if unknown
+     */
+    static QString mimeTypeForPath(const QString& path, const QString& storedMimeType = QString());
+
+    /**
+     * Number of devices handed out that still have their connection.
+     */
+    int openDeviceCount() const;
+
+private slots:
+    void onCartridgeClosing();
+
+private:
+    static QString normalizePath(const QString& path);
+    CartridgeBlobDevice* openDevice(const QString& table, const QString& column, const AssetInfo& info,
+                                    QObject *parent);
+
+    CartridgeService *m_cartridgeService;
+    QList<QPointer<CartridgeBlobDevice>> m_openDevices;  ///< Released when the cartridge is unloaded
+};
+
+} // namespace CodexiumMagnus::Services
+
+#endif // ASSETSERVICE_H
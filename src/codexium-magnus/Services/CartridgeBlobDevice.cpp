@@ -0,0 +1,168 @@
+#include "CartridgeBlobDevice.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QSqlDriver>
+#include <QMutexLocker>
+#include <QDebug>
+#include <atomic>
+#include <cstring>
+
+#ifdef HAVE_SQLITE3_API
+#include <sqlite3.h>
+#endif
+
+namespace CodexiumMagnus::Services {
+
+namespace {
+const qint64 kChunkSize = 64 * 1024;
+
+// Devices of one cartridge may outlive each other in any order
+std::atomic<quint64> nextConnectionId{0};
+}
+
+CartridgeBlobDevice::CartridgeBlobDevice(const QString& cartridgePath, const CartridgeOpenProfile& profile,
+                                         const QString& table, const QString& column,
+                                         qint64 rowId, qint64 size, QObject *parent)
+    : QIODevice(parent)
+    , m_mutex()
+    , m_connectionName(QString("cartridge_blob_%1").arg(++nextConnectionId))
+    , m_database()
+    , m_table(table)
+    , m_column(column)
+    , m_rowId(rowId)
+    , m_size(qMax<qint64>(0, size))
+    , m_blob(nullptr)
+    , m_chunkQuery()
+{
+    if (!openConnection(cartridgePath, profile)) {
+        return;
+    }
+
+    // Unbuffered: reads land directly in the caller's buffer
+    open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+}
+
+CartridgeBlobDevice::~CartridgeBlobDevice() {
+    CartridgeBlobDevice::close();
+}
+
+qint64 CartridgeBlobDevice::chunkSize() {
+    return kChunkSize;
+}
+
+bool CartridgeBlobDevice::openConnection(const QString& cartridgePath, CartridgeOpenProfile profile) {
+    // Blobs are only read, whatever profile the GUI connection uses
+    profile.readOnly = true;
+
+    m_database = QSqlDatabase::addDatabase("QSQLITE", m_connectionName);
+    profile.configure(m_database, cartridgePath);
+    if (!m_database.open()) {
+        setErrorString(m_database.lastError().text());
+        m_database = QSqlDatabase();
+        QSqlDatabase::removeDatabase(m_connectionName);
+        return false;
+    }
+    profile.applyPragmas(m_database);
+
+#ifdef HAVE_SQLITE3_API
+    QVariant handle = m_database.driver()->handle();
+    if (handle.isValid() && qstrcmp(handle.typeName(), "sqlite3*") == 0) {
+        sqlite3 *connection = *static_cast<sqlite3 **>(handle.data());
+        if (connection && sqlite3_blob_open(connection, "main", m_table.toUtf8().constData(),
+                                            m_column.toUtf8().constData(), m_rowId, 0, &m_blob) != SQLITE_OK) {
+            qWarning() << "Failed to open blob" << m_table << m_rowId << ":" << sqlite3_errmsg(connection);
+            sqlite3_blob_close(m_blob);
+            m_blob = nullptr;
+        }
+    }
+#endif
+
+    if (!m_blob) {
+        m_chunkQuery = std::make_unique<QSqlQuery>(m_database);
+        m_chunkQuery->setForwardOnly(true);
+        // The cast makes substr() count bytes for TEXT values too
+        if (!m_chunkQuery->prepare(QString("SELECT substr(CAST(\"%1\" AS BLOB), ?, ?) FROM \"%2\" WHERE rowid = ?")
+                                       .arg(m_column, m_table))) {
+            setErrorString(m_chunkQuery->lastError().text());
+            m_chunkQuery.reset();
+            releaseConnection();
+            return false;
+        }
+    }
+    return true;
+}
+
+void CartridgeBlobDevice::releaseConnection() {
+    QMutexLocker locker(&m_mutex);
+#ifdef HAVE_SQLITE3_API
+    if (m_blob) {
+        sqlite3_blob_close(m_blob);
+        m_blob = nullptr;
+    }
+#endif
+    m_chunkQuery.reset();
+    if (m_database.isValid()) {
+        m_database.close();
+        m_database = QSqlDatabase();
+        QSqlDatabase::removeDatabase(m_connectionName);
+    }
+}
+
+bool CartridgeBlobDevice::hasConnection() const {
+    QMutexLocker locker(&m_mutex);
+    return m_database.isValid();
+}
+
+void CartridgeBlobDevice::close() {
+    releaseConnection();
+    if (isOpen()) {
+        QIODevice::close();
+    }
+}
+
+qint64 CartridgeBlobDevice::readData(char *data, qint64 maxSize) {
+    QMutexLocker locker(&m_mutex);
+    const qint64 position = pos();
+    const qint64 count = qMin(qMin(maxSize, kChunkSize), m_size - position);
+    if (count <= 0) {
+        return 0;
+    }
+
+#ifdef HAVE_SQLITE3_API
+    if (m_blob) {
+        const int status = sqlite3_blob_read(m_blob, data, static_cast<int>(count), static_cast<int>(position));
+        if (status != SQLITE_OK) {
+            setErrorString(QString::fromUtf8(sqlite3_errstr(status)));
+            return -1;
+        }
+        return count;
+    }
+#endif
+
+    if (!m_chunkQuery) {
+        return -1;
+    }
+
+    // substr() counts from 1
+    m_chunkQuery->addBindValue(position + 1);
+    m_chunkQuery->addBindValue(count);
+    m_chunkQuery->addBindValue(m_rowId);
+    qint64 read = -1;
+    if (m_chunkQuery->exec() && m_chunkQuery->next()) {
+        const QByteArray chunk = m_chunkQuery->value(0).toByteArray();
+        read = qMin<qint64>(chunk.size(), count);
+        std::memcpy(data, chunk.constData(), read);
+    } else {
+        setErrorString(m_chunkQuery->lastError().text());
+    }
+    m_chunkQuery->finish();
+    return read;
+}
+
+qint64 CartridgeBlobDevice::writeData(const char *data, qint64 maxSize) {
+    Q_UNUSED(data);
+    Q_UNUSED(maxSize);
+    return -1;
+}
+
+} // namespace CodexiumMagnus::Services
@@ -0,0 +1,97 @@
+#ifndef CARTRIDGEBLOBDEVICE_H
+#define CARTRIDGEBLOBDEVICE_H
+
+#include "CartridgeOpenProfile.h"
+#include <QIODevice>
+#include <QMutex>
+#include <QSqlDatabase>
+#include <QString>
+#include <memory>
+
+class QSqlQuery;
+struct sqlite3_blob;
+
+namespace CodexiumMagnus::Services {
+
+/**
+ * Read-only, seekable device over one BLOB value of a cartridge. TEXT
+ * values are read as their stored (UTF-8) bytes.
+ *
+ * With the SQLite C API available (HAVE_SQLITE3_API), reads go through
+ * SQLite incremental blob I/O (sqlite3_blob_read) straight into the
+ * caller's buffer, at most chunkSize() bytes per read, so an asset is never
+ * held in memory as a whole. Without it, each read fetches one chunk with
+ * substr(); memory stays bounded by the chunk size, but SQLite walks the
+ * value's overflow pages from the start on every read.
+ *
+ * The device reports the exact size and supports seek(), so Qt WebEngine
+ * can answer HTTP Range requests (media seeking, resumed image decoding)
+ * by seeking rather than reading from the start.
+ *
+ * Qt WebEngine reads the device on its IO thread while the GUI thread
+ * owns the cartridge connection, so each device opens a private read-only
+ * connection to the cartridge with the cartridge's open profile. Reads and
+ * the release of that connection are serialized by a mutex: the GUI thread
+ * may call releaseConnection() while a read is in progress elsewhere, and
+ * reads fail from then on (see AssetService).
+ */
+class CartridgeBlobDevice : public QIODevice {
+    Q_OBJECT
+
+public:
+    /**
+     * Create a device over a BLOB value, opened for reading on its own
+     * connection.
+     * @param cartridgePath Path to the cartridge file
+     * @param profile Open profile of the cartridge; always opened read-only
+     * @param table Table holding the value
+     * @param column Column holding the value
+     * @param rowId Rowid of the row holding the value
+     * @param size Size of the value in bytes
+     */
+    CartridgeBlobDevice(const QString& cartridgePath, const CartridgeOpenProfile& profile,
+                        const QString& table, const QString& column,
+                        qint64 rowId, qint64 size, QObject *parent = nullptr);
+    ~CartridgeBlobDevice();
+
+    /**
+     * Largest number of bytes read from SQLite at once (64 KiB).
+     */
+    static qint64 chunkSize();
+
+    bool isSequential() const override { return false; }
+    qint64 size() const override { return m_size; }
+    void close() override;
+
+    /**
+     * Close the device's connection; reads fail from then on. Unlike
+     * close(), safe to call while another thread is reading.
+     */
+    void releaseConnection();
+
+    /**
+     * Check whether the device still has its connection.
+     */
+    bool hasConnection() const;
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 maxSize) override;
+
+private:
+    bool openConnection(const QString& cartridgePath, CartridgeOpenProfile profile);
+
+    mutable QMutex m_mutex;                   ///< Serializes reads and releaseConnection()
+    QString m_connectionName;
+    QSqlDatabase m_database;                  ///< Private connection, used under m_mutex
+    QString m_table;
+    QString m_column;
+    qint64 m_rowId;
+    qint64 m_size;
+    sqlite3_blob *m_blob;                     ///< Incremental blob handle; null without the C API
+    std::unique_ptr<QSqlQuery> m_chunkQuery;  ///< substr() reads when no blob handle is available
+};
+
+} // namespace CodexiumMagnus::Services
+
+#endif // CARTRIDGEBLOBDEVICE_H
@@ -0,0 +1,340 @@
+#include "CartridgeNavigationModel.h"
+#include <QSqlError>
+#include <QDebug>
+#include <limits>
+
+namespace CodexiumMagnus::Services {
+
+namespace {
+
+// Children are read in sort order with a (sort_key, rowid) keyset cursor over
+// the parent_id index. A NULL sort_order would make the row-value comparison
+// NULL and drop the row, so it sorts as the smallest key, first, as the
+// materialized model had it.
+const QString kSortKey = "COALESCE(n.sort_order, -9223372036854775807 - 1)";
+
+const QString kChildColumns = R"(
+    SELECT
+        n.id,
+        n.title,
+        n.type,
+        %1 AS sort_key,
+        n.rowid,
+        EXISTS(SELECT 1 FROM navigation c WHERE c.parent_id = n.id) AS has_children
+    FROM navigation n
+)";
+
+QString childQuerySql(const QString& filter) {
+    return kChildColumns.arg(kSortKey) + QString(R"(
+        WHERE %1
+          AND (%2, n.rowid) > (?, ?)
+        ORDER BY sort_key, n.rowid
+        LIMIT ?
+    )").arg(filter, kSortKey);
+}
+
+const int kDefaultBlockCacheCapacity = 32;
+const int kDefaultBatchSize = 256;
+
+} // namespace
+
+CartridgeNavigationModel::CartridgeNavigationModel(QObject *parent)
+    : QAbstractItemModel(parent)
+    , m_database()
+    , m_rootQuery()
+    , m_childQuery()
+    , m_root()
+    , m_placeholderTitle()
+    , m_blockCacheCapacity(kDefaultBlockCacheCapacity)
+    , m_batchSize(kDefaultBatchSize)
+    , m_loadedNodeCount(0)
+{
+}
+
+CartridgeNavigationModel::~CartridgeNavigationModel() {
+    // Queries must be released before the connection handle
+    m_rootQuery.reset();
+    m_childQuery.reset();
+}
+
+void CartridgeNavigationModel::setDatabase(const QSqlDatabase& database, const QString& placeholderTitle) {
+    beginResetModel();
+
+    m_rootQuery.reset();
+    m_childQuery.reset();
+    m_releasableBlocks.clear();
+    m_loadedNodeCount = 0;
+
+    m_database = database;
+    m_placeholderTitle = placeholderTitle;
+    m_root = std::make_unique<Node>();
+    m_root->hasChildren = true;
+    resetCursor(m_root.get());
+
+    if (m_database.isOpen()) {
+        auto rootQuery = std::make_unique<QSqlQuery>(m_database);
+        auto childQuery = std::make_unique<QSqlQuery>(m_database);
+        // Nodes whose parent is missing are shown at the top level, as the
+        // materialized model did, rather than becoming unreachable
+        bool prepared = rootQuery->prepare(childQuerySql(R"(
+                (n.parent_id IS NULL OR n.parent_id = ''
+                 OR NOT EXISTS(SELECT 1 FROM navigation p WHERE p.id = n.parent_id)))"))
+            && childQuery->prepare(childQuerySql("n.parent_id = ?"));
+
+        if (prepared) {
+            m_rootQuery = std::move(rootQuery);
+            m_childQuery = std::move(childQuery);
+        } else {
+            // No navigation table: fetchMore() falls back to a placeholder root
+            qDebug() << "CartridgeNavigationModel: Navigation table not available:"
+                     << rootQuery->lastError().text();
+        }
+    }
+
+    endResetModel();
+}
+
+void CartridgeNavigationModel::clear() {
+    beginResetModel();
+    m_releasableBlocks.clear();
+    m_root.reset();
+    m_rootQuery.reset();
+    m_childQuery.reset();
+    m_database = QSqlDatabase();
+    m_loadedNodeCount = 0;
+    endResetModel();
+}
+
+void CartridgeNavigationModel::setBlockCacheCapacity(int capacity) {
+    m_blockCacheCapacity = qMax(0, capacity);
+    trimBlockCache();
+}
+
+void CartridgeNavigationModel::setBatchSize(int batchSize) {
+    m_batchSize = qMax(1, batchSize);
+}
+
+QModelIndex CartridgeNavigationModel::index(int row, int column, const QModelIndex& parent) const {
+    if (!hasIndex(row, column, parent)) {
+        return QModelIndex();
+    }
+
+    Node *parentNode = nodeFromIndex(parent);
+    if (!parentNode || row >= static_cast<int>(parentNode->children.size())) {
+        return QModelIndex();
+    }
+
+    return createIndex(row, column, parentNode->children[row].get());
+}
+
+QModelIndex CartridgeNavigationModel::parent(const QModelIndex& child) const {
+    if (!child.isValid()) {
+        return QModelIndex();
+    }
+
+    Node *node = static_cast<Node*>(child.internalPointer());
+    return indexFromNode(node ? node->parent : nullptr);
+}
+
+int CartridgeNavigationModel::rowCount(const QModelIndex& parent) const {
+    if (parent.column() > 0) {
+        return 0;
+    }
+
+    Node *node = nodeFromIndex(parent);
+    return node ? static_cast<int>(node->children.size()) : 0;
+}
+
+int CartridgeNavigationModel::columnCount(const QModelIndex& parent) const {
+    Q_UNUSED(parent);
+    return 1;
+}
+
+QVariant CartridgeNavigationModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid()) {
+        return QVariant();
+    }
+
+    Node *node = static_cast<Node*>(index.internalPointer());
+    switch (role) {
+        case Qt::DisplayRole:
+        case Qt::ToolTipRole:
+            return node->title;
+        case Qt::UserRole:
+            return node->type;
+        case Qt::UserRole + 1:
+            return node->id;
+        default:
+            return QVariant();
+    }
+}
+
+bool CartridgeNavigationModel::hasChildren(const QModelIndex& parent) const {
+    Node *node = nodeFromIndex(parent);
+    if (!node) {
+        return false;
+    }
+    // Answered from the EXISTS column so expand arrows show without fetching
+    return node->hasChildren;
+}
+
+bool CartridgeNavigationModel::canFetchMore(const QModelIndex& parent) const {
+    Node *node = nodeFromIndex(parent);
+    return node && node->hasChildren && !node->complete;
+}
+
+void CartridgeNavigationModel::fetchMore(const QModelIndex& parent) {
+    Node *node = nodeFromIndex(parent);
+    if (!node || node->complete) {
+        return;
+    }
+
+    const bool isRoot = (node == m_root.get());
+    QSqlQuery *query = isRoot ? m_rootQuery.get() : m_childQuery.get();
+
+    if (!query) {
+        node->complete = true;
+        if (isRoot && !m_placeholderTitle.isEmpty()) {
+            // Fallback: Create a simple placeholder
+            auto placeholder = std::make_unique<Node>();
+            placeholder->title = m_placeholderTitle;
+            placeholder->type = "corpus";
+            placeholder->parent = node;
+            beginInsertRows(QModelIndex(), 0, 0);
+            node->children.push_back(std::move(placeholder));
+            ++m_loadedNodeCount;
+            endInsertRows();
+        }
+        return;
+    }
+
+    if (!isRoot) {
+        query->addBindValue(node->id);
+    }
+    query->addBindValue(node->lastSortOrder);
+    query->addBindValue(node->lastRowId);
+    query->addBindValue(m_batchSize);
+
+    if (!query->exec()) {
+        qWarning() << "CartridgeNavigationModel: Failed to fetch children:" << query->lastError().text();
+        node->complete = true;
+        return;
+    }
+
+    std::vector<std::unique_ptr<Node>> batch;
+    while (query->next()) {
+        auto child = std::make_unique<Node>();
+        child->id = query->value(0).toString();
+        child->title = query->value(1).toString();
+        child->type = query->value(2).toString();
+        child->hasChildren = query->value(5).toBool();
+        child->parent = node;
+        resetCursor(child.get());
+
+        node->lastSortOrder = query->value(3).toLongLong();
+        node->lastRowId = query->value(4).toLongLong();
+        batch.push_back(std::move(child));
+    }
+    query->finish();
+
+    if (static_cast<int>(batch.size()) < m_batchSize) {
+        node->complete = true;
+    }
+    if (batch.empty()) {
+        if (node->children.empty()) {
+            node->hasChildren = false;
+        }
+        return;
+    }
+
+    const int first = static_cast<int>(node->children.size());
+    const int last = first + static_cast<int>(batch.size()) - 1;
+
+    beginInsertRows(parent, first, last);
+    for (auto& child : batch) {
+        child->row = static_cast<int>(node->children.size());
+        node->children.push_back(std::move(child));
+    }
+    m_loadedNodeCount += static_cast<int>(batch.size());
+    endInsertRows();
+}
+
+void CartridgeNavigationModel::onNodeExpanded(const QModelIndex& index) {
+    Node *node = nodeFromIndex(index);
+    if (node && node != m_root.get()) {
+        m_releasableBlocks.removeOne(node);
+    }
+}
+
+void CartridgeNavigationModel::onNodeCollapsed(const QModelIndex& index) {
+    Node *node = nodeFromIndex(index);
+    if (!node || node == m_root.get() || node->children.empty()) {
+        return;
+    }
+
+    m_releasableBlocks.removeOne(node);
+    m_releasableBlocks.prepend(node);
+    trimBlockCache();
+}
+
+CartridgeNavigationModel::Node* CartridgeNavigationModel::nodeFromIndex(const QModelIndex& index) const {
+    if (!index.isValid()) {
+        return m_root.get();
+    }
+    return static_cast<Node*>(index.internalPointer());
+}
+
+QModelIndex CartridgeNavigationModel::indexFromNode(Node *node) const {
+    if (!node || node == m_root.get()) {
+        return QModelIndex();
+    }
+    return createIndex(node->row, 0, node);
+}
+
+void CartridgeNavigationModel::releaseChildren(Node *node) {
+    if (node->children.empty()) {
+        return;
+    }
+
+    for (auto& child : node->children) {
+        forgetBlocks(child.get());
+    }
+
+    const int removed = countNodes(node) - 1;
+    beginRemoveRows(indexFromNode(node), 0, static_cast<int>(node->children.size()) - 1);
+    node->children.clear();
+    m_loadedNodeCount -= removed;
+    endRemoveRows();
+
+    // Re-expanding fetches the block again from the first batch
+    resetCursor(node);
+}
+
+void CartridgeNavigationModel::forgetBlocks(Node *node) {
+    m_releasableBlocks.removeOne(node);
+    for (auto& child : node->children) {
+        forgetBlocks(child.get());
+    }
+}
+
+void CartridgeNavigationModel::trimBlockCache() {
+    while (m_releasableBlocks.size() > m_blockCacheCapacity) {
+        releaseChildren(m_releasableBlocks.takeLast());
+    }
+}
+
+void CartridgeNavigationModel::resetCursor(Node *node) {
+    node->complete = false;
+    node->lastSortOrder = std::numeric_limits<qint64>::min();
+    node->lastRowId = std::numeric_limits<qint64>::min();
+}
+
+int CartridgeNavigationModel::countNodes(const Node *node) const {
+    int count = 1;
+    for (const auto& child : node->children) {
+        count += countNodes(child.get());
+    }
+    return count;
+}
+
+} // namespace CodexiumMagnus::Services
@@ -0,0 +1,127 @@
+#ifndef CARTRIDGENAVIGATIONMODEL_H
+#define CARTRIDGENAVIGATIONMODEL_H
+
+#include <QAbstractItemModel>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QString>
+#include <QList>
+#include <memory>
+#include <vector>
+
+namespace CodexiumMagnus::Services {
+
+/**
+ * Lazy, SQL-backed navigation tree for a loaded cartridge.
+ *
+ * Replaces the fully materialized QStandardItemModel. Only the children of
+ * nodes the view asks for (root and expanded nodes) are read, in batches,
+ * using the cartridge's indexed parent_id column. Top-level nodes are those
+ * without a parent_id or whose parent is missing. Child blocks of collapsed
+ * nodes are kept in a small LRU and released beyond its capacity, so memory
+ * tracks what the user has open rather than the size of the cartridge.
+ *
+ * Roles match the previous model: DisplayRole is the title, Qt::UserRole the
+ * node type ("corpus", "volume", "section", "document") and Qt::UserRole + 1
+ * the node id.
+ *
+ * The model runs its queries on the connection it is given and must be used
+ * from the thread that owns that connection.
+ */
+class CartridgeNavigationModel : public QAbstractItemModel {
+    Q_OBJECT
+
+public:
+    explicit CartridgeNavigationModel(QObject *parent = nullptr);
+    ~CartridgeNavigationModel();
+
+    /**
+     * Attach the model to a cartridge connection and reset it.
+     * If the cartridge has no navigation table, a single placeholder root
+     * node titled placeholderTitle is shown instead.
+     *
+     * @param database Open cartridge connection
+     * @param placeholderTitle Title of the fallback root node
+     */
+    void setDatabase(const QSqlDatabase& database, const QString& placeholderTitle);
+
+    /**
+     * Detach from the cartridge and drop all nodes.
+     * Must be called before the underlying connection is removed.
+     */
+    void clear();
+
+    /**
+     * Number of collapsed child blocks kept before the least recently used
+     * one is released.
+     */
+    void setBlockCacheCapacity(int capacity);
+    int blockCacheCapacity() const { return m_blockCacheCapacity; }
+
+    /**
+     * Number of child rows read per fetchMore() call.
+     */
+    void setBatchSize(int batchSize);
+    int batchSize() const { return m_batchSize; }
+
+    /**
+     * Number of nodes currently held in memory.
+     */
+    int loadedNodeCount() const { return m_loadedNodeCount; }
+
+    QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex& child) const override;
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    bool hasChildren(const QModelIndex& parent = QModelIndex()) const override;
+    bool canFetchMore(const QModelIndex& parent) const override;
+    void fetchMore(const QModelIndex& parent) override;
+
+public slots:
+    /**
+     * Pin the children of an expanded node so they are not released.
+     */
+    void onNodeExpanded(const QModelIndex& index);
+
+    /**
+     * Make the children of a collapsed node eligible for release.
+     */
+    void onNodeCollapsed(const QModelIndex& index);
+
+private:
+    struct Node {
+        QString id;
+        QString title;
+        QString type;
+        Node *parent = nullptr;
+        int row = 0;
+        bool hasChildren = false;
+        bool complete = false;       ///< All children have been fetched
+        qint64 lastSortOrder = 0;    ///< Keyset cursor (sort key, rowid) for the next batch; NULL sort_order is INT64_MIN
+        qint64 lastRowId = 0;
+        std::vector<std::unique_ptr<Node>> children;
+    };
+
+    Node* nodeFromIndex(const QModelIndex& index) const;
+    QModelIndex indexFromNode(Node *node) const;
+    void releaseChildren(Node *node);
+    void forgetBlocks(Node *node);
+    void trimBlockCache();
+    void resetCursor(Node *node);
+    int countNodes(const Node *node) const;
+
+    QSqlDatabase m_database;
+    std::unique_ptr<QSqlQuery> m_rootQuery;   ///< Prepared once per cartridge, rebound per batch
+    std::unique_ptr<QSqlQuery> m_childQuery;  ///< Prepared once per cartridge, rebound per batch
+    std::unique_ptr<Node> m_root;
+    QString m_placeholderTitle;
+    QList<Node*> m_releasableBlocks;  ///< Collapsed nodes with fetched children, most recent first
+    int m_blockCacheCapacity;
+    int m_batchSize;
+    int m_loadedNodeCount;
+};
+
+} // namespace CodexiumMagnus::Services
+
+#endif // CARTRIDGENAVIGATIONMODEL_H
@@ -0,0 +1,88 @@
+#include "CartridgeOpenProfile.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QStringList>
+#include <QFileInfo>
+#include <QUrl>
+#include <QUrlQuery>
+#include <QDebug>
+
+namespace CodexiumMagnus::Services {
+
+CartridgeOpenProfile CartridgeOpenProfile::immutableCartridge() {
+    return CartridgeOpenProfile();
+}
+
+CartridgeOpenProfile CartridgeOpenProfile::defaults() {
+    CartridgeOpenProfile profile;
+    profile.readOnly = false;
+    profile.immutable = false;
+    profile.mmapSize = 0;
+    profile.cacheSize = 0;
+    return profile;
+}
+
+void CartridgeOpenProfile::configure(QSqlDatabase& database, const QString& path) const {
+    QStringList options;
+    if (readOnly) {
+        options << "QSQLITE_OPEN_READONLY";
+    }
+
+    if (immutable || !vfs.isEmpty()) {
+        // SQLite decodes percent-escapes in URI filenames, so the fully
+        // encoded form round-trips paths with spaces or '?'
+        QUrl url = QUrl::fromLocalFile(QFileInfo(path).absoluteFilePath());
+        QUrlQuery query;
+        if (immutable) {
+            query.addQueryItem("immutable", "1");
+        }
+        if (!vfs.isEmpty()) {
+            query.addQueryItem("vfs", vfs);
+        }
+        if (readOnly) {
+            query.addQueryItem("mode", "ro");
+        }
+        url.setQuery(query);
+
+        options << "QSQLITE_OPEN_URI";
+        database.setDatabaseName(url.toString(QUrl::FullyEncoded));
+    } else {
+        database.setDatabaseName(path);
+    }
+
+    database.setConnectOptions(options.join(';'));
+}
+
+bool CartridgeOpenProfile::applyPragmas(QSqlDatabase& database) const {
+    QStringList pragmas;
+    if (mmapSize > 0) {
+        pragmas << QString("PRAGMA mmap_size = %1").arg(mmapSize);
+    }
+    if (cacheSize > 0) {
+        // Negative cache_size is a size in KiB rather than a page count
+        pragmas << QString("PRAGMA cache_size = -%1").arg(qMax<qint64>(1, cacheSize / 1024));
+    }
+    if (readOnly) {
+        pragmas << "PRAGMA temp_store = MEMORY";
+    }
+
+    bool ok = true;
+    for (const QString& pragma : pragmas) {
+        QSqlQuery query(database);
+        if (!query.exec(pragma)) {
+            qWarning() << "CartridgeOpenProfile: Failed to apply" << pragma << ":" << query.lastError().text();
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+bool CartridgeOpenProfile::operator==(const CartridgeOpenProfile& other) const {
+    return readOnly == other.readOnly
+        && immutable == other.immutable
+        && mmapSize == other.mmapSize
+        && cacheSize == other.cacheSize
+        && vfs == other.vfs;
+}
+
+} // namespace CodexiumMagnus::Services
@@ -0,0 +1,63 @@
+#ifndef CARTRIDGEOPENPROFILE_H
+#define CARTRIDGEOPENPROFILE_H
+
+#include <QSqlDatabase>
+#include <QString>
+
+namespace CodexiumMagnus::Services {
+
+/**
+ * SQLite open options for a cartridge connection.
+ *
+ * Cartridges are immutable once signed (NFR-2), so the default profile opens
+ * them read-only with the immutable=1 URI parameter: SQLite then skips file
+ * locking and change detection entirely. Pages are served from a memory map
+ * sized by mmapSize, with cacheSize bounding the private page cache for
+ * anything the map does not cover.
+ *
+ * immutable must only be set for files that are not modified while open;
+ * use defaults() for cartridges that may still be written to (for example
+ * while authoring).
+ *
+ * vfs selects a registered SQLite VFS by name, e.g. VerifyingVfs::name()
+ * for lazy integrity verification; it also requires the URI form.
+ */
+struct CartridgeOpenProfile {
+    bool readOnly = true;            ///< Open with QSQLITE_OPEN_READONLY
+    bool immutable = true;           ///< Open via file: URI with immutable=1
+    qint64 mmapSize = 256LL * 1024 * 1024;  ///< PRAGMA mmap_size in bytes; 0 disables memory mapping
+    qint64 cacheSize = 16LL * 1024 * 1024;  ///< PRAGMA cache_size in bytes; 0 keeps the SQLite default
+    QString vfs;                     ///< SQLite VFS to open with; empty uses the default VFS
+
+    /**
+     * Profile for signed, read-only cartridges (the default).
+     */
+    static CartridgeOpenProfile immutableCartridge();
+
+    /**
+     * Plain QSQLITE defaults: read-write, no URI flags, no pragmas.
+     */
+    static CartridgeOpenProfile defaults();
+
+    /**
+     * Set connect options and database name on a connection that has not
+     * been opened yet.
+     * @param database Connection to configure
+     * @param path Path to the cartridge file
+     */
+    void configure(QSqlDatabase& database, const QString& path) const;
+
+    /**
+     * Apply the connection pragmas. Call once, right after open().
+     * @param database Open connection
+     * @return true if all pragmas were accepted
+     */
+    bool applyPragmas(QSqlDatabase& database) const;
+
+    bool operator==(const CartridgeOpenProfile& other) const;
+    bool operator!=(const CartridgeOpenProfile& other) const { return !(*this == other); }
+};
+
+} // namespace CodexiumMagnus::Services
+
+#endif // CARTRIDGEOPENPROFILE_H
@@ -0,0 +1,185 @@
+#include "CartridgeSchemeHandler.h"
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QFileInfo>
+#include <QWebEngineUrlScheme>
+#include <QDebug>
+
+namespace CodexiumMagnus::Services {
+
+namespace {
+const QString kDocumentsPath = "/documents/";
+const QString kAssetsPath = "/assets/";
+
+/**
+ * Path below prefix of a cdoc:// URL, decoded.
+ */
+QString pathBelow(const QUrl& url, const QString& prefix) {
+    const QString path = url.path(QUrl::FullyEncoded);
+    if (!path.startsWith(prefix) || path.size() == prefix.size()) {
+        return QString();
+    }
+    return QUrl::fromPercentEncoding(path.mid(prefix.size()).toLatin1());
+}
+const QByteArray kHtmlContentType = "text/html;charset=utf-8";
+}
+
+CartridgeSchemeHandler::CartridgeSchemeHandler(QObject *parent)
+    : QWebEngineUrlSchemeHandler(parent)
+    , m_services()
+{
+}
+
+CartridgeSchemeHandler::~CartridgeSchemeHandler() {
+    // No cleanup needed - replies are owned by their request jobs
+}
+
+QByteArray CartridgeSchemeHandler::schemeName() {
+    return QByteArrayLiteral("cdoc");
+}
+
+void CartridgeSchemeHandler::registerScheme() {
+    QWebEngineUrlScheme scheme(schemeName());
+    scheme.setSyntax(QWebEngineUrlScheme::Syntax::Host);
+    // Cartridge pages are trusted local content, not mixed content
+    scheme.setFlags(QWebEngineUrlScheme::SecureScheme);
+    QWebEngineUrlScheme::registerScheme(scheme);
+}
+
+QString CartridgeSchemeHandler::cartridgeHost(const QString& cartridgePath) {
+    const QByteArray path = QFileInfo(cartridgePath).absoluteFilePath().toUtf8();
+    return QString::fromLatin1(QCryptographicHash::hash(path, QCryptographicHash::Sha1).toHex().left(16));
+}
+
+QUrl CartridgeSchemeHandler::documentUrl(const QString& cartridgePath, const QString& documentId) {
+    QUrl url;
+    url.setScheme(QString::fromLatin1(schemeName()));
+    url.setHost(cartridgeHost(cartridgePath));
+    // Ids may contain '/' and other reserved characters
+    url.setPath(kDocumentsPath + QString::fromLatin1(QUrl::toPercentEncoding(documentId)));
+    return url;
+}
+
+QString CartridgeSchemeHandler::documentIdFromUrl(const QUrl& url) {
+    if (url.scheme() != QString::fromLatin1(schemeName())) {
+        return QString();
+    }
+    return pathBelow(url, kDocumentsPath);
+}
+
+QUrl CartridgeSchemeHandler::assetUrl(const QString& cartridgePath, const QString& assetPath) {
+    QUrl url;
+    url.setScheme(QString::fromLatin1(schemeName()));
+    url.setHost(cartridgeHost(cartridgePath));
+    // Keep the path's directories, so assets can refer to each other relatively
+    url.setPath(kAssetsPath + QString::fromLatin1(QUrl::toPercentEncoding(assetPath, "/")));
+    return url;
+}
+
+QString CartridgeSchemeHandler::assetPathFromUrl(const QUrl& url) {
+    if (url.scheme() != QString::fromLatin1(schemeName())) {
+        return QString();
+    }
+    return pathBelow(url, kAssetsPath);
+}
+
+void CartridgeSchemeHandler::addCartridgeService(ICartridgeService *service, AssetService *assets) {
+    if (!service) {
+        return;
+    }
+    for (auto& served : m_services) {
+        if (served.service == service) {
+            served.assets = assets;
+            return;
+        }
+    }
+    m_services.append(ServedCartridges{service, assets});
+}
+
+const CartridgeSchemeHandler::ServedCartridges* CartridgeSchemeHandler::servedForHost(const QString& host) const {
+    for (const auto& served : m_services) {
+        if (served.service && served.service->isCartridgeLoaded()
+            && cartridgeHost(served.service->getCartridgePath()) == host) {
+            return &served;
+        }
+    }
+    return nullptr;
+}
+
+void CartridgeSchemeHandler::requestStarted(QWebEngineUrlRequestJob *job) {
+    const QUrl url = job->requestUrl();
+    const ServedCartridges *served = servedForHost(url.host());
+    if (!served) {
+        job->fail(QWebEngineUrlRequestJob::UrlNotFound);
+        return;
+    }
+
+    const QString assetPath = assetPathFromUrl(url);
+    if (!assetPath.isEmpty()) {
+        replyWithAsset(job, served->assets, assetPath);
+        return;
+    }
+
+    const QString documentId = documentIdFromUrl(url);
+    if (documentId.isEmpty()) {
+        job->fail(QWebEngineUrlRequestJob::UrlNotFound);
+        return;
+    }
+
+    if (!served->assets) {
+        replyWithContent(job, served->service, documentId);
+        return;
+    }
+
+    // Relative asset reference of a document; a single lookup in the
+    // assets table, so images do not query the documents first
+    AssetService::AssetInfo info;
+    if (served->assets->findAsset(documentId, info)) {
+        replyWithAsset(job, served->assets, documentId);
+        return;
+    }
+
+    // Streamed from the stored content, like an asset
+    CartridgeBlobDevice *device = served->assets->openDocument(documentId, info);
+    if (!device) {
+        qWarning() << "cdoc: not found:" << url.toString();
+        job->fail(QWebEngineUrlRequestJob::UrlNotFound);
+        return;
+    }
+    connect(job, &QObject::destroyed, device, &QObject::deleteLater);
+    job->reply(info.mimeType.toUtf8(), device);
+}
+
+void CartridgeSchemeHandler::replyWithContent(QWebEngineUrlRequestJob *job, ICartridgeService *service,
+                                              const QString& documentId) {
+    // Without an AssetService there is no blob device to stream from
+    const QString content = service->getDocumentContent(documentId);
+    if (content.isEmpty()) {
+        job->fail(QWebEngineUrlRequestJob::UrlNotFound);
+        return;
+    }
+
+    // The job reads the device until it is done; delete it with the job
+    auto *device = new QBuffer();
+    device->setData(content.toUtf8());
+    device->open(QIODevice::ReadOnly);
+    connect(job, &QObject::destroyed, device, &QObject::deleteLater);
+    job->reply(kHtmlContentType, device);
+}
+
+void CartridgeSchemeHandler::replyWithAsset(QWebEngineUrlRequestJob *job, AssetService *assets, const QString& path) {
+    AssetService::AssetInfo info;
+    CartridgeBlobDevice *device = assets ? assets->openAsset(path, info) : nullptr;
+    if (!device) {
+        qWarning() << "cdoc: not found:" << job->requestUrl().toString();
+        job->fail(QWebEngineUrlRequestJob::UrlNotFound);
+        return;
+    }
+
+    // The device is seekable and sized, so Range requests are answered
+    // by seeking into the blob
+    connect(job, &QObject::destroyed, device, &QObject::deleteLater);
+    job->reply(info.mimeType.toUtf8(), device);
+}
+
+} // namespace CodexiumMagnus::Services
@@ -0,0 +1,126 @@
+#ifndef CARTRIDGESCHEMEHANDLER_H
+#define CARTRIDGESCHEMEHANDLER_H
+
+#include "ICartridgeService.h"
+#include "AssetService.h"
+#include <QWebEngineUrlSchemeHandler>
+#include <QWebEngineUrlRequestJob>
+#include <QByteArray>
+#include <QList>
+#include <QPointer>
+#include <QString>
+#include <QUrl>
+
+namespace CodexiumMagnus::Services {
+
+/**
+ * Serves cartridge content to Qt WebEngine under the cdoc:// scheme
+ * (FR-AT-9.4).
+ *
+ * Documents are addressed as cdoc://<cartridge>/documents/<id> and
+ * embedded assets as cdoc://<cartridge>/assets/<path>, where <cartridge> is
+ * a key derived from the cartridge path (see cartridgeHost()), so relative
+ * links between documents resolve inside the cartridge and pages of
+ * different cartridges never share an origin. A relative asset reference
+ * in a document (<img src="images/map.png">) resolves below /documents/;
+ * paths there are looked up in the assets table first, then as documents.
+ *
+ * Replies are read from a device that Chromium pulls in chunks, instead of
+ * pushing the page through QWebEngineView::setHtml(), which is limited to
+ * about 2 MB and copies the content into a data: URL. Documents are served
+ * as stored; theming is applied by a profile script (see
+ * MainWindow::updateThemeStyleSheet()). Both documents and assets are
+ * streamed from the cartridge by the AssetService (see
+ * CartridgeBlobDevice), so neither is held in memory as a whole.
+ *
+ * The scheme must be registered with registerScheme() before the
+ * QApplication is created. The handler is installed once per profile and
+ * serves every cartridge whose service has been added with
+ * addCartridgeService().
+ */
+class CartridgeSchemeHandler : public QWebEngineUrlSchemeHandler {
+    Q_OBJECT
+
+public:
+    explicit CartridgeSchemeHandler(QObject *parent = nullptr);
+    ~CartridgeSchemeHandler();
+
+    /**
+     * Name of the scheme, "cdoc".
+     */
+    static QByteArray schemeName();
+
+    /**
+     * Register the cdoc scheme with Qt WebEngine.
+     * Must be called before the QApplication is constructed.
+     */
+    static void registerScheme();
+
+    /**
+     * Host under which a cartridge's content is served.
+     * @param cartridgePath Path to the cartridge file
+     * @return Stable key derived from the absolute path
+     */
+    static QString cartridgeHost(const QString& cartridgePath);
+
+    /**
+     * URL of a document in a cartridge.
+     */
+    static QUrl documentUrl(const QString& cartridgePath, const QString& documentId);
+
+    /**
+     * Document id of a cdoc:// document URL.
+     * @return Document id, or an empty string if url is not a document URL
+     */
+    static QString documentIdFromUrl(const QUrl& url);
+
+    /**
+     * URL of an embedded asset in a cartridge.
+     */
+    static QUrl assetUrl(const QString& cartridgePath, const QString& assetPath);
+
+    /**
+     * Asset path of a cdoc:// asset URL.
+     * @return Asset path, or an empty string if url is not an asset URL
+     */
+    static QString assetPathFromUrl(const QUrl& url);
+
+    /**
+     * Serve the cartridges loaded in a service.
+     * Requests are matched against the service's current cartridge path.
+     * @param service Service providing documents
+     * @param assets Service providing embedded assets of the same
+     *               cartridges; may be null
+     */
+    void addCartridgeService(ICartridgeService *service, AssetService *assets = nullptr);
+
+    void requestStarted(QWebEngineUrlRequestJob *job) override;
+
+private:
+    struct ServedCartridges {
+        QPointer<ICartridgeService> service;
+        QPointer<AssetService> assets;
+    };
+
+    /**
+     * Services whose loaded cartridge is served under the given host.
+     */
+    const ServedCartridges* servedForHost(const QString& host) const;
+
+    /**
+     * Reply with a document loaded as a whole; used for services added
+     * without an AssetService. Fails the job if there is no such document.
+     */
+    void replyWithContent(QWebEngineUrlRequestJob *job, ICartridgeService *service, const QString& documentId);
+
+    /**
+     * Reply with an asset; fails the job if there is none at path.
+     */
+    void replyWithAsset(QWebEngineUrlRequestJob *job, AssetService *assets, const QString& path);
+
+    QList<ServedCartridges> m_services;
+};
+
+} // namespace CodexiumMagnus::Services
+
+#endif // CARTRIDGESCHEMEHANDLER_H
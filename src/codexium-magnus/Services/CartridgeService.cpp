@@ -2,12 +2,20 @@
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QFileInfo>
-#include <QStandardItem>
-#include <QMap>
+#include <QMetaObject>
 #include <QDebug>
 
 namespace CodexiumMagnus::Services {
 
+namespace {
+const qint64 kDefaultDocumentCacheBudget = 32 * 1024 * 1024;  // 32 MB
+
+// Hot queries, prepared once per loaded cartridge
+// TODO: Adjust queries based on actual cartridge schema
+const QString kDocumentContentSql = "SELECT content FROM documents WHERE id = ?";
+const QString kDocumentListSql = "SELECT id, title FROM documents ORDER BY title";
+}
+
 CartridgeService::CartridgeService(QObject *parent)
     : ICartridgeService(parent)
     , m_cartridgePath()
@@ -15,14 +23,25 @@ CartridgeService::CartridgeService(QObject *parent)
     , m_navigationModel(nullptr)
     , m_isLoaded(false)
     , m_trustLevel(TrustLevel::Unverified)
+    , m_trustLevelDetermined(false)
     , m_signatureService(nullptr)
+    , m_loadThread(nullptr)
+    , m_retiredLoadThreads()
+    , m_loadGeneration(std::make_shared<std::atomic<quint64>>(0))
+    , m_statements(std::make_unique<PreparedStatementCache>())
+    , m_documentCache(kDefaultDocumentCacheBudget)
+    , m_documentCacheHits(0)
+    , m_documentCacheMisses(0)
+    , m_defaultOpenProfile(CartridgeOpenProfile::immutableCartridge())
+    , m_openProfiles()
 {
-    m_navigationModel = new QStandardItemModel(this);
+    m_navigationModel = new CartridgeNavigationModel(this);
     // SignatureService will be set by MainWindow or created here if needed
 }
 
 CartridgeService::~CartridgeService() {
     unloadCartridge();
+    stopLoadThreads();
 }
 
 bool CartridgeService::loadCartridge(const QString& path) {
@@ -30,16 +49,65 @@ bool CartridgeService::loadCartridge(const QString& path) {
         unloadCartridge();
     }
 
+    // Supersede any in-flight asynchronous load or verification
+    const quint64 generation = ++*m_loadGeneration;
+
     QFileInfo fileInfo(path);
     if (!fileInfo.exists() || !fileInfo.isReadable()) {
         emit errorOccurred(QString("Cartridge file not found or not readable: %1").arg(path));
         return false;
     }
 
+    if (!openDatabase(path)) {
+        return false;
+    }
+
+    m_cartridgePath = path;
+    m_cartridgeName = fileInfo.baseName();
+    m_trustLevel = TrustLevel::Unverified;
+    m_trustLevelDetermined = false;
+    m_isLoaded = true;
+
+    buildNavigationModel();
+    emit cartridgeLoaded(m_cartridgeName);
+
+    // Content is readable now; trust-sensitive actions wait for
+    // trustLevelDetermined
+    verifyInBackground(generation, path);
+
+    return true;
+}
+
+void CartridgeService::verifyInBackground(quint64 generation, const QString& path) {
+    if (!m_signatureService) {
+        // No signature service available - mark as unverified
+        onAsyncVerified(generation, TrustLevel::Unverified);
+        return;
+    }
+
+    // A verification still running belongs to a superseded load; it is
+    // cancelled by the generation bump and left to finish on its own
+    retireLoadThread();
+
+    ISignatureService *signatureService = m_signatureService;
+    const std::function<bool()> isCancelled = cancellationCheck(generation);
+    m_loadThread = QThread::create([this, generation, path, signatureService, isCancelled]() {
+        TrustLevel trustLevel = signatureService->verifyCartridge(path, isCancelled);
+        QMetaObject::invokeMethod(this, [this, generation, trustLevel]() {
+            onAsyncVerified(generation, trustLevel);
+        }, Qt::QueuedConnection);
+    });
+
+    connect(m_loadThread, &QThread::finished, m_loadThread, &QObject::deleteLater);
+    m_loadThread->start();
+}
+
+bool CartridgeService::openDatabase(const QString& path) {
     // Open SQLite database
     QString connectionName = QString("cartridge_%1").arg(reinterpret_cast<quintptr>(this));
+    const CartridgeOpenProfile profile = openProfile(path);
     m_database = QSqlDatabase::addDatabase("QSQLITE", connectionName);
-    m_database.setDatabaseName(path);
+    profile.configure(m_database, path);
 
     if (!m_database.open()) {
         QString error = m_database.lastError().text();
@@ -47,6 +115,9 @@ bool CartridgeService::loadCartridge(const QString& path) {
         return false;
     }
 
+    // Best effort: a rejected pragma only costs performance
+    profile.applyPragmas(m_database);
+
     // Verify it's a valid cartridge (check for expected tables)
     QSqlQuery query(m_database);
     if (!query.exec("SELECT name FROM sqlite_master WHERE type='table'")) {
@@ -55,40 +126,198 @@ bool CartridgeService::loadCartridge(const QString& path) {
         return false;
     }
 
-    // Verify cartridge signature if signature service is available
-    if (m_signatureService) {
-        m_trustLevel = m_signatureService->verifyCartridge(path);
-        emit trustLevelDetermined(m_trustLevel);
-    } else {
-        // No signature service available - mark as unverified
-        m_trustLevel = TrustLevel::Unverified;
-        emit trustLevelDetermined(m_trustLevel);
+    // Prepare hot queries once; later calls only rebind
+    m_statements = std::make_unique<PreparedStatementCache>(m_database);
+    m_statements->prepare(kDocumentContentSql);
+    m_statements->prepare(kDocumentListSql);
+
+    return true;
+}
+
+void CartridgeService::loadCartridgeAsync(const QString& path) {
+    if (m_isLoaded) {
+        unloadCartridge();
+    }
+
+    // A superseded load is cancelled by the generation bump and left to
+    // finish on its own; its results are dropped via the generation check
+    retireLoadThread();
+
+    const quint64 generation = ++*m_loadGeneration;
+    ISignatureService *signatureService = m_signatureService;
+    const std::function<bool()> isCancelled = cancellationCheck(generation);
+
+    m_loadThread = QThread::create([this, path, generation, signatureService, isCancelled]() {
+        QFileInfo fileInfo(path);
+        if (!fileInfo.exists() || !fileInfo.isReadable()) {
+            QString error = QString("Cartridge file not found or not readable: %1").arg(path);
+            QMetaObject::invokeMethod(this, [this, generation, error]() {
+                onAsyncFailed(generation, error);
+            }, Qt::QueuedConnection);
+            return;
+        }
+
+        // The connection is opened once, on the GUI thread that uses it;
+        // SQLite reads nothing until the structure probe there
+        QMetaObject::invokeMethod(this, [this, generation, path]() {
+            onAsyncOpened(generation, path);
+        }, Qt::QueuedConnection);
+
+        // Hashing is the slowest stage and runs last so the UI is already usable
+        TrustLevel trustLevel = signatureService
+            ? signatureService->verifyCartridge(path, isCancelled)
+            : TrustLevel::Unverified;
+        QMetaObject::invokeMethod(this, [this, generation, trustLevel]() {
+            onAsyncVerified(generation, trustLevel);
+        }, Qt::QueuedConnection);
+    });
+
+    connect(m_loadThread, &QThread::finished, m_loadThread, &QObject::deleteLater);
+    m_loadThread->start();
+}
+
+void CartridgeService::setOpenProfile(const QString& path, const CartridgeOpenProfile& profile) {
+    m_openProfiles.insert(QFileInfo(path).absoluteFilePath(), profile);
+}
+
+CartridgeOpenProfile CartridgeService::openProfile(const QString& path) const {
+    return m_openProfiles.value(QFileInfo(path).absoluteFilePath(), m_defaultOpenProfile);
+}
+
+bool CartridgeService::isLoading() const {
+    if (m_loadThread && m_loadThread->isRunning()) {
+        return true;
+    }
+    for (const QPointer<QThread>& thread : m_retiredLoadThreads) {
+        if (thread && thread->isRunning()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void CartridgeService::onAsyncOpened(quint64 generation, const QString& path) {
+    if (generation != m_loadGeneration->load()) {
+        return;
+    }
+
+    // The GUI thread gets its own connection for content, navigation and
+    // search queries
+    if (!openDatabase(path)) {
+        ++*m_loadGeneration;  // Drop the remaining stages of this load
+        return;
     }
 
     m_cartridgePath = path;
-    m_cartridgeName = fileInfo.baseName();
+    m_cartridgeName = QFileInfo(path).baseName();
+    m_trustLevel = TrustLevel::Unverified;
+    m_trustLevelDetermined = false;
     m_isLoaded = true;
 
+    emit cartridgeOpened(m_cartridgeName);
+
+    // Attaching the lazy model is cheap; rows are read as the view expands
     buildNavigationModel();
+    emit navigationReady();
     emit cartridgeLoaded(m_cartridgeName);
+}
 
-    return true;
+void CartridgeService::onAsyncVerified(quint64 generation, TrustLevel trustLevel) {
+    if (generation != m_loadGeneration->load() || !m_isLoaded) {
+        return;
+    }
+
+    m_trustLevel = trustLevel;
+    m_trustLevelDetermined = true;
+    emit trustLevelDetermined(m_trustLevel);
+}
+
+void CartridgeService::setSignatureService(ISignatureService *service) {
+    if (m_signatureService) {
+        disconnect(m_signatureService, nullptr, this, nullptr);
+    }
+    m_signatureService = service;
+    if (m_signatureService) {
+        // Emitted from verification threads; delivered queued
+        connect(m_signatureService, &ISignatureService::trustLevelChanged,
+                this, &CartridgeService::onTrustLevelChanged);
+    }
+}
+
+void CartridgeService::onTrustLevelChanged(const QString& path, TrustLevel trustLevel) {
+    if (!m_isLoaded || QFileInfo(path).absoluteFilePath() != QFileInfo(m_cartridgePath).absoluteFilePath()) {
+        return;
+    }
+
+    m_trustLevel = trustLevel;
+    m_trustLevelDetermined = true;
+    emit trustLevelDetermined(m_trustLevel);
+}
+
+void CartridgeService::onAsyncFailed(quint64 generation, const QString& errorMessage) {
+    if (generation != m_loadGeneration->load()) {
+        return;
+    }
+
+    emit errorOccurred(errorMessage);
+}
+
+void CartridgeService::retireLoadThread() {
+    // Finished workers delete themselves; drop their null entries
+    m_retiredLoadThreads.removeIf([](const QPointer<QThread>& thread) { return thread.isNull(); });
+    if (m_loadThread) {
+        m_retiredLoadThreads.append(m_loadThread);
+        m_loadThread = nullptr;
+    }
+}
+
+void CartridgeService::stopLoadThreads() {
+    // Workers post results to this object, so none may outlive it; all of
+    // them are cancelled by now and stop within one hash chunk
+    ++*m_loadGeneration;
+    retireLoadThread();
+    for (const QPointer<QThread>& thread : m_retiredLoadThreads) {
+        if (thread) {
+            thread->wait();
+            delete thread;
+        }
+    }
+    m_retiredLoadThreads.clear();
+}
+
+std::function<bool()> CartridgeService::cancellationCheck(quint64 generation) const {
+    std::shared_ptr<std::atomic<quint64>> latestGeneration = m_loadGeneration;
+    return [latestGeneration, generation]() {
+        return latestGeneration->load() != generation;
+    };
 }
 
 void CartridgeService::unloadCartridge() {
+    // Invalidate any in-flight asynchronous load
+    ++*m_loadGeneration;
+
     if (m_isLoaded) {
+        emit cartridgeClosing();
+        
+        // The navigation model holds prepared queries on this connection
+        if (m_navigationModel) {
+            m_navigationModel->clear();
+        }
+        
+        evictCachedDocuments(m_cartridgePath);
+        m_statements->clear();
+        
         m_database.close();
         QString connectionName = m_database.connectionName();
+        m_database = QSqlDatabase();
         QSqlDatabase::removeDatabase(connectionName);
         
         m_cartridgePath.clear();
         m_cartridgeName.clear();
+        m_trustLevel = TrustLevel::Unverified;
+        m_trustLevelDetermined = false;
         m_isLoaded = false;
         
-        if (m_navigationModel) {
-            m_navigationModel->clear();
-        }
-        
         emit cartridgeUnloaded();
     }
 }
@@ -114,7 +343,7 @@ QSqlDatabase* CartridgeService::getDatabase() const {
     return const_cast<QSqlDatabase*>(&m_database);
 }
 
-QStandardItemModel* CartridgeService::getNavigationModel() {
+QAbstractItemModel* CartridgeService::getNavigationModel() {
     return m_navigationModel;
 }
 
@@ -123,7 +352,35 @@ QString CartridgeService::getDocumentContent(const QString& documentId) {
         return QString();
     }
 
-    return queryDocumentContent(documentId);
+    // QString is implicitly shared, so a cache hit is a reference-count bump
+    const QPair<QString, QString> key(m_cartridgePath, documentId);
+    if (const QString *cached = m_documentCache.object(key)) {
+        ++m_documentCacheHits;
+        return *cached;
+    }
+
+    ++m_documentCacheMisses;
+    QString content = queryDocumentContent(documentId);
+    if (!content.isEmpty()) {
+        const qint64 cost = content.size() * static_cast<qint64>(sizeof(QChar));
+        // QCache deletes the entry itself if it exceeds the whole budget
+        m_documentCache.insert(key, new QString(content), cost);
+    }
+
+    return content;
+}
+
+void CartridgeService::setDocumentCacheBudget(qint64 bytes) {
+    m_documentCache.setMaxCost(qMax<qint64>(0, bytes));
+}
+
+void CartridgeService::evictCachedDocuments(const QString& cartridgePath) {
+    const QList<QPair<QString, QString>> keys = m_documentCache.keys();
+    for (const auto& key : keys) {
+        if (key.first == cartridgePath) {
+            m_documentCache.remove(key);
+        }
+    }
 }
 
 QStringList CartridgeService::getDocumentList() const {
@@ -133,62 +390,36 @@ QStringList CartridgeService::getDocumentList() const {
         return documents;
     }
 
-    QSqlQuery query(m_database);
-    // TODO: Adjust query based on actual cartridge schema
-    if (query.exec("SELECT id, title FROM documents ORDER BY title")) {
-        while (query.next()) {
-            documents.append(query.value(0).toString());
+    QSqlQuery *query = preparedStatement(kDocumentListSql);
+    if (query && query->exec()) {
+        while (query->next()) {
+            documents.append(query->value(0).toString());
         }
+        query->finish();
     }
 
     return documents;
 }
 
+QSqlQuery* CartridgeService::preparedStatement(const QString& sql) const {
+    if (!m_isLoaded) {
+        return nullptr;
+    }
+    return m_statements->statement(sql);
+}
+
+QSqlError CartridgeService::statementError() const {
+    return m_statements->lastError();
+}
+
 void CartridgeService::buildNavigationModel() {
     if (!m_isLoaded || !m_navigationModel) {
         return;
     }
 
-    m_navigationModel->clear();
-
-    // TODO: Build navigation tree based on actual cartridge schema
-    // For now, create a placeholder structure
-    QSqlQuery query(m_database);
-    
-    // Example: Query for corpus/volume/document structure
-    // This is a placeholder - adjust based on actual schema
-    if (query.exec("SELECT id, title, parent_id, type FROM navigation ORDER BY sort_order")) {
-        QMap<QString, QStandardItem*> itemMap;
-        
-        while (query.next()) {
-            QString id = query.value(0).toString();
-            QString title = query.value(1).toString();
-            QString parentId = query.value(2).toString();
-            QString type = query.value(3).toString();
-            
-            QStandardItem *item = new QStandardItem(title);
-            item->setData(type, Qt::UserRole);
-            item->setData(id, Qt::UserRole + 1);
-            
-            if (parentId.isEmpty()) {
-                m_navigationModel->appendRow(item);
-            } else {
-                QStandardItem *parent = itemMap.value(parentId);
-                if (parent) {
-                    parent->appendRow(item);
-                } else {
-                    m_navigationModel->appendRow(item);
-                }
-            }
-            
-            itemMap[id] = item;
-        }
-    } else {
-        // Fallback: Create a simple placeholder
-        QStandardItem *root = new QStandardItem(m_cartridgeName);
-        root->setData("corpus", Qt::UserRole);
-        m_navigationModel->appendRow(root);
-    }
+    // Children are fetched on demand via the indexed parent_id column;
+    // cartridges without a navigation table get a placeholder root.
+    m_navigationModel->setDatabase(m_database, m_cartridgeName);
 }
 
 QString CartridgeService::queryDocumentContent(const QString& documentId) {
@@ -196,16 +427,19 @@ QString CartridgeService::queryDocumentContent(const QString& documentId) {
         return QString();
     }
 
-    QSqlQuery query(m_database);
-    // TODO: Adjust query based on actual cartridge schema
-    query.prepare("SELECT content FROM documents WHERE id = ?");
-    query.addBindValue(documentId);
+    QSqlQuery *query = preparedStatement(kDocumentContentSql);
+    if (!query) {
+        return QString();
+    }
 
-    if (query.exec() && query.next()) {
-        return query.value(0).toString();
+    QString content;
+    query->addBindValue(documentId);
+    if (query->exec() && query->next()) {
+        content = query->value(0).toString();
     }
+    query->finish();
 
-    return QString();
+    return content;
 }
 
 } // namespace CodexiumMagnus::Services
\ No newline at end of file
@@ -3,9 +3,19 @@
 
 #include "ICartridgeService.h"
 #include "ISignatureService.h"
-#include <QStandardItemModel>
+#include "CartridgeNavigationModel.h"
+#include "PreparedStatementCache.h"
+#include "CartridgeOpenProfile.h"
 #include <QSqlDatabase>
 #include <QString>
+#include <QThread>
+#include <QPointer>
+#include <QCache>
+#include <QPair>
+#include <QHash>
+#include <QList>
+#include <atomic>
+#include <memory>
 
 namespace CodexiumMagnus::Services {
 
@@ -20,24 +30,122 @@ public:
     explicit CartridgeService(QObject *parent = nullptr);
     ~CartridgeService();
 
+    /**
+     * Load a cartridge on the calling thread.
+     *
+     * cartridgeLoaded is emitted as soon as the database is open; signature
+     * verification then runs on a worker thread and trustLevelDetermined
+     * follows once it finishes (immediately without a signature service).
+     * Until then isTrustLevelDetermined() is false and trust-sensitive
+     * actions should be deferred. Loading another cartridge or unloading
+     * cancels a running verification without waiting for it.
+     *
+     * @param path Path to the cartridge file (SQLite database)
+     * @return true if the cartridge was opened
+     */
     bool loadCartridge(const QString& path) override;
+
+    /**
+     * Load a cartridge without blocking the calling (GUI) thread.
+     *
+     * The file is checked and its signature verified on a worker thread.
+     * The database is opened once, on the calling thread that queries it;
+     * SQLite defers reading until the first statement, so this costs only
+     * the structure probe. Progress is reported in stages: cartridgeOpened,
+     * navigationReady (followed by cartridgeLoaded) and finally
+     * trustLevelDetermined, so the UI can show the TOC and first document
+     * before hashing finishes. The navigation model itself is lazy and reads
+     * on the GUI connection. Failures are reported via errorOccurred.
+     *
+     * A new load or unload cancels a running one without waiting for it.
+     *
+     * @param path Path to the cartridge file (SQLite database)
+     */
+    void loadCartridgeAsync(const QString& path);
+
+    /**
+     * Check whether an asynchronous load or background verification is
+     * still in progress, including superseded ones still winding down.
+     * @return true while any load worker thread is running
+     */
+    bool isLoading() const;
     void unloadCartridge() override;
     bool isCartridgeLoaded() const override;
     QString getCartridgeName() const override;
     QString getCartridgePath() const override;
     
-    QStandardItemModel* getNavigationModel() override;
+    QAbstractItemModel* getNavigationModel() override;
     QString getDocumentContent(const QString& documentId) override;
     QStringList getDocumentList() const override;
     
+    /**
+     * Set the byte budget of the document content cache.
+     * Recently viewed documents are kept in an LRU keyed by
+     * (cartridge path, document id); least recently used entries are
+     * evicted once the budget is exceeded. A budget of 0 disables caching.
+     * @param bytes Maximum total size of cached content in bytes
+     */
+    void setDocumentCacheBudget(qint64 bytes);
+    qint64 documentCacheBudget() const { return m_documentCache.maxCost(); }
+
+    // Document cache statistics (cumulative since construction)
+    quint64 documentCacheHits() const { return m_documentCacheHits; }
+    quint64 documentCacheMisses() const { return m_documentCacheMisses; }
+    qint64 documentCacheSize() const { return m_documentCache.totalCost(); }
+    
+    /**
+     * Set the SQLite open profile used for cartridges without a
+     * per-cartridge override. Takes effect on the next load.
+     * Defaults to CartridgeOpenProfile::immutableCartridge().
+     */
+    void setDefaultOpenProfile(const CartridgeOpenProfile& profile) { m_defaultOpenProfile = profile; }
+    CartridgeOpenProfile defaultOpenProfile() const { return m_defaultOpenProfile; }
+    
+    /**
+     * Override the SQLite open profile for one cartridge file.
+     * @param path Path to the cartridge file
+     * @param profile Profile used whenever this cartridge is loaded
+     */
+    void setOpenProfile(const QString& path, const CartridgeOpenProfile& profile);
+    
+    /**
+     * Get the SQLite open profile that applies to a cartridge file.
+     * @param path Path to the cartridge file
+     * @return Per-cartridge override, or the default profile
+     */
+    CartridgeOpenProfile openProfile(const QString& path) const;
+    
     // Expose database connection for services that need direct access (e.g., FTS5 search)
     QSqlDatabase* getDatabase() const;
     
-    // Get trust level of currently loaded cartridge
+    /**
+     * Get a prepared statement on the cartridge connection.
+     * Statements are prepared once per loaded cartridge and reused with
+     * rebinding; callers must call finish() when done reading.
+     * @param sql SQL text with positional (?) placeholders
+     * @return Prepared statement, or nullptr if no cartridge is loaded or
+     *         preparation failed (see statementError())
+     */
+    QSqlQuery* preparedStatement(const QString& sql) const;
+    QSqlError statementError() const;
+    
+    // Get trust level of currently loaded cartridge; Unverified until
+    // isTrustLevelDetermined()
     TrustLevel getTrustLevel() const { return m_trustLevel; }
+
+    /**
+     * Check whether verification of the loaded cartridge has finished.
+     * Gates trust-sensitive actions (external links per FR-AT-9.3,
+     * printing per FR-AT-10.4).
+     * @return true once trustLevelDetermined has been emitted for the
+     *         loaded cartridge
+     */
+    bool isTrustLevelDetermined() const { return m_trustLevelDetermined; }
     
-    // Set signature service for cartridge verification
-    void setSignatureService(ISignatureService *service) { m_signatureService = service; }
+    // Set signature service for cartridge verification; later trust level
+    // changes it reports for the loaded cartridge are forwarded as
+    // trustLevelDetermined
+    void setSignatureService(ISignatureService *service);
 
 signals:
     /**
@@ -46,17 +154,59 @@ signals:
      */
     void trustLevelDetermined(TrustLevel trustLevel);
 
+    /**
+     * Emitted during an asynchronous load once the cartridge database has
+     * been opened and its structure probed. Document content is available
+     * from this point on.
+     * @param cartridgeName Name of the cartridge being loaded
+     */
+    void cartridgeOpened(const QString& cartridgeName);
+
+    /**
+     * Emitted during an asynchronous load once the navigation model has been
+     * attached to the cartridge. cartridgeLoaded follows immediately.
+     */
+    void navigationReady();
+
+    /**
+     * Emitted when the loaded cartridge is about to be unloaded, while its
+     * connection is still open. Holders of handles on the cartridge (such
+     * as the connections of blob devices) must release them here.
+     */
+    void cartridgeClosing();
+
 private:
+    bool openDatabase(const QString& path);
     void buildNavigationModel();
+    void onAsyncOpened(quint64 generation, const QString& path);
+    void verifyInBackground(quint64 generation, const QString& path);
+    void onAsyncVerified(quint64 generation, TrustLevel trustLevel);
+    void onAsyncFailed(quint64 generation, const QString& errorMessage);
+    void onTrustLevelChanged(const QString& path, TrustLevel trustLevel);
+    void retireLoadThread();
+    void stopLoadThreads();
+    std::function<bool()> cancellationCheck(quint64 generation) const;
     QString queryDocumentContent(const QString& documentId);
+    void evictCachedDocuments(const QString& cartridgePath);
 
     QString m_cartridgePath;
     QString m_cartridgeName;
     QSqlDatabase m_database;
-    QStandardItemModel *m_navigationModel;
+    CartridgeNavigationModel *m_navigationModel;
     bool m_isLoaded;
     TrustLevel m_trustLevel;
+    bool m_trustLevelDetermined;            ///< Verification of the loaded cartridge has finished
     ISignatureService *m_signatureService;  ///< Signature verification service
+    QPointer<QThread> m_loadThread;         ///< Worker thread of the running async load, if any
+    QList<QPointer<QThread>> m_retiredLoadThreads;  ///< Superseded workers, cancelled and finishing on their own
+    std::shared_ptr<std::atomic<quint64>> m_loadGeneration;  ///< Incremented per load/unload, shared with workers;
+                                                             ///< stale results are dropped and stale work cancelled
+    std::unique_ptr<PreparedStatementCache> m_statements;  ///< Hot queries on m_database
+    QCache<QPair<QString, QString>, QString> m_documentCache;  ///< (cartridgePath, documentId) -> content, cost in bytes
+    quint64 m_documentCacheHits;
+    quint64 m_documentCacheMisses;
+    CartridgeOpenProfile m_defaultOpenProfile;
+    QHash<QString, CartridgeOpenProfile> m_openProfiles;  ///< Absolute cartridge path -> profile override
 };
 
 } // namespace CodexiumMagnus::Services
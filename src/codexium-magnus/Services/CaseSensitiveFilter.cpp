@@ -0,0 +1,342 @@
+#include "CaseSensitiveFilter.h"
+#include <QHash>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace CodexiumMagnus::Services {
+
+namespace {
+
+// Word boundaries in the sense of FTS5's unicode61 tokenizer: letters and
+// digits form tokens, everything else separates them
+const QString kWordStart = "(?<![\\p{L}\\p{N}])";
+const QString kWordEnd = "(?![\\p{L}\\p{N}])";
+
+// Named character references with their code points: the HTML 4 set plus
+// the spaces HTML5 added, since whitespace changes the character count
+const std::pair<const char*, char32_t> kNamedEntities[] = {
+    {"quot", 34}, {"amp", 38}, {"apos", 39}, {"lt", 60}, {"gt", 62},
+    {"OElig", 338}, {"oelig", 339}, {"Scaron", 352}, {"scaron", 353}, {"Yuml", 376},
+    {"fnof", 402}, {"circ", 710}, {"tilde", 732},
+    {"Alpha", 913}, {"Beta", 914}, {"Gamma", 915}, {"Delta", 916}, {"Epsilon", 917},
+    {"Zeta", 918}, {"Eta", 919}, {"Theta", 920}, {"Iota", 921}, {"Kappa", 922},
+    {"Lambda", 923}, {"Mu", 924}, {"Nu", 925}, {"Xi", 926}, {"Omicron", 927},
+    {"Pi", 928}, {"Rho", 929}, {"Sigma", 931}, {"Tau", 932}, {"Upsilon", 933},
+    {"Phi", 934}, {"Chi", 935}, {"Psi", 936}, {"Omega", 937},
+    {"alpha", 945}, {"beta", 946}, {"gamma", 947}, {"delta", 948}, {"epsilon", 949},
+    {"zeta", 950}, {"eta", 951}, {"theta", 952}, {"iota", 953}, {"kappa", 954},
+    {"lambda", 955}, {"mu", 956}, {"nu", 957}, {"xi", 958}, {"omicron", 959},
+    {"pi", 960}, {"rho", 961}, {"sigmaf", 962}, {"sigma", 963}, {"tau", 964},
+    {"upsilon", 965}, {"phi", 966}, {"chi", 967}, {"psi", 968}, {"omega", 969},
+    {"thetasym", 977}, {"upsih", 978}, {"piv", 982},
+    {"ensp", 0x2002}, {"emsp", 0x2003}, {"emsp13", 0x2004}, {"emsp14", 0x2005},
+    {"numsp", 0x2007}, {"puncsp", 0x2008}, {"thinsp", 0x2009}, {"ThinSpace", 0x2009},
+    {"hairsp", 0x200a}, {"VeryThinSpace", 0x200a}, {"ZeroWidthSpace", 0x200b},
+    {"zwnj", 0x200c}, {"zwj", 0x200d}, {"lrm", 0x200e}, {"rlm", 0x200f},
+    {"ndash", 0x2013}, {"mdash", 0x2014}, {"lsquo", 0x2018}, {"rsquo", 0x2019},
+    {"sbquo", 0x201a}, {"ldquo", 0x201c}, {"rdquo", 0x201d}, {"bdquo", 0x201e},
+    {"dagger", 0x2020}, {"Dagger", 0x2021}, {"bull", 0x2022}, {"hellip", 0x2026},
+    {"permil", 0x2030}, {"prime", 0x2032}, {"Prime", 0x2033}, {"lsaquo", 0x2039},
+    {"rsaquo", 0x203a}, {"oline", 0x203e}, {"frasl", 0x2044}, {"MediumSpace", 0x205f},
+    {"euro", 0x20ac}, {"image", 0x2111}, {"weierp", 0x2118}, {"real", 0x211c},
+    {"trade", 0x2122}, {"alefsym", 0x2135},
+    {"larr", 0x2190}, {"uarr", 0x2191}, {"rarr", 0x2192}, {"darr", 0x2193},
+    {"harr", 0x2194}, {"crarr", 0x21b5}, {"lArr", 0x21d0}, {"uArr", 0x21d1},
+    {"rArr", 0x21d2}, {"dArr", 0x21d3}, {"hArr", 0x21d4},
+    {"forall", 0x2200}, {"part", 0x2202}, {"exist", 0x2203}, {"empty", 0x2205},
+    {"nabla", 0x2207}, {"isin", 0x2208}, {"notin", 0x2209}, {"ni", 0x220b},
+    {"prod", 0x220f}, {"sum", 0x2211}, {"minus", 0x2212}, {"lowast", 0x2217},
+    {"radic", 0x221a}, {"prop", 0x221d}, {"infin", 0x221e}, {"ang", 0x2220},
+    {"and", 0x2227}, {"or", 0x2228}, {"cap", 0x2229}, {"cup", 0x222a},
+    {"int", 0x222b}, {"there4", 0x2234}, {"sim", 0x223c}, {"cong", 0x2245},
+    {"asymp", 0x2248}, {"ne", 0x2260}, {"equiv", 0x2261}, {"le", 0x2264},
+    {"ge", 0x2265}, {"sub", 0x2282}, {"sup", 0x2283}, {"nsub", 0x2284},
+    {"sube", 0x2286}, {"supe", 0x2287}, {"oplus", 0x2295}, {"otimes", 0x2297},
+    {"perp", 0x22a5}, {"sdot", 0x22c5}, {"lceil", 0x2308}, {"rceil", 0x2309},
+    {"lfloor", 0x230a}, {"rfloor", 0x230b}, {"lang", 0x27e8}, {"rang", 0x27e9},
+    {"loz", 0x25ca}, {"spades", 0x2660}, {"clubs", 0x2663}, {"hearts", 0x2665},
+    {"diams", 0x2666}, {"Tab", 9}, {"NewLine", 10}, {"NonBreakingSpace", 0xa0},
+};
+
+// Latin-1 names in code point order, from U+00A0 (nbsp) to U+00FF (yuml)
+const char *const kLatin1Entities[] = {
+    "nbsp", "iexcl", "cent", "pound", "curren", "yen", "brvbar", "sect",
+    "uml", "copy", "ordf", "laquo", "not", "shy", "reg", "macr",
+    "deg", "plusmn", "sup2", "sup3", "acute", "micro", "para", "middot",
+    "cedil", "sup1", "ordm", "raquo", "frac14", "frac12", "frac34", "iquest",
+    "Agrave", "Aacute", "Acirc", "Atilde", "Auml", "Aring", "AElig", "Ccedil",
+    "Egrave", "Eacute", "Ecirc", "Euml", "Igrave", "Iacute", "Icirc", "Iuml",
+    "ETH", "Ntilde", "Ograve", "Oacute", "Ocirc", "Otilde", "Ouml", "times",
+    "Oslash", "Ugrave", "Uacute", "Ucirc", "Uuml", "Yacute", "THORN", "szlig",
+    "agrave", "aacute", "acirc", "atilde", "auml", "aring", "aelig", "ccedil",
+    "egrave", "eacute", "ecirc", "euml", "igrave", "iacute", "icirc", "iuml",
+    "eth", "ntilde", "ograve", "oacute", "ocirc", "otilde", "ouml", "divide",
+    "oslash", "ugrave", "uacute", "ucirc", "uuml", "yacute", "thorn", "yuml",
+};
+
+// What numeric references to U+0080..U+009F stand for, as HTML parsers
+// read them (Windows-1252); 0 where the code point is kept
+const char16_t kWindows1252[32] = {
+    0x20ac, 0, 0x201a, 0x0192, 0x201e, 0x2026, 0x2020, 0x2021,
+    0x02c6, 0x2030, 0x0160, 0x2039, 0x0152, 0, 0x017d, 0,
+    0, 0x2018, 0x2019, 0x201c, 0x201d, 0x2022, 0x2013, 0x2014,
+    0x02dc, 0x2122, 0x0161, 0x203a, 0x0153, 0, 0x017e, 0x0178,
+};
+
+const QHash<QString, char32_t>& namedEntities() {
+    static const QHash<QString, char32_t> entities = [] {
+        QHash<QString, char32_t> table;
+        for (const auto& entity : kNamedEntities) {
+            table.insert(QString::fromLatin1(entity.first), entity.second);
+        }
+        for (char32_t i = 0; i < std::size(kLatin1Entities); ++i) {
+            table.insert(QString::fromLatin1(kLatin1Entities[i]), 0xa0 + i);
+        }
+        return table;
+    }();
+    return entities;
+}
+
+/**
+ * Code point of a character reference without its '&' and ';', or 0 if
+ * the browser would leave it as literal text.
+ */
+char32_t decodeEntity(QStringView reference) {
+    if (reference.startsWith(u'#')) {
+        const bool hex = reference.size() > 1 && (reference.at(1) == u'x' || reference.at(1) == u'X');
+        const QStringView digits = reference.mid(hex ? 2 : 1);
+        bool ok = false;
+        const qulonglong value = digits.toULongLong(&ok, hex ? 16 : 10);
+        if (!ok || value == 0 || value > 0x10ffff || (value >= 0xd800 && value <= 0xdfff)) {
+            return 0xfffd;
+        }
+        if (value >= 0x80 && value <= 0x9f && kWindows1252[value - 0x80] != 0) {
+            return kWindows1252[value - 0x80];
+        }
+        return static_cast<char32_t>(value);
+    }
+    return namedEntities().value(reference.toString(), 0);
+}
+
+// Whitespace as the in-page highlighter counts it (isSpace() in
+// MainWindow's search script); narrower than QChar::isSpace()
+bool isCollapsibleSpace(char16_t code) {
+    return code == 0x20 || (code >= 0x09 && code <= 0x0d) || code == 0xa0 || code == 0x1680
+        || (code >= 0x2000 && code <= 0x200a) || code == 0x2028 || code == 0x2029
+        || code == 0x202f || code == 0x205f || code == 0x3000;
+}
+
+QString cleanTerm(QString term) {
+    // Wildcards and FTS5 syntax are not part of the text being matched
+    term.remove(QRegularExpression("[\"*^():]"));
+    return term;
+}
+
+} // namespace
+
+CaseSensitiveFilter::CaseSensitiveFilter()
+    : m_patterns()
+{
+}
+
+QStringList CaseSensitiveFilter::phrasePatterns(const QString& phrase) {
+    QStringList words;
+    for (const QString& word : phrase.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts)) {
+        words << QRegularExpression::escape(word);
+    }
+    if (words.isEmpty()) {
+        return QStringList();
+    }
+    return QStringList{kWordStart + words.join("\\s+") + kWordEnd};
+}
+
+QStringList CaseSensitiveFilter::prefixPatterns(const QStringList& terms) {
+    QStringList patterns;
+    for (const QString& term : terms) {
+        const QString cleaned = cleanTerm(term);
+        if (!cleaned.isEmpty()) {
+            patterns << kWordStart + QRegularExpression::escape(cleaned);
+        }
+    }
+    return patterns;
+}
+
+QStringList CaseSensitiveFilter::incrementalPatterns(const QStringList& terms) {
+    QStringList patterns;
+    for (int i = 0; i < terms.size(); ++i) {
+        const QString cleaned = cleanTerm(terms.at(i));
+        if (cleaned.isEmpty()) {
+            continue;
+        }
+        const bool isPrefix = (i == terms.size() - 1);
+        patterns << kWordStart + QRegularExpression::escape(cleaned) + (isPrefix ? QString() : kWordEnd);
+    }
+    return patterns;
+}
+
+void CaseSensitiveFilter::setPatterns(const QStringList& patterns) {
+    m_patterns.clear();
+    for (const QString& pattern : patterns) {
+        QRegularExpression expression(pattern, QRegularExpression::UseUnicodePropertiesOption);
+        // Compile now rather than on the first concurrent match
+        expression.optimize();
+        if (expression.isValid()) {
+            m_patterns.append(expression);
+        }
+    }
+}
+
+void CaseSensitiveFilter::clear() {
+    m_patterns.clear();
+}
+
+bool CaseSensitiveFilter::matches(const QString& title, const QString& text) const {
+    for (const QRegularExpression& pattern : m_patterns) {
+        if (!pattern.match(title).hasMatch() && !pattern.match(text).hasMatch()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QString CaseSensitiveFilter::snippet(const QString& text, int contextLength) const {
+    // First exact-case occurrence of any pattern
+    qsizetype first = -1;
+    qsizetype firstEnd = 0;
+    for (const QRegularExpression& pattern : m_patterns) {
+        QRegularExpressionMatch match = pattern.match(text);
+        if (match.hasMatch() && (first < 0 || match.capturedStart() < first)) {
+            first = match.capturedStart();
+            firstEnd = match.capturedEnd();
+        }
+    }
+    if (first < 0) {
+        first = 0;
+        firstEnd = 0;
+    }
+
+    // Window of context around it, cut at word boundaries
+    qsizetype start = qMax<qsizetype>(0, first - contextLength);
+    if (start > 0) {
+        const qsizetype space = text.indexOf(' ', start);
+        if (space >= 0 && space < first) {
+            start = space + 1;
+        }
+    }
+    qsizetype end = qMin<qsizetype>(text.size(), firstEnd + contextLength);
+    if (end < text.size()) {
+        const qsizetype space = text.lastIndexOf(' ', end);
+        if (space > firstEnd) {
+            end = space;
+        }
+    }
+
+    // Every occurrence inside the window, merged where they overlap
+    std::vector<std::pair<qsizetype, qsizetype>> ranges;
+    for (const QRegularExpression& pattern : m_patterns) {
+        QRegularExpressionMatchIterator it = pattern.globalMatch(text, start);
+        while (it.hasNext()) {
+            QRegularExpressionMatch match = it.next();
+            if (match.capturedStart() >= end) {
+                break;
+            }
+            ranges.emplace_back(match.capturedStart(), qMin(match.capturedEnd(), end));
+        }
+    }
+    std::sort(ranges.begin(), ranges.end());
+
+    QString result;
+    if (start > 0) {
+        result += "...";
+    }
+    qsizetype position = start;
+    for (const auto& range : ranges) {
+        if (range.second <= position) {
+            continue;
+        }
+        const qsizetype markStart = qMax(range.first, position);
+        result += text.mid(position, markStart - position).toHtmlEscaped();
+        result += "<mark>" + text.mid(markStart, range.second - markStart).toHtmlEscaped() + "</mark>";
+        position = range.second;
+    }
+    result += text.mid(position, end - position).toHtmlEscaped();
+    if (end < text.size()) {
+        result += "...";
+    }
+    return result;
+}
+
+QList<QPair<int, int>> CaseSensitiveFilter::matchOffsets(const QString& text) const {
+    std::vector<std::pair<qsizetype, qsizetype>> ranges;
+    for (const QRegularExpression& pattern : m_patterns) {
+        QRegularExpressionMatchIterator it = pattern.globalMatch(text);
+        while (it.hasNext()) {
+            QRegularExpressionMatch match = it.next();
+            ranges.emplace_back(match.capturedStart(), match.capturedEnd());
+        }
+    }
+    std::sort(ranges.begin(), ranges.end());
+
+    // Merge occurrences of different patterns that overlap
+    QList<QPair<int, int>> offsets;
+    qsizetype end = -1;
+    for (const auto& range : ranges) {
+        if (!offsets.isEmpty() && range.first < end) {
+            end = qMax(end, range.second);
+            offsets.last().second = static_cast<int>(end) - offsets.last().first;
+            continue;
+        }
+        offsets.append(qMakePair(static_cast<int>(range.first), static_cast<int>(range.second - range.first)));
+        end = range.second;
+    }
+    return offsets;
+}
+
+QString CaseSensitiveFilter::plainText(const QString& html) {
+    static const QRegularExpression hiddenBlocks("<(script|style)\\b[^>]*>.*?</\\1\\s*>",
+        QRegularExpression::CaseInsensitiveOption | QRegularExpression::DotMatchesEverythingOption);
+    static const QRegularExpression tags("<[^>]*>");
+    static const QRegularExpression references("&(#[0-9]{1,8}|#[xX][0-9a-fA-F]{1,8}|[A-Za-z][A-Za-z0-9]{1,31});");
+
+    // Markup separates text nodes but adds no characters of its own
+    QString stripped = html;
+    stripped.remove(hiddenBlocks);
+    stripped.remove(tags);
+
+    QString decoded;
+    decoded.reserve(stripped.size());
+    qsizetype position = 0;
+    QRegularExpressionMatchIterator it = references.globalMatch(stripped);
+    while (it.hasNext()) {
+        const QRegularExpressionMatch match = it.next();
+        const char32_t code = decodeEntity(match.capturedView(1));
+        if (code == 0) {
+            continue;
+        }
+        decoded += QStringView(stripped).mid(position, match.capturedStart() - position);
+        decoded += QString::fromUcs4(&code, 1);
+        position = match.capturedEnd();
+    }
+    decoded += QStringView(stripped).mid(position);
+
+    // Runs of whitespace count as one space, none at either end
+    QString text;
+    text.reserve(decoded.size());
+    bool pendingSpace = false;
+    for (const QChar character : std::as_const(decoded)) {
+        if (isCollapsibleSpace(character.unicode())) {
+            pendingSpace = true;
+            continue;
+        }
+        if (pendingSpace && !text.isEmpty()) {
+            text += QLatin1Char(' ');
+        }
+        pendingSpace = false;
+        text += character;
+    }
+    return text;
+}
+
+} // namespace CodexiumMagnus::Services
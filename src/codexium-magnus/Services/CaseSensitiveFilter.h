@@ -0,0 +1,99 @@
+#ifndef CASESENSITIVEFILTER_H
+#define CASESENSITIVEFILTER_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QPair>
+#include <QRegularExpression>
+
+namespace CodexiumMagnus::Services {
+
+/**
+ * Exact-case verification of FTS5 search hits.
+ *
+ * FTS5's tokenizer folds case when the index is built, so a MATCH query can
+ * only find the case-insensitive superset of a case-sensitive search. The
+ * filter holds one pattern per query term (or a single pattern for a
+ * phrase) and keeps a candidate document only if every pattern occurs with
+ * the exact case in its title or text. Snippets are regenerated around the
+ * exact-case occurrences, since FTS5's snippet() highlights case-insensitive
+ * ones.
+ *
+ * Patterns are built by SearchService and shipped to the worker as strings.
+ * The const methods only read compiled regular expressions and may be called
+ * from several threads at once.
+ */
+class CaseSensitiveFilter {
+public:
+    CaseSensitiveFilter();
+
+    /**
+     * Pattern matching a whitespace-separated phrase as whole words.
+     */
+    static QStringList phrasePatterns(const QString& phrase);
+
+    /**
+     * Patterns matching each term as a word prefix (wildcard searches).
+     */
+    static QStringList prefixPatterns(const QStringList& terms);
+
+    /**
+     * Patterns matching each term as a whole word, except the last one
+     * which is matched as a prefix (search-as-you-type).
+     */
+    static QStringList incrementalPatterns(const QStringList& terms);
+
+    /**
+     * Compile the patterns to verify candidates against.
+     */
+    void setPatterns(const QStringList& patterns);
+
+    /**
+     * Drop all patterns; an empty filter accepts every document.
+     */
+    void clear();
+
+    bool isEmpty() const { return m_patterns.isEmpty(); }
+
+    /**
+     * Check whether every pattern occurs in the title or the text.
+     * @param title Document title
+     * @param text Plain text of the document (see plainText())
+     */
+    bool matches(const QString& title, const QString& text) const;
+
+    /**
+     * Build a snippet around the first exact-case occurrence in the text,
+     * with all occurrences in it wrapped in <mark></mark>. Falls back to the
+     * beginning of the text if only the title matched.
+     * @param text Plain text of the document
+     * @param contextLength Characters of context kept on either side
+     * @return HTML snippet in the format of FTS5 snippet()
+     */
+    QString snippet(const QString& text, int contextLength = 80) const;
+
+    /**
+     * Locate every exact-case occurrence in the text.
+     * @param text Plain text of the document
+     * @return Sorted, non-overlapping (start, length) pairs
+     */
+    QList<QPair<int, int>> matchOffsets(const QString& text) const;
+
+    /**
+     * Text of stored document content as the web view's DOM holds it.
+     *
+     * Script and style blocks and all markup are dropped without adding
+     * characters, character references are decoded, and whitespace runs
+     * (the set the in-page highlighter uses) collapse to one space with
+     * none at either end. Match offsets count characters of this text.
+     */
+    static QString plainText(const QString& html);
+
+private:
+    QList<QRegularExpression> m_patterns;
+};
+
+} // namespace CodexiumMagnus::Services
+
+#endif // CASESENSITIVEFILTER_H
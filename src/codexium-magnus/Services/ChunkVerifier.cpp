@@ -0,0 +1,169 @@
+#include "ChunkVerifier.h"
+#include "MerkleTreeDigest.h"
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QDebug>
+#include <cstring>
+
+namespace CodexiumMagnus::Services {
+
+ChunkVerifier::ChunkVerifier(const QString& path, qint64 chunkSize, const QList<QByteArray>& chunkHashes)
+    : m_path(path)
+    , m_chunkSize(chunkSize)
+    , m_chunkHashes(chunkHashes)
+    , m_mutex()
+    , m_verified(chunkHashes.size())
+    , m_verifiedCount(0)
+    , m_bytesRead(0)
+    , m_failed(false)
+    , m_failureHandler()
+{
+}
+
+bool ChunkVerifier::isValid() const {
+    QFileInfo info(m_path);
+    return m_chunkSize >= MerkleTreeDigest::minimumChunkSize()
+        && info.isFile()
+        && MerkleTreeDigest::chunkCount(info.size(), m_chunkSize) == chunkCount();
+}
+
+bool ChunkVerifier::verifyRange(qint64 offset, qint64 length) {
+    return verifyChunks(offset, length, nullptr);
+}
+
+bool ChunkVerifier::verifyRead(qint64 offset, const char *data, qint64 length) {
+    return data && verifyChunks(offset, length, data);
+}
+
+bool ChunkVerifier::verifyChunks(qint64 offset, qint64 length, const char *data) {
+    if (offset < 0 || length < 0) {
+        return false;
+    }
+
+    // Chunks still to check; the lock is not held while reading and hashing
+    QList<qint64> pending;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_failed) {
+            return false;
+        }
+        if (length == 0) {
+            return true;
+        }
+        const qint64 first = offset / m_chunkSize;
+        const qint64 last = qMin(chunkCount() - 1, (offset + length - 1) / m_chunkSize);
+        for (qint64 index = first; index <= last; ++index) {
+            if (!m_verified.testBit(index)) {
+                pending.append(index);
+            }
+        }
+    }
+    if (pending.isEmpty()) {
+        return true;
+    }
+
+    QFile file(m_path);
+    QByteArray buffer;
+    for (qint64 index : pending) {
+        qint64 bytesRead = 0;
+        const bool matches = checkChunk(index, offset, length, data, file, buffer, bytesRead);
+
+        QMutexLocker locker(&m_mutex);
+        m_bytesRead += bytesRead;
+        if (m_failed) {
+            return false;
+        }
+        if (!matches) {
+            m_failed = true;
+            qWarning() << "ChunkVerifier: Chunk" << index << "of" << m_path << "failed integrity verification";
+            // The handler may call back into the verifier
+            const auto handler = m_failureHandler;
+            locker.unlock();
+            if (handler) {
+                handler(index);
+            }
+            return false;
+        }
+        if (!m_verified.testBit(index)) {
+            m_verified.setBit(index);
+            ++m_verifiedCount;
+        }
+    }
+    return true;
+}
+
+bool ChunkVerifier::checkChunk(qint64 index, qint64 offset, qint64 length, const char *data,
+                               QFile& file, QByteArray& buffer, qint64& bytesRead) const {
+    const qint64 chunkStart = index * m_chunkSize;
+
+    // A read covering the whole chunk is hashed as the reader got it
+    if (data && offset <= chunkStart && offset + length >= chunkStart + m_chunkSize) {
+        return MerkleTreeDigest::leafHash(QByteArrayView(data + (chunkStart - offset), m_chunkSize))
+            == m_chunkHashes[index];
+    }
+
+    if (!file.isOpen() && !file.open(QIODevice::ReadOnly | QIODevice::Unbuffered)) {
+        qWarning() << "ChunkVerifier: Failed to open" << m_path << ":" << file.errorString();
+        return false;
+    }
+    if (buffer.size() != m_chunkSize) {
+        buffer.resize(m_chunkSize);
+    }
+    if (!file.seek(chunkStart)) {
+        return false;
+    }
+
+    qint64 filled = 0;
+    while (filled < m_chunkSize) {
+        const qint64 read = file.read(buffer.data() + filled, m_chunkSize - filled);
+        if (read < 0) {
+            return false;
+        }
+        if (read == 0) {
+            break;
+        }
+        filled += read;
+    }
+    bytesRead = filled;
+
+    if (MerkleTreeDigest::leafHash(QByteArrayView(buffer.constData(), filled)) != m_chunkHashes[index]) {
+        return false;
+    }
+    if (!data) {
+        return true;
+    }
+
+    // The reader's part of the chunk must be what was just verified
+    const qint64 overlapStart = qMax(offset, chunkStart);
+    const qint64 overlapEnd = qMin(offset + length, chunkStart + filled);
+    return overlapEnd <= overlapStart
+        || std::memcmp(data + (overlapStart - offset), buffer.constData() + (overlapStart - chunkStart),
+                       overlapEnd - overlapStart) == 0;
+}
+
+bool ChunkVerifier::hasFailed() const {
+    QMutexLocker locker(&m_mutex);
+    return m_failed;
+}
+
+qint64 ChunkVerifier::verifiedChunkCount() const {
+    QMutexLocker locker(&m_mutex);
+    return m_verifiedCount;
+}
+
+QBitArray ChunkVerifier::verifiedChunks() const {
+    QMutexLocker locker(&m_mutex);
+    return m_verified;
+}
+
+qint64 ChunkVerifier::bytesRead() const {
+    QMutexLocker locker(&m_mutex);
+    return m_bytesRead;
+}
+
+void ChunkVerifier::setFailureHandler(const std::function<void(qint64 chunk)>& handler) {
+    QMutexLocker locker(&m_mutex);
+    m_failureHandler = handler;
+}
+
+} // namespace CodexiumMagnus::Services
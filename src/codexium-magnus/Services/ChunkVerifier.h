@@ -0,0 +1,116 @@
+#ifndef CHUNKVERIFIER_H
+#define CHUNKVERIFIER_H
+
+#include <QBitArray>
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <functional>
+
+namespace CodexiumMagnus::Services {
+
+/**
+ * On-demand integrity check of a cartridge file against its signed chunk
+ * hash table.
+ *
+ * The table holds one MerkleTreeDigest::leafHash() per chunk of the file;
+ * its Merkle root is what the cartridge signature covers, so a valid
+ * signature vouches for every entry. verifyRange() checks only the chunks
+ * a read touches, the first time they are touched: the chunk is read from
+ * the file, hashed and compared to its table entry. Verified chunks are
+ * remembered in a bitmap and not read again; the verifier can be kept
+ * across loads of the same, unchanged file to reuse it.
+ *
+ * verifyRead() checks the bytes a reader actually got rather than a
+ * second read of the file: a chunk the read covers whole is hashed from
+ * the reader's buffer, and for one covered in part the reader's bytes must
+ * equal the verified chunk. A chunk is only checked the first time it is
+ * read, so a change to the file after that is not noticed until the file
+ * is hashed again; cartridges are opened immutable and the verification
+ * cache re-checks a file whose size or modification time changed.
+ *
+ * Once a chunk fails, the verifier reports every further range as failed.
+ * All methods are thread-safe. Chunks are read and hashed outside the
+ * lock, so readers on different chunks do not wait for each other; two
+ * readers of the same unverified chunk may both check it.
+ */
+class ChunkVerifier {
+public:
+    /**
+     * @param path Path to the cartridge file
+     * @param chunkSize Chunk size the table was built with
+     * @param chunkHashes Leaf hash of each chunk, in file order
+     */
+    ChunkVerifier(const QString& path, qint64 chunkSize, const QList<QByteArray>& chunkHashes);
+
+    QString path() const { return m_path; }
+    qint64 chunkSize() const { return m_chunkSize; }
+    qint64 chunkCount() const { return m_chunkHashes.size(); }
+    QList<QByteArray> chunkHashes() const { return m_chunkHashes; }
+
+    /**
+     * Check whether the table matches the file's current size.
+     * @return false if the file is missing or has a different chunk count
+     */
+    bool isValid() const;
+
+    /**
+     * Verify the chunks covering a byte range.
+     * @param offset First byte of the range
+     * @param length Length of the range; bytes beyond the end of the file
+     *               are ignored
+     * @return true if every chunk in the range matches its table entry
+     */
+    bool verifyRange(qint64 offset, qint64 length);
+
+    /**
+     * Verify a read from the file against the chunks it covers.
+     * @param offset Offset the bytes were read from
+     * @param data Bytes read
+     * @param length Number of bytes read
+     * @return true if every chunk in the range matches its table entry and
+     *         data matches the verified content
+     */
+    bool verifyRead(qint64 offset, const char *data, qint64 length);
+
+    /**
+     * Verify every chunk of the file.
+     */
+    bool verifyAll() { return verifyRange(0, m_chunkSize * chunkCount()); }
+
+    bool hasFailed() const;
+    qint64 verifiedChunkCount() const;
+    QBitArray verifiedChunks() const;
+
+    /**
+     * Bytes read from the file to verify chunks.
+     */
+    qint64 bytesRead() const;
+
+    /**
+     * Called once, from the reading thread, when a chunk fails.
+     * @param handler Receives the index of the failed chunk
+     */
+    void setFailureHandler(const std::function<void(qint64 chunk)>& handler);
+
+private:
+    bool verifyChunks(qint64 offset, qint64 length, const char *data);
+    bool checkChunk(qint64 index, qint64 offset, qint64 length, const char *data,
+                    QFile& file, QByteArray& buffer, qint64& bytesRead) const;
+
+    QString m_path;
+    qint64 m_chunkSize;
+    QList<QByteArray> m_chunkHashes;     ///< Immutable, read without the lock
+    mutable QMutex m_mutex;              ///< Guards everything below
+    QBitArray m_verified;                ///< Bit per chunk, set once verified
+    qint64 m_verifiedCount;
+    qint64 m_bytesRead;
+    bool m_failed;
+    std::function<void(qint64)> m_failureHandler;
+};
+
+} // namespace CodexiumMagnus::Services
+
+#endif // CHUNKVERIFIER_H
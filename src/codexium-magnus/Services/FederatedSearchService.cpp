@@ -0,0 +1,292 @@
+#include "FederatedSearchService.h"
+#include "SearchService.h"
+#include "CaseSensitiveFilter.h"
+#include <QFileInfo>
+#include <QMetaObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QThread>
+#include <QDebug>
+#include <algorithm>
+#include <vector>
+
+namespace CodexiumMagnus::Services {
+
+namespace {
+const int kDefaultResultLimit = 50;
+
+// No cartridge can contribute more than the merged limit, so each one is
+// asked for its own top-k only
+const QString kHitsSql = QString(R"(
+    SELECT
+        document_id,
+        title,
+        snippet(content_fts, 2, '<mark>', '</mark>', '...', 32) as snippet,
+        bm25(content_fts) as score
+    FROM content_fts
+    WHERE content_fts MATCH ?
+    ORDER BY rank
+    LIMIT ?
+)");
+
+// Case-sensitive searches read candidates until enough of them verify
+const QString kCandidatesSql = QString(R"(
+    SELECT
+        document_id,
+        title,
+        content,
+        bm25(content_fts) as score
+    FROM content_fts
+    WHERE content_fts MATCH ?
+    ORDER BY rank
+)");
+
+/**
+ * Merge order: higher score first, ties broken by cartridge and document
+ * so results are deterministic.
+ */
+bool ranksAbove(const FederatedSearchHit& a, const FederatedSearchHit& b) {
+    if (a.score != b.score) {
+        return a.score > b.score;
+    }
+    if (a.cartridgeId != b.cartridgeId) {
+        return a.cartridgeId < b.cartridgeId;
+    }
+    return a.documentId < b.documentId;
+}
+}
+
+struct FederatedSearchService::SearchState {
+    quint64 generation = 0;
+    std::shared_ptr<std::atomic<quint64>> latestGeneration;
+    QString ftsQuery;
+    QStringList caseSensitivePatterns;
+    int limit = kDefaultResultLimit;
+    std::atomic<int> remaining{0};        ///< Cartridges not yet finished
+
+    QMutex mutex;                         ///< Guards the members below
+    std::vector<FederatedSearchHit> heap; ///< Top-k so far; the lowest ranked hit is at the front
+    QList<QPair<QString, QString>> failures;  ///< (cartridge id, error message)
+    int searchedCount = 0;                ///< Cartridges searched successfully
+
+    bool isCancelled() const {
+        return generation != latestGeneration->load(std::memory_order_relaxed);
+    }
+};
+
+FederatedSearchService::FederatedSearchService(QObject *parent)
+    : QObject(parent)
+    , m_cartridges()
+    , m_latestGeneration(std::make_shared<std::atomic<quint64>>(0))
+    , m_resultLimit(kDefaultResultLimit)
+    , m_pool()
+{
+    m_pool.setMaxThreadCount(QThread::idealThreadCount());
+}
+
+FederatedSearchService::~FederatedSearchService() {
+    // Running tasks post back to this object; let them finish first
+    cancelSearch();
+    m_pool.waitForDone();
+}
+
+bool FederatedSearchService::mountCartridge(const QString& cartridgeId,
+                                            const QString& path,
+                                            const CartridgeOpenProfile& profile) {
+    QFileInfo fileInfo(path);
+    if (cartridgeId.isEmpty() || !fileInfo.exists()) {
+        return false;
+    }
+
+    MountedCartridge cartridge;
+    cartridge.cartridgeId = cartridgeId;
+    cartridge.path = fileInfo.absoluteFilePath();
+    cartridge.profile = profile;
+    // Searches only read, whatever profile the cartridge is mounted with
+    cartridge.profile.readOnly = true;
+    m_cartridges.insert(cartridgeId, cartridge);
+    return true;
+}
+
+void FederatedSearchService::unmountCartridge(const QString& cartridgeId) {
+    m_cartridges.remove(cartridgeId);
+}
+
+void FederatedSearchService::setResultLimit(int limit) {
+    m_resultLimit = qMax(1, limit);
+}
+
+void FederatedSearchService::setMaxThreadCount(int threadCount) {
+    m_pool.setMaxThreadCount(qMax(1, threadCount));
+}
+
+double FederatedSearchService::normalizeBm25(double bm25Score) {
+    const double relevance = qMax(0.0, -bm25Score);
+    return relevance / (1.0 + relevance);
+}
+
+void FederatedSearchService::search(const QString& query, bool caseSensitive, bool wildcards) {
+    const quint64 generation = m_latestGeneration->fetch_add(1) + 1;
+
+    QString trimmedQuery = query.trimmed();
+    if (trimmedQuery.isEmpty()) {
+        emit searchError("Search query is empty");
+        return;
+    }
+
+    if (m_cartridges.isEmpty()) {
+        emit searchError("No cartridges mounted");
+        return;
+    }
+
+    auto state = std::make_shared<SearchState>();
+    state->generation = generation;
+    state->latestGeneration = m_latestGeneration;
+    state->ftsQuery = SearchService::buildFtsQuery(trimmedQuery, caseSensitive, false, wildcards);
+    if (state->ftsQuery.isEmpty()) {
+        emit searchError("Invalid search query");
+        return;
+    }
+    if (caseSensitive) {
+        state->caseSensitivePatterns = SearchService::caseSensitivePatterns(trimmedQuery, wildcards);
+    }
+    state->limit = m_resultLimit;
+    state->remaining = static_cast<int>(m_cartridges.size());
+    state->heap.reserve(m_resultLimit + 1);
+
+    for (const MountedCartridge& cartridge : m_cartridges) {
+        m_pool.start([this, cartridge, state]() {
+            searchCartridge(cartridge, state);
+            if (state->remaining.fetch_sub(1) == 1) {
+                QMetaObject::invokeMethod(this, [this, state]() {
+                    onSearchFinished(state);
+                }, Qt::QueuedConnection);
+            }
+        });
+    }
+}
+
+void FederatedSearchService::cancelSearch() {
+    m_latestGeneration->fetch_add(1);
+}
+
+void FederatedSearchService::searchCartridge(const MountedCartridge& cartridge,
+                                             const std::shared_ptr<SearchState>& state) {
+    // Skip cartridges of superseded searches that have not started yet
+    if (state->isCancelled()) {
+        return;
+    }
+
+    const QString connectionName = QString("federated_%1_%2").arg(state->generation).arg(cartridge.cartridgeId);
+    std::vector<FederatedSearchHit> hits;
+    QString error;
+    {
+        QSqlDatabase database = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+        cartridge.profile.configure(database, cartridge.path);
+        if (!database.open()) {
+            error = QString("Failed to open cartridge: %1").arg(database.lastError().text());
+        } else {
+            cartridge.profile.applyPragmas(database);
+
+            const bool verify = !state->caseSensitivePatterns.isEmpty();
+            CaseSensitiveFilter filter;
+            filter.setPatterns(state->caseSensitivePatterns);
+
+            QSqlQuery query(database);
+            query.setForwardOnly(true);
+            bool executed = query.prepare(verify ? kCandidatesSql : kHitsSql);
+            if (executed) {
+                query.addBindValue(state->ftsQuery);
+                if (!verify) {
+                    query.addBindValue(state->limit);
+                }
+                executed = query.exec();
+            }
+
+            if (!executed) {
+                error = QString("Search failed: %1").arg(query.lastError().text());
+            } else {
+                while (static_cast<int>(hits.size()) < state->limit && query.next()) {
+                    if (state->isCancelled()) {
+                        break;
+                    }
+
+                    FederatedSearchHit hit;
+                    hit.cartridgeId = cartridge.cartridgeId;
+                    hit.documentId = query.value("document_id").toString();
+                    hit.title = query.value("title").toString();
+                    hit.score = normalizeBm25(query.value("score").toDouble());
+                    if (verify) {
+                        const QString text = CaseSensitiveFilter::plainText(query.value("content").toString());
+                        if (!filter.matches(hit.title, text)) {
+                            continue;
+                        }
+                        hit.snippet = filter.snippet(text);
+                    } else {
+                        hit.snippet = query.value("snippet").toString();
+                    }
+                    if (hit.snippet.isEmpty()) {
+                        hit.snippet = hit.title;
+                    }
+                    hits.push_back(std::move(hit));
+                }
+                if (query.lastError().isValid()) {
+                    error = QString("Search failed: %1").arg(query.lastError().text());
+                }
+            }
+            query.finish();
+        }
+        database.close();
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+
+    QMutexLocker locker(&state->mutex);
+    if (!error.isEmpty()) {
+        state->failures.append(qMakePair(cartridge.cartridgeId, error));
+        return;
+    }
+
+    ++state->searchedCount;
+    // Hits arrive best first, so the first one that does not make it into
+    // the heap ends the merge for this cartridge
+    for (FederatedSearchHit& hit : hits) {
+        if (static_cast<int>(state->heap.size()) < state->limit) {
+            state->heap.push_back(std::move(hit));
+            std::push_heap(state->heap.begin(), state->heap.end(), ranksAbove);
+        } else if (ranksAbove(hit, state->heap.front())) {
+            std::pop_heap(state->heap.begin(), state->heap.end(), ranksAbove);
+            state->heap.back() = std::move(hit);
+            std::push_heap(state->heap.begin(), state->heap.end(), ranksAbove);
+        } else {
+            break;
+        }
+    }
+}
+
+void FederatedSearchService::onSearchFinished(const std::shared_ptr<SearchState>& state) {
+    if (state->isCancelled()) {
+        return;
+    }
+
+    // All tasks of this search have finished; no locking needed
+    for (const auto& failure : state->failures) {
+        qWarning() << "Federated search failed on cartridge" << failure.first << ":" << failure.second;
+        emit cartridgeSearchFailed(failure.first, failure.second);
+    }
+
+    if (state->searchedCount == 0) {
+        emit searchError("Search failed on every mounted cartridge");
+        return;
+    }
+
+    std::sort_heap(state->heap.begin(), state->heap.end(), ranksAbove);
+    QList<FederatedSearchHit> hits(state->heap.begin(), state->heap.end());
+    qDebug() << "Federated search completed:" << hits.size() << "results from"
+             << state->searchedCount << "cartridges";
+    emit searchCompleted(hits);
+}
+
+} // namespace CodexiumMagnus::Services
@@ -0,0 +1,154 @@
+#ifndef FEDERATEDSEARCHSERVICE_H
+#define FEDERATEDSEARCHSERVICE_H
+
+#include "CartridgeOpenProfile.h"
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QMap>
+#include <QMetaType>
+#include <QThreadPool>
+#include <atomic>
+#include <memory>
+
+namespace CodexiumMagnus::Services {
+
+/**
+ * A hit of a federated search, tagged with the cartridge it came from.
+ */
+struct FederatedSearchHit {
+    QString cartridgeId;
+    QString documentId;
+    QString title;
+    QString snippet;
+    double score = 0.0;            ///< Normalized BM25 relevance in [0, 1); higher is better
+};
+
+/**
+ * Full-text search across all cartridges mounted in the library.
+ *
+ * Cartridges are mounted under a cartridge id (the manifest's cartridgeId,
+ * see Detailed Design §9). A search fans out to every mounted cartridge in
+ * parallel on the service's thread pool: each task opens its own read-only
+ * connection, runs the FTS5 query limited to the result limit and merges
+ * its hits into a shared top-k heap. Once the last cartridge has reported,
+ * the merged hits are emitted on the thread the service lives in, best
+ * first.
+ *
+ * BM25 scores are only comparable in shape between cartridges, not in
+ * scale, so each raw score s (negative in FTS5, lower is better) is mapped
+ * to r / (1 + r) with r = -s before merging. The mapping is monotonic, so
+ * the order within a cartridge is preserved, and bounded, so no single
+ * cartridge can dominate the merged list with outsized scores.
+ *
+ * A new search supersedes the previous one; cartridges that have not
+ * started yet are skipped and stale results are never emitted. Fuzzy
+ * matching needs a per-cartridge vocabulary and is not supported here.
+ */
+class FederatedSearchService : public QObject {
+    Q_OBJECT
+
+public:
+    explicit FederatedSearchService(QObject *parent = nullptr);
+    ~FederatedSearchService();
+
+    /**
+     * Mount a cartridge for federated search.
+     * Remounting an id replaces its cartridge.
+     * @param cartridgeId Id results of this cartridge are tagged with
+     * @param path Path to the cartridge file
+     * @param profile SQLite open profile; the connection is always read-only
+     * @return true if the cartridge file exists
+     */
+    bool mountCartridge(const QString& cartridgeId,
+                        const QString& path,
+                        const CartridgeOpenProfile& profile = CartridgeOpenProfile::immutableCartridge());
+
+    /**
+     * Remove a cartridge from federated search.
+     * Searches already running on it still report its hits.
+     */
+    void unmountCartridge(const QString& cartridgeId);
+
+    bool isMounted(const QString& cartridgeId) const { return m_cartridges.contains(cartridgeId); }
+    QStringList mountedCartridges() const { return m_cartridges.keys(); }
+
+    /**
+     * Search all mounted cartridges.
+     * Results are returned asynchronously via searchCompleted.
+     * @param query The search query string
+     * @param caseSensitive If true, hits are verified for the exact case
+     * @param wildcards If true, terms match as prefixes
+     */
+    void search(const QString& query, bool caseSensitive = false, bool wildcards = false);
+
+    /**
+     * Cancel the running search; its results are not emitted.
+     */
+    void cancelSearch();
+
+    /**
+     * Number of merged hits returned per search (default: 50).
+     */
+    void setResultLimit(int limit);
+    int resultLimit() const { return m_resultLimit; }
+
+    /**
+     * Number of cartridges searched concurrently (default: one per core).
+     */
+    void setMaxThreadCount(int threadCount);
+    int maxThreadCount() const { return m_pool.maxThreadCount(); }
+
+    /**
+     * Map a raw FTS5 bm25() score to the normalized relevance in [0, 1).
+     */
+    static double normalizeBm25(double bm25Score);
+
+signals:
+    /**
+     * Emitted with the merged hits of a search, best first.
+     */
+    void searchCompleted(const QList<CodexiumMagnus::Services::FederatedSearchHit>& hits);
+
+    /**
+     * Emitted if a search cannot run at all or fails on every cartridge.
+     */
+    void searchError(const QString& errorMessage);
+
+    /**
+     * Emitted for each cartridge a search failed on; hits of the other
+     * cartridges are still emitted.
+     */
+    void cartridgeSearchFailed(const QString& cartridgeId, const QString& errorMessage);
+
+private:
+    struct MountedCartridge {
+        QString cartridgeId;
+        QString path;
+        CartridgeOpenProfile profile;
+    };
+    struct SearchState;
+
+    /**
+     * Search one cartridge on a pool thread and merge its hits.
+     */
+    static void searchCartridge(const MountedCartridge& cartridge, const std::shared_ptr<SearchState>& state);
+
+    /**
+     * Emit the merged results of a search on the service's thread.
+     * Results of superseded searches are dropped.
+     */
+    void onSearchFinished(const std::shared_ptr<SearchState>& state);
+
+    QMap<QString, MountedCartridge> m_cartridges;
+    std::shared_ptr<std::atomic<quint64>> m_latestGeneration;  ///< Shared with running tasks
+    int m_resultLimit;
+    QThreadPool m_pool;
+};
+
+} // namespace CodexiumMagnus::Services
+
+Q_DECLARE_METATYPE(CodexiumMagnus::Services::FederatedSearchHit)
+
+#endif // FEDERATEDSEARCHSERVICE_H
@@ -0,0 +1,226 @@
+#include "FuzzyTermIndex.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDebug>
+#include <algorithm>
+#include <cstdlib>
+
+namespace CodexiumMagnus::Services {
+
+namespace {
+// Vocabulary shipped by the cartridge builder, if any
+const QString kShippedVocabularySql = "SELECT term, doc_count FROM fuzzy_vocabulary";
+
+// Otherwise derived from the FTS5 index; fts5vocab tables are read-only
+// views, so one can be created on the temp schema of a read-only connection
+const QString kCreateVocabularySql =
+    "CREATE VIRTUAL TABLE IF NOT EXISTS temp.content_fts_vocab USING fts5vocab('main', 'content_fts', 'row')";
+const QString kDerivedVocabularySql = "SELECT term, doc FROM temp.content_fts_vocab";
+
+const QChar kBoundary(0x1);
+}
+
+FuzzyTermIndex::FuzzyTermIndex()
+    : m_terms()
+    , m_documentCounts()
+    , m_postings()
+    , m_sharedCounts()
+    , m_touched()
+{
+}
+
+bool FuzzyTermIndex::build(const QSqlDatabase& database, QString& errorMessage) {
+    clear();
+
+    QStringList terms;
+    std::vector<qint64> documentCounts;
+
+    QSqlQuery query(database);
+    query.setForwardOnly(true);
+    bool loaded = query.exec(kShippedVocabularySql);
+    if (!loaded) {
+        QSqlQuery create(database);
+        if (!create.exec(kCreateVocabularySql)) {
+            errorMessage = QString("Fuzzy search vocabulary not available: %1").arg(create.lastError().text());
+            return false;
+        }
+        loaded = query.exec(kDerivedVocabularySql);
+    }
+
+    if (!loaded) {
+        errorMessage = QString("Fuzzy search vocabulary not available: %1").arg(query.lastError().text());
+        return false;
+    }
+
+    while (query.next()) {
+        terms.append(query.value(0).toString());
+        documentCounts.push_back(query.value(1).toLongLong());
+    }
+
+    setTerms(terms, documentCounts);
+    qDebug() << "FuzzyTermIndex: Indexed" << m_terms.size() << "terms," << m_postings.size() << "trigrams";
+    return true;
+}
+
+void FuzzyTermIndex::setTerms(const QStringList& terms, const std::vector<qint64>& documentCounts) {
+    clear();
+
+    m_terms.reserve(terms.size());
+    m_documentCounts.reserve(terms.size());
+
+    std::vector<quint64> trigrams;
+    for (int i = 0; i < terms.size(); ++i) {
+        const QString& term = terms.at(i);
+        if (term.size() < 2) {
+            continue;
+        }
+
+        const quint32 id = static_cast<quint32>(m_terms.size());
+        m_terms.append(term);
+        m_documentCounts.push_back(i < static_cast<int>(documentCounts.size()) ? documentCounts[i] : 1);
+
+        trigramsOf(term, trigrams);
+        for (quint64 trigram : trigrams) {
+            m_postings[trigram].push_back(id);
+        }
+    }
+
+    m_sharedCounts.assign(m_terms.size(), 0);
+}
+
+void FuzzyTermIndex::clear() {
+    m_terms.clear();
+    m_documentCounts.clear();
+    m_postings.clear();
+    m_sharedCounts.clear();
+    m_touched.clear();
+}
+
+QStringList FuzzyTermIndex::expand(const QString& term, int maxDistance, int maxExpansions) {
+    if (maxDistance < 0) {
+        maxDistance = defaultMaxDistance(term.size());
+    }
+
+    std::vector<quint64> trigrams;
+    trigramsOf(term, trigrams);
+
+    // q-gram lemma: each edit destroys at most three trigrams of the term
+    const int minShared = std::max(1, static_cast<int>(trigrams.size()) - 3 * maxDistance);
+
+    m_touched.clear();
+    for (quint64 trigram : trigrams) {
+        auto it = m_postings.constFind(trigram);
+        if (it == m_postings.constEnd()) {
+            continue;
+        }
+        for (quint32 id : it.value()) {
+            if (m_sharedCounts[id]++ == 0) {
+                m_touched.push_back(id);
+            }
+        }
+    }
+
+    struct Match {
+        quint32 id;
+        int distance;
+    };
+    std::vector<Match> matches;
+    for (quint32 id : m_touched) {
+        const int shared = m_sharedCounts[id];
+        m_sharedCounts[id] = 0;  // Reset scratch for the next call
+
+        const QString& candidate = m_terms.at(static_cast<int>(id));
+        if (shared < minShared || std::abs(candidate.size() - term.size()) > maxDistance) {
+            continue;
+        }
+
+        const int distance = editDistance(term, candidate, maxDistance);
+        if (distance <= maxDistance) {
+            matches.push_back({id, distance});
+        }
+    }
+
+    std::sort(matches.begin(), matches.end(), [this](const Match& a, const Match& b) {
+        if (a.distance != b.distance) {
+            return a.distance < b.distance;
+        }
+        return m_documentCounts[a.id] > m_documentCounts[b.id];
+    });
+
+    QStringList expansions;
+    for (const Match& match : matches) {
+        if (expansions.size() >= maxExpansions) {
+            break;
+        }
+        expansions.append(m_terms.at(static_cast<int>(match.id)));
+    }
+    return expansions;
+}
+
+int FuzzyTermIndex::defaultMaxDistance(int termLength) {
+    if (termLength <= 3) {
+        return 0;
+    }
+    return termLength <= 7 ? 1 : 2;
+}
+
+int FuzzyTermIndex::editDistance(const QString& a, const QString& b, int maxDistance) {
+    const int n = a.size();
+    const int m = b.size();
+    if (std::abs(n - m) > maxDistance) {
+        return maxDistance + 1;
+    }
+
+    // Two-row dynamic programme restricted to the diagonal band |i - j| <= maxDistance
+    const int outside = maxDistance + 1;
+    std::vector<int> previous(m + 1, outside);
+    std::vector<int> current(m + 1, outside);
+    for (int j = 0; j <= std::min(m, maxDistance); ++j) {
+        previous[j] = j;
+    }
+
+    for (int i = 1; i <= n; ++i) {
+        const int from = std::max(1, i - maxDistance);
+        const int to = std::min(m, i + maxDistance);
+        std::fill(current.begin(), current.end(), outside);
+        if (i <= maxDistance) {
+            current[0] = i;
+        }
+
+        int rowMinimum = current[0];
+        for (int j = from; j <= to; ++j) {
+            const int substitution = previous[j - 1] + (a.at(i - 1) == b.at(j - 1) ? 0 : 1);
+            const int deletion = previous[j] + 1;
+            const int insertion = current[j - 1] + 1;
+            current[j] = std::min({substitution, deletion, insertion, outside});
+            rowMinimum = std::min(rowMinimum, current[j]);
+        }
+
+        if (rowMinimum > maxDistance) {
+            return outside;
+        }
+        std::swap(previous, current);
+    }
+
+    return std::min(previous[m], outside);
+}
+
+void FuzzyTermIndex::trigramsOf(const QString& term, std::vector<quint64>& trigrams) {
+    trigrams.clear();
+
+    // One boundary marker on each side, so a term of length n has n trigrams
+    // and edits at either end are penalized like edits in the middle
+    const QString padded = kBoundary + term + kBoundary;
+    for (int i = 0; i + 3 <= padded.size(); ++i) {
+        const quint64 trigram = (quint64(padded.at(i).unicode()) << 32)
+                              | (quint64(padded.at(i + 1).unicode()) << 16)
+                              | quint64(padded.at(i + 2).unicode());
+        trigrams.push_back(trigram);
+    }
+
+    // Count each distinct trigram once
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+}
+
+} // namespace CodexiumMagnus::Services
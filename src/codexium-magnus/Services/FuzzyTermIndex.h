@@ -0,0 +1,91 @@
+#ifndef FUZZYTERMINDEX_H
+#define FUZZYTERMINDEX_H
+
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <vector>
+
+namespace CodexiumMagnus::Services {
+
+/**
+ * Trigram index over a cartridge's search vocabulary for fuzzy term
+ * expansion.
+ *
+ * The vocabulary is read from a fuzzy_vocabulary(term, doc_count) table if
+ * the cartridge ships one, and otherwise derived from the FTS5 index itself
+ * through an fts5vocab table on the connection's temp schema. Each term is
+ * indexed by its boundary-padded trigrams; expand() gathers terms sharing
+ * enough trigrams with the query term (an edit changes at most three
+ * trigrams) and verifies them with a bounded edit distance, so only a small
+ * candidate set is ever compared.
+ *
+ * The index is not thread-safe and is used from the search worker only.
+ */
+class FuzzyTermIndex {
+public:
+    FuzzyTermIndex();
+
+    FuzzyTermIndex(const FuzzyTermIndex&) = delete;
+    FuzzyTermIndex& operator=(const FuzzyTermIndex&) = delete;
+
+    /**
+     * Load the vocabulary of a cartridge and build the trigram index.
+     * @param database Open cartridge connection
+     * @param errorMessage Set if no vocabulary could be read
+     * @return true if the index was built
+     */
+    bool build(const QSqlDatabase& database, QString& errorMessage);
+
+    /**
+     * Build the index from an explicit vocabulary.
+     * @param terms Lowercased terms
+     * @param documentCounts Number of documents containing each term (may be
+     *        empty, in which case all terms weigh the same)
+     */
+    void setTerms(const QStringList& terms, const std::vector<qint64>& documentCounts = {});
+
+    /**
+     * Drop the vocabulary and index.
+     */
+    void clear();
+
+    bool isEmpty() const { return m_terms.isEmpty(); }
+    int termCount() const { return static_cast<int>(m_terms.size()); }
+
+    /**
+     * Find vocabulary terms within a bounded edit distance of a term.
+     * @param term Lowercased query term
+     * @param maxDistance Maximum edit distance; negative selects
+     *        defaultMaxDistance() for the term
+     * @param maxExpansions Maximum number of terms returned
+     * @return Matching terms, closest first and then most frequent first
+     */
+    QStringList expand(const QString& term, int maxDistance = -1, int maxExpansions = 16);
+
+    /**
+     * Edit distance allowed for a query term: none for very short terms,
+     * one up to seven characters and two beyond.
+     */
+    static int defaultMaxDistance(int termLength);
+
+    /**
+     * Levenshtein distance, computed only within a band of maxDistance.
+     * @return The distance, or maxDistance + 1 if it exceeds maxDistance
+     */
+    static int editDistance(const QString& a, const QString& b, int maxDistance);
+
+private:
+    static void trigramsOf(const QString& term, std::vector<quint64>& trigrams);
+
+    QStringList m_terms;
+    std::vector<qint64> m_documentCounts;
+    QHash<quint64, std::vector<quint32>> m_postings;  ///< Trigram -> ids of terms containing it
+    std::vector<quint16> m_sharedCounts;               ///< Scratch: trigrams shared with the query term, per term id
+    std::vector<quint32> m_touched;                    ///< Scratch: term ids with a non-zero shared count
+};
+
+} // namespace CodexiumMagnus::Services
+
+#endif // FUZZYTERMINDEX_H
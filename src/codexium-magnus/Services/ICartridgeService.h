@@ -4,7 +4,7 @@
 #include <QObject>
 #include <QString>
 #include <QStringList>
-#include <QStandardItemModel>
+#include <QAbstractItemModel>
 
 namespace CodexiumMagnus::Services {
 
@@ -56,9 +56,10 @@ public:
     /**
      * Get the navigation model for the loaded cartridge.
      * The model represents the hierarchical structure (corpus → volume → document).
-     * @return Pointer to QStandardItemModel, or nullptr if no cartridge loaded
+     * Item type is exposed in Qt::UserRole and the node id in Qt::UserRole + 1.
+     * @return Pointer to the navigation model, or nullptr if not available
      */
-    virtual QStandardItemModel* getNavigationModel() = 0;
+    virtual QAbstractItemModel* getNavigationModel() = 0;
 
     /**
      * Get the HTML content for a specific document.
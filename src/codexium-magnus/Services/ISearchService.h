@@ -4,10 +4,29 @@
 #include <QObject>
 #include <QString>
 #include <QList>
+#include <QStringList>
 #include <QPair>
+#include <QMetaType>
 
 namespace CodexiumMagnus::Services {
 
+/**
+ * A document matched by a search.
+ *
+ * Match offsets are (start, length) pairs in characters of the document's
+ * plain text as produced by CaseSensitiveFilter::plainText(): markup
+ * removed, entities decoded, whitespace collapsed and trimmed. They are sorted
+ * and do not overlap; occurrences in the title only are not listed.
+ */
+struct SearchHit {
+    QString documentId;            ///< Primary key of the document (documents.id)
+    QString title;
+    QString snippet;               ///< HTML snippet with the matches wrapped in <mark></mark>; empty until built (see requestSnippets())
+    double rank = 0.0;             ///< FTS5 rank (bm25); lower is better, 0 for the LIKE fallback
+    qint64 rowid = 0;              ///< Rowid of the hit in content_fts, used to build its snippet; 0 for the LIKE fallback
+    QList<QPair<int, int>> matchOffsets;  ///< Built with the snippet
+};
+
 /**
  * Service interface for full-text search functionality.
  * 
@@ -16,7 +35,8 @@ namespace CodexiumMagnus::Services {
  * highlighting and in-page navigation.
  * 
  * The service performs searches on loaded cartridge content and returns
- * results with titles and highlighted snippets for display in the UI.
+ * hits carrying the document id, title, highlighted snippet and match
+ * offsets, so a selected hit can be opened and scrolled to directly.
  */
 class ISearchService : public QObject {
     Q_OBJECT
@@ -33,7 +53,7 @@ public:
      * 
      * @param query The search query string
      * @param caseSensitive If true, perform case-sensitive search (default: false)
-     * @param fuzzy If true, use fuzzy matching (via FTS5 NEAR operator) (default: false)
+     * @param fuzzy If true, match terms within a small edit distance of the query terms (default: false)
      * @param wildcards If true, enable wildcard matching (default: false)
      */
     virtual void performSearch(const QString& query, 
@@ -41,17 +61,92 @@ public:
                               bool fuzzy = false,
                               bool wildcards = false) = 0;
 
+    /**
+     * Search as the user types.
+     * 
+     * The last term is matched as a prefix and earlier terms as whole
+     * words. When the query only narrows the previous incremental query
+     * (the last term was extended or terms were added), the search may be
+     * restricted to the documents that matched before instead of scanning
+     * the index again. Results are delivered like performSearch() results.
+     * 
+     * @param query The partial query typed so far
+     * @param caseSensitive If true, perform case-sensitive search (default: false)
+     */
+    virtual void performIncrementalSearch(const QString& query, bool caseSensitive = false) = 0;
+
+    /**
+     * Cancel the current search. Its pending results and errors are no
+     * longer delivered.
+     */
+    virtual void cancelSearch() = 0;
+
+    /**
+     * Request the next page of results of the current search.
+     * 
+     * Results are streamed in pages; the first page is delivered by
+     * searchCompleted and each further page by resultsAppended. Does
+     * nothing if the current search has no more results or a page is
+     * already being fetched.
+     */
+    virtual void fetchMoreResults() = 0;
+
+    /**
+     * Check whether the current search has further pages.
+     * @return true if fetchMoreResults() would deliver more results
+     */
+    virtual bool hasMoreResults() const = 0;
+
+    /**
+     * Request the total number of hits of the current search.
+     * 
+     * Counting is done separately from paging so it never delays the
+     * first results. The count is reported via totalHitCountReady.
+     */
+    virtual void requestTotalHitCount() = 0;
+
+    /**
+     * Request snippets and match offsets for hits of the current search.
+     * 
+     * Searches deliver their hits as soon as they are ranked; hits whose
+     * snippet is still empty get it here, typically for the rows the user
+     * can see. The hits are completed via snippetsReady.
+     * 
+     * @param hits Hits of the current search, as delivered
+     */
+    virtual void requestSnippets(const QList<SearchHit>& hits) = 0;
+
 signals:
     /**
      * Emitted when a search operation completes successfully.
      * 
-     * The results are provided as a list of pairs, where each pair contains:
-     * - First element: Document title
-     * - Second element: Highlighted snippet with search terms marked
+     * Only the first page of results is delivered here; see
+     * fetchMoreResults().
      * 
-     * @param results List of (title, snippet) pairs representing search results
+     * @param results Hits of the first page, in rank order
      */
-    void searchCompleted(const QList<QPair<QString, QString>>& results);
+    void searchCompleted(const QList<CodexiumMagnus::Services::SearchHit>& results);
+
+    /**
+     * Emitted when a further page of the current search has been fetched.
+     * 
+     * @param results Hits of the next page, in rank order
+     */
+    void resultsAppended(const QList<CodexiumMagnus::Services::SearchHit>& results);
+
+    /**
+     * Emitted when snippets requested by requestSnippets() are built.
+     * 
+     * @param hits Hits with document id, snippet and match offsets set
+     */
+    void snippetsReady(const QList<CodexiumMagnus::Services::SearchHit>& hits);
+
+    /**
+     * Emitted when the total hit count of the current search is known.
+     * 
+     * @param count Number of documents matching the current search
+     */
+    void totalHitCountReady(int count);
 
     /**
      * Emitted when an error occurs during search operations.
@@ -68,4 +163,6 @@ signals:
 
 } // namespace CodexiumMagnus::Services
 
+Q_DECLARE_METATYPE(CodexiumMagnus::Services::SearchHit)
+
 #endif // ISEARCHSERVICE_H
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <QObject>
 #include <QString>
 #include <QByteArray>
+#include <functional>
 
 namespace CodexiumMagnus::Services {
 
@@ -44,6 +45,23 @@ public:
      */
     virtual TrustLevel verifyCartridge(const QString& cartridgePath) = 0;
 
+    /**
+     * Verify a cartridge signature, abandoning the work once isCancelled
+     * returns true (e.g. because the cartridge is no longer loaded).
+     *
+     * A cancelled verification returns TrustLevel::Unverified and its
+     * result must be discarded. The default implementation cannot be
+     * cancelled and calls verifyCartridge(cartridgePath).
+     *
+     * @param cartridgePath Path to the cartridge file
+     * @param isCancelled Polled while hashing, possibly from several threads
+     * @return TrustLevel classification of the cartridge
+     */
+    virtual TrustLevel verifyCartridge(const QString& cartridgePath, const std::function<bool()>& isCancelled) {
+        Q_UNUSED(isCancelled);
+        return verifyCartridge(cartridgePath);
+    }
+
     /**
      * Verify a signature against a message and public key.
      * 
@@ -96,6 +114,15 @@ signals:
      * @param reason Description of the failure
      */
     void verificationFailed(const QString& cartridgePath, const QString& reason);
+
+    /**
+     * Emitted when a cartridge's trust level changes after verifyCartridge()
+     * returned, e.g. because a background re-verification found it modified.
+     * May be emitted from a worker thread.
+     * @param cartridgePath Path to the cartridge
+     * @param trustLevel The new trust level
+     */
+    void trustLevelChanged(const QString& cartridgePath, TrustLevel trustLevel);
 };
 
 } // namespace CodexiumMagnus::Services
@@ -0,0 +1,161 @@
+#include "MerkleTreeDigest.h"
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+#include <QThreadPool>
+#include <QSemaphore>
+#include <QDebug>
+#include <atomic>
+
+namespace CodexiumMagnus::Services {
+
+namespace {
+const qint64 kDefaultChunkSize = 1024 * 1024;
+const qint64 kMinimumChunkSize = 4096;
+const char kLeafPrefix = '\x00';
+const char kNodePrefix = '\x01';
+
+/**
+ * Hash chunks [begin, end) of a file into leaves[begin..end).
+ * @return false if the file could not be read
+ */
+bool hashChunkRange(const QString& path, qint64 chunkSize, qint64 begin, qint64 end,
+                    QByteArray *leaves, std::atomic<qint64>& bytesHashed, const std::atomic<bool>& failed,
+                    const std::function<bool()>& isCancelled) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Unbuffered) || !file.seek(begin * chunkSize)) {
+        qWarning() << "MerkleTreeDigest: Failed to open" << path << ":" << file.errorString();
+        return false;
+    }
+
+    QByteArray buffer(chunkSize, Qt::Uninitialized);
+    for (qint64 index = begin; index < end; ++index) {
+        if (failed.load(std::memory_order_relaxed) || (isCancelled && isCancelled())) {
+            return false;
+        }
+
+        // Unbuffered reads of a regular file may still return short
+        qint64 filled = 0;
+        while (filled < chunkSize) {
+            const qint64 read = file.read(buffer.data() + filled, chunkSize - filled);
+            if (read < 0) {
+                qWarning() << "MerkleTreeDigest: Failed to read" << path << ":" << file.errorString();
+                return false;
+            }
+            if (read == 0) {
+                break;
+            }
+            filled += read;
+        }
+
+        leaves[index] = MerkleTreeDigest::leafHash(QByteArrayView(buffer.constData(), filled));
+        bytesHashed.fetch_add(filled, std::memory_order_relaxed);
+    }
+    return true;
+}
+}
+
+qint64 MerkleTreeDigest::defaultChunkSize() {
+    return kDefaultChunkSize;
+}
+
+qint64 MerkleTreeDigest::minimumChunkSize() {
+    return kMinimumChunkSize;
+}
+
+qint64 MerkleTreeDigest::chunkCount(qint64 fileSize, qint64 chunkSize) {
+    if (chunkSize <= 0) {
+        return 0;
+    }
+    // An empty file still has one (empty) chunk
+    return qMax<qint64>(1, (fileSize + chunkSize - 1) / chunkSize);
+}
+
+QByteArray MerkleTreeDigest::leafHash(QByteArrayView chunk) {
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(QByteArrayView(&kLeafPrefix, 1));
+    hash.addData(chunk);
+    return hash.result();
+}
+
+QByteArray MerkleTreeDigest::nodeHash(const QByteArray& left, const QByteArray& right) {
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(QByteArrayView(&kNodePrefix, 1));
+    hash.addData(left);
+    hash.addData(right);
+    return hash.result();
+}
+
+QByteArray MerkleTreeDigest::rootHash(const QList<QByteArray>& leaves) {
+    if (leaves.isEmpty()) {
+        return QByteArray();
+    }
+
+    QList<QByteArray> level = leaves;
+    while (level.size() > 1) {
+        QList<QByteArray> parents;
+        parents.reserve((level.size() + 1) / 2);
+        for (qsizetype i = 0; i + 1 < level.size(); i += 2) {
+            parents.append(nodeHash(level[i], level[i + 1]));
+        }
+        if (level.size() % 2 != 0) {
+            parents.append(level.last());
+        }
+        level = parents;
+    }
+    return level.first();
+}
+
+QList<QByteArray> MerkleTreeDigest::chunkHashes(const QString& path, qint64 chunkSize,
+                                                QThreadPool *pool, qint64 *bytesHashed,
+                                                const std::function<bool()>& isCancelled) {
+    if (chunkSize < kMinimumChunkSize) {
+        qWarning() << "MerkleTreeDigest: Chunk size" << chunkSize << "is below the minimum of" << kMinimumChunkSize;
+        return QList<QByteArray>();
+    }
+
+    QFileInfo info(path);
+    if (!info.isFile()) {
+        return QList<QByteArray>();
+    }
+
+    const qint64 count = chunkCount(info.size(), chunkSize);
+    QList<QByteArray> leaves(count);
+    // Tasks write to disjoint elements; take the pointer before any of
+    // them starts so the list is never detached concurrently
+    QByteArray *out = leaves.data();
+    std::atomic<qint64> read(0);
+    std::atomic<bool> failed(false);
+
+    const qint64 tasks = pool ? qMin<qint64>(pool->maxThreadCount(), count) : 1;
+    if (tasks <= 1) {
+        failed = !hashChunkRange(path, chunkSize, 0, count, out, read, failed, isCancelled);
+    } else {
+        // Contiguous ranges keep each task's reads sequential. The pool may
+        // be shared by several passes, so wait for this pass's tasks only.
+        const qint64 chunksPerTask = (count + tasks - 1) / tasks;
+        QSemaphore done;
+        int started = 0;
+        for (qint64 begin = 0; begin < count; begin += chunksPerTask) {
+            const qint64 end = qMin(count, begin + chunksPerTask);
+            pool->start([&path, chunkSize, begin, end, out, &read, &failed, &isCancelled, &done]() {
+                if (!hashChunkRange(path, chunkSize, begin, end, out, read, failed, isCancelled)) {
+                    failed = true;
+                }
+                done.release();
+            });
+            ++started;
+        }
+        done.acquire(started);
+    }
+
+    if (failed) {
+        return QList<QByteArray>();
+    }
+    if (bytesHashed) {
+        *bytesHashed = read;
+    }
+    return leaves;
+}
+
+} // namespace CodexiumMagnus::Services
@@ -0,0 +1,83 @@
+#ifndef MERKLETREEDIGEST_H
+#define MERKLETREEDIGEST_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QList>
+#include <QString>
+#include <functional>
+
+class QThreadPool;
+
+namespace CodexiumMagnus::Services {
+
+/**
+ * SHA-256 Merkle tree over fixed-size chunks of a cartridge file.
+ *
+ * The file is split into chunks of chunkSize bytes (the last one may be
+ * shorter). Each chunk is hashed as a leaf, SHA-256(0x00 || chunk), and
+ * pairs of nodes are combined level by level as SHA-256(0x01 || left ||
+ * right); an unpaired node is carried up to the next level unchanged. The
+ * 0x00/0x01 prefixes keep a leaf from ever being taken for an inner node.
+ * An empty file has a single leaf over the empty chunk.
+ *
+ * Leaves are independent, so chunkHashes() spreads them across a thread
+ * pool; each task reads its own contiguous range of chunks through its own
+ * file handle and buffer. Keeping the leaf hashes also allows verifying a
+ * single chunk later without rehashing the file.
+ *
+ * A pass can be abandoned between chunks through an isCancelled predicate,
+ * so a superseded verification stops within one chunk read.
+ */
+class MerkleTreeDigest {
+public:
+    /**
+     * Chunk size used when the manifest does not name one (1 MiB).
+     */
+    static qint64 defaultChunkSize();
+
+    /**
+     * Smallest accepted chunk size (4 KiB, the default SQLite page size).
+     */
+    static qint64 minimumChunkSize();
+
+    /**
+     * Number of chunks a file of the given size is split into.
+     */
+    static qint64 chunkCount(qint64 fileSize, qint64 chunkSize);
+
+    /**
+     * Leaf hash of one chunk.
+     */
+    static QByteArray leafHash(QByteArrayView chunk);
+
+    /**
+     * Hash of an inner node.
+     */
+    static QByteArray nodeHash(const QByteArray& left, const QByteArray& right);
+
+    /**
+     * Root of the tree over the given leaf hashes.
+     * @return Root hash, or empty QByteArray if there are no leaves
+     */
+    static QByteArray rootHash(const QList<QByteArray>& leaves);
+
+    /**
+     * Leaf hashes of every chunk of a file.
+     * @param path Path to the file
+     * @param chunkSize Chunk size in bytes; at least minimumChunkSize()
+     * @param pool Pool to hash on; null hashes on the calling thread
+     * @param bytesHashed Receives the number of file bytes read; may be null
+     * @param isCancelled Polled before each chunk, from the hashing threads;
+     *                    returning true abandons the pass. May be empty
+     * @return One hash per chunk in file order, or an empty list on error or
+     *         cancellation
+     */
+    static QList<QByteArray> chunkHashes(const QString& path, qint64 chunkSize,
+                                         QThreadPool *pool = nullptr, qint64 *bytesHashed = nullptr,
+                                         const std::function<bool()>& isCancelled = {});
+};
+
+} // namespace CodexiumMagnus::Services
+
+#endif // MERKLETREEDIGEST_H
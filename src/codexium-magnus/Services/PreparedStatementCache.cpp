@@ -0,0 +1,60 @@
+#include "PreparedStatementCache.h"
+#include <QDebug>
+
+namespace CodexiumMagnus::Services {
+
+PreparedStatementCache::PreparedStatementCache()
+    : m_database()
+    , m_statements()
+    , m_lastError()
+{
+}
+
+PreparedStatementCache::PreparedStatementCache(const QSqlDatabase& database)
+    : m_database(database)
+    , m_statements()
+    , m_lastError()
+{
+}
+
+PreparedStatementCache::~PreparedStatementCache() {
+    clear();
+}
+
+QSqlQuery* PreparedStatementCache::statement(const QString& sql) {
+    auto it = m_statements.constFind(sql);
+    if (it != m_statements.constEnd()) {
+        QSqlQuery *query = it.value().get();
+        query->finish();  // Reset a statement the previous user left active
+        return query;
+    }
+
+    if (!m_database.isOpen()) {
+        m_lastError = QSqlError("Database connection not available", QString(),
+                                QSqlError::ConnectionError);
+        return nullptr;
+    }
+
+    auto query = std::make_shared<QSqlQuery>(m_database);
+    // Results are read front to back; avoid caching rows for backward seeks
+    query->setForwardOnly(true);
+    if (!query->prepare(sql)) {
+        m_lastError = query->lastError();
+        qDebug() << "PreparedStatementCache: Failed to prepare statement:" << m_lastError.text();
+        return nullptr;
+    }
+
+    m_statements.insert(sql, query);
+    return query.get();
+}
+
+bool PreparedStatementCache::prepare(const QString& sql) {
+    return statement(sql) != nullptr;
+}
+
+void PreparedStatementCache::clear() {
+    m_statements.clear();
+    m_database = QSqlDatabase();
+}
+
+} // namespace CodexiumMagnus::Services
@@ -0,0 +1,74 @@
+#ifndef PREPAREDSTATEMENTCACHE_H
+#define PREPAREDSTATEMENTCACHE_H
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QString>
+#include <QHash>
+#include <memory>
+
+namespace CodexiumMagnus::Services {
+
+/**
+ * Per-connection registry of prepared statements.
+ *
+ * Each SQL text is prepared once on first request (or up front via
+ * prepare()) and the same QSqlQuery is handed out on every later request,
+ * so hot queries only pay for binding and stepping. Callers bind values,
+ * exec(), read the rows and call finish() to reset the statement.
+ *
+ * A cache belongs to one connection and one thread. It must be cleared
+ * before the connection is closed and removed.
+ */
+class PreparedStatementCache {
+public:
+    PreparedStatementCache();
+    explicit PreparedStatementCache(const QSqlDatabase& database);
+    ~PreparedStatementCache();
+
+    PreparedStatementCache(const PreparedStatementCache&) = delete;
+    PreparedStatementCache& operator=(const PreparedStatementCache&) = delete;
+
+    /**
+     * Get the prepared statement for the given SQL, preparing it on first use.
+     * The statement is reset; positional values bound with addBindValue()
+     * replace those of the previous use.
+     *
+     * @param sql SQL text with positional (?) placeholders
+     * @return Prepared statement, or nullptr if preparation failed
+     *         (see lastError())
+     */
+    QSqlQuery* statement(const QString& sql);
+
+    /**
+     * Prepare a statement ahead of its first use.
+     * @param sql SQL text with positional (?) placeholders
+     * @return true if the statement is prepared
+     */
+    bool prepare(const QString& sql);
+
+    /**
+     * Drop all statements and detach from the connection.
+     */
+    void clear();
+
+    /**
+     * Error of the most recent failed preparation.
+     */
+    QSqlError lastError() const { return m_lastError; }
+
+    /**
+     * Number of prepared statements held.
+     */
+    int size() const { return static_cast<int>(m_statements.size()); }
+
+private:
+    QSqlDatabase m_database;
+    QHash<QString, std::shared_ptr<QSqlQuery>> m_statements;
+    QSqlError m_lastError;
+};
+
+} // namespace CodexiumMagnus::Services
+
+#endif // PREPAREDSTATEMENTCACHE_H
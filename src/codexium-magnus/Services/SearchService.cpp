@@ -1,28 +1,68 @@
 #include "SearchService.h"
 #include "ICartridgeService.h"
 #include "CartridgeService.h"
-#include <QSqlQuery>
-#include <QSqlError>
-#include <QSqlDatabase>
+#include <QMetaObject>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QHash>
 #include <QDebug>
 #include <QRegularExpression>
 
 namespace CodexiumMagnus::Services {
 
+namespace {
+const int kDefaultPageSize = 25;
+const int kDefaultResultCacheCapacity = 10000;  // results
+}
+
 SearchService::SearchService(ICartridgeService *cartridgeService, QObject *parent)
     : ISearchService(parent)
     , m_cartridgeService(cartridgeService)
+    , m_workerThread(nullptr)
+    , m_worker(nullptr)
+    , m_latestGeneration(std::make_shared<std::atomic<quint64>>(0))
+    , m_pageSize(kDefaultPageSize)
+    , m_hasMoreResults(false)
+    , m_pageFetchPending(false)
+    , m_totalHitCount(-1)
+    , m_resultCache(kDefaultResultCacheCapacity)
+    , m_resultCacheHits(0)
+    , m_resultCacheMisses(0)
+    , m_currentCacheKey()
+    , m_currentRequest()
+    , m_cachedPosition(-1)
 {
+    m_workerThread = new QThread(this);
+    m_workerThread->setObjectName("SearchWorker");
+    m_worker = new SearchWorker(m_latestGeneration);
+    m_worker->moveToThread(m_workerThread);
+    connect(m_workerThread, &QThread::finished, m_worker, &QObject::deleteLater);
+    m_workerThread->start();
+
+    if (m_cartridgeService) {
+        connect(m_cartridgeService, &ICartridgeService::cartridgeUnloaded,
+                this, &SearchService::onCartridgeUnloaded);
+    }
 }
 
 SearchService::~SearchService() {
-    // Qt parent system handles cleanup
+    // Abort the running search so the worker thread can finish promptly;
+    // the worker closes its connection when it is deleted
+    supersedeSearches();
+    m_workerThread->quit();
+    m_workerThread->wait();
 }
 
 void SearchService::performSearch(const QString& query,
                                  bool caseSensitive,
                                  bool fuzzy,
                                  bool wildcards) {
+    // A new search always supersedes the previous one, even if it is invalid
+    const quint64 generation = supersedeSearches();
+    m_hasMoreResults = false;
+    m_pageFetchPending = false;
+    m_totalHitCount = -1;
+
     // Validate input
     QString trimmedQuery = query.trimmed();
     if (trimmedQuery.isEmpty()) {
@@ -35,124 +75,397 @@ void SearchService::performSearch(const QString& query,
         return;
     }
 
-    CartridgeService *cartridge = qobject_cast<CartridgeService*>(m_cartridgeService);
-    if (!cartridge) {
-        emit searchError("Invalid cartridge service");
+    // Build FTS5 query
+    QString ftsQuery = buildFtsQuery(trimmedQuery, caseSensitive, fuzzy, wildcards);
+    
+    if (ftsQuery.isEmpty()) {
+        emit searchError("Invalid search query");
         return;
     }
 
-    QSqlDatabase *database = cartridge->getDatabase();
-    if (!database || !database->isOpen()) {
-        emit searchError("Database connection not available");
+    SearchRequest request;
+    request.generation = generation;
+    request.query = trimmedQuery;
+    request.ftsQuery = ftsQuery;
+    request.caseSensitive = caseSensitive;
+    if (fuzzy && !wildcards) {
+        // Approximate matching has no exact case to verify
+        request.fuzzyTerms = fuzzyTerms(trimmedQuery);
+    } else if (caseSensitive) {
+        request.caseSensitivePatterns = caseSensitivePatterns(trimmedQuery, wildcards);
+    }
+    dispatchSearch(request, QString("search:c%1f%2w%3")
+        .arg(caseSensitive ? 1 : 0).arg(fuzzy ? 1 : 0).arg(wildcards ? 1 : 0));
+}
+
+void SearchService::performIncrementalSearch(const QString& query, bool caseSensitive) {
+    const quint64 generation = supersedeSearches();
+    m_hasMoreResults = false;
+    m_pageFetchPending = false;
+    m_totalHitCount = -1;
+
+    QString trimmedQuery = query.trimmed();
+    if (trimmedQuery.isEmpty()) {
+        emit searchError("Search query is empty");
         return;
     }
 
-    QList<QPair<QString, QString>> results;
-    
-    // Build FTS5 query
-    QString ftsQuery = buildFtsQuery(trimmedQuery, caseSensitive, fuzzy, wildcards);
-    
-    if (ftsQuery.isEmpty()) {
-        emit searchError("Invalid search query");
+    if (!m_cartridgeService || !m_cartridgeService->isCartridgeLoaded()) {
+        emit searchError("No cartridge loaded");
         return;
     }
-    
-    // Execute FTS5 search
-    // Assuming FTS5 table named "content_fts" with columns: rowid, title, content, document_id
-    // The actual schema may vary - adjust column names as needed
-    QString sql = QString(R"(
-        SELECT 
-            snippet(content_fts, 2, '<mark>', '</mark>', '...', 32) as snippet,
-            title,
-            document_id
-        FROM content_fts
-        WHERE content_fts MATCH ?
-        ORDER BY rank
-        LIMIT 100
-    )");
-    
-    QSqlQuery sqlQuery(*database);
-    sqlQuery.prepare(sql);
-    sqlQuery.addBindValue(ftsQuery);
-    
-    if (sqlQuery.exec()) {
-        int resultCount = 0;
-        while (sqlQuery.next()) {
-            QString title = sqlQuery.value("title").toString();
-            QString snippet = sqlQuery.value("snippet").toString();
-            QString documentId = sqlQuery.value("document_id").toString();
-            
-            // Clean up snippet HTML if needed
-            if (snippet.isEmpty()) {
-                snippet = title; // Use title as fallback if no snippet
-            }
-            
-            results.append(qMakePair(title, snippet));
-            resultCount++;
+
+    SearchRequest request;
+    request.generation = generation;
+    request.query = trimmedQuery;
+    request.prefixTerms = trimmedQuery.toLower().split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
+    request.ftsQuery = buildPrefixQuery(request.prefixTerms);
+    request.caseSensitive = caseSensitive;
+    if (caseSensitive) {
+        request.caseSensitivePatterns = CaseSensitiveFilter::incrementalPatterns(
+            trimmedQuery.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts));
+    }
+    dispatchSearch(request, QString("incremental:c%1").arg(caseSensitive ? 1 : 0));
+}
+
+void SearchService::cancelSearch() {
+    supersedeSearches();
+    m_hasMoreResults = false;
+    m_pageFetchPending = false;
+    m_totalHitCount = -1;
+    m_currentCacheKey.clear();
+    m_cachedPosition = -1;
+}
+
+void SearchService::dispatchSearch(SearchRequest request, const QString& mode) {
+    request.cartridgePath = m_cartridgeService->getCartridgePath();
+    request.pageSize = m_pageSize;
+    if (CartridgeService *cartridge = qobject_cast<CartridgeService*>(m_cartridgeService)) {
+        request.profile = cartridge->openProfile(request.cartridgePath);
+    }
+
+    m_currentRequest = request;
+    m_currentCacheKey = resultCacheKey(request, mode);
+    m_cachedPosition = -1;
+    if (const CachedSearch *cached = m_resultCache.object(m_currentCacheKey)) {
+        ++m_resultCacheHits;
+        serveFromCache(*cached, request.generation);
+        return;
+    }
+    ++m_resultCacheMisses;
+
+    SearchWorker *worker = m_worker;
+    QMetaObject::invokeMethod(worker, [this, worker, request]() {
+        SearchOutcome outcome = worker->run(request);
+        QMetaObject::invokeMethod(this, [this, generation = request.generation, outcome]() {
+            onSearchFinished(generation, outcome);
+        }, Qt::QueuedConnection);
+
+        if (outcome.succeeded && !request.prefixTerms.isEmpty()) {
+            // Runs after the first page is delivered; skipped if the user
+            // has typed on in the meantime
+            worker->collectNarrowingCandidates(request.generation);
         }
-        
-        qDebug() << "Search completed:" << resultCount << "results found for query:" << trimmedQuery;
-        emit searchCompleted(results);
+    }, Qt::QueuedConnection);
+}
+
+QString SearchService::resultCacheKey(const SearchRequest& request, const QString& mode) const {
+    // Hashing the cartridge for every search would cost more than the
+    // search; path, size and modification time identify its content
+    QFileInfo fileInfo(request.cartridgePath);
+    const QString identity = QString("%1|%2|%3")
+        .arg(fileInfo.absoluteFilePath())
+        .arg(fileInfo.size())
+        .arg(fileInfo.lastModified().toMSecsSinceEpoch());
+
+    // Whitespace between FTS5 tokens is insignificant
+    QString key = identity + '\n' + mode + '\n' + request.ftsQuery.simplified();
+
+    // The FTS5 query is case-folded; case-sensitive hits also depend on the
+    // exact-case patterns they were filtered with
+    if (request.caseSensitive) {
+        key += '\n' + request.caseSensitivePatterns.join('\n');
+    }
+    return key;
+}
+
+void SearchService::serveFromCache(const CachedSearch& cached, quint64 generation) {
+    const QList<SearchHit> page = cached.results.mid(0, m_pageSize);
+    m_cachedPosition = page.size();
+    m_hasMoreResults = m_cachedPosition < cached.results.size() || !cached.complete;
+    m_totalHitCount = cached.complete ? cached.results.size() : cached.totalHits;
+
+    // Delivered from the event loop like worker results, so callers see the
+    // same order of calls and signals either way
+    QMetaObject::invokeMethod(this, [this, generation, page]() {
+        if (generation == m_latestGeneration->load()) {
+            emit searchCompleted(page);
+        }
+    }, Qt::QueuedConnection);
+}
+
+void SearchService::resumeOnWorker() {
+    SearchRequest request = m_currentRequest;
+    request.offset = m_cachedPosition;
+    request.pageSize = 0;
+    m_cachedPosition = -1;
+
+    // Queued ahead of the page fetch or count that needs the cursor
+    SearchWorker *worker = m_worker;
+    QMetaObject::invokeMethod(worker, [this, worker, request]() {
+        SearchOutcome outcome = worker->run(request);
+        if (!outcome.succeeded && !outcome.cancelled) {
+            QMetaObject::invokeMethod(this, [this, generation = request.generation, outcome]() {
+                if (generation == m_latestGeneration->load()) {
+                    emit searchError(outcome.errorMessage);
+                }
+            }, Qt::QueuedConnection);
+        }
+    }, Qt::QueuedConnection);
+}
+
+void SearchService::appendToCachedSearch(const QList<SearchHit>& results, bool complete) {
+    // Pages are only added to an entry that holds all pages before them
+    CachedSearch *cached = m_resultCache.take(m_currentCacheKey);
+    if (!cached) {
+        return;
+    }
+    cached->results += results;
+    cached->complete = complete;
+    m_resultCache.insert(m_currentCacheKey, cached, cached->results.size() + 1);
+}
+
+void SearchService::setResultCacheCapacity(int results) {
+    m_resultCache.setMaxCost(qMax(0, results));
+}
+
+void SearchService::fetchMoreResults() {
+    if (!m_hasMoreResults || m_pageFetchPending) {
+        return;
+    }
+    m_pageFetchPending = true;
+
+    if (m_cachedPosition >= 0) {
+        const CachedSearch *cached = m_resultCache.object(m_currentCacheKey);
+        if (cached && m_cachedPosition < cached->results.size()) {
+            const QList<SearchHit> page = cached->results.mid(m_cachedPosition, m_pageSize);
+            m_cachedPosition += page.size();
+            const bool hasMore = m_cachedPosition < cached->results.size() || !cached->complete;
+            const quint64 generation = m_latestGeneration->load();
+            QMetaObject::invokeMethod(this, [this, generation, page, hasMore]() {
+                if (generation != m_latestGeneration->load()) {
+                    return;
+                }
+                m_pageFetchPending = false;
+                m_hasMoreResults = hasMore;
+                emit resultsAppended(page);
+            }, Qt::QueuedConnection);
+            return;
+        }
+        // The cursor continues after the cached results
+        resumeOnWorker();
+    }
+
+    const quint64 generation = m_latestGeneration->load();
+    const int pageSize = m_pageSize;
+    SearchWorker *worker = m_worker;
+    QMetaObject::invokeMethod(worker, [this, worker, generation, pageSize]() {
+        SearchOutcome outcome = worker->fetchPage(generation, pageSize);
+        QMetaObject::invokeMethod(this, [this, generation, outcome]() {
+            onPageFetched(generation, outcome);
+        }, Qt::QueuedConnection);
+    }, Qt::QueuedConnection);
+}
+
+void SearchService::requestTotalHitCount() {
+    if (m_totalHitCount >= 0) {
+        emit totalHitCountReady(m_totalHitCount);
+        return;
+    }
+
+    if (m_cachedPosition >= 0) {
+        // The worker needs the search open to count it
+        resumeOnWorker();
+    }
+
+    const quint64 generation = m_latestGeneration->load();
+    SearchWorker *worker = m_worker;
+    QMetaObject::invokeMethod(worker, [this, worker, generation]() {
+        SearchOutcome outcome = worker->countHits(generation);
+        QMetaObject::invokeMethod(this, [this, generation, outcome]() {
+            onHitCountFinished(generation, outcome);
+        }, Qt::QueuedConnection);
+    }, Qt::QueuedConnection);
+}
+
+void SearchService::requestSnippets(const QList<SearchHit>& hits) {
+    if (m_currentCacheKey.isEmpty()) {
+        return;
+    }
+
+    // Snippets are looked up by FTS5 rowid; fallback hits have theirs already
+    QList<qint64> rowids;
+    for (const SearchHit& hit : hits) {
+        if (hit.rowid > 0) {
+            rowids.append(hit.rowid);
+        }
+    }
+    if (rowids.isEmpty()) {
+        return;
+    }
+
+    // Carries the whole request: a search served from the cache has no
+    // cursor on the worker
+    const SearchRequest request = m_currentRequest;
+    SearchWorker *worker = m_worker;
+    QMetaObject::invokeMethod(worker, [this, worker, request, rowids]() {
+        SearchOutcome outcome = worker->buildSnippets(request, rowids);
+        QMetaObject::invokeMethod(this, [this, generation = request.generation, outcome]() {
+            onSnippetsBuilt(generation, outcome);
+        }, Qt::QueuedConnection);
+    }, Qt::QueuedConnection);
+}
+
+void SearchService::setPageSize(int pageSize) {
+    m_pageSize = qMax(1, pageSize);
+}
+
+quint64 SearchService::supersedeSearches() {
+    // The worker's progress handler sees the new value and interrupts
+    return m_latestGeneration->fetch_add(1) + 1;
+}
+
+void SearchService::onSearchFinished(quint64 generation, const SearchOutcome& outcome) {
+    if (generation != m_latestGeneration->load() || outcome.cancelled) {
+        return;
+    }
+
+    if (outcome.succeeded) {
+        m_hasMoreResults = outcome.hasMore;
+        if (!outcome.hasMore) {
+            // Everything fits in the first page, so the count is known
+            m_totalHitCount = outcome.results.size();
+        }
+
+        CachedSearch *cached = new CachedSearch;
+        cached->results = outcome.results;
+        cached->complete = !outcome.hasMore;
+        m_resultCache.insert(m_currentCacheKey, cached, cached->results.size() + 1);
+
+        emit searchCompleted(outcome.results);
     } else {
-        QString error = sqlQuery.lastError().text();
-        qWarning() << "FTS5 search error:" << error;
-        
-        // If FTS5 table doesn't exist, try fallback search on regular tables
-        if (error.contains("no such table", Qt::CaseInsensitive) || 
-            error.contains("content_fts", Qt::CaseInsensitive)) {
-            qDebug() << "FTS5 table not found, falling back to LIKE search";
-            performFallbackSearch(*database, trimmedQuery, caseSensitive, results);
-        } else {
-            emit searchError(QString("Search failed: %1").arg(error));
+        emit searchError(outcome.errorMessage);
+    }
+}
+
+void SearchService::onPageFetched(quint64 generation, const SearchOutcome& outcome) {
+    if (generation != m_latestGeneration->load() || outcome.cancelled) {
+        return;
+    }
+
+    m_pageFetchPending = false;
+    m_hasMoreResults = outcome.succeeded && outcome.hasMore;
+
+    if (outcome.succeeded) {
+        appendToCachedSearch(outcome.results, !outcome.hasMore);
+        if (!outcome.results.isEmpty()) {
+            emit resultsAppended(outcome.results);
         }
+    } else {
+        emit searchError(outcome.errorMessage);
     }
 }
 
-void SearchService::performFallbackSearch(QSqlDatabase& database, 
-                                         const QString& query,
-                                         bool caseSensitive,
-                                         QList<QPair<QString, QString>>& results) {
-    // Fallback search using LIKE when FTS5 is not available
-    QString sql = QString(R"(
-        SELECT 
-            id,
-            title,
-            substr(content, 1, 200) as snippet
-        FROM documents
-        WHERE title LIKE ? OR content LIKE ?
-        LIMIT 100
-    )");
-    
-    QString searchPattern = caseSensitive ? 
-        QString("%%1%").arg(query) : 
-        QString("%%1%").arg(query.toLower());
-    
-    QSqlQuery sqlQuery(database);
-    sqlQuery.prepare(sql);
-    sqlQuery.addBindValue(searchPattern);
-    sqlQuery.addBindValue(searchPattern);
-    
-    if (sqlQuery.exec()) {
-        int resultCount = 0;
-        while (sqlQuery.next()) {
-            QString title = sqlQuery.value("title").toString();
-            QString snippet = sqlQuery.value("snippet").toString();
-            
-            if (snippet.isEmpty()) {
-                snippet = title; // Use title as fallback
-            }
-            
-            results.append(qMakePair(title, snippet));
-            resultCount++;
+void SearchService::onHitCountFinished(quint64 generation, const SearchOutcome& outcome) {
+    if (generation != m_latestGeneration->load() || outcome.cancelled) {
+        return;
+    }
+
+    if (outcome.succeeded) {
+        m_totalHitCount = outcome.totalHits;
+        if (CachedSearch *cached = m_resultCache.object(m_currentCacheKey)) {
+            cached->totalHits = m_totalHitCount;
         }
-        
-        qDebug() << "Fallback search completed:" << resultCount << "results found";
-        emit searchCompleted(results);
+        emit totalHitCountReady(m_totalHitCount);
     } else {
-        QString error = sqlQuery.lastError().text();
-        qWarning() << "Fallback search error:" << error;
-        emit searchError(QString("Fallback search failed: %1").arg(error));
+        emit searchError(outcome.errorMessage);
+    }
+}
+
+void SearchService::onSnippetsBuilt(quint64 generation, const SearchOutcome& outcome) {
+    if (generation != m_latestGeneration->load() || outcome.cancelled) {
+        return;
+    }
+
+    if (!outcome.succeeded) {
+        emit searchError(outcome.errorMessage);
+        return;
+    }
+
+    // Cached hits keep their snippets, so a repeated search shows them at once
+    if (CachedSearch *cached = m_resultCache.object(m_currentCacheKey)) {
+        QHash<qint64, const SearchHit*> built;
+        for (const SearchHit& hit : outcome.results) {
+            built.insert(hit.rowid, &hit);
+        }
+        for (SearchHit& hit : cached->results) {
+            if (const SearchHit *snippet = built.value(hit.rowid)) {
+                hit.snippet = snippet->snippet;
+                hit.matchOffsets = snippet->matchOffsets;
+            }
+        }
     }
+
+    emit snippetsReady(outcome.results);
+}
+
+void SearchService::onCartridgeUnloaded() {
+    supersedeSearches();
+    m_hasMoreResults = false;
+    m_pageFetchPending = false;
+    m_totalHitCount = -1;
+    m_currentCacheKey.clear();
+    m_cachedPosition = -1;
+    m_resultCache.clear();
+
+    SearchWorker *worker = m_worker;
+    QMetaObject::invokeMethod(worker, [worker]() {
+        worker->close();
+    }, Qt::QueuedConnection);
+}
+
+QStringList SearchService::fuzzyTerms(const QString& query) {
+    // FTS5 operators and punctuation carry no meaning in fuzzy mode
+    QString cleaned = query.toLower();
+    cleaned.replace(QRegularExpression("[\"*^():]"), " ");
+    return cleaned.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
+}
+
+QString SearchService::buildPrefixQuery(const QStringList& terms) {
+    // Every term is quoted so FTS5 operators typed by the user are taken
+    // literally; the last term is still being typed and matches as a prefix
+    // (served from the FTS5 prefix index when the cartridge has one)
+    QStringList quoted;
+    for (const QString& term : terms) {
+        QString escaped = term;
+        escaped.remove(QRegularExpression("[\\x00-\\x1F]"));
+        escaped.replace("\"", "\"\"");
+        if (!escaped.isEmpty()) {
+            quoted << "\"" + escaped + "\"";
+        }
+    }
+    if (quoted.isEmpty()) {
+        return QString();
+    }
+
+    quoted.last() += "*";
+    return quoted.join(" ");
+}
+
+QStringList SearchService::caseSensitivePatterns(const QString& query, bool wildcards) {
+    return wildcards ?
+        CaseSensitiveFilter::prefixPatterns(query.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts)) :
+        CaseSensitiveFilter::phrasePatterns(query.trimmed());
 }
 
 QString SearchService::buildFtsQuery(const QString& query, 
@@ -191,31 +504,22 @@ QString SearchService::buildFtsQuery(const QString& query,
         }
         ftsQuery = terms.join(" ");
     } else if (fuzzy) {
-        // FTS5 doesn't have built-in fuzzy search, but we can use NEAR operator
-        // For true fuzzy, we'd need to implement Levenshtein distance
-        // For now, use NEAR for multi-word queries to find terms near each other
-        QStringList terms = ftsQuery.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
+        // The worker expands each term to its close vocabulary terms; this
+        // exact-term query is only used if no vocabulary is available
+        QStringList terms = fuzzyTerms(query);
         if (terms.isEmpty()) {
             return QString();
         }
-        
-        if (terms.size() > 1) {
-            // Use NEAR for multi-word queries (terms within 10 words of each other)
-            ftsQuery = terms.join(" NEAR/10 ");
-        } else {
-            // Single word - use as-is (FTS5 will find similar)
-            ftsQuery = terms.first();
-        }
+        return buildPrefixQuery(terms).chopped(1);
     } else {
-        // Phrase search for exact matches
-        ftsQuery = "\"" + ftsQuery + "\"";
+        // Phrase search for exact matches. FTS5 folds case anyway, so a
+        // lowercased phrase lets "Navy" and "navy" share a cached result.
+        ftsQuery = "\"" + (caseSensitive ? ftsQuery : ftsQuery.toLower()) + "\"";
     }
     
-    // Case sensitivity: FTS5 is case-insensitive by default
-    // If case-sensitive is required, we'd need to use a case-sensitive FTS5 table
-    // For now, we'll rely on FTS5's default case-insensitive behavior
-    // Note: The caseSensitive parameter is kept for API compatibility but
-    // FTS5 case sensitivity is determined at table creation time
+    // FTS5 folds case at indexing time, so this query finds the
+    // case-insensitive superset; case-sensitive searches verify its hits
+    // against request.caseSensitivePatterns on the worker
     
     return ftsQuery;
 }
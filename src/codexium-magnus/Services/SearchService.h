@@ -2,8 +2,12 @@
 #define SEARCHSERVICE_H
 
 #include "ISearchService.h"
-#include <QSqlDatabase>
+#include "SearchWorker.h"
 #include <QString>
+#include <QThread>
+#include <QCache>
+#include <atomic>
+#include <memory>
 
 namespace CodexiumMagnus::Services {
 
@@ -17,7 +21,24 @@ class ICartridgeService;
  * 
  * The service performs searches on loaded cartridge content and returns
  * results with titles and highlighted snippets. Supports boolean, phrase,
- * fuzzy, and wildcard search modes.
+ * fuzzy (edit-distance term expansion), and wildcard search modes.
+ * 
+ * Queries run on a dedicated worker thread with its own read-only
+ * connection to the cartridge. Each call to performSearch() supersedes the
+ * previous one: an in-flight search is cancelled and only the newest
+ * search's results or error are emitted.
+ * 
+ * FTS5 searches are two-phase: pages are ranked without snippets, which
+ * keeps the time to the first results low for broad queries, and snippets
+ * with match offsets are built on the worker only for the hits passed to
+ * requestSnippets(). Case-sensitive and fallback searches read the content
+ * anyway and deliver complete hits.
+ * 
+ * Results are cached per cartridge, keyed by the normalized FTS5 query and
+ * the search mode. A repeated search is answered from the cache without
+ * touching the worker; the worker only re-runs the query, skipping the
+ * cached results, once the user pages beyond them or the total count is
+ * still unknown. The cache is cleared when the cartridge is unloaded.
  */
 class SearchService : public ISearchService {
     Q_OBJECT
@@ -41,10 +62,11 @@ public:
      * 
      * Executes a search query using SQLite FTS5 with the specified options.
      * Results are returned asynchronously via the searchCompleted signal.
+     * Input validation errors are reported immediately via searchError.
      * 
      * @param query The search query string
      * @param caseSensitive If true, perform case-sensitive search (default: false)
-     * @param fuzzy If true, use fuzzy matching via FTS5 NEAR operator (default: false)
+     * @param fuzzy If true, match terms within a small edit distance (default: false)
      * @param wildcards If true, enable wildcard matching (default: false)
      */
     void performSearch(const QString& query,
@@ -52,7 +74,34 @@ public:
                       bool fuzzy = false,
                       bool wildcards = false) override;
 
-private:
+    void performIncrementalSearch(const QString& query, bool caseSensitive = false) override;
+    void cancelSearch() override;
+    void fetchMoreResults() override;
+    bool hasMoreResults() const override { return m_hasMoreResults; }
+    void requestTotalHitCount() override;
+    void requestSnippets(const QList<SearchHit>& hits) override;
+
+    /**
+     * Set the number of results per page (default: 25).
+     * Takes effect with the next search or page.
+     * @param pageSize Number of results per page
+     */
+    void setPageSize(int pageSize);
+    int pageSize() const { return m_pageSize; }
+
+    /**
+     * Set the capacity of the result cache in results (default: 10000).
+     * Each search costs the number of results read so far plus one.
+     * @param results Maximum number of cached results
+     */
+    void setResultCacheCapacity(int results);
+    int resultCacheCapacity() const { return static_cast<int>(m_resultCache.maxCost()); }
+
+    // Result cache statistics (cumulative since construction)
+    quint64 resultCacheHits() const { return m_resultCacheHits; }
+    quint64 resultCacheMisses() const { return m_resultCacheMisses; }
+    int resultCacheEntries() const { return static_cast<int>(m_resultCache.count()); }
+
     /**
      * Build an FTS5 query string from user input.
      * 
@@ -65,29 +114,123 @@ private:
      * @param wildcards Whether to enable wildcard matching
      * @return Formatted FTS5 query string
      */
-    QString buildFtsQuery(const QString& query, 
-                         bool caseSensitive, 
-                         bool fuzzy, 
-                         bool wildcards);
+    static QString buildFtsQuery(const QString& query, 
+                                 bool caseSensitive, 
+                                 bool fuzzy, 
+                                 bool wildcards);
 
     /**
-     * Perform a fallback search using LIKE when FTS5 is not available.
+     * Build the CaseSensitiveFilter patterns that the hits of a
+     * case-sensitive search are verified against.
      * 
-     * This method is called when the FTS5 table doesn't exist or is
-     * unavailable. It performs a simple LIKE-based search on the documents
-     * table as a fallback.
+     * @param query The user's search query
+     * @param wildcards Whether terms are matched as prefixes
+     * @return Patterns for CaseSensitiveFilter::setPatterns()
+     */
+    static QStringList caseSensitivePatterns(const QString& query, bool wildcards);
+
+private:
+    /**
+     * Split a fuzzy query into lowercased terms for expansion.
+     */
+    static QStringList fuzzyTerms(const QString& query);
+
+    /**
+     * Build an FTS5 query for an incremental search: quoted terms, the last
+     * one as a prefix.
      * 
-     * @param database The database connection to use
-     * @param query The search query
-     * @param caseSensitive Whether the search should be case-sensitive
-     * @param results Output parameter for search results
+     * @param terms Lowercased query terms
+     * @return FTS5 query string, or empty string if no term is left
+     */
+    static QString buildPrefixQuery(const QStringList& terms);
+
+    /**
+     * Results of a search as far as they have been read.
+     */
+    struct CachedSearch {
+        QList<SearchHit> results;
+        bool complete = false;     ///< results holds every hit
+        int totalHits = -1;        ///< -1 until counted
+    };
+
+    /**
+     * Fill in the cartridge-specific parts of a request and answer it from
+     * the result cache, or run it on the worker.
+     * @param request Search to run
+     * @param mode Search mode flags, part of the cache key
+     */
+    void dispatchSearch(SearchRequest request, const QString& mode);
+
+    /**
+     * Build the result cache key of a search: cartridge identity, mode and
+     * normalized FTS5 query.
+     */
+    QString resultCacheKey(const SearchRequest& request, const QString& mode) const;
+
+    /**
+     * Deliver the first page of the current search from its cache entry.
+     */
+    void serveFromCache(const CachedSearch& cached, quint64 generation);
+
+    /**
+     * Re-run the current search on the worker, positioned after the
+     * results already delivered from the cache.
+     */
+    void resumeOnWorker();
+
+    /**
+     * Add a page read by the worker to the cache entry of the current search.
+     */
+    void appendToCachedSearch(const QList<SearchHit>& results, bool complete);
+
+    /**
+     * Cancel any in-flight search.
+     * @return Generation token for the next search
+     */
+    quint64 supersedeSearches();
+
+    /**
+     * Deliver the outcome of a worker search on the GUI thread.
+     * Outcomes of superseded searches are dropped.
+     */
+    void onSearchFinished(quint64 generation, const SearchOutcome& outcome);
+
+    /**
+     * Deliver a further page of the current search on the GUI thread.
+     */
+    void onPageFetched(quint64 generation, const SearchOutcome& outcome);
+
+    /**
+     * Deliver the total hit count of the current search on the GUI thread.
+     */
+    void onHitCountFinished(quint64 generation, const SearchOutcome& outcome);
+
+    /**
+     * Deliver snippets built for the current search on the GUI thread and
+     * add them to its cache entry.
+     */
+    void onSnippetsBuilt(quint64 generation, const SearchOutcome& outcome);
+
+    /**
+     * Cancel searches and close the worker connection when the cartridge
+     * is unloaded.
      */
-    void performFallbackSearch(QSqlDatabase& database, 
-                               const QString& query,
-                               bool caseSensitive,
-                               QList<QPair<QString, QString>>& results);
+    void onCartridgeUnloaded();
 
     ICartridgeService *m_cartridgeService;  ///< Reference to cartridge service for database access
+    QThread *m_workerThread;                ///< Runs all search queries
+    SearchWorker *m_worker;                 ///< Lives in m_workerThread; deleted when it finishes
+    std::shared_ptr<std::atomic<quint64>> m_latestGeneration;  ///< Generation of the newest search, shared with m_worker
+    int m_pageSize;
+    bool m_hasMoreResults;     ///< Current search has unread pages
+    bool m_pageFetchPending;   ///< A fetchMoreResults() request is in flight
+    int m_totalHitCount;       ///< Total hits of the current search, -1 until counted
+    QCache<QString, CachedSearch> m_resultCache;  ///< Cache key -> results, cost in results
+    quint64 m_resultCacheHits;
+    quint64 m_resultCacheMisses;
+    QString m_currentCacheKey;        ///< Cache key of the current search
+    SearchRequest m_currentRequest;   ///< Current search, for resuming it on the worker
+    int m_cachedPosition;             ///< Results of the current search delivered from the cache; -1 once the worker serves it
 };
 
 } // namespace CodexiumMagnus::Services
@@ -0,0 +1,860 @@
+#include "SearchWorker.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QSqlDriver>
+#include <QThread>
+#include <QDebug>
+#include <algorithm>
+
+#ifdef HAVE_SQLITE3_API
+#include <sqlite3.h>
+#endif
+
+namespace CodexiumMagnus::Services {
+
+namespace {
+// Number of SQLite virtual machine instructions between cancellation checks
+const int kProgressHandlerInterval = 1000;
+
+// Assuming FTS5 table named "content_fts" with columns: rowid, title, content, document_id
+// The actual schema may vary - adjust column names as needed
+// Pages are read rank-only; snippets are built by kFtsSnippetsSql for the
+// hits that are actually shown
+const QString kFtsSql = QString(R"(
+    SELECT 
+        rowid,
+        title,
+        document_id,
+        rank
+    FROM content_fts
+    WHERE content_fts MATCH ?
+    ORDER BY rank
+)");
+
+const QString kFtsCountSql = "SELECT count(*) FROM content_fts WHERE content_fts MATCH ?";
+
+// Incremental search restricted to the hits of the query it narrows. The
+// IN subquery is materialized once when the statement starts, so the
+// candidates table can be refilled while this cursor is still open.
+const QString kFtsNarrowedSql = QString(R"(
+    SELECT 
+        rowid,
+        title,
+        document_id,
+        rank
+    FROM content_fts
+    WHERE content_fts MATCH ?
+      AND rowid IN (SELECT doc_rowid FROM temp.search_candidates)
+    ORDER BY rank
+)");
+
+// Hits snippets are built for per statement; shorter batches repeat
+// their last rowid so a single prepared statement serves every batch
+const int kSnippetBatchSize = 16;
+
+// Snippets and match offsets of given hits. highlight() brackets every match
+// in the full content with control characters, from which the match offsets
+// in the plain text are taken. Hits are selected by rowid, which FTS5 looks
+// up directly; document_id is UNINDEXED and would be compared row by row.
+const QString kFtsSnippetsSql = QString(R"(
+    SELECT 
+        rowid,
+        document_id,
+        title,
+        snippet(content_fts, 2, '<mark>', '</mark>', '...', 32) as snippet,
+        highlight(content_fts, 2, char(2), char(3)) as highlighted
+    FROM content_fts
+    WHERE content_fts MATCH ?
+      AND rowid IN (%1)
+)").arg(QStringList(kSnippetBatchSize, "?").join(", "));
+
+// Case-sensitive searches rank candidates with FTS5 and verify them against
+// the stored content, so no FTS5 snippet is generated
+const QString kFtsCandidatesSql = QString(R"(
+    SELECT 
+        rowid,
+        title,
+        document_id,
+        content,
+        rank
+    FROM content_fts
+    WHERE content_fts MATCH ?
+    ORDER BY rank
+)");
+
+const QString kFtsNarrowedCandidatesSql = QString(R"(
+    SELECT 
+        rowid,
+        title,
+        document_id,
+        content,
+        rank
+    FROM content_fts
+    WHERE content_fts MATCH ?
+      AND rowid IN (SELECT doc_rowid FROM temp.search_candidates)
+    ORDER BY rank
+)");
+
+const QString kFtsCandidatesCountSql = "SELECT title, content FROM content_fts WHERE content_fts MATCH ?";
+
+// Candidates read from the cursor and verified at a time
+const int kCandidateBatchSize = 256;
+
+// Below this many candidates per thread, verifying in parallel does not pay off
+const int kMinCandidatesPerThread = 32;
+
+const QString kCollectCandidatesSql =
+    "INSERT INTO temp.search_candidates (doc_rowid) SELECT rowid FROM content_fts WHERE content_fts MATCH ? LIMIT ?";
+
+// Beyond this many hits a query is too broad for narrowing to pay off
+const int kMaxNarrowingCandidates = 2000;
+
+// Fallback search using LIKE when FTS5 is not available. LIKE folds ASCII
+// case on both sides, so the pattern is bound as typed.
+const QString kFallbackSql = QString(R"(
+    SELECT 
+        id as document_id,
+        title,
+        substr(content, 1, 200) as snippet,
+        content
+    FROM documents
+    WHERE title LIKE ? ESCAPE '\' OR content LIKE ? ESCAPE '\'
+)");
+
+const QString kFallbackCountSql =
+    "SELECT count(*) FROM documents WHERE title LIKE ? ESCAPE '\\' OR content LIKE ? ESCAPE '\\'";
+
+// instr() compares exactly, for the case-sensitive fallback
+const QString kFallbackCaseSensitiveSql = QString(R"(
+    SELECT 
+        id as document_id,
+        title,
+        substr(content, 1, 200) as snippet,
+        content
+    FROM documents
+    WHERE instr(title, ?) > 0 OR instr(content, ?) > 0
+)");
+
+const QString kFallbackCaseSensitiveCountSql =
+    "SELECT count(*) FROM documents WHERE instr(title, ?) > 0 OR instr(content, ?) > 0";
+
+const QChar kMatchStart(0x02);
+const QChar kMatchEnd(0x03);
+
+/**
+ * Match offsets in the plain text of content marked up by highlight().
+ */
+QList<QPair<int, int>> highlightedOffsets(const QString& highlighted) {
+    QList<QPair<int, int>> offsets;
+    const QString text = CaseSensitiveFilter::plainText(highlighted);
+    int position = 0;
+    int start = -1;
+    for (const QChar character : text) {
+        if (character == kMatchStart) {
+            start = position;
+        } else if (character == kMatchEnd) {
+            if (start >= 0 && position > start) {
+                offsets.append(qMakePair(start, position - start));
+            }
+            start = -1;
+        } else {
+            ++position;
+        }
+    }
+    return offsets;
+}
+
+/**
+ * Match offsets of the LIKE fallback: occurrences of the whole query.
+ */
+QList<QPair<int, int>> fallbackOffsets(const QString& content, const QString& query, bool caseSensitive) {
+    QList<QPair<int, int>> offsets;
+    if (query.isEmpty()) {
+        return offsets;
+    }
+    const QString text = CaseSensitiveFilter::plainText(content);
+    const Qt::CaseSensitivity sensitivity = caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive;
+    for (qsizetype index = text.indexOf(query, 0, sensitivity); index >= 0;
+         index = text.indexOf(query, index + query.size(), sensitivity)) {
+        offsets.append(qMakePair(static_cast<int>(index), static_cast<int>(query.size())));
+    }
+    return offsets;
+}
+
+}
+
+SearchWorker::SearchWorker(std::shared_ptr<std::atomic<quint64>> latestGeneration, QObject *parent)
+    : QObject(parent)
+    , m_latestGeneration(std::move(latestGeneration))
+    , m_activeGeneration(0)
+    , m_request()
+    , m_cursor(nullptr)
+    , m_cursorHasRow(false)
+    , m_cursorUsesFallback(false)
+    , m_caseFilter()
+    , m_verifiedResults()
+    , m_verifyPool(nullptr)
+    , m_candidateTerms()
+    , m_fuzzyIndex()
+    , m_fuzzyIndexBuilt(false)
+    , m_connectionName(QString("search_%1").arg(reinterpret_cast<quintptr>(this)))
+    , m_cartridgePath()
+    , m_database()
+    , m_statements(std::make_unique<PreparedStatementCache>())
+{
+}
+
+SearchWorker::~SearchWorker() {
+    close();
+}
+
+SearchOutcome SearchWorker::run(const SearchRequest& request) {
+    SearchOutcome outcome;
+    m_activeGeneration = request.generation;
+    closeCursor();
+
+    // Drain searches that were superseded while queued
+    if (isCancelled()) {
+        outcome.cancelled = true;
+        return outcome;
+    }
+
+    if (!ensureConnection(request, outcome.errorMessage)) {
+        return outcome;
+    }
+
+    m_request = request;
+    m_cursorUsesFallback = false;
+    m_caseFilter.setPatterns(request.caseSensitivePatterns);
+    const bool verified = !m_caseFilter.isEmpty();
+
+    if (!request.fuzzyTerms.isEmpty()) {
+        m_request.ftsQuery = expandFuzzyQuery(request);
+        if (isCancelled()) {
+            outcome.cancelled = true;
+            return outcome;
+        }
+    }
+
+    bool narrowed = !request.prefixTerms.isEmpty() && narrows(m_candidateTerms, request.prefixTerms);
+    QSqlQuery *sqlQuery = m_statements->statement(verified ?
+        (narrowed ? kFtsNarrowedCandidatesSql : kFtsCandidatesSql) :
+        (narrowed ? kFtsNarrowedSql : kFtsSql));
+    bool executed = false;
+    if (sqlQuery) {
+        sqlQuery->addBindValue(m_request.ftsQuery);
+        executed = sqlQuery->exec();
+    }
+
+    if (!executed && narrowed && !isCancelled()) {
+        // Candidates unusable; search the whole index instead
+        m_candidateTerms.clear();
+        narrowed = false;
+        sqlQuery = m_statements->statement(verified ? kFtsCandidatesSql : kFtsSql);
+        if (sqlQuery) {
+            sqlQuery->addBindValue(m_request.ftsQuery);
+            executed = sqlQuery->exec();
+        }
+    }
+
+    if (!executed) {
+        QString error = sqlQuery ? sqlQuery->lastError().text() : m_statements->lastError().text();
+        if (isCancelled()) {
+            outcome.cancelled = true;
+            return outcome;
+        }
+        qWarning() << "FTS5 search error:" << error;
+
+        // If FTS5 table doesn't exist, try fallback search on regular tables
+        if (error.contains("no such table", Qt::CaseInsensitive) ||
+            error.contains("content_fts", Qt::CaseInsensitive)) {
+            qDebug() << "FTS5 table not found, falling back to LIKE search";
+            return runFallback(request);
+        }
+
+        outcome.errorMessage = QString("Search failed: %1").arg(error);
+        return outcome;
+    }
+
+    m_cursor = sqlQuery;
+    m_cursorHasRow = m_cursor->next();
+    if (!skipResults(request.offset, outcome)) {
+        return outcome;
+    }
+    outcome = readPage(request.pageSize);
+
+    qDebug() << "Search completed:" << outcome.results.size() << "results in first page for query:" << request.query
+             << (narrowed ? "(narrowed)" : "") << (verified ? "(case-sensitive)" : "");
+    return outcome;
+}
+
+SearchOutcome SearchWorker::runFallback(const SearchRequest& request) {
+    SearchOutcome outcome;
+    m_cursorUsesFallback = true;
+
+    const QString searchPattern = fallbackPattern(request);
+    QSqlQuery *sqlQuery = m_statements->statement(request.caseSensitive ? kFallbackCaseSensitiveSql : kFallbackSql);
+    bool executed = false;
+    if (sqlQuery) {
+        sqlQuery->addBindValue(searchPattern);
+        sqlQuery->addBindValue(searchPattern);
+        executed = sqlQuery->exec();
+    }
+
+    if (!executed) {
+        if (isCancelled()) {
+            outcome.cancelled = true;
+            return outcome;
+        }
+        QString error = sqlQuery ? sqlQuery->lastError().text() : m_statements->lastError().text();
+        qWarning() << "Fallback search error:" << error;
+        outcome.errorMessage = QString("Fallback search failed: %1").arg(error);
+        return outcome;
+    }
+
+    m_cursor = sqlQuery;
+    m_cursorHasRow = m_cursor->next();
+    if (!skipResults(request.offset, outcome)) {
+        return outcome;
+    }
+    outcome = readPage(request.pageSize);
+
+    qDebug() << "Fallback search completed:" << outcome.results.size() << "results in first page";
+    return outcome;
+}
+
+SearchOutcome SearchWorker::fetchPage(quint64 generation, int pageSize) {
+    SearchOutcome outcome;
+    m_activeGeneration = generation;
+
+    if (isCancelled()) {
+        outcome.cancelled = true;
+        return outcome;
+    }
+
+    if ((!m_cursor && m_verifiedResults.isEmpty()) || m_request.generation != generation) {
+        // Cursor already exhausted
+        outcome.succeeded = true;
+        return outcome;
+    }
+
+    return readPage(pageSize);
+}
+
+SearchOutcome SearchWorker::countHits(quint64 generation) {
+    SearchOutcome outcome;
+    m_activeGeneration = generation;
+
+    if (isCancelled()) {
+        outcome.cancelled = true;
+        return outcome;
+    }
+
+    if (m_request.generation != generation || !m_database.isOpen()) {
+        outcome.errorMessage = "No search to count hits for";
+        return outcome;
+    }
+
+    if (!m_caseFilter.isEmpty() && !m_cursorUsesFallback) {
+        return countVerifiedHits();
+    }
+
+    // Counting skips ranking and snippets, so it is much cheaper than paging
+    // through the cursor, but still a full scan of the posting lists
+    const QString countSql = !m_cursorUsesFallback ? kFtsCountSql :
+        (m_request.caseSensitive ? kFallbackCaseSensitiveCountSql : kFallbackCountSql);
+    QSqlQuery *sqlQuery = m_statements->statement(countSql);
+    bool executed = false;
+    if (sqlQuery) {
+        if (m_cursorUsesFallback) {
+            const QString searchPattern = fallbackPattern(m_request);
+            sqlQuery->addBindValue(searchPattern);
+            sqlQuery->addBindValue(searchPattern);
+        } else {
+            sqlQuery->addBindValue(m_request.ftsQuery);
+        }
+        executed = sqlQuery->exec() && sqlQuery->next();
+    }
+
+    if (!executed) {
+        if (isCancelled()) {
+            outcome.cancelled = true;
+            return outcome;
+        }
+        QString error = sqlQuery ? sqlQuery->lastError().text() : m_statements->lastError().text();
+        outcome.errorMessage = QString("Counting search results failed: %1").arg(error);
+        return outcome;
+    }
+
+    outcome.totalHits = sqlQuery->value(0).toInt();
+    sqlQuery->finish();
+    outcome.succeeded = true;
+    return outcome;
+}
+
+SearchOutcome SearchWorker::buildSnippets(const SearchRequest& request, const QList<qint64>& rowids) {
+    SearchOutcome outcome;
+    m_activeGeneration = request.generation;
+
+    if (isCancelled()) {
+        outcome.cancelled = true;
+        return outcome;
+    }
+
+    if (!ensureConnection(request, outcome.errorMessage)) {
+        return outcome;
+    }
+
+    // Fuzzy searches match the expanded terms, so their snippets must too
+    QString ftsQuery = request.ftsQuery;
+    if (request.generation == m_request.generation) {
+        ftsQuery = m_request.ftsQuery;
+    } else if (!request.fuzzyTerms.isEmpty()) {
+        ftsQuery = expandFuzzyQuery(request);
+    }
+
+    for (int begin = 0; begin < rowids.size(); begin += kSnippetBatchSize) {
+        QSqlQuery *sqlQuery = m_statements->statement(kFtsSnippetsSql);
+        bool executed = false;
+        if (sqlQuery) {
+            const QList<qint64> batch = rowids.mid(begin, kSnippetBatchSize);
+            sqlQuery->addBindValue(ftsQuery);
+            for (int i = 0; i < kSnippetBatchSize; ++i) {
+                sqlQuery->addBindValue(batch.at(qMin(i, static_cast<int>(batch.size()) - 1)));
+            }
+            executed = sqlQuery->exec();
+        }
+
+        if (!executed) {
+            if (isCancelled()) {
+                outcome.cancelled = true;
+                return outcome;
+            }
+            QString error = sqlQuery ? sqlQuery->lastError().text() : m_statements->lastError().text();
+            outcome.errorMessage = QString("Building snippets failed: %1").arg(error);
+            return outcome;
+        }
+
+        while (sqlQuery->next()) {
+            SearchHit hit;
+            hit.rowid = sqlQuery->value("rowid").toLongLong();
+            hit.documentId = sqlQuery->value("document_id").toString();
+            hit.title = sqlQuery->value("title").toString();
+            hit.snippet = sqlQuery->value("snippet").toString();
+            hit.matchOffsets = highlightedOffsets(sqlQuery->value("highlighted").toString());
+            if (hit.snippet.isEmpty()) {
+                hit.snippet = hit.title; // Only the title matched
+            }
+            outcome.results.append(hit);
+        }
+        sqlQuery->finish();
+
+        if (isCancelled()) {
+            outcome.cancelled = true;
+            return outcome;
+        }
+    }
+
+    outcome.succeeded = true;
+    return outcome;
+}
+
+QString SearchWorker::expandFuzzyQuery(const SearchRequest& request) {
+    if (!m_fuzzyIndexBuilt) {
+        m_fuzzyIndexBuilt = true;
+        QString error;
+        if (!m_fuzzyIndex.build(m_database, error)) {
+            qWarning() << error;
+        }
+    }
+
+    if (m_fuzzyIndex.isEmpty()) {
+        // Without a vocabulary, fuzzy degrades to matching the exact terms
+        return request.ftsQuery;
+    }
+
+    // Each term becomes a group of its expansions: ("term" OR "tern" OR ...)
+    QStringList groups;
+    for (const QString& term : request.fuzzyTerms) {
+        QStringList expansions = m_fuzzyIndex.expand(term);
+        if (expansions.isEmpty()) {
+            expansions.append(term);
+        }
+
+        QStringList quoted;
+        for (QString expansion : expansions) {
+            expansion.replace("\"", "\"\"");
+            quoted << "\"" + expansion + "\"";
+        }
+        groups << (quoted.size() == 1 ? quoted.first() : "(" + quoted.join(" OR ") + ")");
+    }
+
+    return groups.join(" AND ");
+}
+
+void SearchWorker::collectNarrowingCandidates(quint64 generation) {
+    m_activeGeneration = generation;
+    if (isCancelled() || m_request.generation != generation || m_cursorUsesFallback
+        || m_request.prefixTerms.isEmpty() || !m_database.isOpen()) {
+        return;
+    }
+
+    m_candidateTerms.clear();
+
+    QSqlQuery clear(m_database);
+    if (!clear.exec("DELETE FROM temp.search_candidates")) {
+        return;
+    }
+
+    QSqlQuery *collect = m_statements->statement(kCollectCandidatesSql);
+    if (!collect) {
+        return;
+    }
+    collect->addBindValue(m_request.ftsQuery);
+    collect->addBindValue(kMaxNarrowingCandidates + 1);
+    if (!collect->exec()) {
+        return;
+    }
+    const int collected = collect->numRowsAffected();
+    collect->finish();
+
+    if (collected <= kMaxNarrowingCandidates) {
+        m_candidateTerms = m_request.prefixTerms;
+    }
+}
+
+bool SearchWorker::narrows(const QStringList& previous, const QStringList& next) {
+    if (previous.isEmpty() || next.size() < previous.size()) {
+        return false;
+    }
+
+    // Complete terms must be unchanged ...
+    const int lastIndex = previous.size() - 1;
+    for (int i = 0; i < lastIndex; ++i) {
+        if (next.at(i) != previous.at(i)) {
+            return false;
+        }
+    }
+
+    // ... and the previous prefix may only have been extended. Terms added
+    // after it only narrow further, since terms are ANDed.
+    return next.at(lastIndex).startsWith(previous.at(lastIndex));
+}
+
+SearchOutcome SearchWorker::readPage(int pageSize) {
+    if (!m_caseFilter.isEmpty() && !m_cursorUsesFallback) {
+        return readVerifiedPage(pageSize);
+    }
+
+    SearchOutcome outcome;
+
+    while (m_cursorHasRow && outcome.results.size() < pageSize) {
+        if (isCancelled()) {
+            closeCursor();
+            outcome.cancelled = true;
+            return outcome;
+        }
+
+        SearchHit hit;
+        hit.documentId = m_cursor->value("document_id").toString();
+        hit.title = m_cursor->value("title").toString();
+        if (m_cursorUsesFallback) {
+            hit.snippet = m_cursor->value("snippet").toString();
+            hit.matchOffsets = fallbackOffsets(m_cursor->value("content").toString(),
+                                               m_request.query, m_request.caseSensitive);
+            if (hit.snippet.isEmpty()) {
+                hit.snippet = hit.title; // Use title as fallback if no snippet
+            }
+        } else {
+            // Snippet left empty until buildSnippets() is asked for it
+            hit.rowid = m_cursor->value("rowid").toLongLong();
+            hit.rank = m_cursor->value("rank").toDouble();
+        }
+
+        outcome.results.append(hit);
+        m_cursorHasRow = m_cursor->next();
+    }
+
+    if (cursorFailed(outcome)) {
+        return outcome;
+    }
+
+    // The row after the page is already fetched, so hasMore is exact
+    outcome.hasMore = m_cursorHasRow;
+    if (!m_cursorHasRow) {
+        closeCursor();
+    }
+
+    outcome.succeeded = true;
+    return outcome;
+}
+
+bool SearchWorker::skipResults(int count, SearchOutcome& outcome) {
+    if (count <= 0) {
+        return true;
+    }
+
+    // Read like a page so that case-sensitive searches skip verified hits
+    SearchOutcome skipped = readPage(count);
+    if (!skipped.succeeded) {
+        outcome = skipped;
+        return false;
+    }
+    return true;
+}
+
+SearchOutcome SearchWorker::readVerifiedPage(int pageSize) {
+    SearchOutcome outcome;
+
+    while (outcome.results.size() < pageSize) {
+        if (!m_verifiedResults.isEmpty()) {
+            outcome.results.append(m_verifiedResults.takeFirst());
+            continue;
+        }
+        if (!m_cursorHasRow) {
+            break;
+        }
+
+        std::vector<Candidate> candidates = readCandidates(m_cursor, m_cursorHasRow, kCandidateBatchSize, true);
+        if (cursorFailed(outcome)) {
+            return outcome;
+        }
+        verifyCandidates(candidates, true);
+        if (isCancelled()) {
+            closeCursor();
+            outcome.cancelled = true;
+            return outcome;
+        }
+
+        for (const Candidate& candidate : candidates) {
+            if (candidate.matched) {
+                m_verifiedResults.append(candidate.hit);
+            }
+        }
+    }
+
+    // Verified hits left over from the last batch are returned first by the
+    // next page. If only unverified candidates remain, that page may come
+    // back empty.
+    outcome.hasMore = m_cursorHasRow || !m_verifiedResults.isEmpty();
+    if (!m_cursorHasRow && m_cursor) {
+        m_cursor->finish();
+        m_cursor = nullptr;
+    }
+
+    outcome.succeeded = true;
+    return outcome;
+}
+
+SearchOutcome SearchWorker::countVerifiedHits() {
+    SearchOutcome outcome;
+
+    QSqlQuery *sqlQuery = m_statements->statement(kFtsCandidatesCountSql);
+    bool hasRow = false;
+    if (sqlQuery) {
+        sqlQuery->addBindValue(m_request.ftsQuery);
+        hasRow = sqlQuery->exec() && sqlQuery->next();
+    }
+
+    int totalHits = 0;
+    while (hasRow) {
+        std::vector<Candidate> candidates = readCandidates(sqlQuery, hasRow, kCandidateBatchSize, false);
+        verifyCandidates(candidates, false);
+        if (isCancelled()) {
+            sqlQuery->finish();
+            outcome.cancelled = true;
+            return outcome;
+        }
+        totalHits += static_cast<int>(std::count_if(candidates.begin(), candidates.end(),
+                                                    [](const Candidate& candidate) { return candidate.matched; }));
+    }
+
+    if (!sqlQuery || sqlQuery->lastError().isValid()) {
+        if (isCancelled()) {
+            outcome.cancelled = true;
+            return outcome;
+        }
+        QString error = sqlQuery ? sqlQuery->lastError().text() : m_statements->lastError().text();
+        outcome.errorMessage = QString("Counting search results failed: %1").arg(error);
+        return outcome;
+    }
+
+    sqlQuery->finish();
+    outcome.totalHits = totalHits;
+    outcome.succeeded = true;
+    return outcome;
+}
+
+bool SearchWorker::cursorFailed(SearchOutcome& outcome) {
+    if (m_cursorHasRow || !m_cursor || !m_cursor->lastError().isValid()) {
+        return false;
+    }
+
+    const bool cancelled = isCancelled();
+    const QString error = m_cursor->lastError().text();
+    closeCursor();
+    if (cancelled) {
+        outcome.cancelled = true;
+    } else {
+        outcome.errorMessage = QString("Search failed: %1").arg(error);
+    }
+    return true;
+}
+
+std::vector<SearchWorker::Candidate> SearchWorker::readCandidates(QSqlQuery *query, bool& hasRow, int count,
+                                                                 bool readHits) {
+    std::vector<Candidate> candidates;
+    candidates.reserve(count);
+    while (hasRow && static_cast<int>(candidates.size()) < count) {
+        Candidate candidate;
+        candidate.hit.title = query->value("title").toString();
+        if (readHits) {
+            candidate.hit.rowid = query->value("rowid").toLongLong();
+            candidate.hit.documentId = query->value("document_id").toString();
+            candidate.hit.rank = query->value("rank").toDouble();
+        }
+        candidate.content = query->value("content").toString();
+        candidates.push_back(std::move(candidate));
+        hasRow = query->next();
+    }
+    return candidates;
+}
+
+void SearchWorker::verifyCandidates(std::vector<Candidate>& candidates, bool buildSnippets) {
+    const int count = static_cast<int>(candidates.size());
+    if (!m_verifyPool) {
+        m_verifyPool = std::make_unique<QThreadPool>();
+        m_verifyPool->setMaxThreadCount(QThread::idealThreadCount());
+    }
+
+    const int threads = qMin(m_verifyPool->maxThreadCount(), count / kMinCandidatesPerThread);
+    if (threads <= 1) {
+        verifyRange(candidates, 0, count, buildSnippets);
+        return;
+    }
+
+    // Each task owns a disjoint range of the candidates
+    const int chunkSize = (count + threads - 1) / threads;
+    for (int begin = 0; begin < count; begin += chunkSize) {
+        const int end = qMin(count, begin + chunkSize);
+        m_verifyPool->start([this, &candidates, begin, end, buildSnippets]() {
+            verifyRange(candidates, begin, end, buildSnippets);
+        });
+    }
+    m_verifyPool->waitForDone();
+}
+
+void SearchWorker::verifyRange(std::vector<Candidate>& candidates, int begin, int end, bool buildSnippets) const {
+    for (int i = begin; i < end; ++i) {
+        if (isCancelled()) {
+            return;
+        }
+
+        Candidate& candidate = candidates[i];
+        const QString text = CaseSensitiveFilter::plainText(candidate.content);
+        candidate.content.clear();
+        candidate.matched = m_caseFilter.matches(candidate.hit.title, text);
+        if (candidate.matched && buildSnippets) {
+            candidate.hit.snippet = m_caseFilter.snippet(text);
+            candidate.hit.matchOffsets = m_caseFilter.matchOffsets(text);
+            if (candidate.hit.snippet.isEmpty()) {
+                candidate.hit.snippet = candidate.hit.title;
+            }
+        }
+    }
+}
+
+void SearchWorker::closeCursor() {
+    if (m_cursor) {
+        m_cursor->finish();
+        m_cursor = nullptr;
+    }
+    m_cursorHasRow = false;
+    m_verifiedResults.clear();
+}
+
+QString SearchWorker::fallbackPattern(const SearchRequest& request) {
+    if (request.caseSensitive) {
+        // Bound to instr(), which takes the text literally
+        return request.query;
+    }
+
+    QString escaped = request.query;
+    escaped.replace("\\", "\\\\");
+    escaped.replace("%", "\\%");
+    escaped.replace("_", "\\_");
+    return QString("%%1%").arg(escaped);
+}
+
+void SearchWorker::close() {
+    closeCursor();
+    m_request = SearchRequest();
+    m_caseFilter.clear();
+    m_candidateTerms.clear();
+    m_fuzzyIndex.clear();
+    m_fuzzyIndexBuilt = false;
+
+    if (!m_database.isValid()) {
+        return;
+    }
+
+    m_statements->clear();
+    m_database.close();
+    m_database = QSqlDatabase();
+    QSqlDatabase::removeDatabase(m_connectionName);
+    m_cartridgePath.clear();
+}
+
+bool SearchWorker::ensureConnection(const SearchRequest& request, QString& errorMessage) {
+    if (m_database.isOpen() && m_cartridgePath == request.cartridgePath) {
+        return true;
+    }
+
+    close();
+
+    // Searches only read, whatever profile the GUI connection uses
+    CartridgeOpenProfile profile = request.profile;
+    profile.readOnly = true;
+
+    m_database = QSqlDatabase::addDatabase("QSQLITE", m_connectionName);
+    profile.configure(m_database, request.cartridgePath);
+    if (!m_database.open()) {
+        errorMessage = QString("Failed to open cartridge for search: %1").arg(m_database.lastError().text());
+        m_database = QSqlDatabase();
+        QSqlDatabase::removeDatabase(m_connectionName);
+        return false;
+    }
+
+    profile.applyPragmas(m_database);
+    installProgressHandler();
+
+    // Temporary tables live outside the read-only cartridge file
+    QSqlQuery(m_database).exec("CREATE TEMP TABLE IF NOT EXISTS search_candidates (doc_rowid INTEGER PRIMARY KEY)");
+
+    m_statements = std::make_unique<PreparedStatementCache>(m_database);
+    m_cartridgePath = request.cartridgePath;
+    return true;
+}
+
+void SearchWorker::installProgressHandler() {
+#ifdef HAVE_SQLITE3_API
+    QVariant handle = m_database.driver()->handle();
+    if (handle.isValid() && qstrcmp(handle.typeName(), "sqlite3*") == 0) {
+        sqlite3 *connection = *static_cast<sqlite3 **>(handle.data());
+        if (connection) {
+            sqlite3_progress_handler(connection, kProgressHandlerInterval, &SearchWorker::progressCallback, this);
+        }
+    }
+#endif
+}
+
+int SearchWorker::progressCallback(void *context) {
+    // Non-zero aborts the running statement with SQLITE_INTERRUPT
+    return static_cast<const SearchWorker*>(context)->isCancelled() ? 1 : 0;
+}
+
+bool SearchWorker::isCancelled() const {
+    return m_activeGeneration != m_latestGeneration->load(std::memory_order_relaxed);
+}
+
+} // namespace CodexiumMagnus::Services
@@ -0,0 +1,207 @@
+#ifndef SEARCHWORKER_H
+#define SEARCHWORKER_H
+
+#include "CartridgeOpenProfile.h"
+#include "PreparedStatementCache.h"
+#include "FuzzyTermIndex.h"
+#include "CaseSensitiveFilter.h"
+#include "ISearchService.h"
+#include <QObject>
+#include <QSqlDatabase>
+#include <QString>
+#include <QList>
+#include <QPair>
+#include <QStringList>
+#include <QThreadPool>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace CodexiumMagnus::Services {
+
+/**
+ * A single search to run on the search worker.
+ */
+struct SearchRequest {
+    quint64 generation = 0;        ///< Token of this search; superseded once the service's latest generation moves on
+    QString cartridgePath;
+    CartridgeOpenProfile profile;
+    QString query;                 ///< Trimmed user query (used by the LIKE fallback)
+    QString ftsQuery;              ///< Query in FTS5 MATCH syntax
+    QStringList prefixTerms;       ///< Lowercased terms of an incremental search (last one is a prefix); empty otherwise
+    QStringList fuzzyTerms;        ///< Lowercased terms to expand by edit distance; empty unless fuzzy
+    bool caseSensitive = false;
+    QStringList caseSensitivePatterns;  ///< CaseSensitiveFilter patterns FTS5 hits must match; empty unless case-sensitive
+    int pageSize = 25;             ///< Number of results in the first page
+    int offset = 0;                ///< Results skipped before the first page (resuming a cached search)
+};
+
+/**
+ * Result of a search run on the search worker.
+ */
+struct SearchOutcome {
+    bool succeeded = false;
+    bool cancelled = false;        ///< Superseded by a newer search before finishing
+    QString errorMessage;
+    QList<SearchHit> results;      ///< Hits of one page, in rank order
+    bool hasMore = false;          ///< Further pages can be fetched from the cursor
+    int totalHits = -1;            ///< Set by countHits() only
+};
+
+/**
+ * Executes searches for SearchService on its worker thread.
+ *
+ * The worker holds its own read-only connection to the cartridge, opened
+ * on first use and reopened when the cartridge changes, so FTS5 MATCH and
+ * snippet generation never touch the GUI thread's connection.
+ *
+ * Results are streamed: run() leaves the statement of the current search
+ * open as a cursor and returns its first page, fetchPage() continues from
+ * where the previous page ended. FTS5 pages are read rank-only (document
+ * rowid, id, title and rank); snippets and match offsets, by far the most
+ * expensive part of a hit, are built by buildSnippets() in small batches
+ * for the hits the user can see. The total hit count is a separate, cheaper
+ * count(*) query run on demand by countHits().
+ *
+ * Case-sensitive searches use FTS5 only to find candidates, since the
+ * index folds case. Candidates are read from the cursor in batches, checked
+ * for the exact-case terms in parallel on a small thread pool, and given a
+ * snippet built around the exact-case hits (see CaseSensitiveFilter). The
+ * total hit count of such a search verifies every candidate.
+ *
+ * Fuzzy searches expand each term to the vocabulary terms within a small
+ * edit distance (see FuzzyTermIndex, built on the first fuzzy search per
+ * cartridge) and match any of them.
+ *
+ * For search-as-you-type, the documents matched by an incremental query
+ * are kept in a temporary table (when there are few enough of them), and
+ * a next query that only narrows it is evaluated against those documents
+ * alone.
+ *
+ * Cancellation is cooperative: every request carries a generation token and
+ * the worker compares it against the service's latest generation. Stale
+ * requests are skipped before they start; a running statement is aborted
+ * through an SQLite progress handler when the SQLite C API is available
+ * (HAVE_SQLITE3_API), and otherwise between result rows.
+ *
+ * All methods must be called on the thread the worker lives in.
+ */
+class SearchWorker : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @param latestGeneration Generation of the newest search, shared with
+     *        the owning service
+     * @param parent Parent QObject
+     */
+    explicit SearchWorker(std::shared_ptr<std::atomic<quint64>> latestGeneration,
+                          QObject *parent = nullptr);
+    ~SearchWorker();
+
+    /**
+     * Start a search and read its first page, falling back to a LIKE scan
+     * of the documents table if the cartridge has no FTS5 index.
+     * Replaces the cursor of any previous search. With a request offset,
+     * that many results are read and dropped first, so the cursor resumes
+     * a search whose first results are already known.
+     * @param request Search to run
+     * @return First page, or the reason the search failed or was cancelled
+     */
+    SearchOutcome run(const SearchRequest& request);
+
+    /**
+     * Read the next page from the cursor of the current search.
+     * @param generation Generation of the search to continue
+     * @param pageSize Maximum number of results to read
+     * @return Next page; empty if the search is exhausted
+     */
+    SearchOutcome fetchPage(quint64 generation, int pageSize);
+
+    /**
+     * Build snippets and match offsets for hits of a search.
+     * Pages of FTS5 searches are read rank-only, so this is the second,
+     * more expensive phase, run for the hits that are actually shown. It
+     * does not touch the cursor and also serves searches answered from the
+     * service's result cache.
+     * @param request Search the hits belong to
+     * @param rowids content_fts rowids of the hits to build snippets for
+     * @return Outcome whose results carry rowid, document id, title, snippet and
+     *         match offsets of every given document that still matches
+     */
+    SearchOutcome buildSnippets(const SearchRequest& request, const QList<qint64>& rowids);
+
+    /**
+     * Count all hits of the current search.
+     * @param generation Generation of the search to count
+     * @return Outcome with totalHits set on success
+     */
+    SearchOutcome countHits(quint64 generation);
+
+    /**
+     * Remember the documents matched by an incremental search so that a
+     * following search that only narrows it can be restricted to them.
+     * Skipped if the search was superseded or matches too many documents.
+     * @param generation Generation of the incremental search
+     */
+    void collectNarrowingCandidates(quint64 generation);
+
+    /**
+     * Check whether an incremental query can only match a subset of the
+     * documents matched by a previous one.
+     * @param previous Terms of the previous query (last one is a prefix)
+     * @param next Terms of the new query (last one is a prefix)
+     * @return true if every match of next is also a match of previous
+     */
+    static bool narrows(const QStringList& previous, const QStringList& next);
+
+    /**
+     * Close the worker's cartridge connection.
+     */
+    void close();
+
+private:
+    bool ensureConnection(const SearchRequest& request, QString& errorMessage);
+    void installProgressHandler();
+    bool isCancelled() const;
+    static int progressCallback(void *context);
+    SearchOutcome runFallback(const SearchRequest& request);
+    SearchOutcome readPage(int pageSize);
+    SearchOutcome readVerifiedPage(int pageSize);
+    bool skipResults(int count, SearchOutcome& outcome);
+    SearchOutcome countVerifiedHits();
+    bool cursorFailed(SearchOutcome& outcome);
+    QString expandFuzzyQuery(const SearchRequest& request);
+    void closeCursor();
+    static QString fallbackPattern(const SearchRequest& request);
+
+    struct Candidate {
+        SearchHit hit;               ///< Snippet and match offsets are set once verified
+        QString content;             ///< Stored HTML; released once verified
+        bool matched = false;
+    };
+    static std::vector<Candidate> readCandidates(QSqlQuery *query, bool& hasRow, int count, bool readHits);
+    void verifyCandidates(std::vector<Candidate>& candidates, bool buildSnippets);
+    void verifyRange(std::vector<Candidate>& candidates, int begin, int end, bool buildSnippets) const;
+
+    std::shared_ptr<std::atomic<quint64>> m_latestGeneration;
+    quint64 m_activeGeneration;           ///< Generation of the request being executed
+    SearchRequest m_request;              ///< Search the cursor belongs to
+    QSqlQuery *m_cursor;                  ///< Open statement of the current search, owned by m_statements
+    bool m_cursorHasRow;                  ///< m_cursor is positioned on the first row of the next page
+    bool m_cursorUsesFallback;            ///< Current search runs on the LIKE fallback
+    CaseSensitiveFilter m_caseFilter;     ///< Exact-case check of the current search; empty if case-insensitive
+    QList<SearchHit> m_verifiedResults;   ///< Verified hits not yet returned in a page
+    std::unique_ptr<QThreadPool> m_verifyPool;  ///< Created on the first case-sensitive search
+    QStringList m_candidateTerms;         ///< Incremental query whose hits are in temp.search_candidates; empty if none
+    FuzzyTermIndex m_fuzzyIndex;          ///< Vocabulary of the open cartridge, built on the first fuzzy search
+    bool m_fuzzyIndexBuilt;               ///< Build was attempted for the open cartridge
+    QString m_connectionName;
+    QString m_cartridgePath;              ///< Cartridge the connection is open on
+    QSqlDatabase m_database;
+    std::unique_ptr<PreparedStatementCache> m_statements;
+};
+
+} // namespace CodexiumMagnus::Services
+
+#endif // SEARCHWORKER_H
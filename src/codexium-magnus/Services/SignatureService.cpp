@@ -1,4 +1,6 @@
 #include "SignatureService.h"
+#include "MerkleTreeDigest.h"
+#include "VerifyingVfs.h"
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -7,6 +9,12 @@
 #include <QDebug>
 #include <QStandardPaths>
 #include <QDir>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QMutexLocker>
+#include <QReadLocker>
+#include <QWriteLocker>
+#include <QFileInfo>
 
 #ifdef HAVE_LIBSODIUM
 #include <sodium.h>
@@ -14,10 +22,30 @@
 
 namespace CodexiumMagnus::Services {
 
+namespace {
+const qint64 kHashChunkSize = 1024 * 1024;
+const QString kMerkleSha256Format = "merkle-sha256";
+const qint64 kDefaultReverifyInterval = 7 * 24 * 60 * 60;  // 7 days
+const QString kManifestSuffix = ".manifest.json";
+// Room for the chunk table of a multi-gigabyte cartridge
+const qint64 kMaxManifestSize = 64 * 1024 * 1024;
+}
+
 SignatureService::SignatureService(QObject *parent)
     : ISignatureService(parent)
+    , m_trustedKeysLock()
+    , m_trustedKeys()
     , m_settings(nullptr)
     , m_libsodiumAvailable(false)
+    , m_hashPool()
+    , m_verificationCache()
+    , m_reverifyInterval(kDefaultReverifyInterval)
+    , m_reverifyMutex()
+    , m_reverifying()
+    , m_lazyVerification(false)
+    , m_lazyMutex()
+    , m_lazyVerifiers()
+    , m_reverifyPool()
 {
     m_settings = new QSettings("CodexiumMagnus", "SignatureService", this);
     initialize();
@@ -25,14 +53,30 @@ SignatureService::SignatureService(QObject *parent)
 
 SignatureService::SignatureService(QSettings *settings, QObject *parent)
     : ISignatureService(parent)
+    , m_trustedKeysLock()
+    , m_trustedKeys()
     , m_settings(settings)
     , m_libsodiumAvailable(false)
+    , m_hashPool()
+    , m_verificationCache()
+    , m_reverifyInterval(kDefaultReverifyInterval)
+    , m_reverifyMutex()
+    , m_reverifying()
+    , m_lazyVerification(false)
+    , m_lazyMutex()
+    , m_lazyVerifiers()
+    , m_reverifyPool()
 {
     // Use provided settings (for testing) - caller manages lifetime
     initialize();
 }
 
 void SignatureService::initialize() {
+    m_hashPool.setMaxThreadCount(QThread::idealThreadCount());
+    // Re-verification must not compete with loading and rendering
+    m_reverifyPool.setMaxThreadCount(1);
+    m_reverifyPool.setThreadPriority(QThread::LowestPriority);
+
 #ifdef HAVE_LIBSODIUM
     if (sodium_init() < 0) {
         qWarning() << "SignatureService: Failed to initialize libsodium";
@@ -53,36 +97,98 @@ void SignatureService::initialize() {
 
 SignatureService::~SignatureService() {
     // Qt parent system handles cleanup
+    m_reverifyPool.clear();
+    waitForReverification();
+
+    // Verifiers may outlive the service in open connections
+    QMutexLocker locker(&m_lazyMutex);
+    for (auto it = m_lazyVerifiers.constBegin(); it != m_lazyVerifiers.constEnd(); ++it) {
+        it.value().verifier->setFailureHandler(nullptr);
+        VerifyingVfs::detach(it.key());
+    }
+}
+
+void SignatureService::setVerificationCache(std::unique_ptr<VerificationCache> cache) {
+    // Pending re-verifications still use the old cache
+    m_reverifyPool.clear();
+    waitForReverification();
+    m_verificationCache = std::move(cache);
+}
+
+void SignatureService::waitForReverification() {
+    m_reverifyPool.waitForDone();
 }
 
 TrustLevel SignatureService::verifyCartridge(const QString& cartridgePath) {
+    return verifyCartridge(cartridgePath, std::function<bool()>());
+}
+
+TrustLevel SignatureService::verifyCartridge(const QString& cartridgePath, const std::function<bool()>& isCancelled) {
     if (!QFile::exists(cartridgePath)) {
         emit verificationFailed(cartridgePath, "Cartridge file does not exist");
         return TrustLevel::Invalid;
     }
 
-    // Read manifest
-    QByteArray manifest = readManifest(cartridgePath);
-    if (manifest.isEmpty()) {
-        emit verificationFailed(cartridgePath, "Failed to read manifest");
-        return TrustLevel::Invalid;
+    // Taken before hashing, so a change during hashing is a mismatch next
+    // time; the signature lives in the sidecar, which can change on its own
+    const VerificationCache::FileIdentity identity = VerificationCache::FileIdentity::of(cartridgePath);
+    const VerificationCache::FileIdentity manifestIdentity =
+        VerificationCache::FileIdentity::of(manifestPath(cartridgePath));
+    if (m_verificationCache && identity.isValid()) {
+        VerificationCache::Entry entry;
+        if (m_verificationCache->lookup(cartridgePath, entry) && entry.identity == identity
+            && entry.manifestIdentity == manifestIdentity) {
+            // Trusted keys may have changed since; only the signing key is cached
+            TrustLevel trustLevel = trustLevelForFingerprint(entry.keyFingerprint);
+            if (!entry.verifiedUtc.isValid()
+                || entry.verifiedUtc.secsTo(QDateTime::currentDateTimeUtc()) >= m_reverifyInterval) {
+                scheduleReverification(cartridgePath, entry);
+            }
+            emit cartridgeVerified(cartridgePath, trustLevel);
+            return trustLevel;
+        }
     }
 
+    // Read manifest; a cartridge without a readable one is unsigned, which
+    // is not evidence of tampering
+    QByteArray manifest = readManifest(cartridgePath);
+
     // Extract signature and public key from manifest
-    QByteArray signature = extractSignature(manifest);
-    QByteArray publicKey = extractPublicKey(manifest);
+    QByteArray signature = manifest.isEmpty() ? QByteArray() : extractSignature(manifest);
+    QByteArray publicKey = manifest.isEmpty() ? QByteArray() : extractPublicKey(manifest);
 
     if (signature.isEmpty() || publicKey.isEmpty()) {
         // Unsigned cartridge
+        if (m_lazyVerification) {
+            VerifyingVfs::detach(cartridgePath);
+        }
         emit cartridgeVerified(cartridgePath, TrustLevel::Homebrew);
         return TrustLevel::Homebrew;
     }
 
+    // Lazily verified cartridges are signed off on their chunk table; the
+    // chunks themselves are checked as they are read
+    std::shared_ptr<ChunkVerifier> verifier =
+        m_lazyVerification ? lazyChunkVerifier(cartridgePath, manifest, identity) : nullptr;
+    if (verifier && verifier->hasFailed()) {
+        emit verificationFailed(cartridgePath, "Cartridge content does not match its chunk table");
+        return TrustLevel::Invalid;
+    }
+
     // Compute hash of manifest + database
-    QByteArray message = computeCartridgeHash(cartridgePath);
+    QByteArray message = verifier
+        ? QCryptographicHash::hash(signedManifest(manifest) + MerkleTreeDigest::rootHash(verifier->chunkHashes()),
+                                   QCryptographicHash::Sha256)
+        : computeCartridgeHash(cartridgePath, signedManifest(manifest), isCancelled);
+    if (message.isEmpty() && isCancelled && isCancelled()) {
+        // Superseded; the caller drops the result, so report nothing
+        return TrustLevel::Unverified;
+    }
     if (message.isEmpty()) {
+        // Unreadable file or unsupported digest format: the signature could
+        // not be checked, which is not the same as a mismatch
         emit verificationFailed(cartridgePath, "Failed to compute cartridge hash");
-        return TrustLevel::Invalid;
+        return TrustLevel::Unverified;
     }
 
     // Verify signature
@@ -106,6 +212,27 @@ TrustLevel SignatureService::verifyCartridge(const QString& cartridgePath) {
 
     // Check if key is trusted
     TrustLevel trustLevel = getKeyTrustLevel(publicKey);
+
+    if (verifier) {
+        // Reads made before the signature was checked are verified now; a
+        // failure is reported by the verifier's failure handler
+        if (!VerifyingVfs::attach(cartridgePath, verifier)) {
+            return TrustLevel::Invalid;
+        }
+    } else if (m_verificationCache && identity.isValid()) {
+        // Only valid signatures over the whole file are cached; anything
+        // else is re-checked on every load
+        VerificationCache::Entry entry;
+        entry.path = cartridgePath;
+        entry.identity = identity;
+        entry.manifestIdentity = manifestIdentity;
+        entry.digest = message;
+        entry.trustLevel = trustLevel;
+        entry.keyFingerprint = VerificationCache::keyFingerprint(publicKey);
+        entry.verifiedUtc = QDateTime::currentDateTimeUtc();
+        m_verificationCache->store(entry);
+    }
+
     emit cartridgeVerified(cartridgePath, trustLevel);
     return trustLevel;
 }
@@ -148,59 +275,236 @@ void SignatureService::addTrustedKey(const QByteArray& publicKey,
     key.label = label;
     key.isOfficial = isOfficial;
 
-    m_trustedKeys[publicKey] = key;
+    {
+        QWriteLocker locker(&m_trustedKeysLock);
+        m_trustedKeys[publicKey] = key;
+    }
     saveTrustedKeys();
 }
 
 void SignatureService::removeTrustedKey(const QByteArray& publicKey) {
-    if (m_trustedKeys.remove(publicKey) > 0) {
+    bool removed = false;
+    {
+        QWriteLocker locker(&m_trustedKeysLock);
+        removed = m_trustedKeys.remove(publicKey) > 0;
+    }
+    if (removed) {
         saveTrustedKeys();
     }
 }
 
 TrustLevel SignatureService::getKeyTrustLevel(const QByteArray& publicKey) const {
-    if (!m_trustedKeys.contains(publicKey)) {
+    QReadLocker locker(&m_trustedKeysLock);
+    const auto it = m_trustedKeys.constFind(publicKey);
+    if (it == m_trustedKeys.constEnd()) {
         return TrustLevel::Unverified;
     }
-
-    const TrustedKey& key = m_trustedKeys[publicKey];
-    return key.isOfficial ? TrustLevel::Official : TrustLevel::Verified;
+    return it.value().isOfficial ? TrustLevel::Official : TrustLevel::Verified;
 }
 
-QByteArray SignatureService::computeCartridgeHash(const QString& cartridgePath) {
-    // Compute hash of manifest + database
+QByteArray SignatureService::computeCartridgeHash(const QString& cartridgePath, const QByteArray& manifest,
+                                                  const std::function<bool()>& isCancelled) {
+    // Compute hash of the signed manifest + database
     // This should match the hash computed during cartridge signing
-    
-    QByteArray manifest = readManifest(cartridgePath);
     if (manifest.isEmpty()) {
         return QByteArray();
     }
 
-    // Read database file
-    QFile dbFile(cartridgePath);
-    if (!dbFile.open(QIODevice::ReadOnly)) {
-        qWarning() << "SignatureService: Failed to open cartridge database";
+    qint64 chunkSize = 0;
+    HashStatistics statistics;
+    QByteArray hash;
+    switch (extractDigestFormat(manifest, &chunkSize)) {
+    case DigestFormat::Sequential:
+        hash = hashFile(cartridgePath, manifest, &statistics, isCancelled);
+        break;
+    case DigestFormat::MerkleSha256: {
+        // The signature covers SHA-256(manifest + root)
+        QElapsedTimer timer;
+        timer.start();
+        const QByteArray root = MerkleTreeDigest::rootHash(
+            MerkleTreeDigest::chunkHashes(cartridgePath, chunkSize, &m_hashPool, &statistics.bytesHashed,
+                                          isCancelled));
+        if (!root.isEmpty()) {
+            hash = QCryptographicHash::hash(manifest + root, QCryptographicHash::Sha256);
+            statistics.bytesHashed += manifest.size();
+        }
+        statistics.elapsedMs = timer.elapsed();
+        break;
+    }
+    case DigestFormat::Unsupported:
+        qWarning() << "SignatureService: Unsupported cartridge digest format";
+        return QByteArray();
+    }
+
+    if (hash.isEmpty() && isCancelled && isCancelled()) {
+        qDebug() << "SignatureService: Hashing cancelled for" << cartridgePath;
+        return QByteArray();
+    }
+    if (hash.isEmpty()) {
+        qWarning() << "SignatureService: Failed to hash cartridge database";
         return QByteArray();
     }
 
-    QByteArray dbData = dbFile.readAll();
-    dbFile.close();
+    qDebug() << "SignatureService: Hashed" << statistics.bytesHashed << "bytes in"
+             << statistics.elapsedMs << "ms (" << statistics.megabytesPerSecond() << "MB/s )";
+    emit cartridgeHashed(cartridgePath, statistics.bytesHashed, statistics.megabytesPerSecond());
+    return hash;
+}
+
+double SignatureService::HashStatistics::megabytesPerSecond() const {
+    // Sub-millisecond passes are counted as 1 ms
+    return bytesHashed / 1e6 / (qMax<qint64>(1, elapsedMs) / 1e3);
+}
+
+qint64 SignatureService::hashChunkSize() {
+    return kHashChunkSize;
+}
+
+QByteArray SignatureService::hashFile(const QString& path, const QByteArray& prefix, HashStatistics *statistics,
+                                      const std::function<bool()>& isCancelled) {
+    QElapsedTimer timer;
+    timer.start();
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Unbuffered)) {
+        return QByteArray();
+    }
 
-    // Combine manifest + database and hash
-    QByteArray combined = manifest + dbData;
     QCryptographicHash hash(QCryptographicHash::Sha256);
-    hash.addData(combined);
+    hash.addData(prefix);
+    qint64 bytesHashed = prefix.size();
+
+    // One buffer for the whole pass; reads bypass QFile's own buffer
+    QByteArray buffer(kHashChunkSize, Qt::Uninitialized);
+    for (;;) {
+        if (isCancelled && isCancelled()) {
+            return QByteArray();
+        }
+        const qint64 read = file.read(buffer.data(), buffer.size());
+        if (read < 0) {
+            qWarning() << "SignatureService: Failed to read" << path << ":" << file.errorString();
+            return QByteArray();
+        }
+        if (read == 0) {
+            break;
+        }
+        hash.addData(QByteArrayView(buffer.constData(), read));
+        bytesHashed += read;
+    }
 
+    if (statistics) {
+        statistics->bytesHashed = bytesHashed;
+        statistics->elapsedMs = timer.elapsed();
+    }
     return hash.result();
 }
 
+QString SignatureService::manifestPath(const QString& cartridgePath) {
+    return cartridgePath + kManifestSuffix;
+}
+
+QByteArray SignatureService::signedManifest(const QByteArray& manifest) {
+    QJsonDocument doc = QJsonDocument::fromJson(manifest);
+    if (!doc.isObject()) {
+        return QByteArray();
+    }
+
+    // QJsonObject keeps its keys sorted, so the serialization is canonical
+    QJsonObject obj = doc.object();
+    obj.remove("signature");
+    return QJsonDocument(obj).toJson(QJsonDocument::Compact);
+}
+
 QByteArray SignatureService::readManifest(const QString& cartridgePath) {
-    // Open SQLite database and read manifest from metadata table
-    // For now, return empty - this needs SQLite integration
-    // TODO: Implement manifest reading from cartridge SQLite database
-    
-    qWarning() << "SignatureService: Manifest reading not yet implemented";
-    return QByteArray();
+    QFile file(manifestPath(cartridgePath));
+    if (!file.exists()) {
+        return QByteArray();
+    }
+    if (file.size() > kMaxManifestSize) {
+        qWarning() << "SignatureService: Manifest too large:" << file.fileName();
+        return QByteArray();
+    }
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "SignatureService: Failed to read manifest" << file.fileName() << ":" << file.errorString();
+        return QByteArray();
+    }
+
+    QByteArray manifest = file.readAll();
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(manifest, &error);
+    if (error.error != QJsonParseError::NoError || !doc.isObject()) {
+        qWarning() << "SignatureService: Malformed manifest" << file.fileName() << ":" << error.errorString();
+        return QByteArray();
+    }
+    return manifest;
+}
+
+TrustLevel SignatureService::trustLevelForFingerprint(const QString& keyFingerprint) const {
+    QReadLocker locker(&m_trustedKeysLock);
+    for (auto it = m_trustedKeys.constBegin(); it != m_trustedKeys.constEnd(); ++it) {
+        if (VerificationCache::keyFingerprint(it.key()) == keyFingerprint) {
+            return it.value().isOfficial ? TrustLevel::Official : TrustLevel::Verified;
+        }
+    }
+    return TrustLevel::Unverified;
+}
+
+void SignatureService::scheduleReverification(const QString& cartridgePath, const VerificationCache::Entry& entry) {
+    {
+        QMutexLocker locker(&m_reverifyMutex);
+        if (m_reverifying.contains(entry.path)) {
+            return;
+        }
+        m_reverifying.insert(entry.path);
+    }
+
+    m_reverifyPool.start([this, cartridgePath, entry]() {
+        reverify(cartridgePath, entry);
+        QMutexLocker locker(&m_reverifyMutex);
+        m_reverifying.remove(entry.path);
+    });
+}
+
+void SignatureService::reverify(const QString& cartridgePath, VerificationCache::Entry entry) {
+    if (!m_verificationCache) {
+        return;
+    }
+
+    const VerificationCache::FileIdentity identity = VerificationCache::FileIdentity::of(cartridgePath);
+    const VerificationCache::FileIdentity manifestIdentity =
+        VerificationCache::FileIdentity::of(manifestPath(cartridgePath));
+    const QByteArray manifest = readManifest(cartridgePath);
+    if (manifest.isEmpty()) {
+        // Signature removed; the cartridge is now merely unsigned
+        m_verificationCache->remove(cartridgePath);
+        emit trustLevelChanged(cartridgePath, TrustLevel::Homebrew);
+        return;
+    }
+
+    const QByteArray digest = computeCartridgeHash(cartridgePath, signedManifest(manifest));
+    if (digest.isEmpty()) {
+        m_verificationCache->remove(cartridgePath);
+        emit verificationFailed(cartridgePath, "Failed to compute cartridge hash");
+        emit trustLevelChanged(cartridgePath, TrustLevel::Unverified);
+        return;
+    }
+
+    // Same content and key; a rewritten sidecar may still carry a
+    // different signature, which is checked again
+    if (digest == entry.digest
+        && (manifestIdentity == entry.manifestIdentity
+            || verifySignature(digest, extractSignature(manifest), extractPublicKey(manifest)))) {
+        entry.identity = identity;
+        entry.manifestIdentity = manifestIdentity;
+        entry.verifiedUtc = QDateTime::currentDateTimeUtc();
+        m_verificationCache->store(entry);
+        return;
+    }
+
+    qWarning() << "SignatureService: Cartridge changed since it was verified:" << cartridgePath;
+    m_verificationCache->remove(cartridgePath);
+    emit verificationFailed(cartridgePath, "Cartridge was modified after it was verified");
+    emit trustLevelChanged(cartridgePath, TrustLevel::Invalid);
 }
 
 QByteArray SignatureService::extractSignature(const QByteArray& manifest) {
@@ -238,9 +542,91 @@ QByteArray SignatureService::extractPublicKey(const QByteArray& manifest) {
     return QByteArray::fromBase64(keyStr.toUtf8());
 }
 
-void SignatureService::loadTrustedKeys() {
-    m_trustedKeys.clear();
+SignatureService::DigestFormat SignatureService::extractDigestFormat(const QByteArray& manifest, qint64 *chunkSize) {
+    QJsonDocument doc = QJsonDocument::fromJson(manifest);
+    QJsonObject obj = doc.object();
+    if (!obj.contains("digest")) {
+        return DigestFormat::Sequential;
+    }
+
+    QJsonObject digest = obj["digest"].toObject();
+    if (digest["format"].toString() != kMerkleSha256Format) {
+        return DigestFormat::Unsupported;
+    }
+
+    const qint64 size = digest["chunkSize"].toInteger(MerkleTreeDigest::defaultChunkSize());
+    if (size < MerkleTreeDigest::minimumChunkSize()) {
+        return DigestFormat::Unsupported;
+    }
+    if (chunkSize) {
+        *chunkSize = size;
+    }
+    return DigestFormat::MerkleSha256;
+}
 
+QList<QByteArray> SignatureService::extractChunkHashes(const QByteArray& manifest) {
+    QJsonDocument doc = QJsonDocument::fromJson(manifest);
+    QJsonObject digest = doc.object()["digest"].toObject();
+    const QByteArray table = QByteArray::fromBase64(digest["chunkHashes"].toString().toLatin1());
+    const qsizetype hashSize = 32;
+    if (table.isEmpty() || table.size() % hashSize != 0) {
+        return QList<QByteArray>();
+    }
+
+    QList<QByteArray> hashes;
+    hashes.reserve(table.size() / hashSize);
+    for (qsizetype offset = 0; offset < table.size(); offset += hashSize) {
+        hashes.append(table.mid(offset, hashSize));
+    }
+    return hashes;
+}
+
+std::shared_ptr<ChunkVerifier> SignatureService::chunkVerifier(const QString& cartridgePath) const {
+    QMutexLocker locker(&m_lazyMutex);
+    return m_lazyVerifiers.value(QFileInfo(cartridgePath).absoluteFilePath()).verifier;
+}
+
+std::shared_ptr<ChunkVerifier> SignatureService::lazyChunkVerifier(const QString& cartridgePath,
+                                                                   const QByteArray& manifest,
+                                                                   const VerificationCache::FileIdentity& identity) {
+    const QString key = QFileInfo(cartridgePath).absoluteFilePath();
+    qint64 chunkSize = 0;
+    const QList<QByteArray> chunkHashes = extractDigestFormat(manifest, &chunkSize) == DigestFormat::MerkleSha256
+        ? extractChunkHashes(manifest) : QList<QByteArray>();
+
+    QMutexLocker locker(&m_lazyMutex);
+    auto it = m_lazyVerifiers.find(key);
+    if (it != m_lazyVerifiers.end() && identity.isValid() && it->identity == identity
+        && it->verifier->chunkSize() == chunkSize && it->verifier->chunkHashes() == chunkHashes) {
+        // Same file and table: keep the chunks verified by earlier loads
+        return it->verifier;
+    }
+    if (it != m_lazyVerifiers.end()) {
+        it->verifier->setFailureHandler(nullptr);
+        m_lazyVerifiers.erase(it);
+    }
+
+    auto verifier = std::make_shared<ChunkVerifier>(cartridgePath, chunkSize, chunkHashes);
+    if (chunkHashes.isEmpty() || !verifier->isValid()) {
+        // No usable table; the whole file is hashed instead
+        VerifyingVfs::detach(cartridgePath);
+        return nullptr;
+    }
+
+    // Called from whichever thread's read hit the chunk
+    verifier->setFailureHandler([this, cartridgePath](qint64 chunk) {
+        emit verificationFailed(cartridgePath, QString("Chunk %1 does not match its signed hash").arg(chunk));
+        emit trustLevelChanged(cartridgePath, TrustLevel::Invalid);
+    });
+    LazyVerifier entry;
+    entry.identity = identity;
+    entry.verifier = verifier;
+    m_lazyVerifiers.insert(key, entry);
+    return verifier;
+}
+
+void SignatureService::loadTrustedKeys() {
+    QMap<QByteArray, TrustedKey> trustedKeys;
     int size = m_settings->beginReadArray("trustedKeys");
     for (int i = 0; i < size; ++i) {
         m_settings->setArrayIndex(i);
@@ -256,13 +642,17 @@ void SignatureService::loadTrustedKeys() {
             key.publicKey = publicKey;
             key.label = label;
             key.isOfficial = isOfficial;
-            m_trustedKeys[publicKey] = key;
+            trustedKeys[publicKey] = key;
         }
     }
     m_settings->endArray();
+
+    QWriteLocker locker(&m_trustedKeysLock);
+    m_trustedKeys.swap(trustedKeys);
 }
 
 void SignatureService::saveTrustedKeys() {
+    QReadLocker locker(&m_trustedKeysLock);
     m_settings->beginWriteArray("trustedKeys");
     int index = 0;
     for (auto it = m_trustedKeys.constBegin(); it != m_trustedKeys.constEnd(); ++it) {
@@ -2,8 +2,16 @@
 #define SIGNATURESERVICE_H
 
 #include "ISignatureService.h"
+#include "ChunkVerifier.h"
+#include "VerificationCache.h"
+#include <QHash>
 #include <QMap>
+#include <QMutex>
+#include <QReadWriteLock>
+#include <QSet>
 #include <QSettings>
+#include <QThreadPool>
+#include <memory>
 
 namespace CodexiumMagnus::Services {
 
@@ -12,6 +20,28 @@ namespace CodexiumMagnus::Services {
  * 
  * Provides cartridge signature verification and trust management.
  * Stores trusted keys in QSettings for persistence.
+ *
+ * A cartridge's manifest is the JSON file next to it named by
+ * manifestPath(). It cannot live inside the cartridge database, since the
+ * signature covers the database file byte for byte. The signed message is
+ * SHA-256 of signedManifest() (the manifest without its signature) followed
+ * by the database. A cartridge without a readable manifest, or whose
+ * manifest carries no signature, is unsigned (Homebrew); only a signature
+ * or content mismatch makes a cartridge Invalid.
+ *
+ * With a VerificationCache set, a cartridge whose file identity matches
+ * an earlier successful verification is not hashed again; its trust level
+ * is derived from the cached key fingerprint and the current trusted keys.
+ * Cached results older than reverifyInterval() are re-hashed on a
+ * low-priority background thread; if the digest no longer matches, the
+ * entry is dropped and trustLevelChanged() reports the cartridge as
+ * Invalid (FR-AT-4.3).
+ *
+ * With lazy verification enabled, a Merkle-digest cartridge whose manifest
+ * carries its chunk table ("chunkHashes") is not hashed up front: the
+ * signature is checked against the table's root, and each chunk is checked
+ * against the table when SQLite first reads it, through VerifyingVfs. A
+ * chunk that fails reports the cartridge Invalid through trustLevelChanged().
  */
 class SignatureService : public ISignatureService {
     Q_OBJECT
@@ -21,7 +51,104 @@ public:
     explicit SignatureService(QSettings *settings, QObject *parent = nullptr); // For testing
     ~SignatureService();
 
+    /**
+     * How the database part of the signed message is digested, as named by
+     * the manifest's "digest" object, e.g.
+     * {"format": "merkle-sha256", "chunkSize": 1048576}.
+     */
+    enum class DigestFormat {
+        Sequential,     ///< No "digest" object: one SHA-256 pass over manifest + database
+        MerkleSha256,   ///< "merkle-sha256": SHA-256 of manifest + Merkle root (see MerkleTreeDigest)
+        Unsupported     ///< Unknown format or invalid chunk size
+    };
+
+    /**
+     * Size and duration of one streamed hash pass.
+     */
+    struct HashStatistics {
+        qint64 bytesHashed = 0;    ///< Bytes fed into the digest, prefix included
+        qint64 elapsedMs = 0;      ///< Wall time of the pass
+
+        /**
+         * Throughput of the pass in MB/s (10^6 bytes per second).
+         */
+        double megabytesPerSecond() const;
+    };
+
+    /**
+     * Hash a file with SHA-256 without loading it into memory.
+     *
+     * The file is read in hashChunkSize() blocks through a single reused
+     * buffer, so peak memory is independent of the file size.
+     *
+     * @param path Path to the file
+     * @param prefix Bytes hashed before the file content (e.g. the manifest)
+     * @param statistics Receives the size and duration of the pass; may be null
+     * @param isCancelled Polled before each block; returning true abandons
+     *                    the pass. May be empty
+     * @return SHA-256 of prefix + file content, or empty QByteArray on error
+     *         or cancellation
+     */
+    static QByteArray hashFile(const QString& path, const QByteArray& prefix = QByteArray(),
+                               HashStatistics *statistics = nullptr,
+                               const std::function<bool()>& isCancelled = {});
+
+    /**
+     * Bytes read from the cartridge per hash update (1 MiB).
+     */
+    static qint64 hashChunkSize();
+
+    /**
+     * Path of a cartridge's manifest: the cartridge path plus
+     * ".manifest.json".
+     */
+    static QString manifestPath(const QString& cartridgePath);
+
+    /**
+     * Part of a manifest covered by its signature: the manifest object
+     * without its "signature" member, as compact JSON with sorted keys.
+     * @param manifest Manifest JSON
+     * @return Canonical signed bytes, or empty if the manifest is not a
+     *         JSON object
+     */
+    static QByteArray signedManifest(const QByteArray& manifest);
+
+    /**
+     * Cache verification results across sessions.
+     * @param cache Cache to use; null disables caching
+     */
+    void setVerificationCache(std::unique_ptr<VerificationCache> cache);
+    VerificationCache* verificationCache() const { return m_verificationCache.get(); }
+
+    /**
+     * Age after which a cached verification is re-hashed in the background
+     * when the cartridge is loaded again (default 7 days).
+     * @param seconds Interval in seconds; 0 re-verifies on every cache hit
+     */
+    void setReverifyInterval(qint64 seconds) { m_reverifyInterval = seconds; }
+    qint64 reverifyInterval() const { return m_reverifyInterval; }
+
+    /**
+     * Block until background re-verifications have finished.
+     */
+    void waitForReverification();
+
+    /**
+     * Verify cartridges with a chunk table lazily, chunk by chunk as they are
+     * read (default off). Connections must open cartridges through
+     * VerifyingVfs, or their chunks are never checked.
+     */
+    void setLazyVerification(bool enabled) { m_lazyVerification = enabled; }
+    bool lazyVerification() const { return m_lazyVerification; }
+
+    /**
+     * Chunk verifier of a lazily verified cartridge.
+     * @return Verifier, or null if the cartridge was not verified lazily
+     */
+    std::shared_ptr<ChunkVerifier> chunkVerifier(const QString& cartridgePath) const;
+
     TrustLevel verifyCartridge(const QString& cartridgePath) override;
+    TrustLevel verifyCartridge(const QString& cartridgePath, const std::function<bool()>& isCancelled) override;
     bool verifySignature(const QByteArray& message, 
                         const QByteArray& signature, 
                         const QByteArray& publicKey) override;
@@ -35,23 +162,82 @@ public:
     QByteArray extractSignature(const QByteArray& manifest);
     QByteArray extractPublicKey(const QByteArray& manifest);
 
+    /**
+     * Digest format named by a manifest.
+     * @param manifest Manifest JSON
+     * @param chunkSize Receives the Merkle chunk size; may be null
+     * @return Format; Sequential if the manifest names none
+     */
+    DigestFormat extractDigestFormat(const QByteArray& manifest, qint64 *chunkSize = nullptr);
+
+    /**
+     * Chunk table of a Merkle-digest manifest: the base64 "chunkHashes" of
+     * its "digest" object, one 32-byte leaf hash per chunk.
+     * @param manifest Manifest JSON
+     * @return Leaf hashes in file order, or empty if absent or malformed
+     */
+    QList<QByteArray> extractChunkHashes(const QByteArray& manifest);
+
+signals:
+    /**
+     * Emitted after a cartridge has been hashed for verification.
+     * May be emitted from the thread running verifyCartridge().
+     * @param cartridgePath Path to the cartridge
+     * @param bytesHashed Bytes hashed (manifest + database)
+     * @param megabytesPerSecond Hash throughput in MB/s
+     */
+    void cartridgeHashed(const QString& cartridgePath, qint64 bytesHashed, double megabytesPerSecond);
+
 private:
     /**
      * Compute hash of manifest + database for signature verification.
+     * The database is streamed (see hashFile()), or hashed chunk-wise on
+     * the hash pool for Merkle digests.
      * 
      * @param cartridgePath Path to the cartridge
+     * @param manifest signedManifest() of the cartridge's manifest
+     * @param isCancelled Abandons hashing once it returns true; may be empty
      * @return Hash of manifest + database, or empty QByteArray on error
      */
-    QByteArray computeCartridgeHash(const QString& cartridgePath);
+    QByteArray computeCartridgeHash(const QString& cartridgePath, const QByteArray& manifest,
+                                    const std::function<bool()>& isCancelled = {});
 
     /**
-     * Read manifest from cartridge.
+     * Read a cartridge's manifest from manifestPath().
      * 
      * @param cartridgePath Path to the cartridge
-     * @return Manifest JSON as QByteArray, or empty on error
+     * @return Manifest JSON as QByteArray, or empty if the file is missing,
+     *         unreadable or not a JSON object
      */
     QByteArray readManifest(const QString& cartridgePath);
 
+    /**
+     * Trust level of the trusted key with the given fingerprint.
+     * @return Official or Verified for a trusted key, Unverified otherwise
+     */
+    TrustLevel trustLevelForFingerprint(const QString& keyFingerprint) const;
+
+    /**
+     * Re-hash a cartridge answered from the cache on the re-verify pool,
+     * unless it is already being re-verified.
+     */
+    void scheduleReverification(const QString& cartridgePath, const VerificationCache::Entry& entry);
+
+    /**
+     * Re-hash a cartridge and compare against its cached digest.
+     * Runs on the re-verify pool.
+     */
+    void reverify(const QString& cartridgePath, VerificationCache::Entry entry);
+
+    /**
+     * Chunk verifier for lazy verification of a cartridge, reused while the
+     * file is unchanged so verified chunks are not read again.
+     * @return Verifier, or null if the cartridge has no usable chunk table
+     */
+    std::shared_ptr<ChunkVerifier> lazyChunkVerifier(const QString& cartridgePath,
+                                                     const QByteArray& manifest,
+                                                     const VerificationCache::FileIdentity& identity);
+
     /**
      * Initialize libsodium and load trusted keys.
      */
@@ -73,9 +259,24 @@ private:
         bool isOfficial;
     };
 
+    struct LazyVerifier {
+        VerificationCache::FileIdentity identity;   ///< File the verifier was built for
+        std::shared_ptr<ChunkVerifier> verifier;
+    };
+
+    mutable QReadWriteLock m_trustedKeysLock;     ///< Guards m_trustedKeys; verification threads read it
     QMap<QByteArray, TrustedKey> m_trustedKeys;  ///< Map of public key -> key info
     QSettings *m_settings;                        ///< Settings for key persistence
     bool m_libsodiumAvailable;                    ///< Whether libsodium is available
+    QThreadPool m_hashPool;                       ///< Hashes Merkle chunks in parallel
+    std::unique_ptr<VerificationCache> m_verificationCache;  ///< Null when caching is disabled
+    qint64 m_reverifyInterval;                    ///< Seconds before a cached result is re-hashed
+    QMutex m_reverifyMutex;                       ///< Guards m_reverifying
+    QSet<QString> m_reverifying;                  ///< Cache keys queued or being re-verified
+    bool m_lazyVerification;                      ///< Verify chunk-table cartridges as they are read
+    mutable QMutex m_lazyMutex;                   ///< Guards m_lazyVerifiers
+    QHash<QString, LazyVerifier> m_lazyVerifiers; ///< Absolute path -> chunk verifier
+    QThreadPool m_reverifyPool;                   ///< One low-priority thread; declared last so it stops first
 };
 
 } // namespace CodexiumMagnus::Services
@@ -0,0 +1,49 @@
+#include "TrustGate.h"
+#include "CartridgeService.h"
+
+namespace CodexiumMagnus::Services {
+
+TrustGate::TrustGate(const CartridgeService *cartridgeService)
+    : m_cartridgeService(cartridgeService)
+    , m_deferred()
+{
+}
+
+TrustGate::Decision TrustGate::decide() const {
+    if (!m_cartridgeService || !m_cartridgeService->isCartridgeLoaded()) {
+        return Decision::Run;
+    }
+    if (!m_cartridgeService->isTrustLevelDetermined()) {
+        return Decision::Defer;
+    }
+    return m_cartridgeService->getTrustLevel() == TrustLevel::Invalid ? Decision::Refuse : Decision::Run;
+}
+
+TrustGate::Decision TrustGate::submit(const QString& actionName, const std::function<void()>& action) {
+    const Decision decision = decide();
+    switch (decision) {
+    case Decision::Run:
+        action();
+        break;
+    case Decision::Defer:
+        m_deferred.append(qMakePair(actionName, action));
+        break;
+    case Decision::Refuse:
+        break;
+    }
+    return decision;
+}
+
+QStringList TrustGate::runDeferred() {
+    QStringList refused;
+    const auto deferred = m_deferred;
+    m_deferred.clear();
+    for (const auto& action : deferred) {
+        if (submit(action.first, action.second) == Decision::Refuse) {
+            refused.append(action.first);
+        }
+    }
+    return refused;
+}
+
+} // namespace CodexiumMagnus::Services
@@ -0,0 +1,65 @@
+#ifndef TRUSTGATE_H
+#define TRUSTGATE_H
+
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <functional>
+
+namespace CodexiumMagnus::Services {
+
+class CartridgeService;
+
+/**
+ * Gate for trust-sensitive actions (external links per FR-AT-9.3, printing
+ * per FR-AT-10.4) on the loaded cartridge.
+ *
+ * Actions run at once when no cartridge is loaded or its trust level allows
+ * them. While verification is still running they are held back and run by
+ * runDeferred() once the trust level is known. Only a cartridge found to be
+ * tampered with or corrupted (TrustLevel::Invalid) refuses them; unsigned
+ * and untrusted cartridges do not.
+ */
+class TrustGate {
+public:
+    enum class Decision {
+        Run,     ///< Action was run
+        Defer,   ///< Verification in progress; action runs from runDeferred()
+        Refuse   ///< Cartridge is Invalid; action was dropped
+    };
+
+    explicit TrustGate(const CartridgeService *cartridgeService);
+
+    /**
+     * Run an action, defer it until verification finishes, or refuse it.
+     * @param actionName User-visible name of the action, e.g. "Printing"
+     * @param action Action to run
+     * @return What happened to the action
+     */
+    Decision submit(const QString& actionName, const std::function<void()>& action);
+
+    /**
+     * Submit the deferred actions again; call once the trust level of the
+     * loaded cartridge has been determined.
+     * @return Names of the actions refused
+     */
+    QStringList runDeferred();
+
+    /**
+     * Drop deferred actions, e.g. when another cartridge is opened.
+     */
+    void clear() { m_deferred.clear(); }
+
+    int deferredCount() const { return m_deferred.size(); }
+
+private:
+    Decision decide() const;
+
+    const CartridgeService *m_cartridgeService;
+    QList<QPair<QString, std::function<void()>>> m_deferred;  ///< Actions held back while verifying
+};
+
+} // namespace CodexiumMagnus::Services
+
+#endif // TRUSTGATE_H
@@ -0,0 +1,193 @@
+#include "VerificationCache.h"
+#include <QCryptographicHash>
+#include <QFile>
+#include <QFileInfo>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QMutexLocker>
+#include <QDebug>
+#include <functional>
+
+#ifdef Q_OS_UNIX
+#include <sys/stat.h>
+#endif
+
+namespace CodexiumMagnus::Services {
+
+namespace {
+const QString kLoadSql = R"(
+    SELECT Path, Inode, Size, ModifiedMs, ManifestInode, ManifestSize, ManifestModifiedMs,
+           Digest, TrustLevel, KeyFingerprint, VerifiedUtc
+    FROM VerificationCache
+)";
+const QString kStoreSql = R"(
+    INSERT OR REPLACE INTO VerificationCache
+        (Path, Inode, Size, ModifiedMs, ManifestInode, ManifestSize, ManifestModifiedMs,
+         Digest, TrustLevel, KeyFingerprint, VerifiedUtc)
+    VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
+)";
+const QString kRemoveSql = "DELETE FROM VerificationCache WHERE Path = ?";
+
+QString cacheKey(const QString& path) {
+    return QFileInfo(path).absoluteFilePath();
+}
+
+/**
+ * Run work on a connection to the app database that lives for this call
+ * only, so it never crosses threads.
+ */
+bool withConnection(const QString& dbPath, const QString& connectionName,
+                    const std::function<bool(QSqlDatabase&)>& work) {
+    bool result = false;
+    {
+        QSqlDatabase database = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+        database.setDatabaseName(dbPath);
+        if (database.open()) {
+            result = work(database);
+            database.close();
+        } else {
+            qWarning() << "VerificationCache: Failed to open" << dbPath << ":" << database.lastError().text();
+        }
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+    return result;
+}
+}
+
+bool VerificationCache::FileIdentity::operator==(const FileIdentity& other) const {
+    return inode == other.inode && size == other.size && modifiedMs == other.modifiedMs;
+}
+
+VerificationCache::FileIdentity VerificationCache::FileIdentity::of(const QString& path) {
+    FileIdentity identity;
+#ifdef Q_OS_UNIX
+    struct stat info;
+    if (::stat(QFile::encodeName(path).constData(), &info) == 0 && S_ISREG(info.st_mode)) {
+#ifdef Q_OS_DARWIN
+        const qint64 nanoseconds = info.st_mtimespec.tv_nsec;
+#else
+        const qint64 nanoseconds = info.st_mtim.tv_nsec;
+#endif
+        identity.inode = static_cast<qint64>(info.st_ino);
+        identity.size = static_cast<qint64>(info.st_size);
+        identity.modifiedMs = static_cast<qint64>(info.st_mtime) * 1000 + nanoseconds / 1000000;
+    }
+#else
+    QFileInfo info(path);
+    if (info.isFile()) {
+        identity.size = info.size();
+        identity.modifiedMs = info.lastModified().toMSecsSinceEpoch();
+    }
+#endif
+    return identity;
+}
+
+VerificationCache::VerificationCache(const QString& dbPath)
+    : m_dbPath(dbPath)
+    , m_mutex()
+    , m_loaded(false)
+    , m_entries()
+{
+}
+
+bool VerificationCache::loadEntries() const {
+    if (m_loaded) {
+        return true;
+    }
+    QHash<QString, Entry> entries;
+    const bool loaded = withConnection(m_dbPath, QString("verification_cache_%1").arg(reinterpret_cast<quintptr>(this)),
+                                       [&entries](QSqlDatabase& database) {
+        QSqlQuery query(database);
+        query.setForwardOnly(true);
+        if (!query.exec(kLoadSql)) {
+            qWarning() << "VerificationCache: Failed to load:" << query.lastError().text();
+            return false;
+        }
+        while (query.next()) {
+            Entry entry;
+            entry.path = query.value(0).toString();
+            entry.identity.inode = query.value(1).toLongLong();
+            entry.identity.size = query.value(2).toLongLong();
+            entry.identity.modifiedMs = query.value(3).toLongLong();
+            entry.manifestIdentity.inode = query.value(4).toLongLong();
+            entry.manifestIdentity.size = query.value(5).toLongLong();
+            entry.manifestIdentity.modifiedMs = query.value(6).toLongLong();
+            entry.digest = query.value(7).toByteArray();
+            entry.trustLevel = static_cast<TrustLevel>(query.value(8).toInt());
+            entry.keyFingerprint = query.value(9).toString();
+            entry.verifiedUtc = QDateTime::fromString(query.value(10).toString(), Qt::ISODate);
+            entries.insert(entry.path, entry);
+        }
+        return true;
+    });
+    if (loaded) {
+        m_entries.swap(entries);
+        m_loaded = true;
+    }
+    return loaded;
+}
+
+bool VerificationCache::lookup(const QString& path, Entry& entry) const {
+    QMutexLocker locker(&m_mutex);
+    if (!loadEntries()) {
+        return false;
+    }
+    const auto it = m_entries.constFind(cacheKey(path));
+    if (it == m_entries.constEnd()) {
+        return false;
+    }
+    entry = it.value();
+    return true;
+}
+
+bool VerificationCache::store(const Entry& entry) {
+    QMutexLocker locker(&m_mutex);
+    Entry stored = entry;
+    stored.path = cacheKey(entry.path);
+    const bool written = withConnection(m_dbPath, QString("verification_cache_%1").arg(reinterpret_cast<quintptr>(this)),
+                                        [&stored](QSqlDatabase& database) {
+        QSqlQuery query(database);
+        query.prepare(kStoreSql);
+        query.addBindValue(stored.path);
+        query.addBindValue(stored.identity.inode);
+        query.addBindValue(stored.identity.size);
+        query.addBindValue(stored.identity.modifiedMs);
+        query.addBindValue(stored.manifestIdentity.inode);
+        query.addBindValue(stored.manifestIdentity.size);
+        query.addBindValue(stored.manifestIdentity.modifiedMs);
+        query.addBindValue(stored.digest);
+        query.addBindValue(static_cast<int>(stored.trustLevel));
+        query.addBindValue(stored.keyFingerprint);
+        query.addBindValue(stored.verifiedUtc.toUTC().toString(Qt::ISODate));
+        if (!query.exec()) {
+            qWarning() << "VerificationCache: Failed to store" << stored.path << ":" << query.lastError().text();
+            return false;
+        }
+        return true;
+    });
+    if (written && m_loaded) {
+        m_entries.insert(stored.path, stored);
+    }
+    return written;
+}
+
+void VerificationCache::remove(const QString& path) {
+    QMutexLocker locker(&m_mutex);
+    const QString key = cacheKey(path);
+    // Forgotten even if the database cannot be written, so it is not trusted again
+    m_entries.remove(key);
+    withConnection(m_dbPath, QString("verification_cache_%1").arg(reinterpret_cast<quintptr>(this)),
+                   [&key](QSqlDatabase& database) {
+        QSqlQuery query(database);
+        query.prepare(kRemoveSql);
+        query.addBindValue(key);
+        return query.exec();
+    });
+}
+
+QString VerificationCache::keyFingerprint(const QByteArray& publicKey) {
+    return QString::fromLatin1(QCryptographicHash::hash(publicKey, QCryptographicHash::Sha256).toHex());
+}
+
+} // namespace CodexiumMagnus::Services
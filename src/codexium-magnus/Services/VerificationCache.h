@@ -0,0 +1,108 @@
+#ifndef VERIFICATIONCACHE_H
+#define VERIFICATIONCACHE_H
+
+#include "ISignatureService.h"
+#include <QByteArray>
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+namespace CodexiumMagnus::Services {
+
+/**
+ * Results of earlier cartridge verifications, kept in the local app
+ * database (the VerificationCache table created by
+ * Storage::DbInitializer).
+ *
+ * Cartridges are immutable once signed (NFR-2), so a cartridge whose file
+ * identity (inode, size, modification time) and whose sidecar manifest's
+ * identity are unchanged since it was verified does not need to be hashed
+ * again; SignatureService answers such loads from the cache and re-verifies
+ * them in the background (see SignatureService::setReverifyInterval()).
+ *
+ * The table is read into memory on the first lookup, so loads do not touch
+ * the app database; store() and remove() write through. Writes open a
+ * short-lived connection, so the cache may be used from the load and
+ * verification threads; calls are serialized.
+ */
+class VerificationCache {
+public:
+    /**
+     * What identifies a cartridge file between verifications.
+     */
+    struct FileIdentity {
+        qint64 inode = 0;          ///< Inode (file index); 0 where the platform has none
+        qint64 size = -1;          ///< Size in bytes; -1 if the file could not be read
+        qint64 modifiedMs = 0;     ///< Last modification, ms since the epoch (UTC)
+
+        bool isValid() const { return size >= 0; }
+        bool operator==(const FileIdentity& other) const;
+        bool operator!=(const FileIdentity& other) const { return !(*this == other); }
+
+        /**
+         * Identity of a file, read with a single stat call.
+         */
+        static FileIdentity of(const QString& path);
+    };
+
+    /**
+     * Verification result for one cartridge.
+     */
+    struct Entry {
+        QString path;              ///< Absolute path of the cartridge
+        FileIdentity identity;     ///< Identity of the file that was verified
+        FileIdentity manifestIdentity;  ///< Identity of its sidecar manifest
+        QByteArray digest;         ///< Signed message digest (manifest + database)
+        TrustLevel trustLevel = TrustLevel::Unverified;  ///< Trust level when verified
+        QString keyFingerprint;    ///< keyFingerprint() of the signing key
+        QDateTime verifiedUtc;     ///< When the digest was last computed
+    };
+
+    /**
+     * @param dbPath Path to the app database; its schema must exist
+     *               (see Storage::DbInitializer::ensureCreated())
+     */
+    explicit VerificationCache(const QString& dbPath);
+
+    QString databasePath() const { return m_dbPath; }
+
+    /**
+     * Look up the cached verification of a cartridge.
+     * @param path Path to the cartridge
+     * @param entry Receives the cached result
+     * @return true if the cartridge has a cached result
+     */
+    bool lookup(const QString& path, Entry& entry) const;
+
+    /**
+     * Store or replace the verification result of a cartridge.
+     * @return true if the entry was written
+     */
+    bool store(const Entry& entry);
+
+    /**
+     * Forget the verification result of a cartridge.
+     */
+    void remove(const QString& path);
+
+    /**
+     * Fingerprint of a public key: hex SHA-256 of its bytes.
+     */
+    static QString keyFingerprint(const QByteArray& publicKey);
+
+private:
+    /**
+     * Read the table into m_entries unless already done; call with m_mutex held.
+     */
+    bool loadEntries() const;
+
+    QString m_dbPath;
+    mutable QMutex m_mutex;    ///< Serializes access to the app database and m_entries
+    mutable bool m_loaded;     ///< m_entries holds the table
+    mutable QHash<QString, Entry> m_entries;  ///< Absolute path -> cached result
+};
+
+} // namespace CodexiumMagnus::Services
+
+#endif // VERIFICATIONCACHE_H
@@ -0,0 +1,469 @@
+#include "VerifyingVfs.h"
+#include <QFileInfo>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPair>
+#include <QSqlDatabase>
+#include <QDebug>
+#include <cstring>
+
+#ifdef HAVE_SQLITE3_VFS
+#include <sqlite3.h>
+#endif
+
+namespace CodexiumMagnus::Services {
+
+namespace {
+const char kVfsName[] = "codexium-verify";
+
+// Reads recorded per file before its verifier is attached; beyond this the
+// whole file is verified on attach
+const int kMaxUnverifiedReads = 256;
+
+struct TrackedFile {
+    std::shared_ptr<ChunkVerifier> verifier;
+    QList<QPair<qint64, qint64>> unverifiedReads;  ///< (offset, length) read before attach
+    bool overflowed = false;                       ///< More reads than kMaxUnverifiedReads
+    int openFiles = 0;                             ///< Open SQLite handles on the file
+};
+
+QMutex& registryMutex() {
+    static QMutex mutex;
+    return mutex;
+}
+
+QHash<QString, TrackedFile>& registry() {
+    static QHash<QString, TrackedFile> files;
+    return files;
+}
+
+QString fileKey(const QString& path) {
+    return QFileInfo(path).absoluteFilePath();
+}
+
+#ifdef HAVE_SQLITE3_VFS
+/**
+ * Verifier of a file, or record the read if none is attached yet.
+ */
+std::shared_ptr<ChunkVerifier> verifierOrRecordRead(const QString& key, qint64 offset, qint64 length) {
+    QMutexLocker locker(&registryMutex());
+    auto it = registry().find(key);
+    if (it == registry().end()) {
+        return nullptr;
+    }
+    if (it->verifier) {
+        return it->verifier;
+    }
+    if (it->unverifiedReads.size() < kMaxUnverifiedReads) {
+        it->unverifiedReads.append(qMakePair(offset, length));
+    } else {
+        it->overflowed = true;
+    }
+    return nullptr;
+}
+
+void fileOpened(const QString& key) {
+    QMutexLocker locker(&registryMutex());
+    ++registry()[key].openFiles;
+}
+
+void fileClosed(const QString& key) {
+    QMutexLocker locker(&registryMutex());
+    auto it = registry().find(key);
+    if (it == registry().end()) {
+        return;
+    }
+    // Pages read by closed connections are gone with their page cache
+    if (--it->openFiles <= 0 && !it->verifier) {
+        registry().erase(it);
+    }
+}
+
+/**
+ * Main database file of a cartridge; the real file of the default VFS
+ * follows this struct in the same allocation.
+ */
+struct VerifyingFile {
+    sqlite3_file base;                      ///< Must be first
+    sqlite3_file *real;
+    QString *key;                           ///< Null for files that are not verified
+};
+
+sqlite3_vfs* baseVfs(sqlite3_vfs *vfs) {
+    return static_cast<sqlite3_vfs*>(vfs->pAppData);
+}
+
+sqlite3_file* realFile(sqlite3_file *file) {
+    return reinterpret_cast<VerifyingFile*>(file)->real;
+}
+
+/**
+ * Verify bytes SQLite read; with data null, verify the range on disk.
+ */
+bool verifyRead(sqlite3_file *file, qint64 offset, const void *data, qint64 length) {
+    auto *verifying = reinterpret_cast<VerifyingFile*>(file);
+    if (!verifying->key) {
+        return true;
+    }
+    // Looked up on every read, so attach() and detach() reach open files
+    const std::shared_ptr<ChunkVerifier> verifier = verifierOrRecordRead(*verifying->key, offset, length);
+    if (!verifier) {
+        return true;
+    }
+    return data ? verifier->verifyRead(offset, static_cast<const char*>(data), length)
+                : verifier->verifyRange(offset, length);
+}
+
+int fileClose(sqlite3_file *file) {
+    auto *verifying = reinterpret_cast<VerifyingFile*>(file);
+    const int result = verifying->real->pMethods->xClose(verifying->real);
+    if (verifying->key) {
+        fileClosed(*verifying->key);
+        delete verifying->key;
+        verifying->key = nullptr;
+    }
+    return result;
+}
+
+int fileRead(sqlite3_file *file, void *buffer, int amount, sqlite3_int64 offset) {
+    // Verify what was read, not a second read of the file, so the file
+    // cannot change between the check and the read
+    sqlite3_file *real = realFile(file);
+    const int result = real->pMethods->xRead(real, buffer, amount, offset);
+    const bool verified = result == SQLITE_OK ? verifyRead(file, offset, buffer, amount)
+                        : result == SQLITE_IOERR_SHORT_READ ? verifyRead(file, offset, nullptr, amount)
+                        : true;
+    if (!verified) {
+        std::memset(buffer, 0, amount);
+        return SQLITE_IOERR_READ;
+    }
+    return result;
+}
+
+int fileWrite(sqlite3_file *file, const void *buffer, int amount, sqlite3_int64 offset) {
+    sqlite3_file *real = realFile(file);
+    return real->pMethods->xWrite(real, buffer, amount, offset);
+}
+
+int fileTruncate(sqlite3_file *file, sqlite3_int64 size) {
+    sqlite3_file *real = realFile(file);
+    return real->pMethods->xTruncate(real, size);
+}
+
+int fileSync(sqlite3_file *file, int flags) {
+    sqlite3_file *real = realFile(file);
+    return real->pMethods->xSync(real, flags);
+}
+
+int fileSize(sqlite3_file *file, sqlite3_int64 *size) {
+    sqlite3_file *real = realFile(file);
+    return real->pMethods->xFileSize(real, size);
+}
+
+int fileLock(sqlite3_file *file, int lock) {
+    sqlite3_file *real = realFile(file);
+    return real->pMethods->xLock(real, lock);
+}
+
+int fileUnlock(sqlite3_file *file, int lock) {
+    sqlite3_file *real = realFile(file);
+    return real->pMethods->xUnlock(real, lock);
+}
+
+int fileCheckReservedLock(sqlite3_file *file, int *result) {
+    sqlite3_file *real = realFile(file);
+    return real->pMethods->xCheckReservedLock(real, result);
+}
+
+int fileControl(sqlite3_file *file, int op, void *arg) {
+    sqlite3_file *real = realFile(file);
+    return real->pMethods->xFileControl(real, op, arg);
+}
+
+int fileSectorSize(sqlite3_file *file) {
+    sqlite3_file *real = realFile(file);
+    return real->pMethods->xSectorSize(real);
+}
+
+int fileDeviceCharacteristics(sqlite3_file *file) {
+    sqlite3_file *real = realFile(file);
+    return real->pMethods->xDeviceCharacteristics(real);
+}
+
+int fileShmMap(sqlite3_file *file, int region, int size, int extend, void volatile **memory) {
+    sqlite3_file *real = realFile(file);
+    if (real->pMethods->iVersion < 2) {
+        return SQLITE_IOERR_SHMMAP;
+    }
+    return real->pMethods->xShmMap(real, region, size, extend, memory);
+}
+
+int fileShmLock(sqlite3_file *file, int offset, int count, int flags) {
+    sqlite3_file *real = realFile(file);
+    if (real->pMethods->iVersion < 2) {
+        return SQLITE_IOERR_SHMLOCK;
+    }
+    return real->pMethods->xShmLock(real, offset, count, flags);
+}
+
+void fileShmBarrier(sqlite3_file *file) {
+    sqlite3_file *real = realFile(file);
+    if (real->pMethods->iVersion >= 2) {
+        real->pMethods->xShmBarrier(real);
+    }
+}
+
+int fileShmUnmap(sqlite3_file *file, int deleteFlag) {
+    sqlite3_file *real = realFile(file);
+    if (real->pMethods->iVersion < 2) {
+        return SQLITE_OK;
+    }
+    return real->pMethods->xShmUnmap(real, deleteFlag);
+}
+
+int fileFetch(sqlite3_file *file, sqlite3_int64 offset, int amount, void **pointer) {
+    *pointer = nullptr;
+    sqlite3_file *real = realFile(file);
+    if (real->pMethods->iVersion < 3) {
+        return SQLITE_OK;
+    }
+    const int result = real->pMethods->xFetch(real, offset, amount, pointer);
+    // Without a mapping SQLite falls back to xRead, which reports the failure
+    if (result == SQLITE_OK && *pointer && !verifyRead(file, offset, *pointer, amount)) {
+        real->pMethods->xUnfetch(real, offset, *pointer);
+        *pointer = nullptr;
+    }
+    return result;
+}
+
+int fileUnfetch(sqlite3_file *file, sqlite3_int64 offset, void *pointer) {
+    sqlite3_file *real = realFile(file);
+    if (real->pMethods->iVersion < 3) {
+        return SQLITE_OK;
+    }
+    return real->pMethods->xUnfetch(real, offset, pointer);
+}
+
+const sqlite3_io_methods kIoMethods = {
+    3,
+    fileClose,
+    fileRead,
+    fileWrite,
+    fileTruncate,
+    fileSync,
+    fileSize,
+    fileLock,
+    fileUnlock,
+    fileCheckReservedLock,
+    fileControl,
+    fileSectorSize,
+    fileDeviceCharacteristics,
+    fileShmMap,
+    fileShmLock,
+    fileShmBarrier,
+    fileShmUnmap,
+    fileFetch,
+    fileUnfetch
+};
+
+int vfsOpen(sqlite3_vfs *vfs, const char *name, sqlite3_file *file, int flags, int *outFlags) {
+    auto *verifying = reinterpret_cast<VerifyingFile*>(file);
+    verifying->base.pMethods = nullptr;
+    verifying->real = reinterpret_cast<sqlite3_file*>(verifying + 1);
+    verifying->key = nullptr;
+
+    sqlite3_vfs *base = baseVfs(vfs);
+    const int result = base->xOpen(base, name, verifying->real, flags, outFlags);
+    if (result != SQLITE_OK) {
+        if (verifying->real->pMethods) {
+            verifying->real->pMethods->xClose(verifying->real);
+        }
+        return result;
+    }
+
+    // Journals and temporary files are not part of the signed cartridge
+    if (name && (flags & SQLITE_OPEN_MAIN_DB)) {
+        verifying->key = new QString(fileKey(QString::fromUtf8(name)));
+        fileOpened(*verifying->key);
+    }
+    verifying->base.pMethods = &kIoMethods;
+    return SQLITE_OK;
+}
+
+int vfsDelete(sqlite3_vfs *vfs, const char *name, int syncDir) {
+    return baseVfs(vfs)->xDelete(baseVfs(vfs), name, syncDir);
+}
+
+int vfsAccess(sqlite3_vfs *vfs, const char *name, int flags, int *result) {
+    return baseVfs(vfs)->xAccess(baseVfs(vfs), name, flags, result);
+}
+
+int vfsFullPathname(sqlite3_vfs *vfs, const char *name, int size, char *out) {
+    return baseVfs(vfs)->xFullPathname(baseVfs(vfs), name, size, out);
+}
+
+void* vfsDlOpen(sqlite3_vfs *vfs, const char *name) {
+    return baseVfs(vfs)->xDlOpen(baseVfs(vfs), name);
+}
+
+void vfsDlError(sqlite3_vfs *vfs, int size, char *message) {
+    baseVfs(vfs)->xDlError(baseVfs(vfs), size, message);
+}
+
+void (*vfsDlSym(sqlite3_vfs *vfs, void *handle, const char *symbol))(void) {
+    return baseVfs(vfs)->xDlSym(baseVfs(vfs), handle, symbol);
+}
+
+void vfsDlClose(sqlite3_vfs *vfs, void *handle) {
+    baseVfs(vfs)->xDlClose(baseVfs(vfs), handle);
+}
+
+int vfsRandomness(sqlite3_vfs *vfs, int size, char *out) {
+    return baseVfs(vfs)->xRandomness(baseVfs(vfs), size, out);
+}
+
+int vfsSleep(sqlite3_vfs *vfs, int microseconds) {
+    return baseVfs(vfs)->xSleep(baseVfs(vfs), microseconds);
+}
+
+int vfsCurrentTime(sqlite3_vfs *vfs, double *time) {
+    return baseVfs(vfs)->xCurrentTime(baseVfs(vfs), time);
+}
+
+int vfsGetLastError(sqlite3_vfs *vfs, int size, char *message) {
+    return baseVfs(vfs)->xGetLastError(baseVfs(vfs), size, message);
+}
+
+int vfsCurrentTimeInt64(sqlite3_vfs *vfs, sqlite3_int64 *time) {
+    sqlite3_vfs *base = baseVfs(vfs);
+    if (base->iVersion >= 2 && base->xCurrentTimeInt64) {
+        return base->xCurrentTimeInt64(base, time);
+    }
+    double days = 0;
+    const int result = base->xCurrentTime(base, &days);
+    *time = static_cast<sqlite3_int64>(days * 86400000.0);
+    return result;
+}
+
+/**
+ * Whether the QSQLITE driver can open a database through the VFS, i.e. uses
+ * the SQLite library it was registered with.
+ */
+bool driverOpensWithVfs() {
+    const QString connectionName = QString("verifying_vfs_probe");
+    bool opened = false;
+    {
+        QSqlDatabase database = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+        database.setConnectOptions("QSQLITE_OPEN_URI");
+        database.setDatabaseName(QString("file::memory:?vfs=%1").arg(QLatin1String(kVfsName)));
+        opened = database.open();
+        database.close();
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+    return opened;
+}
+#endif
+}
+
+QString VerifyingVfs::name() {
+    return QString::fromLatin1(kVfsName);
+}
+
+bool VerifyingVfs::registerVfs() {
+#ifdef HAVE_SQLITE3_VFS
+    static const bool registered = []() {
+        sqlite3_vfs *base = sqlite3_vfs_find(nullptr);
+        if (!base) {
+            qWarning() << "VerifyingVfs: No default SQLite VFS";
+            return false;
+        }
+
+        static sqlite3_vfs vfs = {};
+        vfs.iVersion = 2;
+        vfs.szOsFile = static_cast<int>(sizeof(VerifyingFile)) + base->szOsFile;
+        vfs.mxPathname = base->mxPathname;
+        vfs.zName = kVfsName;
+        vfs.pAppData = base;
+        vfs.xOpen = vfsOpen;
+        vfs.xDelete = vfsDelete;
+        vfs.xAccess = vfsAccess;
+        vfs.xFullPathname = vfsFullPathname;
+        vfs.xDlOpen = vfsDlOpen;
+        vfs.xDlError = vfsDlError;
+        vfs.xDlSym = vfsDlSym;
+        vfs.xDlClose = vfsDlClose;
+        vfs.xRandomness = vfsRandomness;
+        vfs.xSleep = vfsSleep;
+        vfs.xCurrentTime = vfsCurrentTime;
+        vfs.xGetLastError = vfsGetLastError;
+        vfs.xCurrentTimeInt64 = vfsCurrentTimeInt64;
+
+        const int result = sqlite3_vfs_register(&vfs, 0);
+        if (result != SQLITE_OK) {
+            qWarning() << "VerifyingVfs: Failed to register VFS:" << sqlite3_errstr(result);
+            return false;
+        }
+        // A Qt built with its bundled SQLite does not see VFSes registered
+        // with this library, and would fail to open cartridges with it
+        if (!driverOpensWithVfs()) {
+            qWarning() << "VerifyingVfs: Qt's SQLite driver uses another SQLite library; lazy verification disabled";
+            sqlite3_vfs_unregister(&vfs);
+            return false;
+        }
+        return true;
+    }();
+    return registered;
+#else
+    return false;
+#endif
+}
+
+bool VerifyingVfs::attach(const QString& path, const std::shared_ptr<ChunkVerifier>& verifier) {
+    if (!verifier) {
+        return false;
+    }
+
+    QList<QPair<qint64, qint64>> reads;
+    bool overflowed = false;
+    {
+        QMutexLocker locker(&registryMutex());
+        TrackedFile& file = registry()[fileKey(path)];
+        file.verifier = verifier;
+        reads.swap(file.unverifiedReads);
+        overflowed = file.overflowed;
+        file.overflowed = false;
+    }
+
+    // Pages read before now may sit in a connection's page cache
+    if (overflowed) {
+        return verifier->verifyAll();
+    }
+    for (const auto& read : reads) {
+        if (!verifier->verifyRange(read.first, read.second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void VerifyingVfs::detach(const QString& path) {
+    QMutexLocker locker(&registryMutex());
+    auto it = registry().find(fileKey(path));
+    if (it == registry().end()) {
+        return;
+    }
+    if (it->openFiles > 0) {
+        it->verifier.reset();
+    } else {
+        registry().erase(it);
+    }
+}
+
+std::shared_ptr<ChunkVerifier> VerifyingVfs::verifier(const QString& path) {
+    QMutexLocker locker(&registryMutex());
+    return registry().value(fileKey(path)).verifier;
+}
+
+} // namespace CodexiumMagnus::Services
@@ -0,0 +1,69 @@
+#ifndef VERIFYINGVFS_H
+#define VERIFYINGVFS_H
+
+#include "ChunkVerifier.h"
+#include <QString>
+#include <memory>
+
+namespace CodexiumMagnus::Services {
+
+/**
+ * SQLite VFS that checks every read of a cartridge against its
+ * ChunkVerifier (lazy integrity verification).
+ *
+ * Connections select it with CartridgeOpenProfile::vfs = name(). The VFS
+ * wraps the default one and forwards every call to it; for the main
+ * database file of a cartridge it verifies the bytes returned by each
+ * xRead, and by each xFetch when the file is memory mapped, against the
+ * chunks they cover (see ChunkVerifier::verifyRead()). A read touching a
+ * chunk that fails verification returns SQLITE_IOERR_READ, so the query
+ * fails instead of returning tampered content.
+ *
+ * A connection may read before the cartridge's verifier is attached (the
+ * header and schema are read on open, before the signature has been
+ * checked). Those reads are recorded and their ranges verified on disk
+ * when attach() is called; if too many accumulate, attach() verifies the
+ * whole file instead.
+ *
+ * Built with the ENABLE_VERIFYING_VFS option (HAVE_SQLITE3_VFS), on by
+ * default where SQLite is found. The VFS only works if the QSQLITE driver
+ * uses the same SQLite library; registerVfs() checks that, and where it
+ * fails (or the option is off) cartridges are hashed whole before they are
+ * trusted.
+ */
+class VerifyingVfs {
+public:
+    /**
+     * Name to select the VFS by, "codexium-verify".
+     */
+    static QString name();
+
+    /**
+     * Register the VFS with SQLite. Safe to call more than once.
+     * @return true if the QSQLITE driver can open cartridges through it
+     */
+    static bool registerVfs();
+
+    /**
+     * Verify reads of a cartridge file from now on, including reads done
+     * before this call.
+     * @param path Path to the cartridge file
+     * @param verifier Verifier holding the file's signed chunk table
+     * @return false if one of the earlier reads fails verification
+     */
+    static bool attach(const QString& path, const std::shared_ptr<ChunkVerifier>& verifier);
+
+    /**
+     * Stop verifying reads of a cartridge file.
+     */
+    static void detach(const QString& path);
+
+    /**
+     * Verifier attached to a cartridge file, if any.
+     */
+    static std::shared_ptr<ChunkVerifier> verifier(const QString& path);
+};
+
+} // namespace CodexiumMagnus::Services
+
+#endif // VERIFYINGVFS_H
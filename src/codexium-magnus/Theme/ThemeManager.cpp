@@ -6,6 +6,7 @@
 #include <QStandardPaths>
 #include <QDebug>
 #include <QRegularExpression>
+#include <QJsonArray>
 
 namespace CodexiumMagnus::Theme {
 
@@ -313,4 +314,26 @@ void ThemeManager::loadThemePreference() {
     }
 }
 
-} // namespace CodexiumMagnus::Theme
\ No newline at end of file
+QJsonObject ThemeManager::tokenDiff(const QMap<QString, QString>& from, const QMap<QString, QString>& to) {
+    QJsonObject set;
+    for (auto it = to.constBegin(); it != to.constEnd(); ++it) {
+        auto previous = from.constFind(it.key());
+        if (previous == from.constEnd() || previous.value() != it.value()) {
+            set[it.key()] = it.value();
+        }
+    }
+    
+    QJsonArray remove;
+    for (auto it = from.constBegin(); it != from.constEnd(); ++it) {
+        if (!to.contains(it.key())) {
+            remove.append(it.key());
+        }
+    }
+    
+    QJsonObject diff;
+    diff["set"] = set;
+    diff["remove"] = remove;
+    return diff;
+}
+
+} // namespace CodexiumMagnus::Theme
@@ -4,6 +4,7 @@
 #include <QObject>
 #include <QString>
 #include <QMap>
+#include <QJsonObject>
 #include <QPalette>
 #include <QSettings>
 
@@ -39,6 +40,13 @@ public:
     QMap<QString, QString> getTokenMap() const { return m_tokens; }
     QString getToken(const QString& tokenName) const;
     
+    /**
+     * Tokens that differ between two token maps, in the form pages apply
+     * to switch themes in place: {"set": {token: value}, "remove": [token]}.
+     * Both members are empty if the maps are equal.
+     */
+    static QJsonObject tokenDiff(const QMap<QString, QString>& from, const QMap<QString, QString>& to);
+    
     void saveThemePreference();
     void loadThemePreference();
 
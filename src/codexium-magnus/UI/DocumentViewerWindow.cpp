@@ -1,9 +1,11 @@
 #include "DocumentViewerWindow.h"
+#include "../Services/CartridgeSchemeHandler.h"
 #include <QApplication>
 #include <QKeySequence>
 #include <QSettings>
 #include <QMessageBox>
 #include <QDebug>
+#include <QJsonDocument>
 
 namespace CodexiumMagnus::UI {
 
@@ -25,6 +27,7 @@ DocumentViewerWindow::DocumentViewerWindow(const QString& cartridgeName,
     , m_webEngineBridge(nullptr)
     , m_zoomFactor(ZOOM_DEFAULT)
     , m_currentDocumentId()
+    , m_themeTokens(themeManager ? themeManager->getTokenMap() : QMap<QString, QString>())
 {
     // Load saved zoom factor
     QSettings settings("CodexiumMagnus", "Settings");
@@ -88,21 +91,31 @@ void DocumentViewerWindow::setupWebEngine() {
             });
 }
 
-void DocumentViewerWindow::loadDocument(const QString& documentId, const QString& content) {
+void DocumentViewerWindow::loadDocument(const QString& documentId) {
     m_currentDocumentId = documentId;
-    m_currentDocumentContent = content;
     
-    QString wrappedContent = wrapContentWithTheme(content);
-    m_webEngineView->setHtml(wrappedContent);
+    // Streamed by the scheme handler instead of being pushed through setHtml()
+    m_webEngineView->load(Services::CartridgeSchemeHandler::documentUrl(m_cartridgePath, documentId));
     
     statusBar()->showMessage(QString("Loaded: %1").arg(documentId), 2000);
 }
 
 void DocumentViewerWindow::updateTheme() {
-    if (!m_currentDocumentContent.isEmpty()) {
-        QString wrappedContent = wrapContentWithTheme(m_currentDocumentContent);
-        m_webEngineView->setHtml(wrappedContent);
+    if (!m_themeManager) {
+        return;
+    }
+    
+    const QMap<QString, QString> tokens = m_themeManager->getTokenMap();
+    QJsonObject payload = Theme::ThemeManager::tokenDiff(m_themeTokens, tokens);
+    m_themeTokens = tokens;
+    if (m_currentDocumentId.isEmpty()) {
+        return;
     }
+    
+    // Pages are loaded with the current tokens by the profile script; the
+    // shown one only needs what changed
+    payload["type"] = "theme:update";
+    m_webEngineBridge->send(QString::fromUtf8(QJsonDocument(payload).toJson(QJsonDocument::Compact)));
 }
 
 void DocumentViewerWindow::setZoomFactor(qreal factor) {
@@ -166,54 +179,4 @@ void DocumentViewerWindow::saveWindowState() {
     settings.setValue(QString("viewer/%1/zoom").arg(m_cartridgePath), m_zoomFactor);
 }
 
-QString DocumentViewerWindow::wrapContentWithTheme(const QString& htmlContent) {
-    if (!m_themeManager) {
-        return htmlContent;
-    }
-    
-    // Get theme tokens
-    QMap<QString, QString> tokens = m_themeManager->getTokenMap();
-    
-    // Build CSS with theme tokens
-    QString css = "<style>\n";
-    css += ":root {\n";
-    for (auto it = tokens.constBegin(); it != tokens.constEnd(); ++it) {
-        css += QString("  %1: %2;\n").arg(it.key(), it.value());
-    }
-    css += "}\n";
-    css += "body {\n";
-    css += "  background-color: var(--color-background-primary);\n";
-    css += "  color: var(--color-text-primary);\n";
-    css += "  font-family: var(--font-family-base);\n";
-    css += "  font-size: var(--font-size-base);\n";
-    css += "}\n";
-    css += "a {\n";
-    css += "  color: var(--color-link);\n";
-    css += "}\n";
-    css += "a:hover {\n";
-    css += "  color: var(--color-link-hover);\n";
-    css += "}\n";
-    css += "</style>\n";
-    
-    // Inject CSS into HTML
-    QString wrapped = htmlContent;
-    
-    // Find </head> or <body> tag and insert CSS before it
-    int headEnd = wrapped.indexOf("</head>", 0, Qt::CaseInsensitive);
-    if (headEnd != -1) {
-        wrapped.insert(headEnd, css);
-    } else {
-        // No </head> tag, insert before <body> or at start
-        int bodyStart = wrapped.indexOf("<body", 0, Qt::CaseInsensitive);
-        if (bodyStart != -1) {
-            wrapped.insert(bodyStart, css);
-        } else {
-            // No body tag either, prepend
-            wrapped = css + wrapped;
-        }
-    }
-    
-    return wrapped;
-}
-
 } // namespace CodexiumMagnus::UI
@@ -32,7 +32,17 @@ public:
     QString cartridgeName() const { return m_cartridgeName; }
     QString cartridgePath() const { return m_cartridgePath; }
     
-    void loadDocument(const QString& documentId, const QString& content);
+    /**
+     * Load a document of this window's cartridge from its cdoc:// URL.
+     * The cartridge must be served by the CartridgeSchemeHandler installed
+     * on the default profile.
+     */
+    void loadDocument(const QString& documentId);
+
+    /**
+     * Apply the theme manager's current tokens to the shown document in
+     * place, by sending the changed tokens to the page (no reload).
+     */
     void updateTheme();
     void setZoomFactor(qreal factor);
     qreal zoomFactor() const { return m_zoomFactor; }
@@ -57,7 +67,6 @@ private:
     void setupWebEngine();
     void loadWindowState();
     void saveWindowState();
-    QString wrapContentWithTheme(const QString& htmlContent);
     
     QString m_cartridgeName;
     QString m_cartridgePath;
@@ -72,8 +81,8 @@ private:
     static const qreal ZOOM_STEP;
     static const qreal ZOOM_DEFAULT;
     
-    QString m_currentDocumentContent;
     QString m_currentDocumentId;
+    QMap<QString, QString> m_themeTokens;  ///< Tokens the shown page was last themed with
 };
 
 } // namespace CodexiumMagnus::UI
@@ -1,5 +1,7 @@
 #include "NavigationPane.h"
+#include "../Services/CartridgeNavigationModel.h"
 #include <QHeaderView>
+#include <QStandardItemModel>
 
 namespace CodexiumMagnus::UI {
 
@@ -37,8 +39,9 @@ NavigationPane::~NavigationPane() {
     // Qt parent system handles cleanup
 }
 
-void NavigationPane::setNavigationModel(QStandardItemModel *model) {
+void NavigationPane::setNavigationModel(QAbstractItemModel *model) {
     if (m_model && m_model != model) {
+        disconnect(m_treeView, nullptr, m_model, nullptr);
         m_treeView->setModel(nullptr);
         if (m_model->parent() == this) {
             delete m_model;
@@ -48,12 +51,21 @@ void NavigationPane::setNavigationModel(QStandardItemModel *model) {
     m_model = model;
     if (m_model) {
         m_treeView->setModel(m_model);
+        
+        // Let lazy models release the children of collapsed nodes
+        if (auto *lazyModel = qobject_cast<Services::CartridgeNavigationModel*>(m_model)) {
+            connect(m_treeView, &QTreeView::expanded,
+                    lazyModel, &Services::CartridgeNavigationModel::onNodeExpanded, Qt::UniqueConnection);
+            connect(m_treeView, &QTreeView::collapsed,
+                    lazyModel, &Services::CartridgeNavigationModel::onNodeCollapsed, Qt::UniqueConnection);
+        }
     }
 }
 
 void NavigationPane::clear() {
-    if (m_model) {
-        m_model->clear();
+    // The model is owned by the cartridge service and reset on unload
+    if (auto *standardModel = qobject_cast<QStandardItemModel*>(m_model)) {
+        standardModel->clear();
     }
 }
 
@@ -5,14 +5,14 @@
 #include <QTreeView>
 #include <QVBoxLayout>
 #include <QLabel>
-#include <QStandardItemModel>
+#include <QAbstractItemModel>
 
 namespace CodexiumMagnus::UI {
 
 /**
  * Navigation pane showing corpus → volume → document hierarchy.
  * Populated by Cartridge Service.
- * Uses QTreeView with custom model.
+ * Uses QTreeView with custom model; lazy models are fetched as nodes expand.
  */
 class NavigationPane : public QWidget {
     Q_OBJECT
@@ -21,7 +21,7 @@ public:
     explicit NavigationPane(QWidget *parent = nullptr);
     ~NavigationPane();
 
-    void setNavigationModel(QStandardItemModel *model);
+    void setNavigationModel(QAbstractItemModel *model);
     void clear();
 
 signals:
@@ -35,7 +35,7 @@ private:
     QVBoxLayout *m_layout;
     QLabel *m_titleLabel;
     QTreeView *m_treeView;
-    QStandardItemModel *m_model;
+    QAbstractItemModel *m_model;
 };
 
 } // namespace CodexiumMagnus::UI
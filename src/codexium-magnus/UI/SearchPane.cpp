@@ -1,8 +1,17 @@
 #include "SearchPane.h"
+#include "SearchResultsModel.h"
+#include "SearchResultDelegate.h"
 #include <QKeyEvent>
+#include <QScrollBar>
 
 namespace CodexiumMagnus::UI {
 
+namespace {
+const int kDefaultLiveSearchDelayMs = 150;
+const int kMinLiveSearchLength = 2;  // Single-character prefixes match nearly everything
+const int kSnippetRequestDelayMs = 30;  // Rows flicked past while scrolling are not requested
+}
+
 SearchPane::SearchPane(QWidget *parent)
     : QWidget(parent)
     , m_mainLayout(nullptr)
@@ -15,6 +24,11 @@ SearchPane::SearchPane(QWidget *parent)
     , m_wildcardCheck(nullptr)
     , m_resultsList(nullptr)
     , m_resultsModel(nullptr)
+    , m_resultCountLabel(nullptr)
+    , m_liveSearchTimer(nullptr)
+    , m_snippetTimer(nullptr)
+    , m_requestedSnippets()
+    , m_totalHitCount(-1)
 {
     setupUi();
 }
@@ -28,6 +42,16 @@ void SearchPane::setupUi() {
     m_mainLayout->setContentsMargins(4, 4, 4, 4);
     m_mainLayout->setSpacing(4);
 
+    m_liveSearchTimer = new QTimer(this);
+    m_liveSearchTimer->setSingleShot(true);
+    m_liveSearchTimer->setInterval(kDefaultLiveSearchDelayMs);
+    connect(m_liveSearchTimer, &QTimer::timeout, this, &SearchPane::onLiveSearchTimeout);
+
+    m_snippetTimer = new QTimer(this);
+    m_snippetTimer->setSingleShot(true);
+    m_snippetTimer->setInterval(kSnippetRequestDelayMs);
+    connect(m_snippetTimer, &QTimer::timeout, this, &SearchPane::requestVisibleSnippets);
+
     m_titleLabel = new QLabel("Search", this);
     m_titleLabel->setStyleSheet("font-weight: bold; font-size: 12pt;");
     m_mainLayout->addWidget(m_titleLabel);
@@ -60,11 +84,19 @@ void SearchPane::setupUi() {
     // Results list
     m_resultsList = new QListView(this);
     m_resultsList->setAlternatingRowColors(true);  // Enable zebra striping
-    m_resultsModel = new QStandardItemModel(this);
+    // Every row has the same height, so layout never measures rows
+    m_resultsList->setUniformItemSizes(true);
+    m_resultsList->setItemDelegate(new SearchResultDelegate(m_resultsList));
+    m_resultsModel = new SearchResultsModel(this);
     m_resultsList->setModel(m_resultsModel);
     connect(m_resultsList, &QListView::clicked, this, &SearchPane::onResultClicked);
+    connect(m_resultsList->verticalScrollBar(), &QScrollBar::valueChanged,
+            this, &SearchPane::onResultsScrolled);
     
     m_mainLayout->addWidget(m_resultsList);
+
+    m_resultCountLabel = new QLabel(this);
+    m_mainLayout->addWidget(m_resultCountLabel);
 }
 
 QString SearchPane::searchQuery() const {
@@ -83,23 +115,85 @@ bool SearchPane::useWildcards() const {
     return m_wildcardCheck->isChecked();
 }
 
-void SearchPane::setResults(const QList<QPair<QString, QString>>& results) {
-    m_resultsModel->clear();
-    
-    for (const auto& result : results) {
-        QStandardItem *item = new QStandardItem();
-        item->setText(QString("%1\n%2").arg(result.first, result.second));
-        item->setData(result.first, Qt::UserRole); // Store result ID in UserRole
-        item->setToolTip(result.second);
-        m_resultsModel->appendRow(item);
+void SearchPane::setResults(const QList<Services::SearchHit>& results) {
+    m_requestedSnippets.clear();
+    m_totalHitCount = -1;
+    m_resultsModel->setHits(results);
+    onResultsAdded();
+}
+
+void SearchPane::appendResults(const QList<Services::SearchHit>& results) {
+    // Inserted as rows; the view keeps its scroll position and selection
+    m_resultsModel->appendHits(results);
+    onResultsAdded();
+}
+
+void SearchPane::setTotalHitCount(int count) {
+    m_totalHitCount = count;
+    updateResultCountLabel();
+}
+
+void SearchPane::onResultsAdded() {
+    updateResultCountLabel();
+
+    // Keep fetching until the list is scrollable; the scroll bar range is
+    // only updated once the view has laid out the new rows
+    QTimer::singleShot(0, this, [this]() {
+        onResultsScrolled(m_resultsList->verticalScrollBar()->value());
+    });
+    m_snippetTimer->start();
+}
+
+void SearchPane::setSnippets(const QList<Services::SearchHit>& hits) {
+    m_resultsModel->setSnippets(hits);
+}
+
+void SearchPane::requestVisibleSnippets() {
+    const QModelIndex first = m_resultsList->indexAt(QPoint(0, 0));
+    if (!first.isValid()) {
+        return;
+    }
+    const QModelIndex last = m_resultsList->indexAt(QPoint(0, m_resultsList->viewport()->height() - 1));
+    const int lastRow = last.isValid() ? last.row() : m_resultsModel->rowCount() - 1;
+
+    QList<Services::SearchHit> hits;
+    for (int row = first.row(); row <= lastRow; ++row) {
+        const Services::SearchHit& hit = m_resultsModel->row(row).hit;
+        if (hit.snippet.isEmpty() && hit.rowid != 0 && !m_requestedSnippets.contains(hit.rowid)) {
+            m_requestedSnippets.insert(hit.rowid);
+            hits << hit;
+        }
+    }
+    if (!hits.isEmpty()) {
+        emit snippetsRequested(hits);
     }
 }
 
 void SearchPane::clearResults() {
     m_resultsModel->clear();
+    m_requestedSnippets.clear();
+    m_totalHitCount = -1;
+    updateResultCountLabel();
+}
+
+void SearchPane::updateResultCountLabel() {
+    const int shown = m_resultsModel->rowCount();
+    if (m_totalHitCount >= 0) {
+        m_resultCountLabel->setText(QString("%1 of %2 results").arg(shown).arg(m_totalHitCount));
+    } else if (shown > 0) {
+        m_resultCountLabel->setText(QString("%1 results").arg(shown));
+    } else {
+        m_resultCountLabel->clear();
+    }
+}
+
+void SearchPane::setLiveSearchDelay(int milliseconds) {
+    m_liveSearchTimer->setInterval(qMax(0, milliseconds));
 }
 
 void SearchPane::onSearchButtonClicked() {
+    // An explicit search replaces the pending live search
+    m_liveSearchTimer->stop();
     QString query = m_searchEdit->text().trimmed();
     if (!query.isEmpty()) {
         emit searchRequested(query);
@@ -107,7 +201,42 @@ void SearchPane::onSearchButtonClicked() {
 }
 
 void SearchPane::onSearchTextChanged() {
-    // Could implement live search here if desired
+    // Keystrokes only restart the timer; the search itself runs on the
+    // search service's worker thread
+    const QString query = m_searchEdit->text().trimmed();
+    if (query.isEmpty()) {
+        m_liveSearchTimer->stop();
+        clearResults();
+        emit searchCleared();
+        return;
+    }
+
+    if (query.size() < kMinLiveSearchLength) {
+        m_liveSearchTimer->stop();
+        return;
+    }
+
+    m_liveSearchTimer->start();
+}
+
+void SearchPane::onLiveSearchTimeout() {
+    const QString query = m_searchEdit->text().trimmed();
+    if (query.size() >= kMinLiveSearchLength) {
+        emit liveSearchRequested(query);
+    }
+}
+
+void SearchPane::onResultsScrolled(int value) {
+    if (m_resultsModel->rowCount() == 0) {
+        return;
+    }
+    m_snippetTimer->start();
+
+    // Request the next page about one screen before the end of the list
+    QScrollBar *scrollBar = m_resultsList->verticalScrollBar();
+    if (value >= scrollBar->maximum() - scrollBar->pageStep()) {
+        emit moreResultsRequested();
+    }
 }
 
 void SearchPane::onResultClicked(const QModelIndex& index) {
@@ -115,9 +244,9 @@ void SearchPane::onResultClicked(const QModelIndex& index) {
         return;
     }
     
-    QString resultId = index.data(Qt::UserRole).toString();
-    if (!resultId.isEmpty()) {
-        emit resultSelected(resultId);
+    const Services::SearchHit& hit = m_resultsModel->row(index.row()).hit;
+    if (!hit.documentId.isEmpty()) {
+        emit resultSelected(hit);
     }
 }
 
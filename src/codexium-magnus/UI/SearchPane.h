@@ -9,15 +9,21 @@
 #include <QPushButton>
 #include <QCheckBox>
 #include <QListView>
-#include <QStandardItemModel>
 #include <QComboBox>
+#include <QTimer>
+#include <QSet>
+#include <QStringList>
+#include "../Services/ISearchService.h"
 
 namespace CodexiumMagnus::UI {
 
+class SearchResultsModel;
+
 /**
  * Search pane with textbox, filters (fuzzy, case, wildcard).
  * Binds to Search Service.
- * Displays results with snippet/heading (QListView).
+ * Displays results with snippet/heading (QListView over a
+ * SearchResultsModel, painted by SearchResultDelegate).
  */
 class SearchPane : public QWidget {
     Q_OBJECT
@@ -31,20 +37,65 @@ public:
     bool isFuzzy() const;
     bool useWildcards() const;
 
-    void setResults(const QList<QPair<QString, QString>>& results); // (title, snippet) pairs
+    /**
+     * Delay between the last keystroke and a live search (default: 150 ms).
+     */
+    void setLiveSearchDelay(int milliseconds);
+    int liveSearchDelay() const { return m_liveSearchTimer->interval(); }
+
+    void setResults(const QList<Services::SearchHit>& results);
+    void appendResults(const QList<Services::SearchHit>& results); // Next page of the current search
+    void setTotalHitCount(int count);
+    
+    /**
+     * Fill in the snippets of shown hits, matched by document id.
+     */
+    void setSnippets(const QList<Services::SearchHit>& hits);
     void clearResults();
 
 signals:
     void searchRequested(const QString& query);
-    void resultSelected(const QString& resultId);
+    
+    /**
+     * Emitted while typing, once the query has been stable for
+     * liveSearchDelay() milliseconds.
+     */
+    void liveSearchRequested(const QString& query);
+    
+    /**
+     * Emitted when the search text is cleared.
+     */
+    void searchCleared();
+    
+    /**
+     * Emitted when a result is clicked, with the hit it shows.
+     */
+    void resultSelected(const CodexiumMagnus::Services::SearchHit& hit);
+    
+    /**
+     * Emitted when the results list is scrolled near its end (or is not
+     * yet filled) and further pages should be fetched.
+     */
+    void moreResultsRequested();
+    
+    /**
+     * Emitted with the hits scrolled into view that have no snippet yet.
+     * Each document is requested once per search.
+     */
+    void snippetsRequested(const QList<CodexiumMagnus::Services::SearchHit>& hits);
 
 private slots:
     void onSearchButtonClicked();
     void onSearchTextChanged();
     void onResultClicked(const QModelIndex& index);
+    void onResultsScrolled(int value);
+    void onLiveSearchTimeout();
+    void requestVisibleSnippets();
 
 private:
     void setupUi();
+    void onResultsAdded();
+    void updateResultCountLabel();
 
     QVBoxLayout *m_mainLayout;
     QLabel *m_titleLabel;
@@ -55,7 +106,12 @@ private:
     QCheckBox *m_fuzzyCheck;
     QCheckBox *m_wildcardCheck;
     QListView *m_resultsList;
-    QStandardItemModel *m_resultsModel;
+    SearchResultsModel *m_resultsModel;
+    QLabel *m_resultCountLabel;
+    QTimer *m_liveSearchTimer;  ///< Debounces live search while typing
+    QTimer *m_snippetTimer;     ///< Collects scroll steps into one snippet request
+    QSet<qint64> m_requestedSnippets;       ///< Rowids of hits whose snippet was requested for the current results
+    int m_totalHitCount;  ///< Total hits of the current search, -1 while unknown
 };
 
 } // namespace CodexiumMagnus::UI
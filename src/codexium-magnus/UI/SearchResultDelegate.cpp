@@ -0,0 +1,97 @@
+#include "SearchResultDelegate.h"
+#include "SearchResultsModel.h"
+#include <QApplication>
+#include <QPainter>
+#include <QStyle>
+
+namespace CodexiumMagnus::UI {
+
+namespace {
+const int kHorizontalPadding = 6;
+const int kVerticalPadding = 3;
+const int kLineSpacing = 2;
+
+// Background of marked ranges, like the default <mark> style
+const QColor kMarkBackground(255, 214, 0, 110);
+}
+
+SearchResultDelegate::SearchResultDelegate(QObject *parent)
+    : QStyledItemDelegate(parent)
+{
+}
+
+QSize SearchResultDelegate::sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const {
+    Q_UNUSED(index);
+    const int lineHeight = option.fontMetrics.height();
+    return QSize(option.rect.width(), 2 * lineHeight + kLineSpacing + 2 * kVerticalPadding);
+}
+
+void SearchResultDelegate::paint(QPainter *painter, const QStyleOptionViewItem& option, const QModelIndex& index) const {
+    QStyleOptionViewItem opt = option;
+    initStyleOption(&opt, index);
+    const QWidget *widget = opt.widget;
+    QStyle *style = widget ? widget->style() : QApplication::style();
+
+    // Background, selection and focus as the style draws them, without text
+    opt.text.clear();
+    style->drawControl(QStyle::CE_ItemViewItem, &opt, painter, widget);
+
+    const bool selected = opt.state & QStyle::State_Selected;
+    const QColor textColor = opt.palette.color(opt.state & QStyle::State_Enabled ? QPalette::Normal : QPalette::Disabled,
+                                               selected ? QPalette::HighlightedText : QPalette::Text);
+    const QRect content = opt.rect.adjusted(kHorizontalPadding, kVerticalPadding,
+                                            -kHorizontalPadding, -kVerticalPadding);
+    const int lineHeight = opt.fontMetrics.height();
+
+    painter->save();
+    painter->setClipRect(content);
+    painter->setPen(textColor);
+
+    // Title
+    QFont titleFont = opt.font;
+    titleFont.setBold(true);
+    const QFontMetrics titleMetrics(titleFont);
+    painter->setFont(titleFont);
+    const QRect titleRect(content.left(), content.top(), content.width(), lineHeight);
+    painter->drawText(titleRect, Qt::AlignLeft | Qt::AlignVCenter,
+                      titleMetrics.elidedText(index.data(Qt::DisplayRole).toString(), Qt::ElideRight, content.width()));
+
+    const auto *model = qobject_cast<const SearchResultsModel*>(index.model());
+    if (!model) {
+        painter->restore();
+        return;
+    }
+
+    // Snippet: plain runs and marked runs, left to right until the line is full
+    const SearchResultsModel::Row& row = model->row(index.row());
+    const QFontMetrics& metrics = opt.fontMetrics;
+    painter->setFont(opt.font);
+    const int top = content.top() + lineHeight + kLineSpacing;
+    const int right = content.right();
+    int x = content.left();
+    int position = 0;
+
+    auto drawRun = [&](int start, int length, bool marked) {
+        if (length <= 0 || x > right) {
+            return;
+        }
+        const QString run = row.snippetText.mid(start, length);
+        const int width = metrics.horizontalAdvance(run);
+        if (marked) {
+            painter->fillRect(QRect(x, top, qMin(width, right - x + 1), lineHeight), kMarkBackground);
+        }
+        painter->drawText(QRect(x, top, right - x + 1, lineHeight), Qt::AlignLeft | Qt::AlignVCenter, run);
+        x += width;
+    };
+
+    for (const auto& mark : row.snippetMarks) {
+        drawRun(position, mark.first - position, false);
+        drawRun(mark.first, mark.second, true);
+        position = mark.first + mark.second;
+    }
+    drawRun(position, static_cast<int>(row.snippetText.size()) - position, false);
+
+    painter->restore();
+}
+
+} // namespace CodexiumMagnus::UI
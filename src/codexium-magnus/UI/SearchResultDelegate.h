@@ -0,0 +1,30 @@
+#ifndef SEARCHRESULTDELEGATE_H
+#define SEARCHRESULTDELEGATE_H
+
+#include <QStyledItemDelegate>
+
+namespace CodexiumMagnus::UI {
+
+/**
+ * Paints a search result as two lines: the title in bold and the snippet
+ * with its marked ranges highlighted.
+ *
+ * Rows have a uniform height derived from the font alone, so the view can
+ * lay out any number of rows without asking for each row's size. Snippets
+ * are painted from the plain text and mark ranges SearchResultsModel keeps
+ * per row; no rich-text document is built. With another model only the
+ * display text is painted.
+ */
+class SearchResultDelegate : public QStyledItemDelegate {
+    Q_OBJECT
+
+public:
+    explicit SearchResultDelegate(QObject *parent = nullptr);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+    QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+};
+
+} // namespace CodexiumMagnus::UI
+
+#endif // SEARCHRESULTDELEGATE_H
@@ -0,0 +1,187 @@
+#include "SearchResultsModel.h"
+
+namespace CodexiumMagnus::UI {
+
+namespace {
+
+struct Entity {
+    const char *name;
+    QChar character;
+};
+
+const Entity kEntities[] = {
+    {"&amp;", QChar('&')},
+    {"&lt;", QChar('<')},
+    {"&gt;", QChar('>')},
+    {"&quot;", QChar('"')},
+    {"&#39;", QChar('\'')},
+    {"&nbsp;", QChar(' ')},
+};
+
+} // namespace
+
+SearchResultsModel::SearchResultsModel(QObject *parent)
+    : QAbstractListModel(parent)
+    , m_rows()
+    , m_rowByRowid()
+{
+}
+
+void SearchResultsModel::setHits(const QList<Services::SearchHit>& hits) {
+    beginResetModel();
+    m_rows.clear();
+    m_rowByRowid.clear();
+    m_rows.reserve(hits.size());
+    for (const auto& hit : hits) {
+        indexRow(hit);
+        m_rows.push_back(makeRow(hit));
+    }
+    endResetModel();
+}
+
+void SearchResultsModel::appendHits(const QList<Services::SearchHit>& hits) {
+    if (hits.isEmpty()) {
+        return;
+    }
+
+    const int first = static_cast<int>(m_rows.size());
+    beginInsertRows(QModelIndex(), first, first + static_cast<int>(hits.size()) - 1);
+    m_rows.reserve(m_rows.size() + hits.size());
+    for (const auto& hit : hits) {
+        indexRow(hit);
+        m_rows.push_back(makeRow(hit));
+    }
+    endInsertRows();
+}
+
+void SearchResultsModel::setSnippets(const QList<Services::SearchHit>& hits) {
+    for (const auto& snippet : hits) {
+        const int row = snippet.rowid != 0 ? m_rowByRowid.value(snippet.rowid, -1) : -1;
+        if (row < 0) {
+            continue;
+        }
+
+        Row& target = m_rows[row];
+        target.hit.snippet = snippet.snippet;
+        target.hit.matchOffsets = snippet.matchOffsets;
+        parseSnippet(target.hit.snippet, target.snippetText, target.snippetMarks);
+
+        const QModelIndex changed = index(row);
+        emit dataChanged(changed, changed, {Qt::ToolTipRole, HitRole, SnippetRole});
+    }
+}
+
+void SearchResultsModel::clear() {
+    if (m_rows.empty()) {
+        return;
+    }
+    beginResetModel();
+    m_rows.clear();
+    m_rowByRowid.clear();
+    endResetModel();
+}
+
+void SearchResultsModel::indexRow(const Services::SearchHit& hit) {
+    // LIKE fallback hits have no rowid and arrive with their snippet
+    if (hit.rowid != 0) {
+        m_rowByRowid.insert(hit.rowid, static_cast<int>(m_rows.size()));
+    }
+}
+
+int SearchResultsModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(m_rows.size());
+}
+
+QVariant SearchResultsModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= static_cast<int>(m_rows.size())) {
+        return QVariant();
+    }
+
+    const Row& row = m_rows[index.row()];
+    switch (role) {
+        case Qt::DisplayRole:
+            return row.hit.title;
+        case Qt::ToolTipRole:
+        case SnippetRole:
+            return row.hit.snippet;
+        case DocumentIdRole:
+            return row.hit.documentId;
+        case HitRole:
+            return QVariant::fromValue(row.hit);
+        default:
+            return QVariant();
+    }
+}
+
+SearchResultsModel::Row SearchResultsModel::makeRow(const Services::SearchHit& hit) {
+    Row row;
+    row.hit = hit;
+    parseSnippet(hit.snippet, row.snippetText, row.snippetMarks);
+    return row;
+}
+
+void SearchResultsModel::parseSnippet(const QString& html, QString& text, QList<QPair<int, int>>& marks) {
+    text.clear();
+    marks.clear();
+    text.reserve(html.size());
+
+    int markStart = -1;
+    qsizetype i = 0;
+    while (i < html.size()) {
+        const QChar character = html.at(i);
+
+        if (character == '<') {
+            const qsizetype tagEnd = html.indexOf('>', i);
+            if (tagEnd < 0) {
+                // Tag cut off by the end of the snippet
+                break;
+            }
+            const QStringView tag = QStringView(html).mid(i, tagEnd - i + 1);
+            if (tag.compare(QLatin1String("<mark>"), Qt::CaseInsensitive) == 0) {
+                markStart = static_cast<int>(text.size());
+            } else if (tag.compare(QLatin1String("</mark>"), Qt::CaseInsensitive) == 0) {
+                if (markStart >= 0 && text.size() > markStart) {
+                    marks.append(qMakePair(markStart, static_cast<int>(text.size()) - markStart));
+                }
+                markStart = -1;
+            }
+            i = tagEnd + 1;
+            continue;
+        }
+
+        QChar decoded = character;
+        qsizetype length = 1;
+        if (character == '&') {
+            for (const Entity& entity : kEntities) {
+                const QLatin1String name(entity.name);
+                if (QStringView(html).mid(i).startsWith(name)) {
+                    decoded = entity.character;
+                    length = name.size();
+                    break;
+                }
+            }
+        }
+        i += length;
+
+        // Whitespace collapses to single spaces, as in the rendered page
+        if (decoded.isSpace()) {
+            if (!text.isEmpty() && !text.endsWith(' ')) {
+                text += ' ';
+            }
+            continue;
+        }
+        text += decoded;
+    }
+
+    if (text.endsWith(' ')) {
+        text.chop(1);
+        if (!marks.isEmpty() && marks.last().first + marks.last().second > text.size()) {
+            marks.last().second = static_cast<int>(text.size()) - marks.last().first;
+            if (marks.last().second <= 0) {
+                marks.removeLast();
+            }
+        }
+    }
+}
+
+} // namespace CodexiumMagnus::UI
@@ -0,0 +1,98 @@
+#ifndef SEARCHRESULTSMODEL_H
+#define SEARCHRESULTSMODEL_H
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <vector>
+#include "../Services/ISearchService.h"
+
+namespace CodexiumMagnus::UI {
+
+/**
+ * Flat list model over the hits of the current search.
+ *
+ * Replaces the QStandardItemModel of the search pane, which allocated an
+ * item per hit and a concatenated title/snippet string per row. Hits are
+ * held in a contiguous vector; further pages are inserted with
+ * beginInsertRows() so the view keeps its scroll position and only lays out
+ * the new rows, and snippets built later only emit dataChanged() for their
+ * rows.
+ *
+ * Each row also keeps its snippet parsed into plain text and the ranges
+ * that were wrapped in <mark></mark>, so SearchResultDelegate can paint it
+ * without building a rich-text document per row.
+ *
+ * Roles: DisplayRole is the title, ToolTipRole and SnippetRole the HTML
+ * snippet, DocumentIdRole the document id and HitRole the whole SearchHit.
+ */
+class SearchResultsModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    enum Roles {
+        DocumentIdRole = Qt::UserRole,
+        HitRole,
+        SnippetRole
+    };
+
+    /**
+     * A hit with its snippet prepared for painting.
+     */
+    struct Row {
+        Services::SearchHit hit;
+        QString snippetText;                 ///< Snippet without markup
+        QList<QPair<int, int>> snippetMarks; ///< (start, length) of the marked ranges in snippetText
+    };
+
+    explicit SearchResultsModel(QObject *parent = nullptr);
+
+    /**
+     * Replace all rows with the first page of a new search.
+     */
+    void setHits(const QList<Services::SearchHit>& hits);
+
+    /**
+     * Append a further page of the current search.
+     */
+    void appendHits(const QList<Services::SearchHit>& hits);
+
+    /**
+     * Fill in snippets and match offsets of shown hits, matched by
+     * SearchHit::rowid, since one document can have several rows. Hits
+     * that are no longer shown are ignored.
+     */
+    void setSnippets(const QList<Services::SearchHit>& hits);
+
+    void clear();
+
+    /**
+     * Row at the given position; must be in range.
+     */
+    const Row& row(int row) const { return m_rows[row]; }
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    /**
+     * Split a snippet into plain text and the ranges wrapped in
+     * <mark></mark>. Other tags are dropped and basic entities decoded.
+     * @param html Snippet in the format of FTS5 snippet()
+     * @param text Receives the plain text
+     * @param marks Receives the (start, length) pairs of the marked ranges
+     */
+    static void parseSnippet(const QString& html, QString& text, QList<QPair<int, int>>& marks);
+
+private:
+    static Row makeRow(const Services::SearchHit& hit);
+    void indexRow(const Services::SearchHit& hit);  ///< Call before appending the hit's row
+
+    std::vector<Row> m_rows;
+    QHash<qint64, int> m_rowByRowid;  ///< FTS5 rowid -> row, for setSnippets()
+};
+
+} // namespace CodexiumMagnus::UI
+
+#endif // SEARCHRESULTSMODEL_H
@@ -1,7 +1,11 @@
 #include <QApplication>
 #include "MainWindow.h"
+#include "Services/CartridgeSchemeHandler.h"
 
 int main(int argc, char *argv[]) {
+    // Custom schemes must be known to Qt WebEngine before it starts
+    CodexiumMagnus::Services::CartridgeSchemeHandler::registerScheme();
+    
     QApplication app(argc, argv);
     
     // Set application metadata
@@ -0,0 +1,152 @@
+#include "BenchmarkCartridgeFactory.h"
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QStringList>
+#include <QDebug>
+
+namespace {
+
+// Small fixed vocabulary so generated content is deterministic and
+// produces realistic FTS5 posting lists.
+const QStringList kVocabulary = {
+    "archive", "starship", "navigation", "imperial", "sector", "merchant",
+    "jump", "drive", "scout", "survey", "trade", "route", "planet", "orbit",
+    "reactor", "vessel", "crew", "cargo", "subsector", "travel", "library",
+    "record", "computer", "sensor", "weapon", "armour", "psionic", "noble",
+    "empire", "frontier", "border", "patrol", "naval", "base", "station"
+};
+
+QString generateContent(int index, int wordCount, int variant) {
+    quint32 state = static_cast<quint32>(index) * 2654435761u + 1u + static_cast<quint32>(variant) * 40503u;
+    QStringList words;
+    words.reserve(wordCount);
+    for (int i = 0; i < wordCount; ++i) {
+        state = state * 1664525u + 1013904223u;
+        words.append(kVocabulary.at(static_cast<int>((state >> 16) % kVocabulary.size())));
+    }
+    return QString("<html><head><title>Document %1</title></head><body><p>%2</p></body></html>")
+        .arg(index)
+        .arg(words.join(' '));
+}
+
+} // namespace
+
+BenchmarkCartridgeFactory::BenchmarkCartridgeFactory() {
+}
+
+QString BenchmarkCartridgeFactory::cartridge(int documentCount, int variant) {
+    const QPair<int, int> key(documentCount, variant);
+    if (m_cartridges.contains(key)) {
+        return m_cartridges.value(key);
+    }
+
+    if (!m_directory.isValid()) {
+        return QString();
+    }
+
+    QString fileName = variant == 0 ?
+        QString("bench_%1.cartridge").arg(documentCount) :
+        QString("bench_%1_v%2.cartridge").arg(documentCount).arg(variant);
+    QString path = m_directory.filePath(fileName);
+    if (!createCartridge(path, documentCount, variant)) {
+        return QString();
+    }
+
+    m_cartridges.insert(key, path);
+    return path;
+}
+
+QString BenchmarkCartridgeFactory::documentId(int index) {
+    return QString("doc%1").arg(index, 6, 10, QChar('0'));
+}
+
+bool BenchmarkCartridgeFactory::createCartridge(const QString& path, int documentCount, int variant) {
+    const QString connectionName = QString("bench_factory_%1_%2").arg(documentCount).arg(variant);
+    bool success = true;
+
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+        db.setDatabaseName(path);
+        if (!db.open()) {
+            qWarning() << "BenchmarkCartridgeFactory: Failed to create" << path << db.lastError().text();
+            success = false;
+        } else {
+            QSqlQuery query(db);
+            query.exec("PRAGMA journal_mode = OFF");
+            query.exec("PRAGMA synchronous = OFF");
+
+            query.exec(R"(
+                CREATE TABLE documents (
+                    id TEXT PRIMARY KEY,
+                    title TEXT NOT NULL,
+                    content TEXT
+                )
+            )");
+            query.exec(R"(
+                CREATE TABLE navigation (
+                    id TEXT PRIMARY KEY,
+                    title TEXT NOT NULL,
+                    parent_id TEXT,
+                    type TEXT NOT NULL,
+                    sort_order INTEGER NOT NULL
+                )
+            )");
+            query.exec("CREATE INDEX idx_navigation_parent ON navigation(parent_id, sort_order)");
+            query.exec(R"(
+                CREATE VIRTUAL TABLE content_fts USING fts5(
+                    document_id UNINDEXED,
+                    title,
+                    content,
+                    prefix = '2 3'
+                )
+            )");
+
+            db.transaction();
+
+            QSqlQuery insertDocument(db);
+            insertDocument.prepare("INSERT INTO documents (id, title, content) VALUES (?, ?, ?)");
+            QSqlQuery insertNavigation(db);
+            insertNavigation.prepare("INSERT INTO navigation (id, title, parent_id, type, sort_order) VALUES (?, ?, ?, ?, ?)");
+
+            // One volume per 100 documents gives a two-level tree
+            int sortOrder = 0;
+            for (int i = 0; i < documentCount; ++i) {
+                QString volumeId = QString("vol%1").arg(i / 100);
+                if (i % 100 == 0) {
+                    insertNavigation.addBindValue(volumeId);
+                    insertNavigation.addBindValue(QString("Volume %1").arg(i / 100 + 1));
+                    insertNavigation.addBindValue(QString());
+                    insertNavigation.addBindValue("volume");
+                    insertNavigation.addBindValue(sortOrder++);
+                    insertNavigation.exec();
+                }
+
+                QString id = documentId(i);
+                QString title = QString("Document %1").arg(i);
+                insertDocument.addBindValue(id);
+                insertDocument.addBindValue(title);
+                insertDocument.addBindValue(generateContent(i, 150, variant));
+                if (!insertDocument.exec()) {
+                    qWarning() << "BenchmarkCartridgeFactory: Insert failed" << insertDocument.lastError().text();
+                    success = false;
+                    break;
+                }
+
+                insertNavigation.addBindValue(id);
+                insertNavigation.addBindValue(title);
+                insertNavigation.addBindValue(volumeId);
+                insertNavigation.addBindValue("document");
+                insertNavigation.addBindValue(sortOrder++);
+                insertNavigation.exec();
+            }
+
+            query.exec("INSERT INTO content_fts (document_id, title, content) SELECT id, title, content FROM documents");
+            db.commit();
+            db.close();
+        }
+    }
+
+    QSqlDatabase::removeDatabase(connectionName);
+    return success;
+}
@@ -0,0 +1,44 @@
+#ifndef BENCHMARKCARTRIDGEFACTORY_H
+#define BENCHMARKCARTRIDGEFACTORY_H
+
+#include <QString>
+#include <QMap>
+#include <QPair>
+#include <QTemporaryDir>
+
+/**
+ * Generates synthetic cartridges for benchmarks.
+ *
+ * Cartridges follow the schema used by the service tests (documents,
+ * navigation and content_fts tables) and are deterministic for a given
+ * document count, so runs are comparable across builds.
+ *
+ * Generated files are cached per document count and variant for the
+ * lifetime of the factory and removed with its temporary directory.
+ */
+class BenchmarkCartridgeFactory {
+public:
+    BenchmarkCartridgeFactory();
+
+    /**
+     * Get (creating on first use) a cartridge with the given document count.
+     * @param documentCount Number of documents to generate
+     * @param variant Selects different generated content for cartridges of
+     *        the same size (for multi-cartridge benchmarks)
+     * @return Path to the cartridge file, or empty string on failure
+     */
+    QString cartridge(int documentCount, int variant = 0);
+
+    /**
+     * Identifier of the n-th generated document (0-based).
+     */
+    static QString documentId(int index);
+
+private:
+    static bool createCartridge(const QString& path, int documentCount, int variant);
+
+    QTemporaryDir m_directory;
+    QMap<QPair<int, int>, QString> m_cartridges;  ///< Keyed by (document count, variant)
+};
+
+#endif // BENCHMARKCARTRIDGEFACTORY_H
@@ -0,0 +1,85 @@
+#include "CartridgeLoadBenchmarks.h"
+#include <QElapsedTimer>
+#include <QSignalSpy>
+#include "Services/CartridgeService.h"
+#include "Services/SignatureService.h"
+
+using namespace CodexiumMagnus::Services;
+
+namespace {
+const int kIterations = 5;
+}
+
+void CartridgeLoadBenchmarks::addDocumentCountRows() {
+    QTest::addColumn<int>("documentCount");
+    QTest::newRow("1k") << 1000;
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("100k") << 100000;
+}
+
+void CartridgeLoadBenchmarks::timeToFirstDocument_Sync_data() {
+    addDocumentCountRows();
+}
+
+void CartridgeLoadBenchmarks::timeToFirstDocument_Sync() {
+    QFETCH(int, documentCount);
+    QString path = m_factory.cartridge(documentCount);
+    QVERIFY(!path.isEmpty());
+
+    SignatureService signatureService;
+    CartridgeService service;
+    service.setSignatureService(&signatureService);
+
+    qint64 best = -1;
+    for (int i = 0; i < kIterations; ++i) {
+        QElapsedTimer timer;
+        timer.start();
+        QVERIFY(service.loadCartridge(path));
+        QString content = service.getDocumentContent(BenchmarkCartridgeFactory::documentId(0));
+        qint64 elapsed = timer.nsecsElapsed();
+        QVERIFY(!content.isEmpty());
+
+        service.unloadCartridge();
+        best = (best < 0) ? elapsed : qMin(best, elapsed);
+    }
+
+    QTest::setBenchmarkResult(best / 1000000.0, QTest::WalltimeMilliseconds);
+}
+
+void CartridgeLoadBenchmarks::timeToFirstDocument_Async_data() {
+    addDocumentCountRows();
+}
+
+void CartridgeLoadBenchmarks::timeToFirstDocument_Async() {
+    QFETCH(int, documentCount);
+    QString path = m_factory.cartridge(documentCount);
+    QVERIFY(!path.isEmpty());
+
+    SignatureService signatureService;
+    CartridgeService service;
+    service.setSignatureService(&signatureService);
+
+    qint64 best = -1;
+    for (int i = 0; i < kIterations; ++i) {
+        QSignalSpy loadedSpy(&service, &CartridgeService::cartridgeLoaded);
+        QSignalSpy trustSpy(&service, &CartridgeService::trustLevelDetermined);
+
+        QElapsedTimer timer;
+        timer.start();
+        service.loadCartridgeAsync(path);
+        QVERIFY(loadedSpy.wait(60000));
+        QString content = service.getDocumentContent(BenchmarkCartridgeFactory::documentId(0));
+        qint64 elapsed = timer.nsecsElapsed();
+        QVERIFY(!content.isEmpty());
+
+        // Let verification finish outside the measured window
+        QTRY_VERIFY_WITH_TIMEOUT(trustSpy.count() == 1, 60000);
+        service.unloadCartridge();
+        best = (best < 0) ? elapsed : qMin(best, elapsed);
+    }
+
+    QTest::setBenchmarkResult(best / 1000000.0, QTest::WalltimeMilliseconds);
+}
+
+// QTEST_MAIN removed - using main.cpp instead
+#include "CartridgeLoadBenchmarks.moc"
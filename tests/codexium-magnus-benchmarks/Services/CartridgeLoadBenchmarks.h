@@ -0,0 +1,26 @@
+#ifndef CARTRIDGELOADBENCHMARKS_H
+#define CARTRIDGELOADBENCHMARKS_H
+
+#include <QtTest/QtTest>
+#include "BenchmarkCartridgeFactory.h"
+
+/**
+ * Measures time-to-first-document: from the open request until the first
+ * document's content is available, for synchronous and asynchronous loads.
+ */
+class CartridgeLoadBenchmarks : public QObject {
+    Q_OBJECT
+
+private slots:
+    void timeToFirstDocument_Sync_data();
+    void timeToFirstDocument_Sync();
+    void timeToFirstDocument_Async_data();
+    void timeToFirstDocument_Async();
+
+private:
+    void addDocumentCountRows();
+
+    BenchmarkCartridgeFactory m_factory;
+};
+
+#endif // CARTRIDGELOADBENCHMARKS_H
@@ -0,0 +1,170 @@
+#include "CartridgeOpenProfileBenchmarks.h"
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QSignalSpy>
+#include "Services/CartridgeService.h"
+#include "Services/CartridgeOpenProfile.h"
+#include "Services/SearchService.h"
+
+using namespace CodexiumMagnus::Services;
+
+Q_DECLARE_METATYPE(CodexiumMagnus::Services::CartridgeOpenProfile)
+
+namespace {
+const int kIterations = 5;
+const int kWarmLookups = 1000;
+const QString kFtsQuery = "imperial merchant";
+}
+
+void CartridgeOpenProfileBenchmarks::addProfileRows() {
+    QTest::addColumn<int>("documentCount");
+    QTest::addColumn<CartridgeOpenProfile>("profile");
+    for (int documentCount : {10000, 100000}) {
+        const QString size = QString("%1k").arg(documentCount / 1000);
+        QTest::newRow(qPrintable(size + " default"))
+            << documentCount << CartridgeOpenProfile::defaults();
+        QTest::newRow(qPrintable(size + " immutable"))
+            << documentCount << CartridgeOpenProfile::immutableCartridge();
+    }
+}
+
+void CartridgeOpenProfileBenchmarks::documentFetch_Cold_data() {
+    addProfileRows();
+}
+
+void CartridgeOpenProfileBenchmarks::documentFetch_Cold() {
+    QFETCH(int, documentCount);
+    QFETCH(CartridgeOpenProfile, profile);
+    QString path = m_factory.cartridge(documentCount);
+    QVERIFY(!path.isEmpty());
+
+    CartridgeService service;
+    service.setDefaultOpenProfile(profile);
+    service.setDocumentCacheBudget(0);
+
+    QRandomGenerator generator(42);
+    qint64 best = -1;
+    for (int i = 0; i < kIterations; ++i) {
+        QVERIFY(service.loadCartridge(path));
+        const QString id = BenchmarkCartridgeFactory::documentId(generator.bounded(documentCount));
+
+        QElapsedTimer timer;
+        timer.start();
+        QString content = service.getDocumentContent(id);
+        qint64 elapsed = timer.nsecsElapsed();
+        QVERIFY(!content.isEmpty());
+
+        service.unloadCartridge();
+        best = (best < 0) ? elapsed : qMin(best, elapsed);
+    }
+
+    QTest::setBenchmarkResult(best / 1000000.0, QTest::WalltimeMilliseconds);
+}
+
+void CartridgeOpenProfileBenchmarks::documentFetch_Warm_data() {
+    addProfileRows();
+}
+
+void CartridgeOpenProfileBenchmarks::documentFetch_Warm() {
+    QFETCH(int, documentCount);
+    QFETCH(CartridgeOpenProfile, profile);
+    QString path = m_factory.cartridge(documentCount);
+    QVERIFY(!path.isEmpty());
+
+    CartridgeService service;
+    service.setDefaultOpenProfile(profile);
+    service.setDocumentCacheBudget(0);
+    QVERIFY(service.loadCartridge(path));
+
+    QStringList ids;
+    QRandomGenerator generator(42);
+    for (int i = 0; i < kWarmLookups; ++i) {
+        ids.append(BenchmarkCartridgeFactory::documentId(generator.bounded(documentCount)));
+    }
+
+    // Warm-up pass pulls the touched pages into the page cache / map
+    for (const QString& id : ids) {
+        service.getDocumentContent(id);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    for (const QString& id : ids) {
+        QVERIFY(!service.getDocumentContent(id).isEmpty());
+    }
+    qint64 elapsed = timer.nsecsElapsed();
+
+    qInfo().noquote() << QString("%1 us/lookup").arg(elapsed / 1000.0 / kWarmLookups, 0, 'f', 2);
+    QTest::setBenchmarkResult(elapsed / 1000000.0, QTest::WalltimeMilliseconds);
+}
+
+void CartridgeOpenProfileBenchmarks::ftsQuery_Cold_data() {
+    addProfileRows();
+}
+
+void CartridgeOpenProfileBenchmarks::ftsQuery_Cold() {
+    QFETCH(int, documentCount);
+    QFETCH(CartridgeOpenProfile, profile);
+    QString path = m_factory.cartridge(documentCount);
+    QVERIFY(!path.isEmpty());
+
+    CartridgeService service;
+    service.setDefaultOpenProfile(profile);
+    SearchService search(&service);
+    QSignalSpy completedSpy(&search, &SearchService::searchCompleted);
+
+    qint64 best = -1;
+    for (int i = 0; i < kIterations; ++i) {
+        QVERIFY(service.loadCartridge(path));
+        completedSpy.clear();
+
+        QElapsedTimer timer;
+        timer.start();
+        search.performSearch(kFtsQuery, false, false, false);
+        qint64 elapsed = timer.nsecsElapsed();
+        QCOMPARE(completedSpy.count(), 1);
+
+        service.unloadCartridge();
+        best = (best < 0) ? elapsed : qMin(best, elapsed);
+    }
+
+    QTest::setBenchmarkResult(best / 1000000.0, QTest::WalltimeMilliseconds);
+}
+
+void CartridgeOpenProfileBenchmarks::ftsQuery_Warm_data() {
+    addProfileRows();
+}
+
+void CartridgeOpenProfileBenchmarks::ftsQuery_Warm() {
+    QFETCH(int, documentCount);
+    QFETCH(CartridgeOpenProfile, profile);
+    QString path = m_factory.cartridge(documentCount);
+    QVERIFY(!path.isEmpty());
+
+    CartridgeService service;
+    service.setDefaultOpenProfile(profile);
+    QVERIFY(service.loadCartridge(path));
+    SearchService search(&service);
+    QSignalSpy completedSpy(&search, &SearchService::searchCompleted);
+
+    // Warm-up query
+    search.performSearch(kFtsQuery, false, false, false);
+
+    qint64 best = -1;
+    for (int i = 0; i < kIterations; ++i) {
+        completedSpy.clear();
+
+        QElapsedTimer timer;
+        timer.start();
+        search.performSearch(kFtsQuery, false, false, false);
+        qint64 elapsed = timer.nsecsElapsed();
+        QCOMPARE(completedSpy.count(), 1);
+
+        best = (best < 0) ? elapsed : qMin(best, elapsed);
+    }
+
+    QTest::setBenchmarkResult(best / 1000000.0, QTest::WalltimeMilliseconds);
+}
+
+// QTEST_MAIN removed - using main.cpp instead
+#include "CartridgeOpenProfileBenchmarks.moc"
@@ -0,0 +1,36 @@
+#ifndef CARTRIDGEOPENPROFILEBENCHMARKS_H
+#define CARTRIDGEOPENPROFILEBENCHMARKS_H
+
+#include <QtTest/QtTest>
+#include "BenchmarkCartridgeFactory.h"
+
+/**
+ * Compares the plain QSQLITE open defaults with the read-only immutable
+ * cartridge profile (mmap_size, cache_size) for document fetches and FTS
+ * queries.
+ *
+ * "Cold" measures the first operation after opening the cartridge, when
+ * SQLite's page cache is empty; the OS file cache is not dropped, so cold
+ * numbers reflect SQLite-side work only. "Warm" measures repeated
+ * operations on an open cartridge.
+ */
+class CartridgeOpenProfileBenchmarks : public QObject {
+    Q_OBJECT
+
+private slots:
+    void documentFetch_Cold_data();
+    void documentFetch_Cold();
+    void documentFetch_Warm_data();
+    void documentFetch_Warm();
+    void ftsQuery_Cold_data();
+    void ftsQuery_Cold();
+    void ftsQuery_Warm_data();
+    void ftsQuery_Warm();
+
+private:
+    void addProfileRows();
+
+    BenchmarkCartridgeFactory m_factory;
+};
+
+#endif // CARTRIDGEOPENPROFILEBENCHMARKS_H
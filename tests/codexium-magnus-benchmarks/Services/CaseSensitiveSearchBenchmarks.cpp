@@ -0,0 +1,52 @@
+#include "CaseSensitiveSearchBenchmarks.h"
+#include <QElapsedTimer>
+#include <QSignalSpy>
+#include "Services/CartridgeService.h"
+#include "Services/SearchService.h"
+
+using namespace CodexiumMagnus::Services;
+
+void CaseSensitiveSearchBenchmarks::firstPageAndCount_data() {
+    QTest::addColumn<int>("documentCount");
+    QTest::addColumn<QString>("query");
+    QTest::newRow("1k, all candidates hit") << 1000 << "imperial";
+    QTest::newRow("1k, no candidate hits") << 1000 << "Imperial";
+    QTest::newRow("10k, all candidates hit") << 10000 << "imperial";
+    QTest::newRow("10k, no candidate hits") << 10000 << "Imperial";
+}
+
+void CaseSensitiveSearchBenchmarks::firstPageAndCount() {
+    QFETCH(int, documentCount);
+    QFETCH(QString, query);
+    QString path = m_factory.cartridge(documentCount);
+    QVERIFY(!path.isEmpty());
+
+    CartridgeService service;
+    QVERIFY(service.loadCartridge(path));
+    SearchService search(&service);
+    QSignalSpy completedSpy(&search, &SearchService::searchCompleted);
+    QSignalSpy countSpy(&search, &SearchService::totalHitCountReady);
+
+    QElapsedTimer timer;
+    timer.start();
+    search.performSearch(query, true, false, false);
+    QVERIFY(completedSpy.wait(30000));
+    const qint64 firstPageNs = timer.nsecsElapsed();
+
+    timer.restart();
+    search.requestTotalHitCount();
+    QVERIFY(countSpy.wait(30000));
+    const qint64 countNs = timer.nsecsElapsed();
+    const int hits = countSpy.takeFirst().at(0).toInt();
+
+    qInfo().noquote() << QString("%1 documents, \"%2\": first page %3 ms, %4 hits counted in %5 ms")
+        .arg(documentCount)
+        .arg(query)
+        .arg(firstPageNs / 1000000.0, 0, 'f', 2)
+        .arg(hits)
+        .arg(countNs / 1000000.0, 0, 'f', 2);
+    QTest::setBenchmarkResult(firstPageNs / 1000000.0, QTest::WalltimeMilliseconds);
+}
+
+// QTEST_MAIN removed - using main.cpp instead
+#include "CaseSensitiveSearchBenchmarks.moc"
@@ -0,0 +1,25 @@
+#ifndef CASESENSITIVESEARCHBENCHMARKS_H
+#define CASESENSITIVESEARCHBENCHMARKS_H
+
+#include <QtTest/QtTest>
+#include "BenchmarkCartridgeFactory.h"
+
+/**
+ * Measures case-sensitive search, where every FTS5 candidate is verified
+ * for the exact case: the time to the first page of results and to the
+ * total hit count. Generated content is lowercase, so "imperial" verifies
+ * nearly every document as a hit, while "Imperial" rejects all of them and
+ * has to verify every candidate before the (empty) first page is known.
+ */
+class CaseSensitiveSearchBenchmarks : public QObject {
+    Q_OBJECT
+
+private slots:
+    void firstPageAndCount_data();
+    void firstPageAndCount();
+
+private:
+    BenchmarkCartridgeFactory m_factory;
+};
+
+#endif // CASESENSITIVESEARCHBENCHMARKS_H
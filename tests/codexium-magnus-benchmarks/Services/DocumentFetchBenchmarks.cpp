@@ -0,0 +1,86 @@
+#include "DocumentFetchBenchmarks.h"
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QSqlQuery>
+#include "Services/CartridgeService.h"
+#include "Services/SignatureService.h"
+
+using namespace CodexiumMagnus::Services;
+
+namespace {
+const int kDocumentCount = 10000;
+const int kLookups = 10000;
+
+void reportLatency(const char *label, qint64 elapsedNs) {
+    qInfo().noquote() << QString("%1: %2 lookups in %3 ms (%4 us/lookup)")
+        .arg(label)
+        .arg(kLookups)
+        .arg(elapsedNs / 1000000.0, 0, 'f', 2)
+        .arg(elapsedNs / 1000.0 / kLookups, 0, 'f', 2);
+}
+}
+
+QStringList DocumentFetchBenchmarks::randomDocumentIds() const {
+    // Fixed seed so both variants fetch the same sequence
+    QRandomGenerator generator(42);
+    QStringList ids;
+    ids.reserve(kLookups);
+    for (int i = 0; i < kLookups; ++i) {
+        ids.append(BenchmarkCartridgeFactory::documentId(generator.bounded(kDocumentCount)));
+    }
+    return ids;
+}
+
+void DocumentFetchBenchmarks::randomFetch_FreshStatement() {
+    QString path = m_factory.cartridge(kDocumentCount);
+    QVERIFY(!path.isEmpty());
+
+    SignatureService signatureService;
+    CartridgeService service;
+    service.setSignatureService(&signatureService);
+    QVERIFY(service.loadCartridge(path));
+
+    const QStringList ids = randomDocumentIds();
+    QSqlDatabase db = *service.getDatabase();
+
+    QElapsedTimer timer;
+    timer.start();
+    for (const QString& id : ids) {
+        QSqlQuery query(db);
+        query.prepare("SELECT content FROM documents WHERE id = ?");
+        query.addBindValue(id);
+        QVERIFY(query.exec());
+        QVERIFY(query.next());
+        QVERIFY(!query.value(0).toString().isEmpty());
+    }
+    qint64 elapsed = timer.nsecsElapsed();
+
+    reportLatency("fresh statement", elapsed);
+    QTest::setBenchmarkResult(elapsed / 1000000.0, QTest::WalltimeMilliseconds);
+}
+
+void DocumentFetchBenchmarks::randomFetch_PreparedStatement() {
+    QString path = m_factory.cartridge(kDocumentCount);
+    QVERIFY(!path.isEmpty());
+
+    SignatureService signatureService;
+    CartridgeService service;
+    service.setSignatureService(&signatureService);
+    service.setDocumentCacheBudget(0);
+    QVERIFY(service.loadCartridge(path));
+
+    const QStringList ids = randomDocumentIds();
+
+    QElapsedTimer timer;
+    timer.start();
+    for (const QString& id : ids) {
+        QVERIFY(!service.getDocumentContent(id).isEmpty());
+    }
+    qint64 elapsed = timer.nsecsElapsed();
+
+    reportLatency("prepared statement", elapsed);
+    QTest::setBenchmarkResult(elapsed / 1000000.0, QTest::WalltimeMilliseconds);
+}
+
+// QTEST_MAIN removed - using main.cpp instead
+#include "DocumentFetchBenchmarks.moc"
@@ -0,0 +1,26 @@
+#ifndef DOCUMENTFETCHBENCHMARKS_H
+#define DOCUMENTFETCHBENCHMARKS_H
+
+#include <QtTest/QtTest>
+#include "BenchmarkCartridgeFactory.h"
+
+/**
+ * Measures per-lookup latency of random document fetches by primary key,
+ * preparing a fresh statement per lookup versus reusing the cartridge's
+ * prepared statement. The document cache is disabled so every lookup
+ * reaches SQLite.
+ */
+class DocumentFetchBenchmarks : public QObject {
+    Q_OBJECT
+
+private slots:
+    void randomFetch_FreshStatement();
+    void randomFetch_PreparedStatement();
+
+private:
+    QStringList randomDocumentIds() const;
+
+    BenchmarkCartridgeFactory m_factory;
+};
+
+#endif // DOCUMENTFETCHBENCHMARKS_H
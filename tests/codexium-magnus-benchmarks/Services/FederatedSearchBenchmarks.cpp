@@ -0,0 +1,69 @@
+#include "FederatedSearchBenchmarks.h"
+#include <QElapsedTimer>
+#include <QSignalSpy>
+#include "Services/FederatedSearchService.h"
+
+using namespace CodexiumMagnus::Services;
+
+namespace {
+const int kCartridgeCount = 20;
+const int kDocumentsPerCartridge = 5000;
+const int kRepetitions = 5;
+const QString kQuery = "imperial merchant";
+}
+
+void FederatedSearchBenchmarks::searchLibrary_data() {
+    QTest::addColumn<int>("threadCount");
+    QTest::newRow("1 thread") << 1;
+    QTest::newRow("2 threads") << 2;
+    QTest::newRow("4 threads") << 4;
+    QTest::newRow("one per core") << QThread::idealThreadCount();
+}
+
+void FederatedSearchBenchmarks::searchLibrary() {
+    QFETCH(int, threadCount);
+
+    FederatedSearchService search;
+    search.setMaxThreadCount(threadCount);
+    for (int i = 0; i < kCartridgeCount; ++i) {
+        QString path = m_factory.cartridge(kDocumentsPerCartridge, i);
+        QVERIFY(!path.isEmpty());
+        QVERIFY(search.mountCartridge(QString("cartridge-%1").arg(i), path));
+    }
+    QSignalSpy completedSpy(&search, &FederatedSearchService::searchCompleted);
+
+    // Warm the page cache so every row measures the same work
+    search.search(kQuery);
+    QVERIFY(completedSpy.wait(30000));
+
+    qint64 totalNs = 0;
+    int hits = 0;
+    for (int i = 0; i < kRepetitions; ++i) {
+        completedSpy.clear();
+        QElapsedTimer timer;
+        timer.start();
+        search.search(kQuery);
+        QVERIFY(completedSpy.wait(30000));
+        totalNs += timer.nsecsElapsed();
+        hits = qvariant_cast<QList<FederatedSearchHit>>(completedSpy.first().at(0)).size();
+    }
+
+    const double meanMs = totalNs / 1000000.0 / kRepetitions;
+    if (threadCount == 1) {
+        m_singleThreadMs = meanMs;
+    }
+    const double speedup = m_singleThreadMs > 0.0 ? m_singleThreadMs / meanMs : 0.0;
+
+    qInfo().noquote() << QString("%1 cartridges x %2 documents, %3 threads: mean %4 ms, "
+                                 "%5 merged hits, speedup %6x")
+        .arg(kCartridgeCount)
+        .arg(kDocumentsPerCartridge)
+        .arg(threadCount)
+        .arg(meanMs, 0, 'f', 2)
+        .arg(hits)
+        .arg(speedup, 0, 'f', 2);
+    QTest::setBenchmarkResult(meanMs, QTest::WalltimeMilliseconds);
+}
+
+// QTEST_MAIN removed - using main.cpp instead
+#include "FederatedSearchBenchmarks.moc"
@@ -0,0 +1,24 @@
+#ifndef FEDERATEDSEARCHBENCHMARKS_H
+#define FEDERATEDSEARCHBENCHMARKS_H
+
+#include <QtTest/QtTest>
+#include "BenchmarkCartridgeFactory.h"
+
+/**
+ * Measures federated search across a library of 20 synthetic cartridges
+ * with 1, 2, 4 and one-per-core search threads, and the speedup over a
+ * single thread.
+ */
+class FederatedSearchBenchmarks : public QObject {
+    Q_OBJECT
+
+private slots:
+    void searchLibrary_data();
+    void searchLibrary();
+
+private:
+    BenchmarkCartridgeFactory m_factory;
+    double m_singleThreadMs = 0.0;   ///< Mean of the 1-thread row, for the speedup
+};
+
+#endif // FEDERATEDSEARCHBENCHMARKS_H
@@ -0,0 +1,98 @@
+#include "FuzzyExpansionBenchmarks.h"
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QSet>
+#include "Services/FuzzyTermIndex.h"
+
+using namespace CodexiumMagnus::Services;
+
+namespace {
+const int kQueries = 200;
+
+// Letters weighted roughly like English text so trigram posting lists
+// have realistic skew
+const QString kLetters = "eeeeeeeeeeeetttttttttaaaaaaaaoooooooiiiiiiinnnnnnnsssssshhhhhhrrrrrrddddllllcccuuummwwffggyyppbbvkjxqz";
+
+QString randomTerm(QRandomGenerator& generator) {
+    const int length = 3 + generator.bounded(10);
+    QString term;
+    term.reserve(length);
+    for (int i = 0; i < length; ++i) {
+        term.append(kLetters.at(generator.bounded(int(kLetters.size()))));
+    }
+    return term;
+}
+
+QString misspell(QString term, QRandomGenerator& generator) {
+    const int position = generator.bounded(int(term.size()));
+    switch (generator.bounded(3)) {
+        case 0:
+            term[position] = kLetters.at(generator.bounded(int(kLetters.size())));
+            break;
+        case 1:
+            term.remove(position, 1);
+            break;
+        default:
+            term.insert(position, kLetters.at(generator.bounded(int(kLetters.size()))));
+            break;
+    }
+    return term;
+}
+}
+
+void FuzzyExpansionBenchmarks::expand_data() {
+    QTest::addColumn<int>("termCount");
+    QTest::newRow("50k") << 50000;
+    QTest::newRow("500k") << 500000;
+}
+
+void FuzzyExpansionBenchmarks::expand() {
+    QFETCH(int, termCount);
+
+    QRandomGenerator generator(7);
+    QSet<QString> unique;
+    QStringList terms;
+    std::vector<qint64> documentCounts;
+    while (terms.size() < termCount) {
+        QString term = randomTerm(generator);
+        if (!unique.contains(term)) {
+            unique.insert(term);
+            terms.append(term);
+            documentCounts.push_back(1 + generator.bounded(1000));
+        }
+    }
+
+    FuzzyTermIndex index;
+    QElapsedTimer buildTimer;
+    buildTimer.start();
+    index.setTerms(terms, documentCounts);
+    const qint64 buildMs = buildTimer.elapsed();
+
+    QStringList queries;
+    for (int i = 0; i < kQueries; ++i) {
+        queries.append(misspell(terms.at(generator.bounded(int(terms.size()))), generator));
+    }
+
+    qint64 slowestNs = 0;
+    int expansions = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (const QString& query : queries) {
+        QElapsedTimer queryTimer;
+        queryTimer.start();
+        expansions += index.expand(query).size();
+        slowestNs = qMax(slowestNs, queryTimer.nsecsElapsed());
+    }
+    const qint64 elapsed = timer.nsecsElapsed();
+
+    qInfo().noquote() << QString("%1 terms: index built in %2 ms; %3 expansions, mean %4 ms, slowest %5 ms per term")
+        .arg(termCount)
+        .arg(buildMs)
+        .arg(expansions)
+        .arg(elapsed / 1000000.0 / kQueries, 0, 'f', 3)
+        .arg(slowestNs / 1000000.0, 0, 'f', 3);
+    QTest::setBenchmarkResult(elapsed / 1000000.0 / kQueries, QTest::WalltimeMilliseconds);
+}
+
+// QTEST_MAIN removed - using main.cpp instead
+#include "FuzzyExpansionBenchmarks.moc"
@@ -0,0 +1,18 @@
+#ifndef FUZZYEXPANSIONBENCHMARKS_H
+#define FUZZYEXPANSIONBENCHMARKS_H
+
+#include <QtTest/QtTest>
+
+/**
+ * Measures fuzzy term expansion against a large synthetic vocabulary.
+ * The target is under 20 ms per expanded term for 500k terms.
+ */
+class FuzzyExpansionBenchmarks : public QObject {
+    Q_OBJECT
+
+private slots:
+    void expand_data();
+    void expand();
+};
+
+#endif // FUZZYEXPANSIONBENCHMARKS_H
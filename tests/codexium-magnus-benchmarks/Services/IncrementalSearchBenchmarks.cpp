@@ -0,0 +1,63 @@
+#include "IncrementalSearchBenchmarks.h"
+#include <QElapsedTimer>
+#include <QSignalSpy>
+#include "Services/CartridgeService.h"
+#include "Services/SearchService.h"
+
+using namespace CodexiumMagnus::Services;
+
+namespace {
+const QString kTypedQuery = "imperial merchant";
+const int kMinQueryLength = 2;
+}
+
+void IncrementalSearchBenchmarks::typeQuery_data() {
+    QTest::addColumn<int>("documentCount");
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("100k") << 100000;
+}
+
+void IncrementalSearchBenchmarks::typeQuery() {
+    QFETCH(int, documentCount);
+    QString path = m_factory.cartridge(documentCount);
+    QVERIFY(!path.isEmpty());
+
+    CartridgeService service;
+    QVERIFY(service.loadCartridge(path));
+    SearchService search(&service);
+    QSignalSpy completedSpy(&search, &SearchService::searchCompleted);
+
+    qint64 totalNs = 0;
+    qint64 slowestNs = 0;
+    qint64 slowestCallNs = 0;
+    int keystrokes = 0;
+    for (int length = kMinQueryLength; length <= kTypedQuery.size(); ++length) {
+        const QString prefix = kTypedQuery.left(length);
+        if (prefix.endsWith(' ')) {
+            continue;
+        }
+        completedSpy.clear();
+
+        QElapsedTimer timer;
+        timer.start();
+        search.performIncrementalSearch(prefix);
+        slowestCallNs = qMax(slowestCallNs, timer.nsecsElapsed());
+        QVERIFY(completedSpy.wait(10000));
+        const qint64 elapsed = timer.nsecsElapsed();
+
+        totalNs += elapsed;
+        slowestNs = qMax(slowestNs, elapsed);
+        ++keystrokes;
+    }
+
+    qInfo().noquote() << QString("%1 keystrokes: mean %2 ms, slowest %3 ms to first page; "
+                                 "slowest GUI-thread call %4 us")
+        .arg(keystrokes)
+        .arg(totalNs / 1000000.0 / keystrokes, 0, 'f', 2)
+        .arg(slowestNs / 1000000.0, 0, 'f', 2)
+        .arg(slowestCallNs / 1000.0, 0, 'f', 1);
+    QTest::setBenchmarkResult(totalNs / 1000000.0 / keystrokes, QTest::WalltimeMilliseconds);
+}
+
+// QTEST_MAIN removed - using main.cpp instead
+#include "IncrementalSearchBenchmarks.moc"
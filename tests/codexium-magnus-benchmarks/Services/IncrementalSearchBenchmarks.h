@@ -0,0 +1,24 @@
+#ifndef INCREMENTALSEARCHBENCHMARKS_H
+#define INCREMENTALSEARCHBENCHMARKS_H
+
+#include <QtTest/QtTest>
+#include "BenchmarkCartridgeFactory.h"
+
+/**
+ * Measures search-as-you-type: the time from each keystroke's incremental
+ * search until its first page of results arrives, typing a query one
+ * character at a time. Also measures how long performIncrementalSearch()
+ * blocks the calling (GUI) thread.
+ */
+class IncrementalSearchBenchmarks : public QObject {
+    Q_OBJECT
+
+private slots:
+    void typeQuery_data();
+    void typeQuery();
+
+private:
+    BenchmarkCartridgeFactory m_factory;
+};
+
+#endif // INCREMENTALSEARCHBENCHMARKS_H
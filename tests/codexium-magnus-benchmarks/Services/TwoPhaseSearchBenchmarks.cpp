@@ -0,0 +1,56 @@
+#include "TwoPhaseSearchBenchmarks.h"
+#include <QElapsedTimer>
+#include <QSignalSpy>
+#include "Services/CartridgeService.h"
+#include "Services/SearchService.h"
+
+using namespace CodexiumMagnus::Services;
+
+namespace {
+// Rows of the results list visible at once
+const int kVisibleRows = 10;
+}
+
+void TwoPhaseSearchBenchmarks::firstPageAndVisibleSnippets_data() {
+    QTest::addColumn<int>("documentCount");
+    QTest::newRow("1k documents") << 1000;
+    QTest::newRow("10k documents") << 10000;
+}
+
+void TwoPhaseSearchBenchmarks::firstPageAndVisibleSnippets() {
+    QFETCH(int, documentCount);
+    QString path = m_factory.cartridge(documentCount);
+    QVERIFY(!path.isEmpty());
+
+    CartridgeService service;
+    QVERIFY(service.loadCartridge(path));
+    SearchService search(&service);
+    QSignalSpy completedSpy(&search, &SearchService::searchCompleted);
+    QSignalSpy snippetsSpy(&search, &SearchService::snippetsReady);
+
+    // Every generated document contains common vocabulary words
+    QElapsedTimer timer;
+    timer.start();
+    search.performSearch("archive", false, false, false);
+    QVERIFY(completedSpy.wait(30000));
+    const qint64 firstPageNs = timer.nsecsElapsed();
+
+    const QList<SearchHit> visibleHits =
+        qvariant_cast<QList<SearchHit>>(completedSpy.takeFirst().at(0)).mid(0, kVisibleRows);
+    QVERIFY(!visibleHits.isEmpty());
+
+    timer.restart();
+    search.requestSnippets(visibleHits);
+    QVERIFY(snippetsSpy.wait(30000));
+    const qint64 snippetsNs = timer.nsecsElapsed();
+
+    qInfo().noquote() << QString("%1 documents: first page %2 ms, snippets for %3 visible hits %4 ms")
+        .arg(documentCount)
+        .arg(firstPageNs / 1000000.0, 0, 'f', 2)
+        .arg(visibleHits.size())
+        .arg(snippetsNs / 1000000.0, 0, 'f', 2);
+    QTest::setBenchmarkResult(firstPageNs / 1000000.0, QTest::WalltimeMilliseconds);
+}
+
+// QTEST_MAIN removed - using main.cpp instead
+#include "TwoPhaseSearchBenchmarks.moc"
@@ -0,0 +1,23 @@
+#ifndef TWOPHASESEARCHBENCHMARKS_H
+#define TWOPHASESEARCHBENCHMARKS_H
+
+#include <QtTest/QtTest>
+#include "BenchmarkCartridgeFactory.h"
+
+/**
+ * Measures the two phases of an FTS5 search for a broad query: the time to
+ * the first, rank-only page of results and the time to build snippets for
+ * the hits of one screen of the results list.
+ */
+class TwoPhaseSearchBenchmarks : public QObject {
+    Q_OBJECT
+
+private slots:
+    void firstPageAndVisibleSnippets_data();
+    void firstPageAndVisibleSnippets();
+
+private:
+    BenchmarkCartridgeFactory m_factory;
+};
+
+#endif // TWOPHASESEARCHBENCHMARKS_H
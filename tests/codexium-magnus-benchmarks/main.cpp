@@ -0,0 +1,142 @@
+#include <QtTest/QtTest>
+#include <QApplication>
+#include <QDebug>
+
+// Include benchmark class headers
+#include "Services/CartridgeLoadBenchmarks.h"
+#include "Services/DocumentFetchBenchmarks.h"
+#include "Services/CartridgeOpenProfileBenchmarks.h"
+#include "Services/IncrementalSearchBenchmarks.h"
+#include "Services/FuzzyExpansionBenchmarks.h"
+#include "Services/CaseSensitiveSearchBenchmarks.h"
+#include "Services/FederatedSearchBenchmarks.h"
+#include "Services/TwoPhaseSearchBenchmarks.h"
+
+int main(int argc, char *argv[])
+{
+    // Create a single QApplication for all benchmarks
+    QApplication app(argc, argv);
+    
+    int totalFailures = 0;
+    int totalSuites = 0;
+    
+    qDebug() << "\n========================================";
+    qDebug() << "Codexium Magnus Benchmark Suite";
+    qDebug() << "========================================\n";
+    
+    // Run each benchmark suite
+    {
+        CartridgeLoadBenchmarks benchmark;
+        qDebug() << "\n=== Running CartridgeLoadBenchmarks ===";
+        int result = QTest::qExec(&benchmark, argc, argv);
+        totalSuites++;
+        if (result != 0) {
+            totalFailures++;
+            qDebug() << "✗ CartridgeLoadBenchmarks FAILED";
+        } else {
+            qDebug() << "✓ CartridgeLoadBenchmarks PASSED";
+        }
+    }
+    
+    {
+        DocumentFetchBenchmarks benchmark;
+        qDebug() << "\n=== Running DocumentFetchBenchmarks ===";
+        int result = QTest::qExec(&benchmark, argc, argv);
+        totalSuites++;
+        if (result != 0) {
+            totalFailures++;
+            qDebug() << "✗ DocumentFetchBenchmarks FAILED";
+        } else {
+            qDebug() << "✓ DocumentFetchBenchmarks PASSED";
+        }
+    }
+    
+    {
+        CartridgeOpenProfileBenchmarks benchmark;
+        qDebug() << "\n=== Running CartridgeOpenProfileBenchmarks ===";
+        int result = QTest::qExec(&benchmark, argc, argv);
+        totalSuites++;
+        if (result != 0) {
+            totalFailures++;
+            qDebug() << "✗ CartridgeOpenProfileBenchmarks FAILED";
+        } else {
+            qDebug() << "✓ CartridgeOpenProfileBenchmarks PASSED";
+        }
+    }
+    
+    {
+        IncrementalSearchBenchmarks benchmark;
+        qDebug() << "\n=== Running IncrementalSearchBenchmarks ===";
+        int result = QTest::qExec(&benchmark, argc, argv);
+        totalSuites++;
+        if (result != 0) {
+            totalFailures++;
+            qDebug() << "✗ IncrementalSearchBenchmarks FAILED";
+        } else {
+            qDebug() << "✓ IncrementalSearchBenchmarks PASSED";
+        }
+    }
+    
+    {
+        FuzzyExpansionBenchmarks benchmark;
+        qDebug() << "\n=== Running FuzzyExpansionBenchmarks ===";
+        int result = QTest::qExec(&benchmark, argc, argv);
+        totalSuites++;
+        if (result != 0) {
+            totalFailures++;
+            qDebug() << "✗ FuzzyExpansionBenchmarks FAILED";
+        } else {
+            qDebug() << "✓ FuzzyExpansionBenchmarks PASSED";
+        }
+    }
+    
+    {
+        CaseSensitiveSearchBenchmarks benchmark;
+        qDebug() << "\n=== Running CaseSensitiveSearchBenchmarks ===";
+        int result = QTest::qExec(&benchmark, argc, argv);
+        totalSuites++;
+        if (result != 0) {
+            totalFailures++;
+            qDebug() << "✗ CaseSensitiveSearchBenchmarks FAILED";
+        } else {
+            qDebug() << "✓ CaseSensitiveSearchBenchmarks PASSED";
+        }
+    }
+    
+    {
+        FederatedSearchBenchmarks benchmark;
+        qDebug() << "\n=== Running FederatedSearchBenchmarks ===";
+        int result = QTest::qExec(&benchmark, argc, argv);
+        totalSuites++;
+        if (result != 0) {
+            totalFailures++;
+            qDebug() << "✗ FederatedSearchBenchmarks FAILED";
+        } else {
+            qDebug() << "✓ FederatedSearchBenchmarks PASSED";
+        }
+    }
+    
+    {
+        TwoPhaseSearchBenchmarks benchmark;
+        qDebug() << "\n=== Running TwoPhaseSearchBenchmarks ===";
+        int result = QTest::qExec(&benchmark, argc, argv);
+        totalSuites++;
+        if (result != 0) {
+            totalFailures++;
+            qDebug() << "✗ TwoPhaseSearchBenchmarks FAILED";
+        } else {
+            qDebug() << "✓ TwoPhaseSearchBenchmarks PASSED";
+        }
+    }
+    
+    // Summary
+    qDebug() << "\n========================================";
+    qDebug() << "Benchmark Summary";
+    qDebug() << "========================================";
+    qDebug() << "Total Benchmark Suites:" << totalSuites;
+    qDebug() << "Passed:" << (totalSuites - totalFailures);
+    qDebug() << "Failed:" << totalFailures;
+    qDebug() << "========================================\n";
+    
+    return totalFailures > 0 ? 1 : 0;
+}
@@ -12,6 +12,7 @@ class DbInitializerTests : public QObject {
 
 private slots:
     void ensureCreated_IsIdempotent_AndCreatesTables();
+    void ensureCreated_OldVerificationCache_IsRebuilt();
 };
 
 void DbInitializerTests::ensureCreated_IsIdempotent_AndCreatesTables() {
@@ -53,6 +54,50 @@ void DbInitializerTests::ensureCreated_IsIdempotent_AndCreatesTables() {
     QVERIFY(query.next());
     QCOMPARE(query.value(0).toString(), QString("UserSettings"));
 
+    // Check VerificationCache table
+    query.prepare("SELECT name FROM sqlite_master WHERE type='table' AND name=?");
+    query.addBindValue("VerificationCache");
+    QVERIFY(query.exec());
+    QVERIFY(query.next());
+    QCOMPARE(query.value(0).toString(), QString("VerificationCache"));
+
+    db.close();
+    QSqlDatabase::removeDatabase("test_connection");
+}
+
+void DbInitializerTests::ensureCreated_OldVerificationCache_IsRebuilt() {
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    QString dbPath = tempDir.filePath("app.db");
+
+    {
+        // Arrange: a cache written before manifests were part of the key
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "old_schema_connection");
+        db.setDatabaseName(dbPath);
+        QVERIFY(db.open());
+        QSqlQuery query(db);
+        QVERIFY(query.exec("CREATE TABLE VerificationCache (Path TEXT PRIMARY KEY, Inode INTEGER NOT NULL, "
+                           "Size INTEGER NOT NULL, ModifiedMs INTEGER NOT NULL, Digest BLOB NOT NULL, "
+                           "TrustLevel INTEGER NOT NULL, KeyFingerprint TEXT, VerifiedUtc TEXT NOT NULL)"));
+        QVERIFY(query.exec("INSERT INTO VerificationCache VALUES ('/a.cart', 1, 2, 3, x'00', 0, '', '')"));
+        db.close();
+    }
+    QSqlDatabase::removeDatabase("old_schema_connection");
+
+    // Act
+    DbInitializer::ensureCreated(dbPath);
+
+    // Assert: the old results are gone and the manifest columns exist
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "test_connection");
+    db.setDatabaseName(dbPath);
+    QVERIFY(db.open());
+    {
+        QSqlQuery query(db);
+        QVERIFY(query.exec("SELECT count(*) FROM VerificationCache"));
+        QVERIFY(query.next());
+        QCOMPARE(query.value(0).toInt(), 0);
+        QVERIFY(query.exec("SELECT ManifestInode, ManifestSize, ManifestModifiedMs FROM VerificationCache"));
+    }
     db.close();
     QSqlDatabase::removeDatabase("test_connection");
 }
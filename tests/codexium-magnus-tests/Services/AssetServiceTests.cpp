@@ -0,0 +1,276 @@
+#include "AssetServiceTests.h"
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include "Services/AssetService.h"
+#include "Services/CartridgeService.h"
+#include <QThread>
+#include <atomic>
+#include <memory>
+
+using namespace CodexiumMagnus::Services;
+
+QString AssetServiceTests::createCartridge(const QString& name, bool withAssets) {
+    QString path = m_directory->filePath(name + ".cartridge");
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "asset_test_cartridge");
+        db.setDatabaseName(path);
+        if (!db.open()) {
+            return QString();
+        }
+        
+        QSqlQuery query(db);
+        query.exec("CREATE TABLE documents (id TEXT PRIMARY KEY, title TEXT NOT NULL, content TEXT, parent_id TEXT)");
+        query.exec("INSERT INTO documents (id, title, content) VALUES ('doc1', 'Map Room', '<img src=\"images/map.png\">')");
+        query.prepare("INSERT INTO documents (id, title, content) VALUES (?, ?, ?)");
+        query.addBindValue("doc2");
+        query.addBindValue("Glossary");
+        query.addBindValue(documentText());
+        query.exec();
+        
+        if (withAssets) {
+            query.exec("CREATE TABLE assets (id INTEGER PRIMARY KEY, path TEXT UNIQUE NOT NULL, mime TEXT, blob BLOB)");
+            query.prepare("INSERT INTO assets (path, mime, blob) VALUES (?, ?, ?)");
+            query.addBindValue("images/map.png");
+            query.addBindValue("image/png");
+            query.addBindValue(m_imageData);
+            query.exec();
+            query.addBindValue("fonts/body.ttf");
+            query.addBindValue(QVariant());
+            query.addBindValue(QByteArray("font"));
+            query.exec();
+        }
+        db.close();
+    }
+    QSqlDatabase::removeDatabase("asset_test_cartridge");
+    return path;
+}
+
+QString AssetServiceTests::documentText() {
+    // Multi-byte characters across several chunks, so character and byte
+    // offsets differ
+    return QString("<p>%1</p>").arg(QString::fromUtf8("Über naïve Drachen ✓ ").repeated(8000));
+}
+
+void AssetServiceTests::init() {
+    m_directory = new QTemporaryDir();
+    
+    // Larger than several chunks, with a pattern that shows misplaced reads
+    m_imageData.resize(3 * CartridgeBlobDevice::chunkSize() + 123);
+    for (int i = 0; i < m_imageData.size(); ++i) {
+        m_imageData[i] = static_cast<char>((i * 7 + i / 256) & 0xff);
+    }
+    
+    CartridgeService* cartridgeService = new CartridgeService();
+    m_cartridgeService = cartridgeService;
+    m_service = new AssetService(cartridgeService);
+    QVERIFY(cartridgeService->loadCartridge(createCartridge("assets", true)));
+}
+
+void AssetServiceTests::cleanup() {
+    delete static_cast<AssetService*>(m_service);
+    m_service = nullptr;
+    delete static_cast<CartridgeService*>(m_cartridgeService);
+    m_cartridgeService = nullptr;
+    delete m_directory;
+    m_directory = nullptr;
+}
+
+void AssetServiceTests::findAsset_StoredPath_ReturnsSizeAndMimeType() {
+    AssetService* service = static_cast<AssetService*>(m_service);
+    
+    AssetService::AssetInfo info;
+    QVERIFY(service->findAsset("images/map.png", info));
+    QCOMPARE(info.path, QString("images/map.png"));
+    QCOMPARE(info.mimeType, QString("image/png"));
+    QCOMPARE(info.size, qint64(m_imageData.size()));
+    QVERIFY(info.rowId > 0);
+}
+
+void AssetServiceTests::findAsset_LeadingSlash_IsNormalized() {
+    AssetService* service = static_cast<AssetService*>(m_service);
+    
+    AssetService::AssetInfo info;
+    QVERIFY(service->findAsset("/images/map.png", info));
+    QVERIFY(service->findAsset("./images/../images/map.png", info));
+    QVERIFY(!service->findAsset("../images/map.png", info));
+}
+
+void AssetServiceTests::findAsset_MissingPath_ReturnsFalse() {
+    AssetService* service = static_cast<AssetService*>(m_service);
+    
+    AssetService::AssetInfo info;
+    QVERIFY(!service->findAsset("images/missing.png", info));
+    QVERIFY(!service->openAsset("images/missing.png", info));
+}
+
+void AssetServiceTests::findAsset_NoAssetsTable_ReturnsFalse() {
+    CartridgeService* cartridgeService = static_cast<CartridgeService*>(m_cartridgeService);
+    AssetService* service = static_cast<AssetService*>(m_service);
+    QVERIFY(cartridgeService->loadCartridge(createCartridge("plain", false)));
+    
+    AssetService::AssetInfo info;
+    QVERIFY(!service->findAsset("images/map.png", info));
+    QCOMPARE(cartridgeService->getDocumentContent("doc1"), QString("<img src=\"images/map.png\">"));
+}
+
+void AssetServiceTests::openAsset_LargeBlob_ReadsInChunks() {
+    AssetService* service = static_cast<AssetService*>(m_service);
+    
+    AssetService::AssetInfo info;
+    std::unique_ptr<CartridgeBlobDevice> device(service->openAsset("images/map.png", info));
+    QVERIFY(device);
+    QVERIFY(!device->isSequential());
+    QCOMPARE(device->size(), qint64(m_imageData.size()));
+    
+    QByteArray read;
+    while (!device->atEnd()) {
+        const QByteArray chunk = device->read(10 * CartridgeBlobDevice::chunkSize());
+        QVERIFY(!chunk.isEmpty());
+        QVERIFY(chunk.size() <= CartridgeBlobDevice::chunkSize());
+        read += chunk;
+    }
+    QCOMPARE(read, m_imageData);
+}
+
+void AssetServiceTests::openAsset_Seek_ReadsFromOffset() {
+    AssetService* service = static_cast<AssetService*>(m_service);
+    
+    AssetService::AssetInfo info;
+    std::unique_ptr<CartridgeBlobDevice> device(service->openAsset("images/map.png", info));
+    QVERIFY(device);
+    
+    const qint64 offset = 2 * CartridgeBlobDevice::chunkSize() - 10;
+    QVERIFY(device->seek(offset));
+    QCOMPARE(device->read(20), m_imageData.mid(offset, 20));
+    QVERIFY(device->seek(0));
+    QCOMPARE(device->read(5), m_imageData.left(5));
+}
+
+void AssetServiceTests::openAsset_ReadOnOtherThread_MatchesBlob() {
+    AssetService* service = static_cast<AssetService*>(m_service);
+    
+    AssetService::AssetInfo info;
+    std::unique_ptr<CartridgeBlobDevice> device(service->openAsset("images/map.png", info));
+    QVERIFY(device);
+    
+    // Qt WebEngine reads replies on its IO thread
+    QByteArray read;
+    std::unique_ptr<QThread> reader(QThread::create([&device, &read]() {
+        while (!device->atEnd()) {
+            const QByteArray chunk = device->read(CartridgeBlobDevice::chunkSize());
+            if (chunk.isEmpty()) {
+                return;
+            }
+            read += chunk;
+        }
+    }));
+    reader->start();
+    QVERIFY(reader->wait(10000));
+    QCOMPARE(read, m_imageData);
+}
+
+void AssetServiceTests::openDocument_MultiByteContent_StreamsUtf8() {
+    AssetService* service = static_cast<AssetService*>(m_service);
+    const QByteArray expected = documentText().toUtf8();
+    
+    AssetService::AssetInfo info;
+    std::unique_ptr<CartridgeBlobDevice> device(service->openDocument("doc2", info));
+    QVERIFY(device);
+    QCOMPARE(info.mimeType, QString("text/html;charset=utf-8"));
+    QCOMPARE(device->size(), qint64(expected.size()));
+    QVERIFY(expected.size() > 2 * CartridgeBlobDevice::chunkSize());
+    
+    QByteArray read;
+    while (!device->atEnd()) {
+        const QByteArray chunk = device->read(CartridgeBlobDevice::chunkSize());
+        QVERIFY(!chunk.isEmpty());
+        read += chunk;
+    }
+    QCOMPARE(read, expected);
+}
+
+void AssetServiceTests::openDocument_MissingId_ReturnsNull() {
+    AssetService* service = static_cast<AssetService*>(m_service);
+    
+    AssetService::AssetInfo info;
+    QVERIFY(!service->openDocument("missing", info));
+    QVERIFY(!service->openDocument("images/map.png", info));
+    QCOMPARE(service->openDeviceCount(), 0);
+}
+
+void AssetServiceTests::unloadCartridge_OpenDevice_ReleasesConnection() {
+    CartridgeService* cartridgeService = static_cast<CartridgeService*>(m_cartridgeService);
+    AssetService* service = static_cast<AssetService*>(m_service);
+    const int connections = QSqlDatabase::connectionNames().size();
+    
+    AssetService::AssetInfo info;
+    std::unique_ptr<CartridgeBlobDevice> device(service->openAsset("images/map.png", info));
+    QVERIFY(device);
+    QVERIFY(device->hasConnection());
+    QCOMPARE(service->openDeviceCount(), 1);
+    QCOMPARE(QSqlDatabase::connectionNames().size(), connections + 1);
+    
+    cartridgeService->unloadCartridge();
+    
+    // The device stays open for its reader, but reads fail
+    QVERIFY(!device->hasConnection());
+    QCOMPARE(service->openDeviceCount(), 0);
+    QVERIFY(device->read(16).isEmpty());
+    QVERIFY(QSqlDatabase::connectionNames().size() < connections + 1);
+}
+
+void AssetServiceTests::unloadCartridge_WhileReadingOnOtherThread_FailsReads() {
+    CartridgeService* cartridgeService = static_cast<CartridgeService*>(m_cartridgeService);
+    AssetService* service = static_cast<AssetService*>(m_service);
+    
+    AssetService::AssetInfo info;
+    std::unique_ptr<CartridgeBlobDevice> device(service->openAsset("images/map.png", info));
+    QVERIFY(device);
+    
+    // Reads the blob over and over until the connection goes away; every
+    // chunk read before that must be intact
+    std::atomic<int> passes{0};
+    std::atomic<bool> corrupted{false};
+    const QByteArray expected = m_imageData;
+    std::unique_ptr<QThread> reader(QThread::create([&device, &passes, &corrupted, expected]() {
+        for (;;) {
+            if (!device->seek(0)) {
+                return;
+            }
+            while (!device->atEnd()) {
+                const qint64 position = device->pos();
+                const QByteArray chunk = device->read(CartridgeBlobDevice::chunkSize());
+                if (chunk.isEmpty()) {
+                    return;
+                }
+                if (chunk != expected.mid(position, chunk.size())) {
+                    corrupted = true;
+                    return;
+                }
+            }
+            ++passes;
+        }
+    }));
+    reader->start();
+    QTRY_VERIFY(passes > 0);
+    
+    cartridgeService->unloadCartridge();
+    
+    QVERIFY(reader->wait(10000));
+    QVERIFY(!corrupted);
+    QCOMPARE(service->openDeviceCount(), 0);
+}
+
+void AssetServiceTests::mimeTypeForPath_NoStoredType_UsesExtension() {
+    AssetService* service = static_cast<AssetService*>(m_service);
+    
+    AssetService::AssetInfo info;
+    QVERIFY(service->findAsset("fonts/body.ttf", info));
+    QVERIFY(info.mimeType.startsWith("font/") || info.mimeType.contains("truetype"));
+    QCOMPARE(AssetService::mimeTypeForPath("images/map.png"), QString("image/png"));
+    QCOMPARE(AssetService::mimeTypeForPath("data.unknownext"), QString("application/octet-stream"));
+    QCOMPARE(AssetService::mimeTypeForPath("images/map.png", "image/webp"), QString("image/webp"));
+}
+
+// QTEST_MAIN removed - using main.cpp instead
+#include "AssetServiceTests.moc"
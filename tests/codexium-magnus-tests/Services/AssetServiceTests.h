@@ -0,0 +1,42 @@
+#ifndef ASSETSERVICETESTS_H
+#define ASSETSERVICETESTS_H
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+
+class AssetServiceTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+    
+    // Lookup tests
+    void findAsset_StoredPath_ReturnsSizeAndMimeType();
+    void findAsset_LeadingSlash_IsNormalized();
+    void findAsset_MissingPath_ReturnsFalse();
+    void findAsset_NoAssetsTable_ReturnsFalse();
+    
+    // Streaming tests
+    void openAsset_LargeBlob_ReadsInChunks();
+    void openAsset_Seek_ReadsFromOffset();
+    void openAsset_ReadOnOtherThread_MatchesBlob();
+    void openDocument_MultiByteContent_StreamsUtf8();
+    void openDocument_MissingId_ReturnsNull();
+    void unloadCartridge_OpenDevice_ReleasesConnection();
+    void unloadCartridge_WhileReadingOnOtherThread_FailsReads();
+    
+    // MIME type tests
+    void mimeTypeForPath_NoStoredType_UsesExtension();
+
+private:
+    QString createCartridge(const QString& name, bool withAssets);
+    static QString documentText();
+    
+    void* m_cartridgeService; // CartridgeService* - using void* to avoid include in header
+    void* m_service;          // AssetService*
+    QTemporaryDir* m_directory;
+    QByteArray m_imageData;
+};
+
+#endif // ASSETSERVICETESTS_H
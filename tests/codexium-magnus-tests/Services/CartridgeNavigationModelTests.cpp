@@ -0,0 +1,250 @@
+#include "CartridgeNavigationModelTests.h"
+#include <QTemporaryFile>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QFile>
+#include "Services/CartridgeNavigationModel.h"
+
+using namespace CodexiumMagnus::Services;
+
+// Helper class to create test cartridge with a navigation table
+class TestNavigationCartridgeHelper {
+public:
+    static void createNavigation(QSqlDatabase& db) {
+        QSqlQuery query(db);
+        
+        query.exec(R"(
+            CREATE TABLE IF NOT EXISTS navigation (
+                id TEXT PRIMARY KEY,
+                title TEXT NOT NULL,
+                parent_id TEXT,
+                type TEXT NOT NULL,
+                sort_order INTEGER
+            )
+        )");
+        query.exec("CREATE INDEX IF NOT EXISTS idx_navigation_parent ON navigation(parent_id, sort_order)");
+        
+        query.prepare("INSERT INTO navigation (id, title, parent_id, type, sort_order) VALUES (?, ?, ?, ?, ?)");
+        
+        // Two volumes; vol1 has five documents, vol2 has one
+        int sortOrder = 0;
+        const QStringList volumes = {"vol1", "vol2"};
+        for (const QString& volume : volumes) {
+            query.addBindValue(volume);
+            query.addBindValue(QString("Volume %1").arg(volume));
+            query.addBindValue(QString());
+            query.addBindValue("volume");
+            query.addBindValue(sortOrder++);
+            query.exec();
+        }
+        for (int i = 1; i <= 6; ++i) {
+            query.addBindValue(QString("doc%1").arg(i));
+            query.addBindValue(QString("Document %1").arg(i));
+            query.addBindValue(i <= 5 ? "vol1" : "vol2");
+            query.addBindValue("document");
+            query.addBindValue(sortOrder++);
+            query.exec();
+        }
+    }
+};
+
+void CartridgeNavigationModelTests::init() {
+    m_testCartridge = new QTemporaryFile();
+    m_testCartridge->open();
+    m_testCartridge->close();
+    
+    m_connectionName = "test_navigation_model";
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", m_connectionName);
+    db.setDatabaseName(m_testCartridge->fileName());
+    db.open();
+    TestNavigationCartridgeHelper::createNavigation(db);
+    
+    m_model = new CartridgeNavigationModel();
+}
+
+void CartridgeNavigationModelTests::cleanup() {
+    delete static_cast<CartridgeNavigationModel*>(m_model);
+    m_model = nullptr;
+    
+    QSqlDatabase::database(m_connectionName, false).close();
+    QSqlDatabase::removeDatabase(m_connectionName);
+    
+    if (m_testCartridge) {
+        QFile::remove(m_testCartridge->fileName());
+        delete m_testCartridge;
+        m_testCartridge = nullptr;
+    }
+}
+
+void CartridgeNavigationModelTests::fetchMore_Root_LoadsTopLevelNodesOnly() {
+    CartridgeNavigationModel* model = static_cast<CartridgeNavigationModel*>(m_model);
+    model->setDatabase(QSqlDatabase::database(m_connectionName), "Test");
+    
+    QCOMPARE(model->rowCount(), 0);
+    QVERIFY(model->canFetchMore(QModelIndex()));
+    model->fetchMore(QModelIndex());
+    
+    QCOMPARE(model->rowCount(), 2);
+    QCOMPARE(model->loadedNodeCount(), 2);
+    QCOMPARE(model->rowCount(model->index(0, 0)), 0);
+}
+
+void CartridgeNavigationModelTests::fetchMore_Node_LoadsChildrenInBatches() {
+    CartridgeNavigationModel* model = static_cast<CartridgeNavigationModel*>(m_model);
+    model->setBatchSize(2);
+    model->setDatabase(QSqlDatabase::database(m_connectionName), "Test");
+    model->fetchMore(QModelIndex());
+    
+    QModelIndex volume = model->index(0, 0);
+    QVERIFY(model->canFetchMore(volume));
+    model->fetchMore(volume);
+    QCOMPARE(model->rowCount(volume), 2);
+    
+    while (model->canFetchMore(volume)) {
+        model->fetchMore(volume);
+    }
+    QCOMPARE(model->rowCount(volume), 5);
+    QCOMPARE(model->index(4, 0, volume).data(Qt::UserRole + 1).toString(), QString("doc5"));
+    QCOMPARE(model->parent(model->index(4, 0, volume)), volume);
+}
+
+void CartridgeNavigationModelTests::fetchMore_NullSortOrder_LoadsEveryChild() {
+    QSqlQuery query(QSqlDatabase::database(m_connectionName));
+    QVERIFY(query.exec("INSERT INTO navigation (id, title, parent_id, type, sort_order) VALUES "
+                       "('doc7', 'Document 7', 'vol1', 'document', NULL), "
+                       "('doc8', 'Document 8', 'vol1', 'document', NULL)"));
+    
+    CartridgeNavigationModel* model = static_cast<CartridgeNavigationModel*>(m_model);
+    model->setBatchSize(2);
+    model->setDatabase(QSqlDatabase::database(m_connectionName), "Test");
+    model->fetchMore(QModelIndex());
+    
+    QModelIndex volume = model->index(0, 0);
+    while (model->canFetchMore(volume)) {
+        model->fetchMore(volume);
+    }
+    
+    // Unordered children come first, then the rest in sort order
+    QCOMPARE(model->rowCount(volume), 7);
+    QCOMPARE(model->index(0, 0, volume).data(Qt::UserRole + 1).toString(), QString("doc7"));
+    QCOMPARE(model->index(1, 0, volume).data(Qt::UserRole + 1).toString(), QString("doc8"));
+    QCOMPARE(model->index(2, 0, volume).data(Qt::UserRole + 1).toString(), QString("doc1"));
+    QCOMPARE(model->index(6, 0, volume).data(Qt::UserRole + 1).toString(), QString("doc5"));
+}
+
+void CartridgeNavigationModelTests::fetchMore_Root_ShowsOrphanedNodes() {
+    QSqlQuery query(QSqlDatabase::database(m_connectionName));
+    QVERIFY(query.exec("INSERT INTO navigation (id, title, parent_id, type, sort_order) VALUES "
+                       "('orphan', 'Orphaned Document', 'missing', 'document', 100)"));
+    
+    CartridgeNavigationModel* model = static_cast<CartridgeNavigationModel*>(m_model);
+    model->setDatabase(QSqlDatabase::database(m_connectionName), "Test");
+    model->fetchMore(QModelIndex());
+    
+    QCOMPARE(model->rowCount(), 3);
+    QCOMPARE(model->index(2, 0).data(Qt::UserRole + 1).toString(), QString("orphan"));
+    QVERIFY(!model->hasChildren(model->index(2, 0)));
+}
+
+void CartridgeNavigationModelTests::hasChildren_BeforeFetch_ReflectsDatabase() {
+    CartridgeNavigationModel* model = static_cast<CartridgeNavigationModel*>(m_model);
+    model->setDatabase(QSqlDatabase::database(m_connectionName), "Test");
+    model->fetchMore(QModelIndex());
+    
+    QModelIndex volume = model->index(0, 0);
+    QVERIFY(model->hasChildren(volume));
+    model->fetchMore(volume);
+    QVERIFY(!model->hasChildren(model->index(0, 0, volume)));
+}
+
+void CartridgeNavigationModelTests::data_Roles_ExposeTypeAndId() {
+    CartridgeNavigationModel* model = static_cast<CartridgeNavigationModel*>(m_model);
+    model->setDatabase(QSqlDatabase::database(m_connectionName), "Test");
+    model->fetchMore(QModelIndex());
+    
+    QModelIndex volume = model->index(1, 0);
+    QCOMPARE(volume.data(Qt::DisplayRole).toString(), QString("Volume vol2"));
+    QCOMPARE(volume.data(Qt::UserRole).toString(), QString("volume"));
+    QCOMPARE(volume.data(Qt::UserRole + 1).toString(), QString("vol2"));
+}
+
+void CartridgeNavigationModelTests::onNodeCollapsed_BeyondCapacity_ReleasesChildren() {
+    CartridgeNavigationModel* model = static_cast<CartridgeNavigationModel*>(m_model);
+    model->setBlockCacheCapacity(1);
+    model->setDatabase(QSqlDatabase::database(m_connectionName), "Test");
+    model->fetchMore(QModelIndex());
+    
+    QModelIndex vol1 = model->index(0, 0);
+    QModelIndex vol2 = model->index(1, 0);
+    model->fetchMore(vol1);
+    model->fetchMore(vol2);
+    QCOMPARE(model->loadedNodeCount(), 8);
+    
+    model->onNodeCollapsed(vol1);
+    QCOMPARE(model->rowCount(vol1), 5); // Still within capacity
+    
+    model->onNodeCollapsed(vol2);
+    QCOMPARE(model->rowCount(vol1), 0); // Least recently collapsed block released
+    QCOMPARE(model->rowCount(vol2), 1);
+    QCOMPARE(model->loadedNodeCount(), 3);
+    
+    // Re-expanding fetches the block again
+    QVERIFY(model->canFetchMore(vol1));
+    model->fetchMore(vol1);
+    QCOMPARE(model->rowCount(vol1), 5);
+}
+
+void CartridgeNavigationModelTests::onNodeExpanded_PinsChildren() {
+    CartridgeNavigationModel* model = static_cast<CartridgeNavigationModel*>(m_model);
+    model->setBlockCacheCapacity(0);
+    model->setDatabase(QSqlDatabase::database(m_connectionName), "Test");
+    model->fetchMore(QModelIndex());
+    
+    QModelIndex vol1 = model->index(0, 0);
+    model->fetchMore(vol1);
+    model->onNodeExpanded(vol1);
+    QCOMPARE(model->rowCount(vol1), 5);
+    
+    model->onNodeCollapsed(vol1);
+    QCOMPARE(model->rowCount(vol1), 0);
+}
+
+void CartridgeNavigationModelTests::setDatabase_NoNavigationTable_ShowsPlaceholder() {
+    QTemporaryFile emptyCartridge;
+    QVERIFY(emptyCartridge.open());
+    emptyCartridge.close();
+    
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "test_navigation_empty");
+        db.setDatabaseName(emptyCartridge.fileName());
+        QVERIFY(db.open());
+        
+        CartridgeNavigationModel model;
+        model.setDatabase(db, "Placeholder");
+        model.fetchMore(QModelIndex());
+        
+        QCOMPARE(model.rowCount(), 1);
+        QCOMPARE(model.index(0, 0).data().toString(), QString("Placeholder"));
+        QCOMPARE(model.index(0, 0).data(Qt::UserRole).toString(), QString("corpus"));
+        QVERIFY(!model.canFetchMore(QModelIndex()));
+        
+        model.clear();
+        db.close();
+    }
+    QSqlDatabase::removeDatabase("test_navigation_empty");
+}
+
+void CartridgeNavigationModelTests::clear_DropsAllNodes() {
+    CartridgeNavigationModel* model = static_cast<CartridgeNavigationModel*>(m_model);
+    model->setDatabase(QSqlDatabase::database(m_connectionName), "Test");
+    model->fetchMore(QModelIndex());
+    QVERIFY(model->rowCount() > 0);
+    
+    model->clear();
+    QCOMPARE(model->rowCount(), 0);
+    QCOMPARE(model->loadedNodeCount(), 0);
+    QVERIFY(!model->canFetchMore(QModelIndex()));
+}
+
+// QTEST_MAIN removed - using main.cpp instead
+#include "CartridgeNavigationModelTests.moc"
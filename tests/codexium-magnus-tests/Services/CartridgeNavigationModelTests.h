@@ -0,0 +1,36 @@
+#ifndef CARTRIDGENAVIGATIONMODELTESTS_H
+#define CARTRIDGENAVIGATIONMODELTESTS_H
+
+#include <QtTest/QtTest>
+#include <QTemporaryFile>
+
+class CartridgeNavigationModelTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+    
+    // Fetch tests
+    void fetchMore_Root_LoadsTopLevelNodesOnly();
+    void fetchMore_Node_LoadsChildrenInBatches();
+    void fetchMore_NullSortOrder_LoadsEveryChild();
+    void fetchMore_Root_ShowsOrphanedNodes();
+    void hasChildren_BeforeFetch_ReflectsDatabase();
+    void data_Roles_ExposeTypeAndId();
+    
+    // Memory tests
+    void onNodeCollapsed_BeyondCapacity_ReleasesChildren();
+    void onNodeExpanded_PinsChildren();
+    
+    // Fallback tests
+    void setDatabase_NoNavigationTable_ShowsPlaceholder();
+    void clear_DropsAllNodes();
+
+private:
+    void* m_model; // CartridgeNavigationModel* - using void* to avoid include in header
+    QTemporaryFile* m_testCartridge;
+    QString m_connectionName;
+};
+
+#endif // CARTRIDGENAVIGATIONMODELTESTS_H
@@ -2,13 +2,56 @@
 #include <QTemporaryFile>
 #include <QSqlDatabase>
 #include <QSqlQuery>
-#include <QStandardItemModel>
+#include <QAbstractItemModel>
+#include <QSignalSpy>
 #include <QFile>
 #include "Services/CartridgeService.h"
 #include "Services/ISignatureService.h"
+#include <QSemaphore>
 
 using namespace CodexiumMagnus::Services;
 
+// Signature service whose verification blocks until released
+class GatedSignatureService : public ISignatureService {
+public:
+    TrustLevel verifyCartridge(const QString& cartridgePath) override {
+        Q_UNUSED(cartridgePath);
+        gate.acquire();
+        return TrustLevel::Verified;
+    }
+    bool verifySignature(const QByteArray&, const QByteArray&, const QByteArray&) override { return false; }
+    void addTrustedKey(const QByteArray&, const QString&, bool) override {}
+    void removeTrustedKey(const QByteArray&) override {}
+    TrustLevel getKeyTrustLevel(const QByteArray&) const override { return TrustLevel::Unverified; }
+
+    QSemaphore gate;
+};
+
+// Signature service whose verification runs until cancelled, then blocks
+// until released
+class CancellableSignatureService : public ISignatureService {
+public:
+    TrustLevel verifyCartridge(const QString& cartridgePath) override {
+        return verifyCartridge(cartridgePath, std::function<bool()>());
+    }
+    TrustLevel verifyCartridge(const QString& cartridgePath, const std::function<bool()>& isCancelled) override {
+        Q_UNUSED(cartridgePath);
+        started.release();
+        while (isCancelled && !isCancelled()) {
+            QThread::msleep(1);
+        }
+        finish.acquire();
+        return TrustLevel::Verified;
+    }
+    bool verifySignature(const QByteArray&, const QByteArray&, const QByteArray&) override { return false; }
+    void addTrustedKey(const QByteArray&, const QString&, bool) override {}
+    void removeTrustedKey(const QByteArray&) override {}
+    TrustLevel getKeyTrustLevel(const QByteArray&) const override { return TrustLevel::Unverified; }
+
+    QSemaphore started;
+    QSemaphore finish;
+};
+
 // Helper class to create test cartridge databases
 class TestCartridgeHelper {
 public:
@@ -112,6 +155,77 @@ void CartridgeServiceTests::isCartridgeLoaded_BeforeLoad_ReturnsFalse() {
     QVERIFY(!service->isCartridgeLoaded());
 }
 
+void CartridgeServiceTests::loadCartridgeAsync_ValidPath_EmitsStagedSignals() {
+    CartridgeService* service = static_cast<CartridgeService*>(m_service);
+    QSignalSpy openedSpy(service, &CartridgeService::cartridgeOpened);
+    QSignalSpy navigationSpy(service, &CartridgeService::navigationReady);
+    QSignalSpy loadedSpy(service, &CartridgeService::cartridgeLoaded);
+    QSignalSpy trustSpy(service, &CartridgeService::trustLevelDetermined);
+    
+    service->loadCartridgeAsync(m_testCartridge->fileName());
+    
+    QTRY_COMPARE(trustSpy.count(), 1);
+    QCOMPARE(openedSpy.count(), 1);
+    QCOMPARE(navigationSpy.count(), 1);
+    QCOMPARE(loadedSpy.count(), 1);
+    QVERIFY(service->isCartridgeLoaded());
+    QCOMPARE(service->getCartridgePath(), m_testCartridge->fileName());
+    QVERIFY(service->getDocumentContent("doc1").contains("Content 1"));
+}
+
+void CartridgeServiceTests::loadCartridgeAsync_InvalidPath_EmitsError() {
+    CartridgeService* service = static_cast<CartridgeService*>(m_service);
+    QSignalSpy errorSpy(service, &CartridgeService::errorOccurred);
+    QSignalSpy loadedSpy(service, &CartridgeService::cartridgeLoaded);
+    
+    service->loadCartridgeAsync("/nonexistent/path/to/cartridge.db");
+    
+    QTRY_COMPARE(errorSpy.count(), 1);
+    QCOMPARE(loadedSpy.count(), 0);
+    QVERIFY(!service->isCartridgeLoaded());
+}
+
+void CartridgeServiceTests::loadCartridgeAsync_ThenUnload_DropsPendingStages() {
+    CartridgeService* service = static_cast<CartridgeService*>(m_service);
+    QSignalSpy loadedSpy(service, &CartridgeService::cartridgeLoaded);
+    
+    service->loadCartridgeAsync(m_testCartridge->fileName());
+    service->unloadCartridge();
+    
+    // Let the worker finish and its queued stages be delivered
+    QTRY_VERIFY(!service->isLoading());
+    QTest::qWait(50);
+    
+    QCOMPARE(loadedSpy.count(), 0);
+    QVERIFY(!service->isCartridgeLoaded());
+}
+
+void CartridgeServiceTests::loadCartridgeAsync_WhileVerifying_LoadsLatestWithoutWaiting() {
+    CartridgeService* service = static_cast<CartridgeService*>(m_service);
+    CancellableSignatureService signatureService;
+    service->setSignatureService(&signatureService);
+    QSignalSpy openedSpy(service, &CartridgeService::cartridgeOpened);
+    QSignalSpy trustSpy(service, &CartridgeService::trustLevelDetermined);
+    
+    service->loadCartridgeAsync(m_testCartridge->fileName());
+    QVERIFY(signatureService.started.tryAcquire(1, 5000));
+    QTRY_COMPARE(openedSpy.count(), 1);
+    
+    // The first load's verification cannot finish until released; the
+    // second load must not wait for it
+    service->loadCartridgeAsync(m_testCartridge->fileName());
+    QVERIFY(signatureService.started.tryAcquire(1, 5000));
+    QTRY_COMPARE(openedSpy.count(), 2);
+    QVERIFY(service->isCartridgeLoaded());
+    
+    // Only the latest load reports a trust level
+    signatureService.finish.release(2);
+    QTRY_COMPARE(trustSpy.count(), 1);
+    QTRY_VERIFY(!service->isLoading());
+    QCOMPARE(service->getTrustLevel(), TrustLevel::Verified);
+    service->setSignatureService(nullptr);
+}
+
 void CartridgeServiceTests::getCartridgeName_AfterLoad_ReturnsName() {
     CartridgeService* service = static_cast<CartridgeService*>(m_service);
     service->loadCartridge(m_testCartridge->fileName());
@@ -156,16 +270,53 @@ void CartridgeServiceTests::getDocumentList_AfterLoad_ReturnsList() {
     QVERIFY(documents.contains("doc2"));
 }
 
+void CartridgeServiceTests::getDocumentContent_Repeated_HitsCache() {
+    CartridgeService* service = static_cast<CartridgeService*>(m_service);
+    service->loadCartridge(m_testCartridge->fileName());
+    
+    QString first = service->getDocumentContent("doc1");
+    QString second = service->getDocumentContent("doc1");
+    
+    QCOMPARE(second, first);
+    QCOMPARE(service->documentCacheMisses(), quint64(1));
+    QCOMPARE(service->documentCacheHits(), quint64(1));
+    QVERIFY(service->documentCacheSize() > 0);
+}
+
+void CartridgeServiceTests::getDocumentContent_OverBudget_NotCached() {
+    CartridgeService* service = static_cast<CartridgeService*>(m_service);
+    service->setDocumentCacheBudget(8); // Smaller than any test document
+    service->loadCartridge(m_testCartridge->fileName());
+    
+    QVERIFY(service->getDocumentContent("doc1").contains("Content 1"));
+    QVERIFY(service->getDocumentContent("doc1").contains("Content 1"));
+    
+    QCOMPARE(service->documentCacheHits(), quint64(0));
+    QCOMPARE(service->documentCacheMisses(), quint64(2));
+    QCOMPARE(service->documentCacheSize(), qint64(0));
+}
+
+void CartridgeServiceTests::unloadCartridge_AfterLoad_EvictsCachedDocuments() {
+    CartridgeService* service = static_cast<CartridgeService*>(m_service);
+    service->loadCartridge(m_testCartridge->fileName());
+    service->getDocumentContent("doc1");
+    service->getDocumentContent("doc2");
+    QVERIFY(service->documentCacheSize() > 0);
+    
+    service->unloadCartridge();
+    QCOMPARE(service->documentCacheSize(), qint64(0));
+}
+
 void CartridgeServiceTests::getNavigationModel_AfterLoad_ReturnsModel() {
     CartridgeService* service = static_cast<CartridgeService*>(m_service);
     service->loadCartridge(m_testCartridge->fileName());
-    QStandardItemModel* model = service->getNavigationModel();
+    QAbstractItemModel* model = service->getNavigationModel();
     QVERIFY(model != nullptr);
 }
 
 void CartridgeServiceTests::getNavigationModel_NoCartridge_ReturnsModel() {
     CartridgeService* service = static_cast<CartridgeService*>(m_service);
-    QStandardItemModel* model = service->getNavigationModel();
+    QAbstractItemModel* model = service->getNavigationModel();
     QVERIFY(model != nullptr);
 }
 
@@ -200,6 +351,74 @@ void CartridgeServiceTests::getDatabase_NoCartridge_ReturnsNull() {
     QVERIFY(db == nullptr);
 }
 
+void CartridgeServiceTests::loadCartridge_DefaultProfile_IsReadOnly() {
+    CartridgeService* service = static_cast<CartridgeService*>(m_service);
+    QVERIFY(service->loadCartridge(m_testCartridge->fileName()));
+    
+    QSqlQuery query(*service->getDatabase());
+    QVERIFY(!query.exec("INSERT INTO documents (id, title, content) VALUES ('doc9', 'Doc 9', 'Content 9')"));
+}
+
+void CartridgeServiceTests::loadCartridge_DefaultProfile_AppliesPragmas() {
+    CartridgeService* service = static_cast<CartridgeService*>(m_service);
+    CartridgeOpenProfile profile = CartridgeOpenProfile::immutableCartridge();
+    profile.cacheSize = 4 * 1024 * 1024;
+    service->setDefaultOpenProfile(profile);
+    QVERIFY(service->loadCartridge(m_testCartridge->fileName()));
+    
+    QSqlQuery query(*service->getDatabase());
+    QVERIFY(query.exec("PRAGMA cache_size"));
+    QVERIFY(query.next());
+    QCOMPARE(query.value(0).toLongLong(), -4096LL);
+}
+
+void CartridgeServiceTests::setOpenProfile_PerCartridge_OverridesDefault() {
+    CartridgeService* service = static_cast<CartridgeService*>(m_service);
+    service->setOpenProfile(m_testCartridge->fileName(), CartridgeOpenProfile::defaults());
+    QVERIFY(service->openProfile(m_testCartridge->fileName()) == CartridgeOpenProfile::defaults());
+    QVERIFY(service->openProfile("/other/cartridge.cart") == service->defaultOpenProfile());
+    
+    QVERIFY(service->loadCartridge(m_testCartridge->fileName()));
+    QSqlQuery query(*service->getDatabase());
+    QVERIFY(query.exec("INSERT INTO documents (id, title, content) VALUES ('doc9', 'Doc 9', 'Content 9')"));
+}
+
+void CartridgeServiceTests::preparedStatement_SameSql_ReturnsSameStatement() {
+    CartridgeService* service = static_cast<CartridgeService*>(m_service);
+    service->loadCartridge(m_testCartridge->fileName());
+    
+    const QString sql = "SELECT title FROM documents WHERE id = ?";
+    QSqlQuery* first = service->preparedStatement(sql);
+    QVERIFY(first != nullptr);
+    first->addBindValue("doc1");
+    QVERIFY(first->exec());
+    QVERIFY(first->next());
+    QCOMPARE(first->value(0).toString(), QString("Document 1"));
+    first->finish();
+    
+    // Rebinding the same statement returns the new row
+    QSqlQuery* second = service->preparedStatement(sql);
+    QCOMPARE(second, first);
+    second->addBindValue("doc2");
+    QVERIFY(second->exec());
+    QVERIFY(second->next());
+    QCOMPARE(second->value(0).toString(), QString("Document 2"));
+    second->finish();
+}
+
+void CartridgeServiceTests::preparedStatement_InvalidSql_ReturnsNullWithError() {
+    CartridgeService* service = static_cast<CartridgeService*>(m_service);
+    service->loadCartridge(m_testCartridge->fileName());
+    
+    QVERIFY(service->preparedStatement("SELECT * FROM no_such_table") == nullptr);
+    QVERIFY(service->statementError().text().contains("no such table", Qt::CaseInsensitive));
+}
+
+void CartridgeServiceTests::preparedStatement_NoCartridge_ReturnsNull() {
+    CartridgeService* service = static_cast<CartridgeService*>(m_service);
+    QVERIFY(service->preparedStatement("SELECT id FROM documents") == nullptr);
+}
+
 void CartridgeServiceTests::getTrustLevel_AfterLoad_ReturnsLevel() {
     CartridgeService* service = static_cast<CartridgeService*>(m_service);
     service->loadCartridge(m_testCartridge->fileName());
@@ -216,5 +435,69 @@ void CartridgeServiceTests::setSignatureService_ValidService_SetsService() {
     QVERIFY(true); // If we get here, no crash occurred
 }
 
+void CartridgeServiceTests::loadCartridge_WithSignatureService_DefersTrustLevel() {
+    CartridgeService* service = static_cast<CartridgeService*>(m_service);
+    GatedSignatureService signatureService;
+    service->setSignatureService(&signatureService);
+    QSignalSpy loadedSpy(service, &CartridgeService::cartridgeLoaded);
+    QSignalSpy trustSpy(service, &CartridgeService::trustLevelDetermined);
+    
+    // Loading and reading content must not wait for verification
+    QVERIFY(service->loadCartridge(m_testCartridge->fileName()));
+    QCOMPARE(loadedSpy.count(), 1);
+    QVERIFY(service->getDocumentContent("doc1").contains("Content 1"));
+    QVERIFY(!service->isTrustLevelDetermined());
+    QCOMPARE(trustSpy.count(), 0);
+    
+    signatureService.gate.release();
+    QTRY_COMPARE(trustSpy.count(), 1);
+    QVERIFY(service->isTrustLevelDetermined());
+    QCOMPARE(service->getTrustLevel(), TrustLevel::Verified);
+    service->setSignatureService(nullptr);
+}
+
+void CartridgeServiceTests::unloadCartridge_PendingVerification_DropsTrustLevel() {
+    CartridgeService* service = static_cast<CartridgeService*>(m_service);
+    GatedSignatureService signatureService;
+    service->setSignatureService(&signatureService);
+    QSignalSpy trustSpy(service, &CartridgeService::trustLevelDetermined);
+    
+    QVERIFY(service->loadCartridge(m_testCartridge->fileName()));
+    service->unloadCartridge();
+    signatureService.gate.release();
+    // The worker posts its result before it finishes
+    QTRY_VERIFY(!service->isLoading());
+    QCoreApplication::processEvents();
+    
+    QCOMPARE(trustSpy.count(), 0);
+    QVERIFY(!service->isTrustLevelDetermined());
+    service->setSignatureService(nullptr);
+}
+
+void CartridgeServiceTests::loadCartridge_WhileVerifying_DoesNotWaitForVerification() {
+    CartridgeService* service = static_cast<CartridgeService*>(m_service);
+    CancellableSignatureService signatureService;
+    service->setSignatureService(&signatureService);
+    QSignalSpy trustSpy(service, &CartridgeService::trustLevelDetermined);
+    
+    QVERIFY(service->loadCartridge(m_testCartridge->fileName()));
+    QVERIFY(signatureService.started.tryAcquire(1, 5000));
+    
+    // The first verification is cancelled but cannot finish until released;
+    // loading again must not wait for it
+    QVERIFY(service->loadCartridge(m_testCartridge->fileName()));
+    QVERIFY(signatureService.started.tryAcquire(1, 5000));
+    QVERIFY(service->isLoading());
+    
+    service->unloadCartridge();
+    signatureService.finish.release(2);
+    QTRY_VERIFY(!service->isLoading());
+    QCoreApplication::processEvents();
+    
+    // Both verifications were superseded; neither result is reported
+    QCOMPARE(trustSpy.count(), 0);
+    service->setSignatureService(nullptr);
+}
+
 // QTEST_MAIN removed - using main.cpp instead
 #include "CartridgeServiceTests.moc"
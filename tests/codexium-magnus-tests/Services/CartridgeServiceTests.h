@@ -18,6 +18,12 @@ private slots:
     void isCartridgeLoaded_AfterLoad_ReturnsTrue();
     void isCartridgeLoaded_BeforeLoad_ReturnsFalse();
     
+    // Asynchronous loading tests
+    void loadCartridgeAsync_ValidPath_EmitsStagedSignals();
+    void loadCartridgeAsync_InvalidPath_EmitsError();
+    void loadCartridgeAsync_ThenUnload_DropsPendingStages();
+    void loadCartridgeAsync_WhileVerifying_LoadsLatestWithoutWaiting();
+    
     // Cartridge info tests
     void getCartridgeName_AfterLoad_ReturnsName();
     void getCartridgePath_AfterLoad_ReturnsPath();
@@ -28,6 +34,11 @@ private slots:
     void getDocumentContent_NoCartridge_ReturnsEmpty();
     void getDocumentList_AfterLoad_ReturnsList();
     
+    // Document cache tests
+    void getDocumentContent_Repeated_HitsCache();
+    void getDocumentContent_OverBudget_NotCached();
+    void unloadCartridge_AfterLoad_EvictsCachedDocuments();
+    
     // Navigation model tests
     void getNavigationModel_AfterLoad_ReturnsModel();
     void getNavigationModel_NoCartridge_ReturnsModel();
@@ -40,9 +51,22 @@ private slots:
     void getDatabase_AfterLoad_ReturnsDatabase();
     void getDatabase_NoCartridge_ReturnsNull();
     
+    // Open profile tests
+    void loadCartridge_DefaultProfile_IsReadOnly();
+    void loadCartridge_DefaultProfile_AppliesPragmas();
+    void setOpenProfile_PerCartridge_OverridesDefault();
+    
+    // Prepared statement tests
+    void preparedStatement_SameSql_ReturnsSameStatement();
+    void preparedStatement_InvalidSql_ReturnsNullWithError();
+    void preparedStatement_NoCartridge_ReturnsNull();
+    
     // Trust level tests
     void getTrustLevel_AfterLoad_ReturnsLevel();
     void setSignatureService_ValidService_SetsService();
+    void loadCartridge_WithSignatureService_DefersTrustLevel();
+    void unloadCartridge_PendingVerification_DropsTrustLevel();
+    void loadCartridge_WhileVerifying_DoesNotWaitForVerification();
 
 private:
     void* m_service; // CartridgeService* - using void* to avoid include in header
@@ -0,0 +1,113 @@
+#include "CaseSensitiveFilterTests.h"
+#include "Services/CaseSensitiveFilter.h"
+
+using namespace CodexiumMagnus::Services;
+
+void CaseSensitiveFilterTests::matches_PhraseExactCase_ReturnsTrue() {
+    CaseSensitiveFilter filter;
+    filter.setPatterns(CaseSensitiveFilter::phrasePatterns("Imperial Navy"));
+    
+    QVERIFY(filter.matches("Fleet Records", "Ships of the Imperial  Navy, listed by class."));
+}
+
+void CaseSensitiveFilterTests::matches_PhraseDifferentCase_ReturnsFalse() {
+    CaseSensitiveFilter filter;
+    filter.setPatterns(CaseSensitiveFilter::phrasePatterns("Imperial Navy"));
+    
+    QVERIFY(!filter.matches("Fleet Records", "Ships of the imperial navy, listed by class."));
+    QVERIFY(!filter.matches("IMPERIAL NAVY", "Ships listed by class."));
+}
+
+void CaseSensitiveFilterTests::matches_PhrasePartOfWord_ReturnsFalse() {
+    CaseSensitiveFilter filter;
+    filter.setPatterns(CaseSensitiveFilter::phrasePatterns("Navy"));
+    
+    QVERIFY(!filter.matches("Fleet Records", "The Navyard was closed."));
+    QVERIFY(filter.matches("Fleet Records", "The Navy-yard was closed."));
+}
+
+void CaseSensitiveFilterTests::matches_TermsInTitleAndText_ReturnsTrue() {
+    CaseSensitiveFilter filter;
+    filter.setPatterns(CaseSensitiveFilter::prefixPatterns(QStringList{"Merch*", "Guild"}));
+    
+    QVERIFY(filter.matches("Merchant Houses", "Every Guild keeps its own charter."));
+    QVERIFY(!filter.matches("merchant houses", "Every Guild keeps its own charter."));
+}
+
+void CaseSensitiveFilterTests::matches_IncrementalLastTerm_MatchesPrefix() {
+    CaseSensitiveFilter filter;
+    filter.setPatterns(CaseSensitiveFilter::incrementalPatterns(QStringList{"Star", "Chart"}));
+    
+    QVERIFY(filter.matches("Navigation", "Star Charts of the outer rim."));
+    // Only the last term is a prefix
+    QVERIFY(!filter.matches("Navigation", "Starship Charts of the outer rim."));
+}
+
+void CaseSensitiveFilterTests::matches_EmptyFilter_AcceptsEverything() {
+    CaseSensitiveFilter filter;
+    filter.setPatterns(CaseSensitiveFilter::phrasePatterns("   "));
+    
+    QVERIFY(filter.isEmpty());
+    QVERIFY(filter.matches("Any", "text"));
+}
+
+void CaseSensitiveFilterTests::snippet_ExactCaseHits_AreMarked() {
+    CaseSensitiveFilter filter;
+    filter.setPatterns(CaseSensitiveFilter::phrasePatterns("FTS5"));
+    
+    QString snippet = filter.snippet("Use fts5 or FTS5 <tables> for FTS5 search.");
+    QCOMPARE(snippet, QString("Use fts5 or <mark>FTS5</mark> &lt;tables&gt; for <mark>FTS5</mark> search."));
+}
+
+void CaseSensitiveFilterTests::snippet_LongText_TrimmedAroundFirstHit() {
+    CaseSensitiveFilter filter;
+    filter.setPatterns(CaseSensitiveFilter::phrasePatterns("Archive"));
+    
+    QString text = QString("filler ").repeated(50) + "the Archive opens" + QString(" filler").repeated(50);
+    QString snippet = filter.snippet(text, 20);
+    
+    QVERIFY(snippet.startsWith("..."));
+    QVERIFY(snippet.endsWith("..."));
+    QVERIFY(snippet.contains("the <mark>Archive</mark> opens"));
+    QVERIFY(snippet.size() < 80);
+}
+
+void CaseSensitiveFilterTests::matchOffsets_OverlappingPatterns_AreMerged() {
+    CaseSensitiveFilter filter;
+    filter.setPatterns(CaseSensitiveFilter::prefixPatterns(QStringList{"Arch", "Archive"}));
+    
+    QList<QPair<int, int>> offsets = filter.matchOffsets("the Archive and the archive and Arches");
+    QCOMPARE(offsets.size(), 2);
+    QCOMPARE(offsets.at(0), qMakePair(4, 7));
+    QCOMPARE(offsets.at(1), qMakePair(32, 4));
+}
+
+void CaseSensitiveFilterTests::plainText_Markup_StripsTagsAndDecodesEntities() {
+    QString html = "<html><head><style>p { color: red; }</style></head>"
+                   "<body><h1>Title</h1>\n<p>Fish &amp; Chips&nbsp;&lt;today&gt;</p></body></html>";
+    
+    QCOMPARE(CaseSensitiveFilter::plainText(html), QString("Title Fish & Chips <today>"));
+}
+
+void CaseSensitiveFilterTests::plainText_InlineMarkupAndEntities_OffsetsCountDomText() {
+    // Tags add no characters, every entity is one, U+3000 is whitespace
+    QString html = QString("<p>The <b>bold</b>&mdash;&#8217;s <i>Navy</i>") + QChar(0x3000) + "fleet</p>";
+    QString text = CaseSensitiveFilter::plainText(html);
+    QCOMPARE(text, QString("The bold") + QChar(0x2014) + QChar(0x2019) + "s Navy fleet");
+    
+    CaseSensitiveFilter filter;
+    filter.setPatterns(CaseSensitiveFilter::phrasePatterns("Navy"));
+    QList<QPair<int, int>> offsets = filter.matchOffsets(text);
+    QCOMPARE(offsets.size(), 1);
+    QCOMPARE(offsets.at(0), qMakePair(12, 4));
+}
+
+void CaseSensitiveFilterTests::plainText_NumericAndUnknownReferences_DecodedLikeBrowser() {
+    QString html = "&#x41;&#66;&#128; &bogus; &#0;";
+    
+    QCOMPARE(CaseSensitiveFilter::plainText(html),
+             QString("AB") + QChar(0x20ac) + " &bogus; " + QChar(0xfffd));
+}
+
+// QTEST_MAIN removed - using main.cpp instead
+#include "CaseSensitiveFilterTests.moc"
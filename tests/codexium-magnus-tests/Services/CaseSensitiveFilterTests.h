@@ -0,0 +1,29 @@
+#ifndef CASESENSITIVEFILTERTESTS_H
+#define CASESENSITIVEFILTERTESTS_H
+
+#include <QtTest/QtTest>
+
+class CaseSensitiveFilterTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    // Matching tests
+    void matches_PhraseExactCase_ReturnsTrue();
+    void matches_PhraseDifferentCase_ReturnsFalse();
+    void matches_PhrasePartOfWord_ReturnsFalse();
+    void matches_TermsInTitleAndText_ReturnsTrue();
+    void matches_IncrementalLastTerm_MatchesPrefix();
+    void matches_EmptyFilter_AcceptsEverything();
+    
+    // Snippet tests
+    void snippet_ExactCaseHits_AreMarked();
+    void snippet_LongText_TrimmedAroundFirstHit();
+    void matchOffsets_OverlappingPatterns_AreMerged();
+    
+    // Plain text tests
+    void plainText_Markup_StripsTagsAndDecodesEntities();
+    void plainText_InlineMarkupAndEntities_OffsetsCountDomText();
+    void plainText_NumericAndUnknownReferences_DecodedLikeBrowser();
+};
+
+#endif // CASESENSITIVEFILTERTESTS_H
@@ -0,0 +1,210 @@
+#include "ChunkVerifierTests.h"
+#include <QFile>
+#include <QThread>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include "Services/ChunkVerifier.h"
+#include "Services/MerkleTreeDigest.h"
+#include "Services/VerifyingVfs.h"
+#include "Services/CartridgeOpenProfile.h"
+
+using namespace CodexiumMagnus::Services;
+
+namespace {
+const qint64 kChunkSize = 4096;
+}
+
+QString ChunkVerifierTests::createFile(const QString& name, const QByteArray& content) {
+    QString path = m_tempDir->filePath(name);
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(content) != content.size()) {
+        return QString();
+    }
+    return path;
+}
+
+void ChunkVerifierTests::init() {
+    m_tempDir = new QTemporaryDir();
+}
+
+void ChunkVerifierTests::cleanup() {
+    delete m_tempDir;
+    m_tempDir = nullptr;
+}
+
+void ChunkVerifierTests::verifyRange_OneChunk_VerifiesOnlyThatChunk() {
+    QString path = createFile("rules.cartridge", QByteArray(16 * kChunkSize, 'a'));
+    QVERIFY(!path.isEmpty());
+    ChunkVerifier verifier(path, kChunkSize, MerkleTreeDigest::chunkHashes(path, kChunkSize));
+    QVERIFY(verifier.isValid());
+    QCOMPARE(verifier.chunkCount(), 16);
+
+    QVERIFY(verifier.verifyRange(5 * kChunkSize + 100, 200));
+    QCOMPARE(verifier.verifiedChunkCount(), 1);
+    QVERIFY(verifier.verifiedChunks().testBit(5));
+    QCOMPARE(verifier.bytesRead(), kChunkSize);
+}
+
+void ChunkVerifierTests::verifyRange_SpanningTwoChunks_VerifiesBoth() {
+    QString path = createFile("rules.cartridge", QByteArray(4 * kChunkSize, 'a'));
+    ChunkVerifier verifier(path, kChunkSize, MerkleTreeDigest::chunkHashes(path, kChunkSize));
+
+    QVERIFY(verifier.verifyRange(kChunkSize - 10, 20));
+    QCOMPARE(verifier.verifiedChunkCount(), 2);
+    QVERIFY(verifier.verifiedChunks().testBit(0));
+    QVERIFY(verifier.verifiedChunks().testBit(1));
+}
+
+void ChunkVerifierTests::verifyRange_VerifiedChunk_IsNotReadAgain() {
+    QString path = createFile("rules.cartridge", QByteArray(4 * kChunkSize, 'a'));
+    ChunkVerifier verifier(path, kChunkSize, MerkleTreeDigest::chunkHashes(path, kChunkSize));
+
+    QVERIFY(verifier.verifyRange(0, 100));
+    QVERIFY(verifier.verifyRange(200, 100));
+    QCOMPARE(verifier.bytesRead(), kChunkSize);
+}
+
+void ChunkVerifierTests::verifyRange_TamperedChunk_FailsAndCallsHandler() {
+    QByteArray content(4 * kChunkSize, 'a');
+    QString path = createFile("rules.cartridge", content);
+    QList<QByteArray> hashes = MerkleTreeDigest::chunkHashes(path, kChunkSize);
+
+    content[2 * kChunkSize + 7] = 'b';
+    createFile("rules.cartridge", content);
+
+    ChunkVerifier verifier(path, kChunkSize, hashes);
+    qint64 failedChunk = -1;
+    verifier.setFailureHandler([&failedChunk](qint64 chunk) {
+        failedChunk = chunk;
+    });
+
+    // Untouched chunks still pass
+    QVERIFY(verifier.verifyRange(0, kChunkSize));
+    QVERIFY(!verifier.verifyRange(2 * kChunkSize, 10));
+    QCOMPARE(failedChunk, 2);
+    QVERIFY(verifier.hasFailed());
+    // Every read fails once a chunk has failed
+    QVERIFY(!verifier.verifyRange(0, 10));
+}
+
+void ChunkVerifierTests::isValid_WrongChunkCount_ReturnsFalse() {
+    QString path = createFile("rules.cartridge", QByteArray(4 * kChunkSize, 'a'));
+    QList<QByteArray> hashes = MerkleTreeDigest::chunkHashes(path, kChunkSize);
+    hashes.removeLast();
+
+    ChunkVerifier verifier(path, kChunkSize, hashes);
+    QVERIFY(!verifier.isValid());
+}
+
+void ChunkVerifierTests::verifyRead_WholeChunk_HashesCallerBytes() {
+    const QByteArray content(4 * kChunkSize, 'a');
+    QString path = createFile("rules.cartridge", content);
+    ChunkVerifier verifier(path, kChunkSize, MerkleTreeDigest::chunkHashes(path, kChunkSize));
+
+    // The bytes given are checked; the file is not read again
+    QVERIFY(verifier.verifyRead(kChunkSize, content.constData() + kChunkSize, 2 * kChunkSize));
+    QCOMPARE(verifier.verifiedChunkCount(), 2);
+    QCOMPARE(verifier.bytesRead(), 0);
+
+    // Bytes that differ from the table fail even though the file is intact
+    const QByteArray tampered(kChunkSize, 'b');
+    QVERIFY(!verifier.verifyRead(0, tampered.constData(), kChunkSize));
+    QVERIFY(verifier.hasFailed());
+}
+
+void ChunkVerifierTests::verifyRead_BytesDifferFromVerifiedChunk_Fails() {
+    QString path = createFile("rules.cartridge", QByteArray(4 * kChunkSize, 'a'));
+    ChunkVerifier verifier(path, kChunkSize, MerkleTreeDigest::chunkHashes(path, kChunkSize));
+
+    // Part of a chunk: the chunk is verified from the file, and the bytes
+    // read must match it, as if the file had changed in between
+    const QByteArray read(100, 'a');
+    QVERIFY(verifier.verifyRead(10, read.constData(), read.size()));
+    QCOMPARE(verifier.bytesRead(), kChunkSize);
+
+    const QByteArray changed(100, 'b');
+    QVERIFY(!verifier.verifyRead(kChunkSize + 10, changed.constData(), changed.size()));
+    QVERIFY(verifier.hasFailed());
+}
+
+void ChunkVerifierTests::verifyRange_ConcurrentReaders_VerifyEveryChunk() {
+    const qint64 chunks = 64;
+    QString path = createFile("rules.cartridge", QByteArray(chunks * kChunkSize, 'a'));
+    ChunkVerifier verifier(path, kChunkSize, MerkleTreeDigest::chunkHashes(path, kChunkSize));
+
+    // Readers overlap, so some chunks are checked by two of them at once
+    std::atomic<bool> failed{false};
+    std::vector<std::unique_ptr<QThread>> readers;
+    for (int reader = 0; reader < 4; ++reader) {
+        readers.emplace_back(QThread::create([&verifier, &failed, reader, chunks]() {
+            for (qint64 index = reader; index < chunks; index += 2) {
+                if (!verifier.verifyRange(index * kChunkSize + 1, 10)) {
+                    failed = true;
+                }
+            }
+        }));
+        readers.back()->start();
+    }
+    for (const auto& reader : readers) {
+        QVERIFY(reader->wait(10000));
+    }
+
+    QVERIFY(!failed);
+    QVERIFY(!verifier.hasFailed());
+    QCOMPARE(verifier.verifiedChunkCount(), chunks);
+}
+
+void ChunkVerifierTests::verifyingVfs_QueryOneTable_TouchesFewChunks() {
+#ifdef HAVE_SQLITE3_VFS
+    if (!VerifyingVfs::registerVfs()) {
+        QSKIP("Qt's SQLite driver uses its bundled SQLite - VerifyingVfs unavailable");
+    }
+    QString path = m_tempDir->filePath("rules.cartridge");
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "chunk_verifier_write");
+        db.setDatabaseName(path);
+        QVERIFY(db.open());
+        QSqlQuery query(db);
+        QVERIFY(query.exec("CREATE TABLE Documents (Id INTEGER PRIMARY KEY, Html TEXT)"));
+        QVERIFY(query.exec("INSERT INTO Documents (Html) VALUES ('<p>Rules</p>')"));
+        QVERIFY(query.exec("CREATE TABLE Filler (Data BLOB)"));
+        for (int i = 0; i < 64; ++i) {
+            QVERIFY(query.exec("INSERT INTO Filler (Data) VALUES (zeroblob(4000))"));
+        }
+        db.close();
+    }
+    QSqlDatabase::removeDatabase("chunk_verifier_write");
+
+    auto verifier = std::make_shared<ChunkVerifier>(path, kChunkSize, MerkleTreeDigest::chunkHashes(path, kChunkSize));
+    QVERIFY(verifier->isValid());
+    QVERIFY(VerifyingVfs::attach(path, verifier));
+
+    CartridgeOpenProfile profile = CartridgeOpenProfile::immutableCartridge();
+    profile.mmapSize = 0;
+    profile.vfs = VerifyingVfs::name();
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "chunk_verifier_read");
+        profile.configure(db, path);
+        QVERIFY(db.open());
+        QSqlQuery query(db);
+        QVERIFY(query.exec("SELECT Html FROM Documents WHERE Id = 1"));
+        QVERIFY(query.next());
+        QCOMPARE(query.value(0).toString(), QString("<p>Rules</p>"));
+        query.finish();
+        db.close();
+    }
+    QSqlDatabase::removeDatabase("chunk_verifier_read");
+
+    QVERIFY(verifier->verifiedChunkCount() > 0);
+    QVERIFY(verifier->verifiedChunkCount() < verifier->chunkCount() / 4);
+    VerifyingVfs::detach(path);
+#else
+    QSKIP("Built without ENABLE_VERIFYING_VFS - VerifyingVfs disabled");
+#endif
+}
+
+// QTEST_MAIN removed - using main.cpp test runner instead
+#include "ChunkVerifierTests.moc"
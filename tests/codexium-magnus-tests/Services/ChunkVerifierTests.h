@@ -0,0 +1,33 @@
+#ifndef CHUNKVERIFIERTESTS_H
+#define CHUNKVERIFIERTESTS_H
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+
+class ChunkVerifierTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    // Chunk verification tests
+    void verifyRange_OneChunk_VerifiesOnlyThatChunk();
+    void verifyRange_SpanningTwoChunks_VerifiesBoth();
+    void verifyRange_VerifiedChunk_IsNotReadAgain();
+    void verifyRange_TamperedChunk_FailsAndCallsHandler();
+    void isValid_WrongChunkCount_ReturnsFalse();
+    void verifyRead_WholeChunk_HashesCallerBytes();
+    void verifyRead_BytesDifferFromVerifiedChunk_Fails();
+    void verifyRange_ConcurrentReaders_VerifyEveryChunk();
+
+    // VFS tests
+    void verifyingVfs_QueryOneTable_TouchesFewChunks();
+
+private:
+    QString createFile(const QString& name, const QByteArray& content);
+
+    QTemporaryDir *m_tempDir;
+};
+
+#endif // CHUNKVERIFIERTESTS_H
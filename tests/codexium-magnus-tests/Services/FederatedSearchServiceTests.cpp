@@ -0,0 +1,187 @@
+#include "FederatedSearchServiceTests.h"
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSignalSpy>
+#include "Services/FederatedSearchService.h"
+
+using namespace CodexiumMagnus::Services;
+
+QString FederatedSearchServiceTests::createCartridge(const QString& name,
+                                                     const QList<QPair<QString, QString>>& documents) {
+    QString path = m_directory->filePath(name + ".cartridge");
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "federated_test_cartridge");
+        db.setDatabaseName(path);
+        if (!db.open()) {
+            return QString();
+        }
+        
+        QSqlQuery query(db);
+        query.exec("CREATE TABLE documents (id TEXT PRIMARY KEY, title TEXT NOT NULL, content TEXT)");
+        query.exec("CREATE VIRTUAL TABLE content_fts USING fts5(document_id UNINDEXED, title, content)");
+        
+        query.prepare("INSERT INTO documents (id, title, content) VALUES (?, ?, ?)");
+        for (int i = 0; i < documents.size(); ++i) {
+            query.addBindValue(QString("%1-doc%2").arg(name).arg(i));
+            query.addBindValue(documents.at(i).first);
+            query.addBindValue(documents.at(i).second);
+            query.exec();
+        }
+        query.exec("INSERT INTO content_fts (document_id, title, content) SELECT id, title, content FROM documents");
+        db.close();
+    }
+    QSqlDatabase::removeDatabase("federated_test_cartridge");
+    return path;
+}
+
+void FederatedSearchServiceTests::init() {
+    m_directory = new QTemporaryDir();
+    FederatedSearchService* service = new FederatedSearchService();
+    m_service = service;
+    
+    service->mountCartridge("alpha", createCartridge("alpha", {
+        {"Starship Design", "Designing a starship hull. The starship drive comes next."},
+        {"Trade Routes", "Merchant trade routes between sectors."}
+    }));
+    service->mountCartridge("beta", createCartridge("beta", {
+        {"Scout Service", "The scout service surveys every Starship route."},
+        {"Noble Houses", "Nobles of the imperial court."}
+    }));
+    service->mountCartridge("gamma", createCartridge("gamma", {
+        {"Library Data", "Library records mention a starship once."}
+    }));
+}
+
+void FederatedSearchServiceTests::cleanup() {
+    delete static_cast<FederatedSearchService*>(m_service);
+    m_service = nullptr;
+    delete m_directory;
+    m_directory = nullptr;
+}
+
+void FederatedSearchServiceTests::mountCartridge_ExistingFile_IsMounted() {
+    FederatedSearchService* service = static_cast<FederatedSearchService*>(m_service);
+    
+    QCOMPARE(service->mountedCartridges(), QStringList({"alpha", "beta", "gamma"}));
+    QVERIFY(service->isMounted("beta"));
+}
+
+void FederatedSearchServiceTests::mountCartridge_MissingFile_ReturnsFalse() {
+    FederatedSearchService* service = static_cast<FederatedSearchService*>(m_service);
+    
+    QVERIFY(!service->mountCartridge("missing", m_directory->filePath("missing.cartridge")));
+    QVERIFY(!service->isMounted("missing"));
+}
+
+void FederatedSearchServiceTests::unmountCartridge_Mounted_IsNotSearched() {
+    FederatedSearchService* service = static_cast<FederatedSearchService*>(m_service);
+    QSignalSpy completedSpy(service, &FederatedSearchService::searchCompleted);
+    
+    service->unmountCartridge("alpha");
+    service->search("starship");
+    
+    QTRY_COMPARE(completedSpy.count(), 1);
+    QList<FederatedSearchHit> hits = qvariant_cast<QList<FederatedSearchHit>>(completedSpy.takeFirst().at(0));
+    QCOMPARE(hits.size(), 2);
+    for (const FederatedSearchHit& hit : hits) {
+        QVERIFY(hit.cartridgeId != "alpha");
+    }
+}
+
+void FederatedSearchServiceTests::search_AllCartridges_TagsHitsWithCartridgeId() {
+    FederatedSearchService* service = static_cast<FederatedSearchService*>(m_service);
+    QSignalSpy completedSpy(service, &FederatedSearchService::searchCompleted);
+    
+    service->search("starship");
+    
+    QTRY_COMPARE(completedSpy.count(), 1);
+    QList<FederatedSearchHit> hits = qvariant_cast<QList<FederatedSearchHit>>(completedSpy.takeFirst().at(0));
+    QCOMPARE(hits.size(), 3);
+    
+    QSet<QString> cartridges;
+    for (const FederatedSearchHit& hit : hits) {
+        cartridges.insert(hit.cartridgeId);
+        QVERIFY(hit.documentId.startsWith(hit.cartridgeId + "-"));
+        QVERIFY(hit.snippet.contains("<mark>"));
+    }
+    QCOMPARE(cartridges, QSet<QString>({"alpha", "beta", "gamma"}));
+}
+
+void FederatedSearchServiceTests::search_MergedHits_OrderedByScore() {
+    FederatedSearchService* service = static_cast<FederatedSearchService*>(m_service);
+    QSignalSpy completedSpy(service, &FederatedSearchService::searchCompleted);
+    
+    service->search("starship");
+    
+    QTRY_COMPARE(completedSpy.count(), 1);
+    QList<FederatedSearchHit> hits = qvariant_cast<QList<FederatedSearchHit>>(completedSpy.takeFirst().at(0));
+    QVERIFY(!hits.isEmpty());
+    for (int i = 1; i < hits.size(); ++i) {
+        QVERIFY(hits.at(i - 1).score >= hits.at(i).score);
+    }
+    // Three mentions in title and content outrank a single one
+    QCOMPARE(hits.first().title, QString("Starship Design"));
+}
+
+void FederatedSearchServiceTests::search_ResultLimit_KeepsTopHits() {
+    FederatedSearchService* service = static_cast<FederatedSearchService*>(m_service);
+    service->setResultLimit(1);
+    QSignalSpy completedSpy(service, &FederatedSearchService::searchCompleted);
+    
+    service->search("starship");
+    
+    QTRY_COMPARE(completedSpy.count(), 1);
+    QList<FederatedSearchHit> hits = qvariant_cast<QList<FederatedSearchHit>>(completedSpy.takeFirst().at(0));
+    QCOMPARE(hits.size(), 1);
+    QCOMPARE(hits.first().cartridgeId, QString("alpha"));
+}
+
+void FederatedSearchServiceTests::search_CaseSensitive_VerifiesExactCase() {
+    FederatedSearchService* service = static_cast<FederatedSearchService*>(m_service);
+    QSignalSpy completedSpy(service, &FederatedSearchService::searchCompleted);
+    
+    // Only beta mentions "Starship" capitalized in its content; alpha has it in a title
+    service->search("Starship", true);
+    
+    QTRY_COMPARE(completedSpy.count(), 1);
+    QList<FederatedSearchHit> hits = qvariant_cast<QList<FederatedSearchHit>>(completedSpy.takeFirst().at(0));
+    QCOMPARE(hits.size(), 2);
+    for (const FederatedSearchHit& hit : hits) {
+        QVERIFY(hit.cartridgeId != "gamma");
+    }
+}
+
+void FederatedSearchServiceTests::search_NoCartridges_EmitsError() {
+    FederatedSearchService service;
+    QSignalSpy errorSpy(&service, &FederatedSearchService::searchError);
+    
+    service.search("starship");
+    
+    QCOMPARE(errorSpy.count(), 1);
+}
+
+void FederatedSearchServiceTests::search_NewQuery_SupersedesPending() {
+    FederatedSearchService* service = static_cast<FederatedSearchService*>(m_service);
+    QSignalSpy completedSpy(service, &FederatedSearchService::searchCompleted);
+    
+    service->search("starship");
+    service->search("merchant");
+    
+    QTRY_COMPARE(completedSpy.count(), 1);
+    QList<FederatedSearchHit> hits = qvariant_cast<QList<FederatedSearchHit>>(completedSpy.takeFirst().at(0));
+    QCOMPARE(hits.size(), 1);
+    QCOMPARE(hits.first().title, QString("Trade Routes"));
+    
+    // The superseded search never reports
+    QTest::qWait(100);
+    QCOMPARE(completedSpy.count(), 0);
+}
+
+void FederatedSearchServiceTests::normalizeBm25_BoundedAndMonotonic() {
+    QCOMPARE(FederatedSearchService::normalizeBm25(0.0), 0.0);
+    QVERIFY(FederatedSearchService::normalizeBm25(-0.5) < FederatedSearchService::normalizeBm25(-2.0));
+    QVERIFY(FederatedSearchService::normalizeBm25(-1000.0) < 1.0);
+}
+
+// QTEST_MAIN removed - using main.cpp instead
+#include "FederatedSearchServiceTests.moc"
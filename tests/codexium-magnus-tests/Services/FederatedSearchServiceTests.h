@@ -0,0 +1,35 @@
+#ifndef FEDERATEDSEARCHSERVICETESTS_H
+#define FEDERATEDSEARCHSERVICETESTS_H
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+
+class FederatedSearchServiceTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+    
+    // Mount tests
+    void mountCartridge_ExistingFile_IsMounted();
+    void mountCartridge_MissingFile_ReturnsFalse();
+    void unmountCartridge_Mounted_IsNotSearched();
+    
+    // Search tests
+    void search_AllCartridges_TagsHitsWithCartridgeId();
+    void search_MergedHits_OrderedByScore();
+    void search_ResultLimit_KeepsTopHits();
+    void search_CaseSensitive_VerifiesExactCase();
+    void search_NoCartridges_EmitsError();
+    void search_NewQuery_SupersedesPending();
+    void normalizeBm25_BoundedAndMonotonic();
+
+private:
+    QString createCartridge(const QString& name, const QList<QPair<QString, QString>>& documents);
+    
+    void* m_service; // FederatedSearchService* - using void* to avoid include in header
+    QTemporaryDir* m_directory;
+};
+
+#endif // FEDERATEDSEARCHSERVICETESTS_H
@@ -0,0 +1,97 @@
+#include "FuzzyTermIndexTests.h"
+#include <QTemporaryFile>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include "Services/FuzzyTermIndex.h"
+
+using namespace CodexiumMagnus::Services;
+
+void FuzzyTermIndexTests::editDistance_WithinBound_ReturnsDistance() {
+    QCOMPARE(FuzzyTermIndex::editDistance("testing", "testing", 2), 0);
+    QCOMPARE(FuzzyTermIndex::editDistance("testing", "tesring", 2), 1);   // Substitution
+    QCOMPARE(FuzzyTermIndex::editDistance("testing", "tsting", 2), 1);    // Deletion
+    QCOMPARE(FuzzyTermIndex::editDistance("testing", "testinng", 2), 1);  // Insertion
+    QCOMPARE(FuzzyTermIndex::editDistance("kitten", "sitting", 3), 3);
+    QCOMPARE(FuzzyTermIndex::editDistance("", "ab", 2), 2);
+}
+
+void FuzzyTermIndexTests::editDistance_BeyondBound_ReturnsBoundPlusOne() {
+    QCOMPARE(FuzzyTermIndex::editDistance("kitten", "sitting", 2), 3);
+    QCOMPARE(FuzzyTermIndex::editDistance("search", "archive", 1), 2);
+    QCOMPARE(FuzzyTermIndex::editDistance("ab", "abcdef", 2), 3);
+}
+
+void FuzzyTermIndexTests::defaultMaxDistance_ScalesWithLength() {
+    QCOMPARE(FuzzyTermIndex::defaultMaxDistance(3), 0);
+    QCOMPARE(FuzzyTermIndex::defaultMaxDistance(4), 1);
+    QCOMPARE(FuzzyTermIndex::defaultMaxDistance(7), 1);
+    QCOMPARE(FuzzyTermIndex::defaultMaxDistance(8), 2);
+}
+
+void FuzzyTermIndexTests::expand_Misspelling_FindsTerm() {
+    FuzzyTermIndex index;
+    index.setTerms({"documentation", "document", "testing", "search", "archive"});
+    
+    QCOMPARE(index.expand("documantation"), QStringList{"documentation"});
+    QCOMPARE(index.expand("tesitng", 2), QStringList{"testing"});
+    QVERIFY(index.expand("zzzzzz").isEmpty());
+}
+
+void FuzzyTermIndexTests::expand_ExactTerm_ComesFirst() {
+    FuzzyTermIndex index;
+    index.setTerms({"tests", "test", "text"}, {50, 1, 100});
+    
+    QStringList expansions = index.expand("test");
+    QCOMPARE(expansions.first(), QString("test"));
+    QCOMPARE(expansions.size(), 3);
+}
+
+void FuzzyTermIndexTests::expand_EqualDistance_OrdersByDocumentCount() {
+    FuzzyTermIndex index;
+    index.setTerms({"tent", "tests", "text"}, {5, 20, 10});
+    
+    QCOMPARE(index.expand("test"), (QStringList{"tests", "text", "tent"}));
+}
+
+void FuzzyTermIndexTests::expand_MaxExpansions_LimitsResults() {
+    FuzzyTermIndex index;
+    index.setTerms({"tent", "tests", "text", "best", "rest"});
+    
+    QCOMPARE(index.expand("test", 1, 2).size(), 2);
+}
+
+void FuzzyTermIndexTests::expand_ShortTerm_MatchesExactlyOnly() {
+    FuzzyTermIndex index;
+    index.setTerms({"cat", "car", "cart"});
+    
+    QCOMPARE(index.expand("cat"), QStringList{"cat"});
+}
+
+void FuzzyTermIndexTests::build_FtsCartridge_DerivesVocabulary() {
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    file.close();
+    
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "fuzzy_index_test");
+        db.setDatabaseName(file.fileName());
+        QVERIFY(db.open());
+        
+        QSqlQuery query(db);
+        QVERIFY(query.exec("CREATE VIRTUAL TABLE content_fts USING fts5(document_id UNINDEXED, title, content)"));
+        QVERIFY(query.exec("INSERT INTO content_fts VALUES ('doc1', 'Starship Operations', 'Navigation and survey')"));
+        QVERIFY(query.exec("INSERT INTO content_fts VALUES ('doc2', 'Merchant Routes', 'Trade and navigation')"));
+        
+        FuzzyTermIndex index;
+        QString error;
+        QVERIFY(index.build(db, error));
+        QCOMPARE(index.termCount(), 8);  // Distinct title and content terms
+        QCOMPARE(index.expand("navgation"), QStringList{"navigation"});
+        
+        db.close();
+    }
+    QSqlDatabase::removeDatabase("fuzzy_index_test");
+}
+
+// QTEST_MAIN removed - using main.cpp instead
+#include "FuzzyTermIndexTests.moc"
@@ -0,0 +1,26 @@
+#ifndef FUZZYTERMINDEXTESTS_H
+#define FUZZYTERMINDEXTESTS_H
+
+#include <QtTest/QtTest>
+
+class FuzzyTermIndexTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    // Edit distance tests
+    void editDistance_WithinBound_ReturnsDistance();
+    void editDistance_BeyondBound_ReturnsBoundPlusOne();
+    void defaultMaxDistance_ScalesWithLength();
+    
+    // Expansion tests
+    void expand_Misspelling_FindsTerm();
+    void expand_ExactTerm_ComesFirst();
+    void expand_EqualDistance_OrdersByDocumentCount();
+    void expand_MaxExpansions_LimitsResults();
+    void expand_ShortTerm_MatchesExactlyOnly();
+    
+    // Build tests
+    void build_FtsCartridge_DerivesVocabulary();
+};
+
+#endif // FUZZYTERMINDEXTESTS_H
@@ -0,0 +1,108 @@
+#include "MerkleTreeDigestTests.h"
+#include <QCryptographicHash>
+#include <QFile>
+#include <QThreadPool>
+#include "Services/MerkleTreeDigest.h"
+
+using namespace CodexiumMagnus::Services;
+
+namespace {
+const qint64 kChunkSize = 4096;
+}
+
+QString MerkleTreeDigestTests::createFile(const QByteArray& content) {
+    QString path = m_tempDir->filePath("cartridge.db");
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(content) != content.size()) {
+        return QString();
+    }
+    return path;
+}
+
+void MerkleTreeDigestTests::init() {
+    m_tempDir = new QTemporaryDir();
+}
+
+void MerkleTreeDigestTests::cleanup() {
+    delete m_tempDir;
+    m_tempDir = nullptr;
+}
+
+void MerkleTreeDigestTests::leafHash_DiffersFromNodeHashOfSameBytes() {
+    QByteArray left(32, 'a');
+    QByteArray right(32, 'b');
+
+    // A leaf over the bytes of two child hashes must not collide with their parent
+    QVERIFY(MerkleTreeDigest::leafHash(left + right) != MerkleTreeDigest::nodeHash(left, right));
+    QCOMPARE(MerkleTreeDigest::leafHash(QByteArray("chunk")).size(), 32);
+}
+
+void MerkleTreeDigestTests::rootHash_SingleLeaf_IsLeaf() {
+    QByteArray leaf = MerkleTreeDigest::leafHash(QByteArray("only chunk"));
+    QCOMPARE(MerkleTreeDigest::rootHash({leaf}), leaf);
+    QVERIFY(MerkleTreeDigest::rootHash({}).isEmpty());
+}
+
+void MerkleTreeDigestTests::rootHash_OddLeafCount_CarriesLastLeafUp() {
+    QByteArray l0 = MerkleTreeDigest::leafHash(QByteArray("0"));
+    QByteArray l1 = MerkleTreeDigest::leafHash(QByteArray("1"));
+    QByteArray l2 = MerkleTreeDigest::leafHash(QByteArray("2"));
+
+    QByteArray expected = MerkleTreeDigest::nodeHash(MerkleTreeDigest::nodeHash(l0, l1), l2);
+    QCOMPARE(MerkleTreeDigest::rootHash({l0, l1, l2}), expected);
+}
+
+void MerkleTreeDigestTests::chunkCount_EmptyFile_IsOne() {
+    QCOMPARE(MerkleTreeDigest::chunkCount(0, kChunkSize), qint64(1));
+    QCOMPARE(MerkleTreeDigest::chunkCount(kChunkSize, kChunkSize), qint64(1));
+    QCOMPARE(MerkleTreeDigest::chunkCount(kChunkSize + 1, kChunkSize), qint64(2));
+}
+
+void MerkleTreeDigestTests::chunkHashes_PartialLastChunk_HashesEachChunk() {
+    QByteArray content(2 * kChunkSize + 100, Qt::Uninitialized);
+    for (int i = 0; i < content.size(); ++i) {
+        content[i] = static_cast<char>(i * 13 + i / 97);
+    }
+    QString path = createFile(content);
+    QVERIFY(!path.isEmpty());
+
+    qint64 bytesHashed = 0;
+    QList<QByteArray> leaves = MerkleTreeDigest::chunkHashes(path, kChunkSize, nullptr, &bytesHashed);
+    QCOMPARE(leaves.size(), 3);
+    QCOMPARE(bytesHashed, qint64(content.size()));
+    QCOMPARE(leaves[0], MerkleTreeDigest::leafHash(content.left(kChunkSize)));
+    QCOMPARE(leaves[1], MerkleTreeDigest::leafHash(content.mid(kChunkSize, kChunkSize)));
+    QCOMPARE(leaves[2], MerkleTreeDigest::leafHash(content.mid(2 * kChunkSize)));
+}
+
+void MerkleTreeDigestTests::chunkHashes_ThreadPool_MatchesSingleThread() {
+    // More chunks than threads, so tasks get ranges of several chunks
+    QByteArray content(37 * kChunkSize + 5, Qt::Uninitialized);
+    for (int i = 0; i < content.size(); ++i) {
+        content[i] = static_cast<char>(i * 31 + 7);
+    }
+    QString path = createFile(content);
+    QVERIFY(!path.isEmpty());
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(4);
+    QList<QByteArray> parallel = MerkleTreeDigest::chunkHashes(path, kChunkSize, &pool);
+    QList<QByteArray> sequential = MerkleTreeDigest::chunkHashes(path, kChunkSize);
+    QCOMPARE(parallel.size(), 38);
+    QCOMPARE(parallel, sequential);
+    QCOMPARE(MerkleTreeDigest::rootHash(parallel), MerkleTreeDigest::rootHash(sequential));
+}
+
+void MerkleTreeDigestTests::chunkHashes_ChunkSizeTooSmall_ReturnsEmpty() {
+    QString path = createFile(QByteArray(1024, 'x'));
+    QVERIFY(!path.isEmpty());
+
+    QVERIFY(MerkleTreeDigest::chunkHashes(path, MerkleTreeDigest::minimumChunkSize() - 1).isEmpty());
+}
+
+void MerkleTreeDigestTests::chunkHashes_MissingFile_ReturnsEmpty() {
+    QVERIFY(MerkleTreeDigest::chunkHashes(m_tempDir->filePath("missing.db"), kChunkSize).isEmpty());
+}
+
+// QTEST_MAIN removed - using main.cpp test runner instead
+#include "MerkleTreeDigestTests.moc"
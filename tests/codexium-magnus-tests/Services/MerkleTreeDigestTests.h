@@ -0,0 +1,32 @@
+#ifndef MERKLETREEDIGESTTESTS_H
+#define MERKLETREEDIGESTTESTS_H
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+
+class MerkleTreeDigestTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    // Tree shape tests
+    void leafHash_DiffersFromNodeHashOfSameBytes();
+    void rootHash_SingleLeaf_IsLeaf();
+    void rootHash_OddLeafCount_CarriesLastLeafUp();
+    void chunkCount_EmptyFile_IsOne();
+
+    // File hashing tests
+    void chunkHashes_PartialLastChunk_HashesEachChunk();
+    void chunkHashes_ThreadPool_MatchesSingleThread();
+    void chunkHashes_ChunkSizeTooSmall_ReturnsEmpty();
+    void chunkHashes_MissingFile_ReturnsEmpty();
+
+private:
+    QString createFile(const QByteArray& content);
+
+    QTemporaryDir *m_tempDir;
+};
+
+#endif // MERKLETREEDIGESTTESTS_H
@@ -57,6 +57,14 @@ public:
         query.addBindValue("How to write good documentation for your code.");
         query.exec();
         
+        // Documents for result paging tests
+        for (int i = 0; i < 40; ++i) {
+            query.addBindValue(QString("page%1").arg(i));
+            query.addBindValue(QString("Paging Sample %1").arg(i));
+            query.addBindValue(QString("Pagination sample number %1.").arg(i));
+            query.exec();
+        }
+        
         // Populate FTS5 table
         query.exec("INSERT INTO content_fts (document_id, title, content) SELECT id, title, content FROM documents");
         
@@ -150,8 +158,8 @@ void SearchServiceTests::performSearch_MatchingQuery_ReturnsResults() {
     
     if (completedSpy.count() > 0) {
         QList<QVariant> arguments = completedSpy.takeFirst();
-        QList<QPair<QString, QString>> results = 
-            qvariant_cast<QList<QPair<QString, QString>>>(arguments.at(0));
+        QList<SearchHit> results = 
+            qvariant_cast<QList<SearchHit>>(arguments.at(0));
         QVERIFY(results.size() > 0);
     }
 }
@@ -166,8 +174,8 @@ void SearchServiceTests::performSearch_NonMatchingQuery_ReturnsEmpty() {
     
     if (completedSpy.count() > 0) {
         QList<QVariant> arguments = completedSpy.takeFirst();
-        QList<QPair<QString, QString>> results = 
-            qvariant_cast<QList<QPair<QString, QString>>>(arguments.at(0));
+        QList<SearchHit> results = 
+            qvariant_cast<QList<SearchHit>>(arguments.at(0));
         QCOMPARE(results.size(), 0);
     }
 }
@@ -176,12 +184,65 @@ void SearchServiceTests::performSearch_CaseSensitive_RespectsCase() {
     SearchService* service = static_cast<SearchService*>(m_service);
     QSignalSpy completedSpy(service, &SearchService::searchCompleted);
     
-    // Case-sensitive search for "Testing" (capital T)
+    // "Testing" (capital T) only occurs in the title of doc1
     service->performSearch("Testing", true, false, false);
     
-    QTRY_COMPARE(completedSpy.count() + 1, 2);
-    // Results may vary based on FTS5 configuration, but should not crash
-    QVERIFY(true);
+    QTRY_COMPARE(completedSpy.count(), 1);
+    QList<SearchHit> results = 
+        qvariant_cast<QList<SearchHit>>(completedSpy.takeFirst().at(0));
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results.first().title, QString("Introduction to Testing"));
+    
+    service->performSearch("TESTING", true, false, false);
+    
+    QTRY_COMPARE(completedSpy.count(), 1);
+    results = qvariant_cast<QList<SearchHit>>(completedSpy.takeFirst().at(0));
+    QVERIFY(results.isEmpty());
+}
+
+void SearchServiceTests::performSearch_CaseInsensitive_IgnoresCase() {
+    SearchService* service = static_cast<SearchService*>(m_service);
+    QSignalSpy completedSpy(service, &SearchService::searchCompleted);
+    
+    service->performSearch("TESTING", false, false, false);
+    
+    QTRY_COMPARE(completedSpy.count(), 1);
+    QList<SearchHit> results = 
+        qvariant_cast<QList<SearchHit>>(completedSpy.takeFirst().at(0));
+    QCOMPARE(results.size(), 1);
+}
+
+void SearchServiceTests::performSearch_CaseSensitive_MarksExactHits() {
+    SearchService* service = static_cast<SearchService*>(m_service);
+    QSignalSpy completedSpy(service, &SearchService::searchCompleted);
+    
+    service->performSearch("FTS5", true, false, false);
+    
+    QTRY_COMPARE(completedSpy.count(), 1);
+    QList<SearchHit> results = 
+        qvariant_cast<QList<SearchHit>>(completedSpy.takeFirst().at(0));
+    QCOMPARE(results.size(), 1);
+    QVERIFY(results.first().snippet.contains("<mark>FTS5</mark>"));
+}
+
+void SearchServiceTests::requestTotalHitCount_CaseSensitive_CountsVerifiedHits() {
+    SearchService* service = static_cast<SearchService*>(m_service);
+    service->setPageSize(5);
+    QSignalSpy completedSpy(service, &SearchService::searchCompleted);
+    QSignalSpy countSpy(service, &SearchService::totalHitCountReady);
+    
+    // The paging documents say "Pagination" in their content only
+    service->performSearch("Pagination", true, false, false);
+    QTRY_COMPARE(completedSpy.count(), 1);
+    QCOMPARE(qvariant_cast<QList<SearchHit>>(completedSpy.takeFirst().at(0)).size(), 5);
+    
+    service->requestTotalHitCount();
+    QTRY_COMPARE(countSpy.count(), 1);
+    QCOMPARE(countSpy.takeFirst().at(0).toInt(), 40);
+    
+    service->performSearch("pagination", true, false, false);
+    QTRY_COMPARE(completedSpy.count(), 1);
+    QVERIFY(qvariant_cast<QList<SearchHit>>(completedSpy.takeFirst().at(0)).isEmpty());
 }
 
 void SearchServiceTests::performSearch_Fuzzy_AllowsVariations() {
@@ -206,6 +267,93 @@ void SearchServiceTests::performSearch_Wildcards_AllowsWildcards() {
     QVERIFY(true);
 }
 
+void SearchServiceTests::performSearch_FuzzyMisspelled_FindsDocument() {
+    SearchService* service = static_cast<SearchService*>(m_service);
+    QSignalSpy completedSpy(service, &SearchService::searchCompleted);
+    
+    service->performSearch("documantation", false, true, false);
+    
+    QTRY_COMPARE(completedSpy.count(), 1);
+    QList<SearchHit> results = 
+        qvariant_cast<QList<SearchHit>>(completedSpy.takeFirst().at(0));
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results.first().title, QString("Documentation Guide"));
+}
+
+void SearchServiceTests::performSearch_Hit_CarriesDocumentIdAndMatchOffsets() {
+    SearchService* service = static_cast<SearchService*>(m_service);
+    QSignalSpy completedSpy(service, &SearchService::searchCompleted);
+    QSignalSpy snippetsSpy(service, &SearchService::snippetsReady);
+    
+    service->performSearch("documentation", false, false, false);
+    
+    QTRY_COMPARE(completedSpy.count(), 1);
+    QList<SearchHit> results = 
+        qvariant_cast<QList<SearchHit>>(completedSpy.takeFirst().at(0));
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results.first().documentId, QString("doc3"));
+    QVERIFY(results.first().rank < 0.0);
+    QVERIFY(results.first().rowid > 0);
+    // Ranked hits arrive without snippets
+    QVERIFY(results.first().snippet.isEmpty());
+    
+    service->requestSnippets(results);
+    
+    QTRY_COMPARE(snippetsSpy.count(), 1);
+    QList<SearchHit> snippets = 
+        qvariant_cast<QList<SearchHit>>(snippetsSpy.takeFirst().at(0));
+    QCOMPARE(snippets.size(), 1);
+    QCOMPARE(snippets.first().documentId, QString("doc3"));
+    QCOMPARE(snippets.first().rowid, results.first().rowid);
+    QVERIFY(snippets.first().snippet.contains("<mark>documentation</mark>"));
+    // "How to write good documentation for your code."
+    QCOMPARE(snippets.first().matchOffsets.size(), 1);
+    QCOMPARE(snippets.first().matchOffsets.first(), qMakePair(18, 13));
+}
+
+void SearchServiceTests::requestSnippets_ManyHits_BuildsOnlyRequested() {
+    SearchService* service = static_cast<SearchService*>(m_service);
+    QSignalSpy completedSpy(service, &SearchService::searchCompleted);
+    QSignalSpy snippetsSpy(service, &SearchService::snippetsReady);
+    
+    service->performSearch("pagination", false, false, false);
+    QTRY_COMPARE(completedSpy.count(), 1);
+    
+    // More hits than fit in one statement batch
+    const QList<SearchHit> requested =
+        qvariant_cast<QList<SearchHit>>(completedSpy.takeFirst().at(0)).mid(0, 20);
+    QCOMPARE(requested.size(), 20);
+    QStringList documentIds;
+    for (const SearchHit& hit : requested) {
+        documentIds << hit.documentId;
+    }
+    service->requestSnippets(requested);
+    
+    QTRY_COMPARE(snippetsSpy.count(), 1);
+    QSet<QString> built;
+    for (const auto& hit : qvariant_cast<QList<SearchHit>>(snippetsSpy.takeFirst().at(0))) {
+        QVERIFY(hit.snippet.contains("<mark>Pagination</mark>"));
+        built.insert(hit.documentId);
+    }
+    QCOMPARE(built, QSet<QString>(documentIds.begin(), documentIds.end()));
+}
+
+void SearchServiceTests::performSearch_CaseSensitiveHit_CarriesMatchOffsets() {
+    SearchService* service = static_cast<SearchService*>(m_service);
+    QSignalSpy completedSpy(service, &SearchService::searchCompleted);
+    
+    service->performSearch("FTS5", true, false, false);
+    
+    QTRY_COMPARE(completedSpy.count(), 1);
+    QList<SearchHit> results = 
+        qvariant_cast<QList<SearchHit>>(completedSpy.takeFirst().at(0));
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results.first().documentId, QString("doc2"));
+    // "Learn about full-text search, FTS5, and search algorithms."
+    QCOMPARE(results.first().matchOffsets.size(), 1);
+    QCOMPARE(results.first().matchOffsets.first(), qMakePair(30, 4));
+}
+
 void SearchServiceTests::performSearch_ValidQuery_EmitsSearchCompleted() {
     SearchService* service = static_cast<SearchService*>(m_service);
     QSignalSpy completedSpy(service, &SearchService::searchCompleted);
@@ -226,5 +374,288 @@ void SearchServiceTests::performSearch_InvalidQuery_EmitsSearchError() {
     QTRY_COMPARE(errorSpy.count(), 1);
 }
 
+void SearchServiceTests::performSearch_NewQuery_SupersedesPending() {
+    SearchService* service = static_cast<SearchService*>(m_service);
+    QSignalSpy completedSpy(service, &SearchService::searchCompleted);
+    
+    service->performSearch("testing", false, false, false);
+    service->performSearch("documentation", false, false, false);
+    
+    QTRY_COMPARE(completedSpy.count(), 1);
+    QTest::qWait(100);
+    QCOMPARE(completedSpy.count(), 1);
+    
+    QList<SearchHit> results = 
+        qvariant_cast<QList<SearchHit>>(completedSpy.takeFirst().at(0));
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results.first().title, QString("Documentation Guide"));
+}
+
+void SearchServiceTests::performSearch_Results_DeliveredOnCallerThread() {
+    SearchService* service = static_cast<SearchService*>(m_service);
+    QThread *deliveryThread = nullptr;
+    connect(service, &SearchService::searchCompleted, this, [&deliveryThread]() {
+        deliveryThread = QThread::currentThread();
+    }, Qt::DirectConnection);
+    
+    service->performSearch("search", false, false, false);
+    
+    QTRY_VERIFY(deliveryThread != nullptr);
+    QCOMPARE(deliveryThread, QThread::currentThread());
+}
+
+void SearchServiceTests::performSearch_AfterUnload_DropsPendingResults() {
+    SearchService* service = static_cast<SearchService*>(m_service);
+    QSignalSpy completedSpy(service, &SearchService::searchCompleted);
+    QSignalSpy errorSpy(service, &SearchService::searchError);
+    
+    service->performSearch("testing", false, false, false);
+    static_cast<CartridgeService*>(m_cartridgeService)->unloadCartridge();
+    
+    QTest::qWait(200);
+    QCOMPARE(completedSpy.count(), 0);
+    QCOMPARE(errorSpy.count(), 0);
+}
+
+void SearchServiceTests::performSearch_FirstPage_LimitedToPageSize() {
+    SearchService* service = static_cast<SearchService*>(m_service);
+    service->setPageSize(10);
+    QSignalSpy completedSpy(service, &SearchService::searchCompleted);
+    
+    service->performSearch("pagination", false, false, false);
+    
+    QTRY_COMPARE(completedSpy.count(), 1);
+    QList<SearchHit> results = 
+        qvariant_cast<QList<SearchHit>>(completedSpy.takeFirst().at(0));
+    QCOMPARE(results.size(), 10);
+    QVERIFY(service->hasMoreResults());
+}
+
+void SearchServiceTests::fetchMoreResults_UntilExhausted_ReturnsEveryHitOnce() {
+    SearchService* service = static_cast<SearchService*>(m_service);
+    service->setPageSize(15);
+    QSignalSpy completedSpy(service, &SearchService::searchCompleted);
+    QSignalSpy appendedSpy(service, &SearchService::resultsAppended);
+    
+    service->performSearch("pagination", false, false, false);
+    QTRY_COMPARE(completedSpy.count(), 1);
+    
+    QSet<QString> titles;
+    for (const auto& result : qvariant_cast<QList<SearchHit>>(completedSpy.takeFirst().at(0))) {
+        titles.insert(result.title);
+    }
+    
+    int pages = 1;
+    while (service->hasMoreResults()) {
+        service->fetchMoreResults();
+        QTRY_COMPARE(appendedSpy.count(), pages);
+        for (const auto& result : qvariant_cast<QList<SearchHit>>(appendedSpy.at(pages - 1).at(0))) {
+            titles.insert(result.title);
+        }
+        ++pages;
+    }
+    
+    QCOMPARE(pages, 3);
+    QCOMPARE(titles.size(), 40);
+}
+
+void SearchServiceTests::requestTotalHitCount_AfterFirstPage_CountsAllHits() {
+    SearchService* service = static_cast<SearchService*>(m_service);
+    service->setPageSize(5);
+    QSignalSpy completedSpy(service, &SearchService::searchCompleted);
+    QSignalSpy countSpy(service, &SearchService::totalHitCountReady);
+    
+    service->performSearch("pagination", false, false, false);
+    QTRY_COMPARE(completedSpy.count(), 1);
+    
+    service->requestTotalHitCount();
+    QTRY_COMPARE(countSpy.count(), 1);
+    QCOMPARE(countSpy.takeFirst().at(0).toInt(), 40);
+}
+
+void SearchServiceTests::performIncrementalSearch_PartialTerm_MatchesPrefix() {
+    SearchService* service = static_cast<SearchService*>(m_service);
+    QSignalSpy completedSpy(service, &SearchService::searchCompleted);
+    QSignalSpy countSpy(service, &SearchService::totalHitCountReady);
+    
+    service->performIncrementalSearch("pagin");
+    QTRY_COMPARE(completedSpy.count(), 1);
+    
+    service->requestTotalHitCount();
+    QTRY_COMPARE(countSpy.count(), 1);
+    QCOMPARE(countSpy.takeFirst().at(0).toInt(), 40);
+}
+
+void SearchServiceTests::performIncrementalSearch_NarrowedQuery_ReturnsSubset() {
+    SearchService* service = static_cast<SearchService*>(m_service);
+    QSignalSpy completedSpy(service, &SearchService::searchCompleted);
+    QSignalSpy countSpy(service, &SearchService::totalHitCountReady);
+    
+    service->performIncrementalSearch("pagin");
+    QTRY_COMPARE(completedSpy.count(), 1);
+    
+    // "1*" matches 1 and 10-19
+    service->performIncrementalSearch("pagination number 1");
+    QTRY_COMPARE(completedSpy.count(), 2);
+    
+    service->requestTotalHitCount();
+    QTRY_COMPARE(countSpy.count(), 1);
+    QCOMPARE(countSpy.takeFirst().at(0).toInt(), 11);
+}
+
+void SearchServiceTests::cancelSearch_Pending_DropsResults() {
+    SearchService* service = static_cast<SearchService*>(m_service);
+    QSignalSpy completedSpy(service, &SearchService::searchCompleted);
+    
+    service->performIncrementalSearch("pagin");
+    service->cancelSearch();
+    
+    QTest::qWait(200);
+    QCOMPARE(completedSpy.count(), 0);
+}
+
+void SearchServiceTests::narrows_ExtendedOrAddedTerms_ReturnsTrue() {
+    QVERIFY(SearchWorker::narrows({"pag"}, {"pagin"}));
+    QVERIFY(SearchWorker::narrows({"pag"}, {"pag"}));
+    QVERIFY(SearchWorker::narrows({"pag"}, {"pagination", "num"}));
+    QVERIFY(SearchWorker::narrows({"pagination", "n"}, {"pagination", "number", "1"}));
+}
+
+void SearchServiceTests::narrows_ChangedTerms_ReturnsFalse() {
+    QVERIFY(!SearchWorker::narrows({}, {"pag"}));
+    QVERIFY(!SearchWorker::narrows({"pagin"}, {"pag"}));
+    QVERIFY(!SearchWorker::narrows({"pagination", "num"}, {"pagination"}));
+    QVERIFY(!SearchWorker::narrows({"pagination", "num"}, {"paging", "number"}));
+}
+
+void SearchServiceTests::performSearch_Repeated_ServedFromCache() {
+    SearchService* service = static_cast<SearchService*>(m_service);
+    QSignalSpy completedSpy(service, &SearchService::searchCompleted);
+    
+    service->performSearch("pagination", false, false, false);
+    QTRY_COMPARE(completedSpy.count(), 1);
+    QList<SearchHit> first = 
+        qvariant_cast<QList<SearchHit>>(completedSpy.takeFirst().at(0));
+    QCOMPARE(service->resultCacheMisses(), quint64(1));
+    QCOMPARE(service->resultCacheHits(), quint64(0));
+    
+    service->performSearch("pagination", false, false, false);
+    QTRY_COMPARE(completedSpy.count(), 1);
+    QList<SearchHit> second = 
+        qvariant_cast<QList<SearchHit>>(completedSpy.takeFirst().at(0));
+    QCOMPARE(service->resultCacheHits(), quint64(1));
+    QCOMPARE(second, first);
+    QCOMPARE(service->resultCacheEntries(), 1);
+}
+
+void SearchServiceTests::performSearch_DifferentCase_SharesCacheEntry() {
+    SearchService* service = static_cast<SearchService*>(m_service);
+    QSignalSpy completedSpy(service, &SearchService::searchCompleted);
+    
+    service->performSearch("Pagination", false, false, false);
+    QTRY_COMPARE(completedSpy.count(), 1);
+    service->performSearch("pagination ", false, false, false);
+    QTRY_COMPARE(completedSpy.count(), 2);
+    QCOMPARE(service->resultCacheHits(), quint64(1));
+    
+    // Case-sensitive searches are cached separately
+    service->performSearch("Pagination", true, false, false);
+    QTRY_COMPARE(completedSpy.count(), 3);
+    QCOMPARE(service->resultCacheHits(), quint64(1));
+    QCOMPARE(service->resultCacheEntries(), 2);
+}
+
+void SearchServiceTests::performIncrementalSearch_CaseSensitiveDifferentCase_CachedSeparately() {
+    SearchService* service = static_cast<SearchService*>(m_service);
+    QSignalSpy completedSpy(service, &SearchService::searchCompleted);
+    
+    // "Pagination sample number N." - only the capitalized prefix matches
+    service->performIncrementalSearch("Pagin", true);
+    QTRY_COMPARE(completedSpy.count(), 1);
+    QVERIFY(!qvariant_cast<QList<SearchHit>>(completedSpy.takeFirst().at(0)).isEmpty());
+    
+    // Same FTS5 query, different exact case: not served from the cache
+    service->performIncrementalSearch("pagin", true);
+    QTRY_COMPARE(completedSpy.count(), 1);
+    QVERIFY(qvariant_cast<QList<SearchHit>>(completedSpy.takeFirst().at(0)).isEmpty());
+    QCOMPARE(service->resultCacheHits(), quint64(0));
+    QCOMPARE(service->resultCacheEntries(), 2);
+    
+    // Repeating either one is a cache hit with its own results
+    service->performIncrementalSearch("Pagin", true);
+    QTRY_COMPARE(completedSpy.count(), 1);
+    QVERIFY(!qvariant_cast<QList<SearchHit>>(completedSpy.takeFirst().at(0)).isEmpty());
+    QCOMPARE(service->resultCacheHits(), quint64(1));
+}
+
+void SearchServiceTests::fetchMoreResults_CachedSearch_ResumesAfterCachedPages() {
+    SearchService* service = static_cast<SearchService*>(m_service);
+    service->setPageSize(15);
+    QSignalSpy completedSpy(service, &SearchService::searchCompleted);
+    QSignalSpy appendedSpy(service, &SearchService::resultsAppended);
+    
+    // Only the first page is read and cached
+    service->performSearch("pagination", false, false, false);
+    QTRY_COMPARE(completedSpy.count(), 1);
+    service->performSearch("pagination", false, false, false);
+    QTRY_COMPARE(completedSpy.count(), 2);
+    QCOMPARE(service->resultCacheHits(), quint64(1));
+    
+    QStringList titles;
+    for (const auto& result : qvariant_cast<QList<SearchHit>>(completedSpy.at(1).at(0))) {
+        titles << result.title;
+    }
+    
+    int pages = 1;
+    while (service->hasMoreResults()) {
+        service->fetchMoreResults();
+        QTRY_COMPARE(appendedSpy.count(), pages);
+        for (const auto& result : qvariant_cast<QList<SearchHit>>(appendedSpy.at(pages - 1).at(0))) {
+            titles << result.title;
+        }
+        ++pages;
+    }
+    
+    QCOMPARE(pages, 3);
+    QCOMPARE(titles.size(), 40);
+    QCOMPARE(QSet<QString>(titles.begin(), titles.end()).size(), 40);
+}
+
+void SearchServiceTests::requestTotalHitCount_CachedSearch_CountsAllHits() {
+    SearchService* service = static_cast<SearchService*>(m_service);
+    service->setPageSize(5);
+    QSignalSpy completedSpy(service, &SearchService::searchCompleted);
+    QSignalSpy countSpy(service, &SearchService::totalHitCountReady);
+    
+    service->performSearch("pagination", false, false, false);
+    QTRY_COMPARE(completedSpy.count(), 1);
+    service->performSearch("pagination", false, false, false);
+    QTRY_COMPARE(completedSpy.count(), 2);
+    
+    service->requestTotalHitCount();
+    QTRY_COMPARE(countSpy.count(), 1);
+    QCOMPARE(countSpy.takeFirst().at(0).toInt(), 40);
+    
+    // The count is cached with the results
+    service->performSearch("pagination", false, false, false);
+    QTRY_COMPARE(completedSpy.count(), 3);
+    service->requestTotalHitCount();
+    QCOMPARE(countSpy.count(), 1);
+    QCOMPARE(countSpy.takeFirst().at(0).toInt(), 40);
+}
+
+void SearchServiceTests::unloadCartridge_ClearsResultCache() {
+    SearchService* service = static_cast<SearchService*>(m_service);
+    CartridgeService* cartridge = static_cast<CartridgeService*>(m_cartridgeService);
+    QSignalSpy completedSpy(service, &SearchService::searchCompleted);
+    
+    service->performSearch("pagination", false, false, false);
+    QTRY_COMPARE(completedSpy.count(), 1);
+    QCOMPARE(service->resultCacheEntries(), 1);
+    
+    cartridge->unloadCartridge();
+    QCOMPARE(service->resultCacheEntries(), 0);
+}
+
 // QTEST_MAIN removed - using main.cpp instead
 #include "SearchServiceTests.moc"
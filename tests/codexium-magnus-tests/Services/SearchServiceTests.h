@@ -20,12 +20,44 @@ private slots:
     
     // Search options tests
     void performSearch_CaseSensitive_RespectsCase();
+    void performSearch_CaseInsensitive_IgnoresCase();
+    void performSearch_CaseSensitive_MarksExactHits();
+    void requestTotalHitCount_CaseSensitive_CountsVerifiedHits();
     void performSearch_Fuzzy_AllowsVariations();
     void performSearch_Wildcards_AllowsWildcards();
+    void performSearch_FuzzyMisspelled_FindsDocument();
+    void performSearch_Hit_CarriesDocumentIdAndMatchOffsets();
+    void performSearch_CaseSensitiveHit_CarriesMatchOffsets();
+    void requestSnippets_ManyHits_BuildsOnlyRequested();
     
     // Signal tests
     void performSearch_ValidQuery_EmitsSearchCompleted();
     void performSearch_InvalidQuery_EmitsSearchError();
+    
+    // Worker thread tests
+    void performSearch_NewQuery_SupersedesPending();
+    void performSearch_Results_DeliveredOnCallerThread();
+    void performSearch_AfterUnload_DropsPendingResults();
+    
+    // Paging tests
+    void performSearch_FirstPage_LimitedToPageSize();
+    void fetchMoreResults_UntilExhausted_ReturnsEveryHitOnce();
+    void requestTotalHitCount_AfterFirstPage_CountsAllHits();
+    
+    // Incremental search tests
+    void performIncrementalSearch_PartialTerm_MatchesPrefix();
+    void performIncrementalSearch_NarrowedQuery_ReturnsSubset();
+    void cancelSearch_Pending_DropsResults();
+    void narrows_ExtendedOrAddedTerms_ReturnsTrue();
+    void narrows_ChangedTerms_ReturnsFalse();
+    
+    // Result cache tests
+    void performSearch_Repeated_ServedFromCache();
+    void performSearch_DifferentCase_SharesCacheEntry();
+    void performIncrementalSearch_CaseSensitiveDifferentCase_CachedSeparately();
+    void fetchMoreResults_CachedSearch_ResumesAfterCachedPages();
+    void requestTotalHitCount_CachedSearch_CountsAllHits();
+    void unloadCartridge_ClearsResultCache();
 
 private:
     void* m_service; // SearchService* - using void* to avoid include in header
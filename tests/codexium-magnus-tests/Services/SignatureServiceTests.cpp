@@ -6,8 +6,18 @@
 #include <QJsonObject>
 #include <QDir>
 #include <QSettings>
+#include <QCryptographicHash>
+#include <QFile>
 #include "Services/SignatureService.h"
 #include "Services/ISignatureService.h"
+#include "Services/VerificationCache.h"
+#include "DbInitializer.h"
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
 
 #ifdef HAVE_LIBSODIUM
 #include <sodium.h>
@@ -128,6 +138,8 @@ QString SignatureServiceTests::createTestCartridgeFile(const QByteArray& manifes
     // For now, just create an empty file - full implementation would need SQLite structure
     QTemporaryFile tempFile;
     tempFile.setFileTemplate(QDir::temp().absoluteFilePath("test-cartridge-XXXXXX.db"));
+    // Keep the file once tempFile goes out of scope; callers remove it
+    tempFile.setAutoRemove(false);
     if (tempFile.open()) {
         // In a real test, we'd write SQLite structure and manifest here
         tempFile.write(manifest);
@@ -137,6 +149,45 @@ QString SignatureServiceTests::createTestCartridgeFile(const QByteArray& manifes
     return QString();
 }
 
+QString SignatureServiceTests::createSignedCartridge(const QString& directory, const QByteArray& content,
+                                                    QByteArray *publicKey, QByteArray *message) {
+#ifdef HAVE_LIBSODIUM
+    // Requires sodium_init(), done by any SignatureService
+    unsigned char pk[crypto_sign_PUBLICKEYBYTES];
+    unsigned char sk[crypto_sign_SECRETKEYBYTES];
+    crypto_sign_keypair(pk, sk);
+    *publicKey = QByteArray(reinterpret_cast<const char*>(pk), sizeof(pk));
+
+    QString cartridgePath = QDir(directory).filePath("signed.cartridge");
+    QFile cartridge(cartridgePath);
+    if (!cartridge.open(QIODevice::WriteOnly) || cartridge.write(content) != content.size()) {
+        return QString();
+    }
+    cartridge.close();
+
+    // Sign as the authoring tool does: signed manifest + database
+    QByteArray manifest = createManifestJson(QByteArray(), *publicKey);
+    *message = QCryptographicHash::hash(SignatureService::signedManifest(manifest) + content,
+                                        QCryptographicHash::Sha256);
+    unsigned char sig[crypto_sign_BYTES];
+    crypto_sign_detached(sig, nullptr, reinterpret_cast<const unsigned char*>(message->constData()),
+                         message->size(), sk);
+    manifest = createManifestJson(QByteArray(reinterpret_cast<const char*>(sig), sizeof(sig)), *publicKey);
+
+    QFile manifestFile(SignatureService::manifestPath(cartridgePath));
+    if (!manifestFile.open(QIODevice::WriteOnly) || manifestFile.write(manifest) != manifest.size()) {
+        return QString();
+    }
+    return cartridgePath;
+#else
+    Q_UNUSED(directory);
+    Q_UNUSED(content);
+    Q_UNUSED(publicKey);
+    Q_UNUSED(message);
+    return QString();
+#endif
+}
+
 void SignatureServiceTests::addTrustedKey_ValidKey_Stored() {
     SignatureService* service = static_cast<SignatureService*>(createTestService());
     QByteArray key = createValidPublicKey();
@@ -202,6 +253,40 @@ void SignatureServiceTests::getKeyTrustLevel_UnknownKey_ReturnsUnverified() {
     delete service;
 }
 
+void SignatureServiceTests::getKeyTrustLevel_KeysChangedConcurrently_ReadsConsistent() {
+    SignatureService* service = static_cast<SignatureService*>(createTestService());
+    QByteArray stableKey = createValidPublicKey();
+    QByteArray changingKey(32, 0x5A);
+    service->addTrustedKey(stableKey, "Stable Key", true);
+    
+    // Verification threads read the keys while the GUI thread edits them
+    std::atomic<bool> stop(false);
+    std::atomic<int> wrongLevels(0);
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&]() {
+            while (!stop.load()) {
+                if (service->getKeyTrustLevel(stableKey) != TrustLevel::Official) {
+                    ++wrongLevels;
+                }
+                service->getKeyTrustLevel(changingKey);
+            }
+        });
+    }
+    for (int i = 0; i < 50; ++i) {
+        service->addTrustedKey(changingKey, "Changing Key", i % 2 == 0);
+        service->removeTrustedKey(changingKey);
+    }
+    stop.store(true);
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    
+    QCOMPARE(wrongLevels.load(), 0);
+    QCOMPARE(service->getKeyTrustLevel(changingKey), TrustLevel::Unverified);
+    delete service;
+}
+
 void SignatureServiceTests::verifySignature_ValidSignature_ReturnsTrue() {
 #ifdef HAVE_LIBSODIUM
     SignatureService* service = static_cast<SignatureService*>(createTestService());
@@ -337,18 +422,106 @@ void SignatureServiceTests::extractPublicKey_NoKey_ReturnsEmpty() {
     delete service;
 }
 
+void SignatureServiceTests::extractDigestFormat_NoDigest_ReturnsSequential() {
+    SignatureService* service = static_cast<SignatureService*>(createTestService());
+    QByteArray manifest = createManifestJson(createValidSignature(), createValidPublicKey());
+    
+    QCOMPARE(service->extractDigestFormat(manifest), SignatureService::DigestFormat::Sequential);
+    delete service;
+}
+
+void SignatureServiceTests::extractDigestFormat_MerkleDigest_ReturnsChunkSize() {
+    SignatureService* service = static_cast<SignatureService*>(createTestService());
+    QJsonObject obj = QJsonDocument::fromJson(createManifestJson()).object();
+    QJsonObject digest;
+    digest["format"] = "merkle-sha256";
+    digest["chunkSize"] = 65536;
+    obj["digest"] = digest;
+    
+    qint64 chunkSize = 0;
+    SignatureService::DigestFormat format =
+        service->extractDigestFormat(QJsonDocument(obj).toJson(), &chunkSize);
+    QCOMPARE(format, SignatureService::DigestFormat::MerkleSha256);
+    QCOMPARE(chunkSize, qint64(65536));
+    delete service;
+}
+
+void SignatureServiceTests::extractDigestFormat_UnknownFormat_ReturnsUnsupported() {
+    SignatureService* service = static_cast<SignatureService*>(createTestService());
+    QJsonObject obj = QJsonDocument::fromJson(createManifestJson()).object();
+    QJsonObject digest;
+    digest["format"] = "blake3";
+    obj["digest"] = digest;
+    QCOMPARE(service->extractDigestFormat(QJsonDocument(obj).toJson()),
+             SignatureService::DigestFormat::Unsupported);
+    
+    // Chunks smaller than a SQLite page are rejected too
+    digest["format"] = "merkle-sha256";
+    digest["chunkSize"] = 512;
+    obj["digest"] = digest;
+    QCOMPARE(service->extractDigestFormat(QJsonDocument(obj).toJson()),
+             SignatureService::DigestFormat::Unsupported);
+    delete service;
+}
+
+void SignatureServiceTests::extractChunkHashes_MerkleDigest_SplitsTable() {
+    SignatureService* service = static_cast<SignatureService*>(createTestService());
+    QJsonObject obj = QJsonDocument::fromJson(createManifestJson()).object();
+    QByteArray table = QByteArray(32, '\x01') + QByteArray(32, '\x02') + QByteArray(32, '\x03');
+    QJsonObject digest;
+    digest["format"] = "merkle-sha256";
+    digest["chunkHashes"] = QString::fromLatin1(table.toBase64());
+    obj["digest"] = digest;
+    
+    QList<QByteArray> hashes = service->extractChunkHashes(QJsonDocument(obj).toJson());
+    QCOMPARE(hashes.size(), 3);
+    QCOMPARE(hashes[1], QByteArray(32, '\x02'));
+    
+    // A truncated table is rejected as a whole
+    digest["chunkHashes"] = QString::fromLatin1(table.left(40).toBase64());
+    obj["digest"] = digest;
+    QVERIFY(service->extractChunkHashes(QJsonDocument(obj).toJson()).isEmpty());
+    delete service;
+}
+
+void SignatureServiceTests::manifestPath_Cartridge_IsSidecarFile() {
+    QCOMPARE(SignatureService::manifestPath("/library/ct-vol-1.db"),
+             QString("/library/ct-vol-1.db.manifest.json"));
+}
+
+void SignatureServiceTests::signedManifest_SignedManifest_CompactSortedWithoutSignature() {
+    // The documented signed bytes (Detailed Design 9.2); signing tools must
+    // produce exactly these
+    QByteArray manifest = R"({
+        "title": "Test Cartridge",
+        "signature": "c2lnbmF0dXJl",
+        "publicKey": "cHVibGljS2V5",
+        "digest": { "format": "merkle-sha256", "chunkSize": 4096 }
+    })";
+    
+    QCOMPARE(SignatureService::signedManifest(manifest),
+             QByteArray(R"({"digest":{"chunkSize":4096,"format":"merkle-sha256"},)"
+                        R"("publicKey":"cHVibGljS2V5","title":"Test Cartridge"})"));
+    QVERIFY(SignatureService::signedManifest("[]").isEmpty());
+}
+
 void SignatureServiceTests::verifyCartridge_UnsignedCartridge_ReturnsHomebrew() {
     SignatureService* service = static_cast<SignatureService*>(createTestService());
     QByteArray manifest = createManifestJson(); // No signature or key
     QString cartridgePath = createTestCartridgeFile(manifest);
     
     if (!cartridgePath.isEmpty()) {
-        TrustLevel level = service->verifyCartridge(cartridgePath);
-        // Note: This will return Unverified or Invalid until manifest reading is implemented
-        // For now, we just verify it doesn't crash
-        QVERIFY(level == TrustLevel::Homebrew || 
-                level == TrustLevel::Unverified || 
-                level == TrustLevel::Invalid);
+        // No sidecar manifest: unsigned, not tampered
+        QCOMPARE(service->verifyCartridge(cartridgePath), TrustLevel::Homebrew);
+        
+        // A manifest without a signature is unsigned too
+        QFile sidecar(SignatureService::manifestPath(cartridgePath));
+        QVERIFY(sidecar.open(QIODevice::WriteOnly));
+        sidecar.write(manifest);
+        sidecar.close();
+        QCOMPARE(service->verifyCartridge(cartridgePath), TrustLevel::Homebrew);
+        sidecar.remove();
+        QFile::remove(cartridgePath);
     } else {
         QSKIP("Could not create test cartridge file");
     }
@@ -364,6 +537,268 @@ void SignatureServiceTests::verifyCartridge_InvalidPath_ReturnsInvalid() {
     delete service;
 }
 
+void SignatureServiceTests::verifyCartridge_SignedCartridge_ReadsManifest() {
+#ifdef HAVE_LIBSODIUM
+    QTemporaryDir tempDir;
+    SignatureService* service = static_cast<SignatureService*>(createTestService());
+    QByteArray publicKey;
+    QByteArray message;
+    QString cartridgePath = createSignedCartridge(tempDir.path(), QByteArray(8192, 'c'), &publicKey, &message);
+    QVERIFY(!cartridgePath.isEmpty());
+    
+    // Valid signature by a key that is not trusted yet
+    QCOMPARE(service->verifyCartridge(cartridgePath), TrustLevel::Unverified);
+    service->addTrustedKey(publicKey, "Publisher", true);
+    QCOMPARE(service->verifyCartridge(cartridgePath), TrustLevel::Official);
+    delete service;
+#else
+    QSKIP("libsodium not available - skipping signed cartridge test");
+#endif
+}
+
+void SignatureServiceTests::verifyCartridge_TamperedCartridge_ReturnsInvalid() {
+#ifdef HAVE_LIBSODIUM
+    QTemporaryDir tempDir;
+    SignatureService* service = static_cast<SignatureService*>(createTestService());
+    QByteArray publicKey;
+    QByteArray message;
+    QString cartridgePath = createSignedCartridge(tempDir.path(), QByteArray(8192, 'c'), &publicKey, &message);
+    QVERIFY(!cartridgePath.isEmpty());
+    service->addTrustedKey(publicKey, "Publisher", true);
+    
+    QFile cartridge(cartridgePath);
+    QVERIFY(cartridge.open(QIODevice::ReadWrite));
+    QVERIFY(cartridge.seek(4096));
+    QCOMPARE(cartridge.write("x", 1), qint64(1));
+    cartridge.close();
+    
+    QCOMPARE(service->verifyCartridge(cartridgePath), TrustLevel::Invalid);
+    delete service;
+#else
+    QSKIP("libsodium not available - skipping signed cartridge test");
+#endif
+}
+
+void SignatureServiceTests::verifyCartridge_CachedUnchangedFile_ReturnsCachedTrust() {
+    QTemporaryDir tempDir;
+    QString dbPath = tempDir.filePath("app.db");
+    CodexiumMagnus::Storage::DbInitializer::ensureCreated(dbPath);
+    QString cartridgePath = createTestCartridgeFile(createManifestJson());
+    
+    SignatureService* service = static_cast<SignatureService*>(createTestService());
+    service->addTrustedKey(createValidPublicKey(), "Test Key", true);
+    service->setVerificationCache(std::make_unique<VerificationCache>(dbPath));
+    
+    // Cached as verified moments ago, so no background re-verification either
+    VerificationCache::Entry entry;
+    entry.path = cartridgePath;
+    entry.identity = VerificationCache::FileIdentity::of(cartridgePath);
+    entry.digest = QByteArray(32, '\x42');
+    entry.trustLevel = TrustLevel::Official;
+    entry.keyFingerprint = VerificationCache::keyFingerprint(createValidPublicKey());
+    entry.verifiedUtc = QDateTime::currentDateTimeUtc();
+    QVERIFY(service->verificationCache()->store(entry));
+    
+    // Without the cache this file has no readable manifest and is Homebrew
+    QSignalSpy hashedSpy(service, &SignatureService::cartridgeHashed);
+    QCOMPARE(service->verifyCartridge(cartridgePath), TrustLevel::Official);
+    QCOMPARE(hashedSpy.count(), 0);
+    
+    // The trust level follows the current trusted keys
+    service->removeTrustedKey(createValidPublicKey());
+    QCOMPARE(service->verifyCartridge(cartridgePath), TrustLevel::Unverified);
+    delete service;
+    QFile::remove(cartridgePath);
+}
+
+void SignatureServiceTests::verifyCartridge_CachedChangedFile_IsVerifiedAgain() {
+    QTemporaryDir tempDir;
+    QString dbPath = tempDir.filePath("app.db");
+    CodexiumMagnus::Storage::DbInitializer::ensureCreated(dbPath);
+    QString cartridgePath = createTestCartridgeFile(createManifestJson());
+    
+    SignatureService* service = static_cast<SignatureService*>(createTestService());
+    service->addTrustedKey(createValidPublicKey(), "Test Key", true);
+    service->setVerificationCache(std::make_unique<VerificationCache>(dbPath));
+    
+    VerificationCache::Entry entry;
+    entry.path = cartridgePath;
+    entry.identity = VerificationCache::FileIdentity::of(cartridgePath);
+    entry.identity.size += 1;  // As if the file had been modified since
+    entry.digest = QByteArray(32, '\x42');
+    entry.trustLevel = TrustLevel::Official;
+    entry.keyFingerprint = VerificationCache::keyFingerprint(createValidPublicKey());
+    entry.verifiedUtc = QDateTime::currentDateTimeUtc();
+    QVERIFY(service->verificationCache()->store(entry));
+    
+    QVERIFY(service->verifyCartridge(cartridgePath) != TrustLevel::Official);
+    delete service;
+    QFile::remove(cartridgePath);
+}
+
+void SignatureServiceTests::verifyCartridge_CachedChangedManifest_IsVerifiedAgain() {
+    QTemporaryDir tempDir;
+    QString dbPath = tempDir.filePath("app.db");
+    CodexiumMagnus::Storage::DbInitializer::ensureCreated(dbPath);
+    QString cartridgePath = createTestCartridgeFile(createManifestJson());
+    
+    SignatureService* service = static_cast<SignatureService*>(createTestService());
+    service->addTrustedKey(createValidPublicKey(), "Test Key", true);
+    service->setVerificationCache(std::make_unique<VerificationCache>(dbPath));
+    
+    // Cached while the cartridge had no sidecar
+    VerificationCache::Entry entry;
+    entry.path = cartridgePath;
+    entry.identity = VerificationCache::FileIdentity::of(cartridgePath);
+    entry.manifestIdentity = VerificationCache::FileIdentity::of(SignatureService::manifestPath(cartridgePath));
+    entry.digest = QByteArray(32, '\x42');
+    entry.trustLevel = TrustLevel::Official;
+    entry.keyFingerprint = VerificationCache::keyFingerprint(createValidPublicKey());
+    entry.verifiedUtc = QDateTime::currentDateTimeUtc();
+    QVERIFY(service->verificationCache()->store(entry));
+    
+    // A manifest dropped next to the unchanged database is not trusted
+    // on the strength of the cached result
+    QFile sidecar(SignatureService::manifestPath(cartridgePath));
+    QVERIFY(sidecar.open(QIODevice::WriteOnly));
+    sidecar.write(createManifestJson(createValidSignature(), createValidPublicKey()));
+    sidecar.close();
+    QCOMPARE(VerificationCache::FileIdentity::of(cartridgePath), entry.identity);
+    
+    QVERIFY(service->verifyCartridge(cartridgePath) != TrustLevel::Official);
+    delete service;
+    sidecar.remove();
+    QFile::remove(cartridgePath);
+}
+
+void SignatureServiceTests::verifyCartridge_StaleCacheEntry_ReverifiedInBackground() {
+    QTemporaryDir tempDir;
+    QString dbPath = tempDir.filePath("app.db");
+    CodexiumMagnus::Storage::DbInitializer::ensureCreated(dbPath);
+    QString cartridgePath = createTestCartridgeFile(createManifestJson());
+    
+    SignatureService* service = static_cast<SignatureService*>(createTestService());
+    service->addTrustedKey(createValidPublicKey(), "Test Key", false);
+    service->setVerificationCache(std::make_unique<VerificationCache>(dbPath));
+    service->setReverifyInterval(0);
+    
+    // The cached digest cannot match this file's content
+    QFile sidecar(SignatureService::manifestPath(cartridgePath));
+    QVERIFY(sidecar.open(QIODevice::WriteOnly));
+    sidecar.write(createManifestJson(createValidSignature(), createValidPublicKey()));
+    sidecar.close();
+    VerificationCache::Entry entry;
+    entry.path = cartridgePath;
+    entry.identity = VerificationCache::FileIdentity::of(cartridgePath);
+    entry.manifestIdentity = VerificationCache::FileIdentity::of(sidecar.fileName());
+    entry.digest = QByteArray(32, '\x42');
+    entry.trustLevel = TrustLevel::Verified;
+    entry.keyFingerprint = VerificationCache::keyFingerprint(createValidPublicKey());
+    entry.verifiedUtc = QDateTime::currentDateTimeUtc();
+    QVERIFY(service->verificationCache()->store(entry));
+    
+    QSignalSpy changedSpy(service, &ISignatureService::trustLevelChanged);
+    QCOMPARE(service->verifyCartridge(cartridgePath), TrustLevel::Verified);
+    service->waitForReverification();
+    
+    QCOMPARE(changedSpy.count(), 1);
+    QCOMPARE(changedSpy.first().at(1).value<TrustLevel>(), TrustLevel::Invalid);
+    VerificationCache::Entry cached;
+    QVERIFY(!service->verificationCache()->lookup(cartridgePath, cached));
+    delete service;
+    sidecar.remove();
+    QFile::remove(cartridgePath);
+}
+
+void SignatureServiceTests::verifyCartridge_ValidSignature_FillsCache() {
+#ifdef HAVE_LIBSODIUM
+    QTemporaryDir tempDir;
+    QString dbPath = tempDir.filePath("app.db");
+    CodexiumMagnus::Storage::DbInitializer::ensureCreated(dbPath);
+    SignatureService* service = static_cast<SignatureService*>(createTestService());
+    service->setVerificationCache(std::make_unique<VerificationCache>(dbPath));
+    
+    QByteArray publicKey;
+    QByteArray message;
+    QString cartridgePath = createSignedCartridge(tempDir.path(), QByteArray(8192, 'c'), &publicKey, &message);
+    QVERIFY(!cartridgePath.isEmpty());
+    service->addTrustedKey(publicKey, "Publisher", false);
+    
+    QSignalSpy hashedSpy(service, &SignatureService::cartridgeHashed);
+    QCOMPARE(service->verifyCartridge(cartridgePath), TrustLevel::Verified);
+    QCOMPARE(hashedSpy.count(), 1);
+    
+    VerificationCache::Entry cached;
+    QVERIFY(service->verificationCache()->lookup(cartridgePath, cached));
+    QCOMPARE(cached.digest, message);
+    QCOMPARE(cached.keyFingerprint, VerificationCache::keyFingerprint(publicKey));
+    
+    // Re-opening the unchanged cartridge is answered without hashing
+    QCOMPARE(service->verifyCartridge(cartridgePath), TrustLevel::Verified);
+    QCOMPARE(hashedSpy.count(), 1);
+    delete service;
+#else
+    QSKIP("libsodium not available - skipping verification cache fill test");
+#endif
+}
+
+void SignatureServiceTests::hashFile_MultiChunkFile_MatchesOneShotHash() {
+    // Two and a half chunks, so the last read is a partial one
+    QByteArray content(SignatureService::hashChunkSize() * 5 / 2, Qt::Uninitialized);
+    for (int i = 0; i < content.size(); ++i) {
+        content[i] = static_cast<char>(i * 31 + 7);
+    }
+    QString path = createTestCartridgeFile(content);
+    if (path.isEmpty()) {
+        QSKIP("Could not create test cartridge file");
+    }
+
+    QByteArray manifest = createManifestJson();
+    QByteArray expected = QCryptographicHash::hash(manifest + content, QCryptographicHash::Sha256);
+    QCOMPARE(SignatureService::hashFile(path, manifest), expected);
+    QFile::remove(path);
+}
+
+void SignatureServiceTests::hashFile_Statistics_CountPrefixAndContent() {
+    QByteArray content(4096, 'x');
+    QString path = createTestCartridgeFile(content);
+    if (path.isEmpty()) {
+        QSKIP("Could not create test cartridge file");
+    }
+
+    SignatureService::HashStatistics statistics;
+    QByteArray hash = SignatureService::hashFile(path, QByteArray("manifest"), &statistics);
+    QCOMPARE(hash.size(), 32);
+    QCOMPARE(statistics.bytesHashed, qint64(4096 + 8));
+    QVERIFY(statistics.elapsedMs >= 0);
+    QVERIFY(statistics.megabytesPerSecond() > 0.0);
+    QFile::remove(path);
+}
+
+void SignatureServiceTests::hashFile_MissingFile_ReturnsEmpty() {
+    SignatureService::HashStatistics statistics;
+    QByteArray hash = SignatureService::hashFile("/nonexistent/path/to/cartridge.db", QByteArray(), &statistics);
+    QVERIFY(hash.isEmpty());
+    QCOMPARE(statistics.bytesHashed, qint64(0));
+}
+
+void SignatureServiceTests::hashFile_Cancelled_StopsAfterOneChunk() {
+    QByteArray content(SignatureService::hashChunkSize() * 4, 'x');
+    QString path = createTestCartridgeFile(content);
+    if (path.isEmpty()) {
+        QSKIP("Could not create test cartridge file");
+    }
+
+    // Cancelled once the first chunk has been read
+    int polls = 0;
+    QByteArray hash = SignatureService::hashFile(path, QByteArray(), nullptr, [&polls]() {
+        return ++polls > 1;
+    });
+    QVERIFY(hash.isEmpty());
+    QCOMPARE(polls, 2);
+    QFile::remove(path);
+}
+
 // QTEST_MAIN removed - using main.cpp test runner instead
 #include "SignatureServiceTests.moc"
 
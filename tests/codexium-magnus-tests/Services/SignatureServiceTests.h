@@ -20,6 +20,7 @@ private slots:
     void getKeyTrustLevel_OfficialKey_ReturnsOfficial();
     void getKeyTrustLevel_VerifiedKey_ReturnsVerified();
     void getKeyTrustLevel_UnknownKey_ReturnsUnverified();
+    void getKeyTrustLevel_KeysChangedConcurrently_ReadsConsistent();
     
     // Signature verification tests (require libsodium)
     void verifySignature_ValidSignature_ReturnsTrue();
@@ -32,10 +33,31 @@ private slots:
     void extractSignature_NoSignature_ReturnsEmpty();
     void extractPublicKey_ValidManifest_ReturnsKey();
     void extractPublicKey_NoKey_ReturnsEmpty();
+    void extractDigestFormat_NoDigest_ReturnsSequential();
+    void extractDigestFormat_MerkleDigest_ReturnsChunkSize();
+    void extractDigestFormat_UnknownFormat_ReturnsUnsupported();
+    void extractChunkHashes_MerkleDigest_SplitsTable();
+    void manifestPath_Cartridge_IsSidecarFile();
+    void signedManifest_SignedManifest_CompactSortedWithoutSignature();
     
     // Cartridge verification tests
     void verifyCartridge_UnsignedCartridge_ReturnsHomebrew();
     void verifyCartridge_InvalidPath_ReturnsInvalid();
+    void verifyCartridge_SignedCartridge_ReadsManifest();
+    void verifyCartridge_TamperedCartridge_ReturnsInvalid();
+    
+    // Verification cache tests
+    void verifyCartridge_CachedUnchangedFile_ReturnsCachedTrust();
+    void verifyCartridge_CachedChangedFile_IsVerifiedAgain();
+    void verifyCartridge_CachedChangedManifest_IsVerifiedAgain();
+    void verifyCartridge_StaleCacheEntry_ReverifiedInBackground();
+    void verifyCartridge_ValidSignature_FillsCache();
+    
+    // Streamed hashing tests
+    void hashFile_MultiChunkFile_MatchesOneShotHash();
+    void hashFile_Statistics_CountPrefixAndContent();
+    void hashFile_MissingFile_ReturnsEmpty();
+    void hashFile_Cancelled_StopsAfterOneChunk();
 
 private:
     // Helper methods
@@ -44,6 +66,8 @@ private:
     QByteArray createManifestJson(const QByteArray& signature = QByteArray(), 
                                   const QByteArray& publicKey = QByteArray());
     QString createTestCartridgeFile(const QByteArray& manifest = QByteArray());
+    QString createSignedCartridge(const QString& directory, const QByteArray& content,
+                                  QByteArray *publicKey, QByteArray *message);
     void* createTestService(); // Returns SignatureService* - using void* to avoid include
     
     QSettings *m_testSettings;
@@ -0,0 +1,141 @@
+#include "TrustGateTests.h"
+#include <QSemaphore>
+#include <QSettings>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include "Services/CartridgeService.h"
+#include "Services/ISignatureService.h"
+#include "Services/SignatureService.h"
+#include "Services/TrustGate.h"
+
+using namespace CodexiumMagnus::Services;
+
+// Signature service that reports a fixed trust level once released
+class FixedTrustSignatureService : public ISignatureService {
+public:
+    explicit FixedTrustSignatureService(TrustLevel trustLevel) : trustLevel(trustLevel) {}
+
+    TrustLevel verifyCartridge(const QString& cartridgePath) override {
+        Q_UNUSED(cartridgePath);
+        gate.acquire();
+        return trustLevel;
+    }
+    bool verifySignature(const QByteArray&, const QByteArray&, const QByteArray&) override { return false; }
+    void addTrustedKey(const QByteArray&, const QString&, bool) override {}
+    void removeTrustedKey(const QByteArray&) override {}
+    TrustLevel getKeyTrustLevel(const QByteArray&) const override { return TrustLevel::Unverified; }
+
+    TrustLevel trustLevel;
+    QSemaphore gate;
+};
+
+void TrustGateTests::init() {
+    m_tempDir = new QTemporaryDir();
+    m_cartridgeService = new CartridgeService();
+}
+
+void TrustGateTests::cleanup() {
+    CartridgeService* service = static_cast<CartridgeService*>(m_cartridgeService);
+    service->unloadCartridge();
+    QTRY_VERIFY(!service->isLoading());
+    delete service;
+    m_cartridgeService = nullptr;
+    delete m_tempDir;
+    m_tempDir = nullptr;
+}
+
+QString TrustGateTests::createCartridge(const QString& name) {
+    const QString path = m_tempDir->filePath(name);
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "trust_gate_cartridge");
+        db.setDatabaseName(path);
+        if (!db.open()) {
+            return QString();
+        }
+        QSqlQuery query(db);
+        query.exec("CREATE TABLE documents (id TEXT PRIMARY KEY, title TEXT NOT NULL, content TEXT, parent_id TEXT)");
+        query.exec("INSERT INTO documents VALUES ('doc1', 'Document 1', '<p>Content</p>', '')");
+        db.close();
+    }
+    QSqlDatabase::removeDatabase("trust_gate_cartridge");
+    return path;
+}
+
+void TrustGateTests::submit_NoCartridge_Runs() {
+    TrustGate gate(static_cast<CartridgeService*>(m_cartridgeService));
+    bool ran = false;
+
+    QCOMPARE(gate.submit("Opening external link", [&ran]() { ran = true; }), TrustGate::Decision::Run);
+    QVERIFY(ran);
+}
+
+void TrustGateTests::submit_UnsignedCartridge_PrintingRuns() {
+    CartridgeService* service = static_cast<CartridgeService*>(m_cartridgeService);
+    QSettings settings(m_tempDir->filePath("signature.ini"), QSettings::IniFormat);
+    SignatureService signatureService(&settings);
+    service->setSignatureService(&signatureService);
+
+    // No manifest next to the cartridge: unsigned, as most homebrew ones are
+    const QString path = createCartridge("unsigned.cartridge");
+    QVERIFY(!path.isEmpty());
+    QVERIFY(!QFile::exists(SignatureService::manifestPath(path)));
+    QVERIFY(service->loadCartridge(path));
+    QTRY_VERIFY(service->isTrustLevelDetermined());
+    QCOMPARE(service->getTrustLevel(), TrustLevel::Homebrew);
+
+    TrustGate gate(service);
+    bool printed = false;
+    QCOMPARE(gate.submit("Printing", [&printed]() { printed = true; }), TrustGate::Decision::Run);
+    QVERIFY(printed);
+
+    service->unloadCartridge();
+    QTRY_VERIFY(!service->isLoading());
+    service->setSignatureService(nullptr);
+}
+
+void TrustGateTests::submit_WhileVerifying_RunsOnceDetermined() {
+    CartridgeService* service = static_cast<CartridgeService*>(m_cartridgeService);
+    FixedTrustSignatureService signatureService(TrustLevel::Homebrew);
+    service->setSignatureService(&signatureService);
+    QVERIFY(service->loadCartridge(createCartridge("pending.cartridge")));
+
+    TrustGate gate(service);
+    bool printed = false;
+    QCOMPARE(gate.submit("Printing", [&printed]() { printed = true; }), TrustGate::Decision::Defer);
+    QVERIFY(!printed);
+    QCOMPARE(gate.deferredCount(), 1);
+
+    signatureService.gate.release();
+    QTRY_VERIFY(service->isTrustLevelDetermined());
+    QVERIFY(gate.runDeferred().isEmpty());
+    QVERIFY(printed);
+    QCOMPARE(gate.deferredCount(), 0);
+
+    service->unloadCartridge();
+    QTRY_VERIFY(!service->isLoading());
+    service->setSignatureService(nullptr);
+}
+
+void TrustGateTests::submit_InvalidCartridge_Refuses() {
+    CartridgeService* service = static_cast<CartridgeService*>(m_cartridgeService);
+    FixedTrustSignatureService signatureService(TrustLevel::Invalid);
+    service->setSignatureService(&signatureService);
+    QVERIFY(service->loadCartridge(createCartridge("tampered.cartridge")));
+
+    TrustGate gate(service);
+    bool printed = false;
+    QCOMPARE(gate.submit("Printing", [&printed]() { printed = true; }), TrustGate::Decision::Defer);
+
+    signatureService.gate.release();
+    QTRY_VERIFY(service->isTrustLevelDetermined());
+    QCOMPARE(gate.runDeferred(), QStringList{"Printing"});
+    QCOMPARE(gate.submit("Printing", [&printed]() { printed = true; }), TrustGate::Decision::Refuse);
+    QVERIFY(!printed);
+
+    service->unloadCartridge();
+    QTRY_VERIFY(!service->isLoading());
+    service->setSignatureService(nullptr);
+}
+
+// QTEST_MAIN removed - using main.cpp test runner instead
+#include "TrustGateTests.moc"
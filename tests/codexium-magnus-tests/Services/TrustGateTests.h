@@ -0,0 +1,27 @@
+#ifndef TRUSTGATETESTS_H
+#define TRUSTGATETESTS_H
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+
+class TrustGateTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    // Gate decisions, as MainWindow applies them to links and printing
+    void submit_NoCartridge_Runs();
+    void submit_UnsignedCartridge_PrintingRuns();
+    void submit_WhileVerifying_RunsOnceDetermined();
+    void submit_InvalidCartridge_Refuses();
+
+private:
+    QString createCartridge(const QString& name);
+
+    QTemporaryDir *m_tempDir;
+    void *m_cartridgeService; // CartridgeService* - using void* to avoid include
+};
+
+#endif // TRUSTGATETESTS_H
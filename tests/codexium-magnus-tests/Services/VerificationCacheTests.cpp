@@ -0,0 +1,137 @@
+#include "VerificationCacheTests.h"
+#include <QFile>
+#include "Services/VerificationCache.h"
+#include "DbInitializer.h"
+
+using namespace CodexiumMagnus::Services;
+
+QString VerificationCacheTests::createFile(const QString& name, const QByteArray& content) {
+    QString path = m_tempDir->filePath(name);
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(content) != content.size()) {
+        return QString();
+    }
+    return path;
+}
+
+void VerificationCacheTests::init() {
+    m_tempDir = new QTemporaryDir();
+    m_dbPath = m_tempDir->filePath("app.db");
+    CodexiumMagnus::Storage::DbInitializer::ensureCreated(m_dbPath);
+}
+
+void VerificationCacheTests::cleanup() {
+    delete m_tempDir;
+    m_tempDir = nullptr;
+}
+
+void VerificationCacheTests::store_ThenLookup_ReturnsEntry() {
+    QString cartridgePath = createFile("rules.cartridge", QByteArray("cartridge"));
+    QVERIFY(!cartridgePath.isEmpty());
+    VerificationCache cache(m_dbPath);
+
+    VerificationCache::Entry entry;
+    entry.path = cartridgePath;
+    entry.identity = VerificationCache::FileIdentity::of(cartridgePath);
+    entry.manifestIdentity = VerificationCache::FileIdentity::of(
+        createFile("rules.cartridge.manifest.json", QByteArray("{}")));
+    entry.digest = QByteArray(32, '\x5a');
+    entry.trustLevel = TrustLevel::Official;
+    entry.keyFingerprint = VerificationCache::keyFingerprint(QByteArray(32, '\x01'));
+    entry.verifiedUtc = QDateTime::currentDateTimeUtc();
+    QVERIFY(cache.store(entry));
+
+    // A second instance reads the same database, as after a restart
+    VerificationCache reopened(m_dbPath);
+    VerificationCache::Entry cached;
+    QVERIFY(reopened.lookup(cartridgePath, cached));
+    QCOMPARE(cached.identity, entry.identity);
+    QCOMPARE(cached.manifestIdentity, entry.manifestIdentity);
+    QVERIFY(cached.manifestIdentity.isValid());
+    QCOMPARE(cached.digest, entry.digest);
+    QCOMPARE(cached.trustLevel, TrustLevel::Official);
+    QCOMPARE(cached.keyFingerprint, entry.keyFingerprint);
+    QCOMPARE(cached.keyFingerprint.size(), 64);
+    QCOMPARE(cached.verifiedUtc.toSecsSinceEpoch(), entry.verifiedUtc.toSecsSinceEpoch());
+}
+
+void VerificationCacheTests::store_SamePath_ReplacesEntry() {
+    QString cartridgePath = createFile("rules.cartridge", QByteArray("cartridge"));
+    VerificationCache cache(m_dbPath);
+
+    VerificationCache::Entry entry;
+    entry.path = cartridgePath;
+    entry.identity = VerificationCache::FileIdentity::of(cartridgePath);
+    entry.digest = QByteArray(32, '\x01');
+    entry.verifiedUtc = QDateTime::currentDateTimeUtc();
+    QVERIFY(cache.store(entry));
+    entry.digest = QByteArray(32, '\x02');
+    entry.trustLevel = TrustLevel::Verified;
+    QVERIFY(cache.store(entry));
+
+    VerificationCache::Entry cached;
+    QVERIFY(cache.lookup(cartridgePath, cached));
+    QCOMPARE(cached.digest, QByteArray(32, '\x02'));
+    QCOMPARE(cached.trustLevel, TrustLevel::Verified);
+}
+
+void VerificationCacheTests::remove_StoredEntry_IsForgotten() {
+    QString cartridgePath = createFile("rules.cartridge", QByteArray("cartridge"));
+    VerificationCache cache(m_dbPath);
+
+    VerificationCache::Entry entry;
+    entry.path = cartridgePath;
+    entry.identity = VerificationCache::FileIdentity::of(cartridgePath);
+    entry.digest = QByteArray(32, '\x01');
+    entry.verifiedUtc = QDateTime::currentDateTimeUtc();
+    QVERIFY(cache.store(entry));
+
+    cache.remove(cartridgePath);
+    VerificationCache::Entry cached;
+    QVERIFY(!cache.lookup(cartridgePath, cached));
+}
+
+void VerificationCacheTests::lookup_AfterFirstLookup_ServedFromMemory() {
+    QString cartridgePath = createFile("rules.cartridge", QByteArray("cartridge"));
+    VerificationCache cache(m_dbPath);
+
+    VerificationCache::Entry entry;
+    entry.path = cartridgePath;
+    entry.identity = VerificationCache::FileIdentity::of(cartridgePath);
+    entry.digest = QByteArray(32, '\x01');
+    entry.verifiedUtc = QDateTime::currentDateTimeUtc();
+    QVERIFY(cache.store(entry));
+    VerificationCache::Entry cached;
+    QVERIFY(cache.lookup(cartridgePath, cached));
+
+    // Loads no longer open the app database once the table is in memory
+    QVERIFY(QFile::remove(m_dbPath));
+    QVERIFY(cache.lookup(cartridgePath, cached));
+    QCOMPARE(cached.digest, entry.digest);
+    QVERIFY(!cache.lookup(m_tempDir->filePath("unknown.cartridge"), cached));
+}
+
+void VerificationCacheTests::lookup_UnknownPath_ReturnsFalse() {
+    VerificationCache cache(m_dbPath);
+    VerificationCache::Entry cached;
+    QVERIFY(!cache.lookup(m_tempDir->filePath("unknown.cartridge"), cached));
+}
+
+void VerificationCacheTests::fileIdentity_RewrittenFile_Differs() {
+    QString cartridgePath = createFile("rules.cartridge", QByteArray("original"));
+    VerificationCache::FileIdentity before = VerificationCache::FileIdentity::of(cartridgePath);
+    QVERIFY(before.isValid());
+    QCOMPARE(before, VerificationCache::FileIdentity::of(cartridgePath));
+
+    createFile("rules.cartridge", QByteArray("tampered content"));
+    VerificationCache::FileIdentity after = VerificationCache::FileIdentity::of(cartridgePath);
+    QVERIFY(after.isValid());
+    QVERIFY(after != before);
+}
+
+void VerificationCacheTests::fileIdentity_MissingFile_IsInvalid() {
+    QVERIFY(!VerificationCache::FileIdentity::of(m_tempDir->filePath("missing.cartridge")).isValid());
+}
+
+// QTEST_MAIN removed - using main.cpp test runner instead
+#include "VerificationCacheTests.moc"
@@ -0,0 +1,32 @@
+#ifndef VERIFICATIONCACHETESTS_H
+#define VERIFICATIONCACHETESTS_H
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+
+class VerificationCacheTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    // Persistence tests
+    void store_ThenLookup_ReturnsEntry();
+    void store_SamePath_ReplacesEntry();
+    void remove_StoredEntry_IsForgotten();
+    void lookup_AfterFirstLookup_ServedFromMemory();
+    void lookup_UnknownPath_ReturnsFalse();
+
+    // File identity tests
+    void fileIdentity_RewrittenFile_Differs();
+    void fileIdentity_MissingFile_IsInvalid();
+
+private:
+    QString createFile(const QString& name, const QByteArray& content);
+
+    QTemporaryDir *m_tempDir;
+    QString m_dbPath;
+};
+
+#endif // VERIFICATIONCACHETESTS_H
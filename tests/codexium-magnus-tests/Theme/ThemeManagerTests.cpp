@@ -6,6 +6,7 @@
 #include <QTemporaryFile>
 #include <QFile>
 #include "Theme/ThemeManager.h"
+#include <QJsonArray>
 
 using namespace CodexiumMagnus::Theme;
 
@@ -112,6 +113,37 @@ void ThemeManagerTests::getToken_InvalidToken_ReturnsEmpty() {
     QVERIFY(value.isEmpty());
 }
 
+void ThemeManagerTests::tokenDiff_ChangedAndRemovedTokens_AreReported() {
+    QMap<QString, QString> from{{"--a", "1"}, {"--b", "2"}, {"--c", "3"}};
+    QMap<QString, QString> to{{"--a", "1"}, {"--b", "20"}, {"--d", "4"}};
+    
+    QJsonObject diff = ThemeManager::tokenDiff(from, to);
+    QJsonObject set = diff["set"].toObject();
+    QCOMPARE(set.size(), 2);
+    QCOMPARE(set["--b"].toString(), QString("20"));
+    QCOMPARE(set["--d"].toString(), QString("4"));
+    QCOMPARE(diff["remove"].toArray(), QJsonArray({"--c"}));
+    
+    QJsonObject none = ThemeManager::tokenDiff(to, to);
+    QVERIFY(none["set"].toObject().isEmpty());
+    QVERIFY(none["remove"].toArray().isEmpty());
+}
+
+void ThemeManagerTests::tokenDiff_LightToDark_SetsOnlyChangedTokens() {
+    ThemeManager* manager = static_cast<ThemeManager*>(m_manager);
+    manager->setTheme(ThemeManager::Light);
+    const QMap<QString, QString> light = manager->getTokenMap();
+    manager->setTheme(ThemeManager::Dark);
+    const QMap<QString, QString> dark = manager->getTokenMap();
+    
+    QJsonObject set = ThemeManager::tokenDiff(light, dark)["set"].toObject();
+    QVERIFY(!set.isEmpty());
+    for (auto it = set.constBegin(); it != set.constEnd(); ++it) {
+        QCOMPARE(it.value().toString(), dark.value(it.key()));
+        QVERIFY(light.value(it.key()) != dark.value(it.key()));
+    }
+}
+
 void ThemeManagerTests::loadCustomTheme_ValidPath_SetsPath() {
     // Create a temporary theme file
     QTemporaryFile tempFile;
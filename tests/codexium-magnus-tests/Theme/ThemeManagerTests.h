@@ -22,6 +22,8 @@ private slots:
     void getTokenMap_AfterSetTheme_ReturnsTokens();
     void getToken_ValidToken_ReturnsValue();
     void getToken_InvalidToken_ReturnsEmpty();
+    void tokenDiff_ChangedAndRemovedTokens_AreReported();
+    void tokenDiff_LightToDark_SetsOnlyChangedTokens();
     
     // Custom theme tests
     void loadCustomTheme_ValidPath_SetsPath();
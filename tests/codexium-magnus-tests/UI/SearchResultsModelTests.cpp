@@ -0,0 +1,134 @@
+#include "SearchResultsModelTests.h"
+#include <QSignalSpy>
+#include "UI/SearchResultsModel.h"
+
+using namespace CodexiumMagnus::UI;
+using CodexiumMagnus::Services::SearchHit;
+
+namespace {
+QList<SearchHit> makeHits(int first, int count) {
+    QList<SearchHit> hits;
+    for (int i = first; i < first + count; ++i) {
+        SearchHit hit;
+        hit.documentId = QString("doc%1").arg(i);
+        hit.title = QString("Document %1").arg(i);
+        hit.rowid = 100 + i;
+        hits << hit;
+    }
+    return hits;
+}
+}
+
+void SearchResultsModelTests::setHits_NewSearch_ResetsRows() {
+    SearchResultsModel model;
+    model.setHits(makeHits(0, 5));
+    QSignalSpy resetSpy(&model, &QAbstractItemModel::modelReset);
+    
+    model.setHits(makeHits(10, 3));
+    
+    QCOMPARE(resetSpy.count(), 1);
+    QCOMPARE(model.rowCount(), 3);
+    QCOMPARE(model.row(0).hit.documentId, QString("doc10"));
+}
+
+void SearchResultsModelTests::appendHits_NextPage_InsertsRowsWithoutReset() {
+    SearchResultsModel model;
+    model.setHits(makeHits(0, 25));
+    QSignalSpy resetSpy(&model, &QAbstractItemModel::modelReset);
+    QSignalSpy insertedSpy(&model, &QAbstractItemModel::rowsInserted);
+    
+    model.appendHits(makeHits(25, 25));
+    
+    QCOMPARE(resetSpy.count(), 0);
+    QCOMPARE(insertedSpy.count(), 1);
+    QCOMPARE(insertedSpy.first().at(1).toInt(), 25);
+    QCOMPARE(insertedSpy.first().at(2).toInt(), 49);
+    QCOMPARE(model.rowCount(), 50);
+    QCOMPARE(model.row(49).hit.documentId, QString("doc49"));
+}
+
+void SearchResultsModelTests::setSnippets_ShownHits_EmitsDataChanged() {
+    SearchResultsModel model;
+    model.setHits(makeHits(0, 5));
+    QSignalSpy changedSpy(&model, &QAbstractItemModel::dataChanged);
+    
+    SearchHit snippet;
+    snippet.documentId = "doc3";
+    snippet.rowid = 103;
+    snippet.snippet = "the <mark>archive</mark> opens";
+    snippet.matchOffsets = {qMakePair(120, 7)};
+    model.setSnippets({snippet});
+    
+    QCOMPARE(changedSpy.count(), 1);
+    QCOMPARE(changedSpy.first().at(0).toModelIndex().row(), 3);
+    const SearchResultsModel::Row& row = model.row(3);
+    QCOMPARE(row.hit.title, QString("Document 3"));
+    QCOMPARE(row.hit.matchOffsets.first(), qMakePair(120, 7));
+    QCOMPARE(row.snippetText, QString("the archive opens"));
+    QCOMPARE(row.snippetMarks.first(), qMakePair(4, 7));
+}
+
+void SearchResultsModelTests::setSnippets_UnknownDocument_IsIgnored() {
+    SearchResultsModel model;
+    model.setHits(makeHits(0, 5));
+    QSignalSpy changedSpy(&model, &QAbstractItemModel::dataChanged);
+    
+    SearchHit snippet;
+    snippet.documentId = "elsewhere";
+    snippet.rowid = 999;
+    snippet.snippet = "<mark>stale</mark>";
+    model.setSnippets({snippet});
+    
+    QCOMPARE(changedSpy.count(), 0);
+}
+
+void SearchResultsModelTests::setSnippets_SameDocumentTwice_MatchedByRowid() {
+    SearchResultsModel model;
+    QList<SearchHit> hits = makeHits(0, 2);
+    hits[1].documentId = hits[0].documentId;
+    model.setHits(hits);
+    
+    SearchHit snippet = hits[1];
+    snippet.snippet = "second <mark>row</mark>";
+    model.setSnippets({snippet});
+    
+    QVERIFY(model.row(0).hit.snippet.isEmpty());
+    QCOMPARE(model.row(1).hit.snippet, QString("second <mark>row</mark>"));
+}
+
+void SearchResultsModelTests::data_Roles_ReturnHitFields() {
+    SearchResultsModel model;
+    QList<SearchHit> hits = makeHits(0, 1);
+    hits.first().snippet = "a <mark>hit</mark>";
+    model.setHits(hits);
+    
+    const QModelIndex index = model.index(0);
+    QCOMPARE(index.data(Qt::DisplayRole).toString(), QString("Document 0"));
+    QCOMPARE(index.data(SearchResultsModel::DocumentIdRole).toString(), QString("doc0"));
+    QCOMPARE(index.data(SearchResultsModel::SnippetRole).toString(), QString("a <mark>hit</mark>"));
+    QCOMPARE(index.data(SearchResultsModel::HitRole).value<SearchHit>().documentId, QString("doc0"));
+}
+
+void SearchResultsModelTests::parseSnippet_Marks_ReturnsRangesInPlainText() {
+    QString text;
+    QList<QPair<int, int>> marks;
+    SearchResultsModel::parseSnippet("...use <mark>FTS5</mark> and <mark>search</mark>...", text, marks);
+    
+    QCOMPARE(text, QString("...use FTS5 and search..."));
+    QCOMPARE(marks.size(), 2);
+    QCOMPARE(marks.at(0), qMakePair(7, 4));
+    QCOMPARE(marks.at(1), qMakePair(16, 6));
+}
+
+void SearchResultsModelTests::parseSnippet_MarkupAndEntities_StrippedAndDecoded() {
+    QString text;
+    QList<QPair<int, int>> marks;
+    SearchResultsModel::parseSnippet("<p>Tom &amp; <b>Jerry</b>\n\n  &lt;<mark>cat</mark>&gt; <a href=\"x", text, marks);
+    
+    QCOMPARE(text, QString("Tom & Jerry <cat>"));
+    QCOMPARE(marks.size(), 1);
+    QCOMPARE(marks.first(), qMakePair(13, 3));
+}
+
+// QTEST_MAIN removed - using main.cpp instead
+#include "SearchResultsModelTests.moc"
@@ -0,0 +1,23 @@
+#ifndef SEARCHRESULTSMODELTESTS_H
+#define SEARCHRESULTSMODELTESTS_H
+
+#include <QtTest/QtTest>
+
+class SearchResultsModelTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    // Row tests
+    void setHits_NewSearch_ResetsRows();
+    void appendHits_NextPage_InsertsRowsWithoutReset();
+    void setSnippets_ShownHits_EmitsDataChanged();
+    void setSnippets_UnknownDocument_IsIgnored();
+    void setSnippets_SameDocumentTwice_MatchedByRowid();
+    void data_Roles_ReturnHitFields();
+    
+    // Snippet parsing tests
+    void parseSnippet_Marks_ReturnsRangesInPlainText();
+    void parseSnippet_MarkupAndEntities_StrippedAndDecoded();
+};
+
+#endif // SEARCHRESULTSMODELTESTS_H
@@ -6,10 +6,20 @@
 #include "Services/SignatureServiceTests.h"
 #include "Services/LinkServiceTests.h"
 #include "Services/CartridgeServiceTests.h"
+#include "Services/CartridgeNavigationModelTests.h"
 #include "Services/SearchServiceTests.h"
+#include "Services/FuzzyTermIndexTests.h"
+#include "Services/CaseSensitiveFilterTests.h"
+#include "Services/FederatedSearchServiceTests.h"
+#include "Services/AssetServiceTests.h"
+#include "Services/MerkleTreeDigestTests.h"
+#include "Services/VerificationCacheTests.h"
+#include "Services/ChunkVerifierTests.h"
+#include "Services/TrustGateTests.h"
 #include "UI/TypographySettingsWidgetTests.h"
 #include "UI/BibliographySettingsWidgetTests.h"
 #include "UI/SettingsDialogTests.h"
+#include "UI/SearchResultsModelTests.h"
 #include "Theme/ThemeManagerTests.h"
 
 int main(int argc, char *argv[])
@@ -64,6 +74,19 @@ int main(int argc, char *argv[])
         }
     }
     
+    {
+        CartridgeNavigationModelTests test;
+        qDebug() << "\n=== Running CartridgeNavigationModelTests ===";
+        int result = QTest::qExec(&test, argc, argv);
+        totalTests++;
+        if (result != 0) {
+            totalFailures++;
+            qDebug() << "✗ CartridgeNavigationModelTests FAILED";
+        } else {
+            qDebug() << "✓ CartridgeNavigationModelTests PASSED";
+        }
+    }
+    
     {
         SearchServiceTests test;
         qDebug() << "\n=== Running SearchServiceTests ===";
@@ -77,6 +100,110 @@ int main(int argc, char *argv[])
         }
     }
     
+    {
+        FuzzyTermIndexTests test;
+        qDebug() << "\n=== Running FuzzyTermIndexTests ===";
+        int result = QTest::qExec(&test, argc, argv);
+        totalTests++;
+        if (result != 0) {
+            totalFailures++;
+            qDebug() << "✗ FuzzyTermIndexTests FAILED";
+        } else {
+            qDebug() << "✓ FuzzyTermIndexTests PASSED";
+        }
+    }
+    
+    {
+        CaseSensitiveFilterTests test;
+        qDebug() << "\n=== Running CaseSensitiveFilterTests ===";
+        int result = QTest::qExec(&test, argc, argv);
+        totalTests++;
+        if (result != 0) {
+            totalFailures++;
+            qDebug() << "✗ CaseSensitiveFilterTests FAILED";
+        } else {
+            qDebug() << "✓ CaseSensitiveFilterTests PASSED";
+        }
+    }
+    
+    {
+        FederatedSearchServiceTests test;
+        qDebug() << "\n=== Running FederatedSearchServiceTests ===";
+        int result = QTest::qExec(&test, argc, argv);
+        totalTests++;
+        if (result != 0) {
+            totalFailures++;
+            qDebug() << "✗ FederatedSearchServiceTests FAILED";
+        } else {
+            qDebug() << "✓ FederatedSearchServiceTests PASSED";
+        }
+    }
+    
+    {
+        AssetServiceTests test;
+        qDebug() << "\n=== Running AssetServiceTests ===";
+        int result = QTest::qExec(&test, argc, argv);
+        totalTests++;
+        if (result != 0) {
+            totalFailures++;
+            qDebug() << "✗ AssetServiceTests FAILED";
+        } else {
+            qDebug() << "✓ AssetServiceTests PASSED";
+        }
+    }
+    
+    {
+        MerkleTreeDigestTests test;
+        qDebug() << "\n=== Running MerkleTreeDigestTests ===";
+        int result = QTest::qExec(&test, argc, argv);
+        totalTests++;
+        if (result != 0) {
+            totalFailures++;
+            qDebug() << "✗ MerkleTreeDigestTests FAILED";
+        } else {
+            qDebug() << "✓ MerkleTreeDigestTests PASSED";
+        }
+    }
+    
+    {
+        VerificationCacheTests test;
+        qDebug() << "\n=== Running VerificationCacheTests ===";
+        int result = QTest::qExec(&test, argc, argv);
+        totalTests++;
+        if (result != 0) {
+            totalFailures++;
+            qDebug() << "✗ VerificationCacheTests FAILED";
+        } else {
+            qDebug() << "✓ VerificationCacheTests PASSED";
+        }
+    }
+    
+    {
+        ChunkVerifierTests test;
+        qDebug() << "\n=== Running ChunkVerifierTests ===";
+        int result = QTest::qExec(&test, argc, argv);
+        totalTests++;
+        if (result != 0) {
+            totalFailures++;
+            qDebug() << "✗ ChunkVerifierTests FAILED";
+        } else {
+            qDebug() << "✓ ChunkVerifierTests PASSED";
+        }
+    }
+    
+    {
+        TrustGateTests test;
+        qDebug() << "\n=== Running TrustGateTests ===";
+        int result = QTest::qExec(&test, argc, argv);
+        totalTests++;
+        if (result != 0) {
+            totalFailures++;
+            qDebug() << "✗ TrustGateTests FAILED";
+        } else {
+            qDebug() << "✓ TrustGateTests PASSED";
+        }
+    }
+    
     {
         TypographySettingsWidgetTests test;
         qDebug() << "\n=== Running TypographySettingsWidgetTests ===";
@@ -116,6 +243,19 @@ int main(int argc, char *argv[])
         }
     }
     
+    {
+        SearchResultsModelTests test;
+        qDebug() << "\n=== Running SearchResultsModelTests ===";
+        int result = QTest::qExec(&test, argc, argv);
+        totalTests++;
+        if (result != 0) {
+            totalFailures++;
+            qDebug() << "✗ SearchResultsModelTests FAILED";
+        } else {
+            qDebug() << "✓ SearchResultsModelTests PASSED";
+        }
+    }
+    
     {
         ThemeManagerTests test;
         qDebug() << "\n=== Running ThemeManagerTests ===";